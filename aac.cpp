@@ -1,6 +1,4 @@
 
-//#define AAC_ENABLE_SBR
-
 #include "common/assembly.h"
 
 #include "aac/aacdec.h"
@@ -8,6 +6,15 @@
 #ifdef  AAC_ENABLE_SBR
  #include "aac/sbr.h"
  #include "aac/sbr.c"
+ #include "aac/sbrfft.c"
+ #include "aac/sbrfreq.c"
+ #include "aac/sbrhfadj.c"
+ #include "aac/sbrhfgen.c"
+ #include "aac/sbrhuff.c"
+ #include "aac/sbrmath.c"
+ #include "aac/sbrqmf.c"
+ #include "aac/sbrside.c"
+ #include "aac/sbrtabs.c"
 #endif
 
 #include "aac/aacdec.c"
@@ -22,6 +29,12 @@
 #include "aac/tns.c"
 #include "aac/dct4.c"
 #include "aac/imdct.c"
+#ifdef  AAC_ENABLE_UPSAMPLE
+ #include "aac/upsample.c"
+#endif
+#ifdef  AAC_ENABLE_SBR
+ #include "aac/sbrimdct.c"
+#endif
 #include "aac/fft.c"
 
 #include "aac/aactabs.c"
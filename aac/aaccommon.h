@@ -83,6 +83,8 @@
 #define EXT_SBR_DATA		0x0d
 #define EXT_SBR_DATA_CRC	0x0e
 
+#define MAX_HUFF_BITS		20
+
 #define IS_ADIF(p)		((p)[0] == 'A' && (p)[1] == 'D' && (p)[2] == 'I' && (p)[3] == 'F')
 #define GET_ELE_ID(p)	((AACElementID)(*(p) >> (8-NUM_SYN_ID_BITS)))
 
@@ -110,6 +112,13 @@ enum {
 	AAC_ID_END =  7
 };
 
+/* canonical Huffman table description, shared by the core and SBR decoders */
+typedef struct _HuffInfo {
+	int maxBits;							/* number of bits in longest codeword */
+	unsigned char count[MAX_HUFF_BITS];		/* count[i] = number of codes with length i+1 bits */
+	int offset;								/* offset into symbol table */
+} HuffInfo;
+
 typedef struct _AACDecInfo {
 	/* pointers to platform-specific state information */
 	void *psInfoBase;	/* baseline MPEG-4 LC decoding */
@@ -139,12 +148,31 @@ typedef struct _AACDecInfo {
 	int profile;
 	int format;
 	int sbrEnabled;
+	int sbrCoreOnly;	/* skip SBR, upsample the core instead (AACSetSBRCoreOnly()) */
 	int tnsUsed;
 	int pnsUsed;
 	int frameCount;
 
+#ifdef AAC_STAGE_STATS
+	AACStageStats stageStats;
+#endif
+#ifdef AAC_FRAME_STATS
+	AACFrameStats frameStats;
+#endif
+#ifdef AAC_STACK_STATS
+	int stackPeak;
+#endif
+
 } AACDecInfo;
 
+#ifdef AAC_STAGE_STATS
+#define STAGE_START()		stageTime = CYCLES()
+#define STAGE_END(stage)	AddStageTime(aacDecInfo, stage, stageTime)
+#else
+#define STAGE_START()
+#define STAGE_END(stage)
+#endif
+
 /* decoder functions which must be implemented for each platform */
 AACDecInfo *AllocateBuffers(void);
 void FreeBuffers(AACDecInfo *aacDecInfo);
@@ -166,13 +194,23 @@ int DeinterleaveShortBlocks(AACDecInfo *aacDecInfo, int ch);
 int PNS(AACDecInfo *aacDecInfo, int ch);
 int TNSFilter(AACDecInfo *aacDecInfo, int ch);
 int IMDCT(AACDecInfo *aacDecInfo, int ch, int chBase, short *outbuf);
+int UpsampleCore(AACDecInfo *aacDecInfo, short *outbuf);
+#ifdef AAC_STAGE_STATS
+void AddStageTime(AACDecInfo *aacDecInfo, int stage, unsigned int start);
+#endif
+
+/* huffman.c */
+#define DecodeHuffmanScalar	STATNAME(DecodeHuffmanScalar)
+int DecodeHuffmanScalar(const signed short *huffTab, const HuffInfo *huffTabInfo, unsigned int bitBuf, signed int *val);
 
 /* SBR specific functions */
 int InitSBR(AACDecInfo *aacDecInfo);
 void FreeSBR(AACDecInfo *aacDecInfo);
+int GetSBRMemSize(void);
 int DecodeSBRBitstream(AACDecInfo *aacDecInfo, int chBase);
 int DecodeSBRData(AACDecInfo *aacDecInfo, int chBase, short *outbuf);
 int FlushCodecSBR(AACDecInfo *aacDecInfo);
+int SetSBRLowPower(AACDecInfo *aacDecInfo, int lowPower);
 
 /* aactabs.c - global ROM tables */
 extern const int sampRateTab[NUM_SAMPLE_RATES];
@@ -43,12 +43,52 @@
  * aacdec.c - platform-independent top level decoder API
  **************************************************************************************/
 
+#include <string.h>		/* for memcpy, memset */
 #include "aaccommon.h"
 
-//#include "profile.h"
+#ifdef AAC_STACK_STATS
+#include "../common/stackpaint.h"
+#endif
+
+#ifdef AAC_STAGE_STATS
+/**************************************************************************************
+ * Function:    AddStageTime
+ *
+ * Description: book the time since start to one stage of the current channel element
+ *
+ * Inputs:      valid AACDecInfo struct
+ *              stage (AAC_STAGE_xxx)
+ *              CYCLES() at the start of the stage
+ *
+ * Outputs:     updated stageStats
+ *
+ * Return:      none
+ *
+ * Notes:       SBR data comes in a fill element, its time goes to the SCE or CPE
+ *                the fill element follows
+ **************************************************************************************/
+void AddStageTime(AACDecInfo *aacDecInfo, int stage, unsigned int start)
+{
+	unsigned int t = CYCLES() - start;
+	AACStageStats *stats = &aacDecInfo->stageStats;
+	int id, elem;
+
+	id = aacDecInfo->currBlockID;
+	if (id == AAC_ID_FIL)
+		id = aacDecInfo->prevBlockID;
+	if (id == AAC_ID_CPE)
+		elem = AAC_STATS_CPE;
+	else if (id == AAC_ID_LFE)
+		elem = AAC_STATS_LFE;
+	else
+		elem = AAC_STATS_SCE;
 
-#define PROFILE_START(x)
-#define PROFILE_END()
+	stats->time[elem][stage] += t;
+	stats->calls[elem][stage]++;
+	if (t > stats->maxTime[elem][stage])
+		stats->maxTime[elem][stage] = t;
+}
+#endif
 
 /**************************************************************************************
  * Function:    AACInitDecoder
@@ -56,6 +96,7 @@
  * Description: allocate memory for platform-specific data
  *              clear all the user-accessible fields
  *              initialize SBR decoder if enabled
+ *              without SBR decoder, HE-AAC streams are always decoded core-only
  *
  * Inputs:      none
  *
@@ -76,6 +117,8 @@ HAACDecoder AACInitDecoder(void)
 		AACFreeDecoder(aacDecInfo);
 		return 0;
 	}
+#else
+	aacDecInfo->sbrCoreOnly = 1;
 #endif
 
 	return (HAACDecoder)aacDecInfo;
@@ -132,6 +175,96 @@ int AACFindSyncWord(unsigned char *buf, int nBytes)
 	return -1;
 }
 
+/**************************************************************************************
+ * Function:    DescriptorLength
+ *
+ * Description: read the length field of an MPEG-4 descriptor (1 to 4 bytes, 7 bits each)
+ *
+ * Inputs:      buffer, number of bytes in buffer, read position
+ *
+ * Outputs:     updated read position
+ *
+ * Return:      length of the descriptor payload in bytes
+ **************************************************************************************/
+static int DescriptorLength(unsigned char *buf, int nBytes, int *pos)
+{
+	int i, b, len;
+
+	len = 0;
+	for (i = 0; i < 4 && *pos < nBytes; i++) {
+		b = buf[(*pos)++];
+		len = (len << 7) | (b & 0x7f);
+		if (!(b & 0x80))
+			break;
+	}
+	return len;
+}
+
+/**************************************************************************************
+ * Function:    AACParseESDS
+ *
+ * Description: get channels and core sample rate from the AudioSpecificConfig in the
+ *                esds box of an MP4 audio track
+ *
+ * Inputs:      buffer starting with the esds box header
+ *              number of bytes in buffer
+ *
+ * Outputs:     number of channels (0 if not 1 or 2, e.g. given by a PCE)
+ *              sample rate of the AAC core
+ *
+ * Return:      0 if successful, error code (< 0) if the box can't be parsed
+ *
+ * Notes:       HE-AAC files often put the output rate in the mp4a entry, the decoder
+ *                needs the core rate for AACSetRawBlockParams()
+ *              explicit SBR signalling (object type 5) also has the core rate here
+ *              escaped object types and explicit sample rates are not supported
+ **************************************************************************************/
+int AACParseESDS(unsigned char *buf, int nBytes, int *nChans, int *sampRate)
+{
+	int pos, flags, len, objectType, sampRateIdx, chanConfig;
+
+	if (nBytes < 12 || buf[4] != 'e' || buf[5] != 's' || buf[6] != 'd' || buf[7] != 's')
+		return ERR_AAC_INVALID_FRAME;
+	pos = 12;	/* box header, version and flags */
+
+	/* ES_Descriptor */
+	if (pos >= nBytes || buf[pos++] != 0x03)
+		return ERR_AAC_INVALID_FRAME;
+	DescriptorLength(buf, nBytes, &pos);
+	if (pos + 3 > nBytes)
+		return ERR_AAC_INVALID_FRAME;
+	flags = buf[pos + 2];
+	pos += 3;								/* ES_ID, flags */
+	if (flags & 0x80)	pos += 2;			/* dependsOn_ES_ID */
+	if ((flags & 0x40) && pos < nBytes)
+		pos += 1 + buf[pos];				/* URL */
+	if (flags & 0x20)	pos += 2;			/* OCR_ES_Id */
+
+	/* DecoderConfigDescriptor */
+	if (pos >= nBytes || buf[pos++] != 0x04)
+		return ERR_AAC_INVALID_FRAME;
+	DescriptorLength(buf, nBytes, &pos);
+	pos += 13;								/* objectType, streamType, bufferSize, bitrates */
+
+	/* DecoderSpecificInfo = AudioSpecificConfig */
+	if (pos >= nBytes || buf[pos++] != 0x05)
+		return ERR_AAC_INVALID_FRAME;
+	len = DescriptorLength(buf, nBytes, &pos);
+	if (len < 2 || pos + 2 > nBytes)
+		return ERR_AAC_INVALID_FRAME;
+
+	objectType = buf[pos] >> 3;
+	sampRateIdx = ((buf[pos] & 0x07) << 1) | (buf[pos + 1] >> 7);
+	chanConfig = (buf[pos + 1] >> 3) & 0x0f;
+	if (objectType == 31 || sampRateIdx >= NUM_SAMPLE_RATES)
+		return ERR_AAC_INVALID_FRAME;
+
+	*sampRate = sampRateTab[sampRateIdx];
+	*nChans = (chanConfig == 1 || chanConfig == 2) ? chanConfig : 0;
+
+	return ERR_AAC_NONE;
+}
+
 /**************************************************************************************
  * Function:    AACGetLastFrameInfo
  *
@@ -239,6 +372,10 @@ int AACFlushCodec(HAACDecoder hAACDecoder)
 	aacDecInfo->adtsBlocksLeft = 0;
 	aacDecInfo->tnsUsed = 0;
 	aacDecInfo->pnsUsed = 0;
+#ifdef AAC_FRAME_STATS
+	/* filled in by IMDCT() and DecodeSBRData() */
+	memset(&aacDecInfo->frameStats, 0, sizeof(AACFrameStats));
+#endif
 
 	/* reset internal codec state (flush overlap buffers, etc.) */
 	FlushCodec(aacDecInfo);
@@ -250,7 +387,162 @@ int AACFlushCodec(HAACDecoder hAACDecoder)
 }
 
 /**************************************************************************************
- * Function:    AACDecode
+ * Function:    AACSetSBRLowPower
+ *
+ * Description: select low-power (real-valued) SBR for this decoder instance
+ *
+ * Inputs:      valid AAC decoder instance pointer (HAACDecoder)
+ *              non-zero for low-power SBR, 0 for high-quality SBR (default)
+ *
+ * Outputs:     updated SBR state
+ *
+ * Return:      0 if successful, error code (< 0) if error
+ *
+ * Notes:       low-power SBR uses a real-valued QMF bank and HF generator with
+ *                aliasing reduction, for a small loss in quality
+ *              it is not half the work of the complex version: the QMF convolutions
+ *                are the same in both modes and dominate, only the transforms, HF
+ *                generation and adjustment get cheaper (about 1/6 less HE-AAC
+ *                decode time on the host)
+ *              it doesn't save memory either, PSInfoSBR keeps its complex-sized
+ *                buffers (see sbr.h)
+ *              changing the mode flushes the SBR state, so call it before decoding
+ *                (or right after AACFlushCodec)
+ *              does nothing without AAC_ENABLE_SBR
+ **************************************************************************************/
+int AACSetSBRLowPower(HAACDecoder hAACDecoder, int lowPower)
+{
+	AACDecInfo *aacDecInfo = (AACDecInfo *)hAACDecoder;
+
+	if (!aacDecInfo)
+		return ERR_AAC_NULL_POINTER;
+
+#ifdef AAC_ENABLE_SBR
+	return SetSBRLowPower(aacDecInfo, lowPower);
+#else
+	return ERR_AAC_NONE;
+#endif
+}
+
+/**************************************************************************************
+ * Function:    AACSetSBRCoreOnly
+ *
+ * Description: decode only the AAC core of HE-AAC streams, without SBR
+ *
+ * Inputs:      valid AAC decoder instance pointer (HAACDecoder)
+ *              non-zero to skip SBR, 0 to decode it (default)
+ *
+ * Outputs:     updated decoder state
+ *
+ * Return:      0 if successful, error code (< 0) if error
+ *
+ * Notes:       the SBR data is not even parsed, the core output is upsampled by 2
+ *                with a half-band filter instead (UpsampleCore), so sampRateOut and
+ *                outputSamps stay the same - a cheap fallback when the CPU can't
+ *                keep up with SBR, at the cost of the high band
+ *              call it between frames, switching back to SBR flushes the SBR state
+ *                (it's stale), expect a click at the switch
+ *              without AAC_ENABLE_SBR streams are always decoded core-only, without
+ *                AAC_ENABLE_UPSAMPLE (or AAC_ENABLE_SBR) it does nothing
+ **************************************************************************************/
+int AACSetSBRCoreOnly(HAACDecoder hAACDecoder, int coreOnly)
+{
+	AACDecInfo *aacDecInfo = (AACDecInfo *)hAACDecoder;
+
+	if (!aacDecInfo)
+		return ERR_AAC_NULL_POINTER;
+
+#ifdef AAC_ENABLE_SBR
+	coreOnly = (coreOnly ? 1 : 0);
+	if (aacDecInfo->sbrCoreOnly && !coreOnly)
+		FlushCodecSBR(aacDecInfo);
+	aacDecInfo->sbrCoreOnly = coreOnly;
+#endif
+
+	return ERR_AAC_NONE;
+}
+
+#ifdef AAC_STAGE_STATS
+/**************************************************************************************
+ * Function:    AACGetStageStats
+ *
+ * Description: get the accumulated per-stage timing of AACDecode
+ *
+ * Inputs:      valid AAC decoder instance pointer (HAACDecoder)
+ *              pointer to AACStageStats struct
+ *
+ * Outputs:     filled-in AACStageStats struct
+ *
+ * Return:      0 if successful, error code (< 0) if error
+ *
+ * Notes:       times are cycles on ARM, nanoseconds on the host
+ *              the copy is not atomic, a decode running in a higher priority
+ *                interrupt may update the stats while they are copied
+ **************************************************************************************/
+int AACGetStageStats(HAACDecoder hAACDecoder, AACStageStats *stats)
+{
+	AACDecInfo *aacDecInfo = (AACDecInfo *)hAACDecoder;
+
+	if (!aacDecInfo || !stats)
+		return ERR_AAC_NULL_POINTER;
+
+	memcpy(stats, &aacDecInfo->stageStats, sizeof(AACStageStats));
+
+	return ERR_AAC_NONE;
+}
+
+/**************************************************************************************
+ * Function:    AACResetStageStats
+ *
+ * Description: clear the per-stage timing of AACDecode
+ *
+ * Inputs:      valid AAC decoder instance pointer (HAACDecoder)
+ *
+ * Outputs:     none
+ *
+ * Return:      none
+ **************************************************************************************/
+void AACResetStageStats(HAACDecoder hAACDecoder)
+{
+	AACDecInfo *aacDecInfo = (AACDecInfo *)hAACDecoder;
+
+	if (!aacDecInfo)
+		return;
+
+	memset(&aacDecInfo->stageStats, 0, sizeof(AACStageStats));
+}
+#endif
+
+#ifdef AAC_FRAME_STATS
+/**************************************************************************************
+ * Function:    AACGetFrameStats
+ *
+ * Description: get window sequences, TNS/PNS use and SBR envelopes of the last frame
+ *
+ * Inputs:      valid AAC decoder instance pointer (HAACDecoder)
+ *              pointer to AACFrameStats struct
+ *
+ * Outputs:     filled-in AACFrameStats struct
+ *
+ * Return:      0 if successful, error code (< 0) if error
+ *
+ * Notes:       only complete if the last call to AACDecode returned ERR_AAC_NONE
+ **************************************************************************************/
+int AACGetFrameStats(HAACDecoder hAACDecoder, AACFrameStats *stats)
+{
+	AACDecInfo *aacDecInfo = (AACDecInfo *)hAACDecoder;
+
+	if (!aacDecInfo || !stats)
+		return ERR_AAC_NULL_POINTER;
+
+	memcpy(stats, &aacDecInfo->frameStats, sizeof(AACFrameStats));
+
+	return ERR_AAC_NONE;
+}
+#endif
+
+/**************************************************************************************
+ * Function:    AACDecodeFrame
  *
  * Description: decode AAC frame
  *
@@ -271,7 +563,7 @@ int AACFlushCodec(HAACDecoder hAACDecoder)
  *                successfully decoded, so if ERR_AAC_INDATA_UNDERFLOW is returned
  *                just call AACDecode again with more data in inbuf
  **************************************************************************************/
-int AACDecode(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, short *outbuf)
+static int AACDecodeFrame(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, short *outbuf)
 {
 	int err, offset, bitOffset, bitsAvail;
 	int ch, baseChan, elementChans;
@@ -280,9 +572,16 @@ int AACDecode(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, sh
 #ifdef AAC_ENABLE_SBR
 	int baseChanSBR, elementChansSBR;
 #endif
+#ifdef AAC_STAGE_STATS
+	unsigned int stageTime;
+#endif
 
 	if (!aacDecInfo)
 		return ERR_AAC_NULL_POINTER;
+#ifdef AAC_FRAME_STATS
+	/* filled in by IMDCT() and DecodeSBRData(), only for the elements of this frame */
+	memset(&aacDecInfo->frameStats, 0, sizeof(AACFrameStats));
+#endif
 
 	/* make local copies (see "Notes" above) */
 	inptr = *inbuf;
@@ -366,34 +665,33 @@ int AACDecode(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, sh
 
 		/* noiseless decoder and dequantizer */
 		for (ch = 0; ch < elementChans; ch++) {
-      PROFILE_START("noiseless decoder");
+			STAGE_START();
 			err = DecodeNoiselessData(aacDecInfo, &inptr, &bitOffset, &bitsAvail, ch);
-      PROFILE_END();
-      			
 			if (err)
 				return err;
+			STAGE_END(AAC_STAGE_NOISELESS);
 
-			PROFILE_START("dequant");
+			STAGE_START();
 			if (Dequantize(aacDecInfo, ch))
 				return ERR_AAC_DEQUANT;
-      PROFILE_END();
+			STAGE_END(AAC_STAGE_DEQUANT);
 		}
 
-    PROFILE_START("mid-side and intensity stereo");
 		/* mid-side and intensity stereo */
 		if (aacDecInfo->currBlockID == AAC_ID_CPE) {
+			STAGE_START();
 			if (StereoProcess(aacDecInfo))
 				return ERR_AAC_STEREO_PROCESS;
+			STAGE_END(AAC_STAGE_STEREO);
 		}
-    PROFILE_END();
 
 
 		/* PNS, TNS, inverse transform */
 		for (ch = 0; ch < elementChans; ch++) {
-      PROFILE_START("PNS");
+			STAGE_START();
 			if (PNS(aacDecInfo, ch))
 				return ERR_AAC_PNS;
-      PROFILE_END();
+			STAGE_END(AAC_STAGE_PNS);
 
 			if (aacDecInfo->sbDeinterleaveReqd[ch]) {
 				/* deinterleave short blocks, if required */
@@ -402,19 +700,19 @@ int AACDecode(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, sh
 				aacDecInfo->sbDeinterleaveReqd[ch] = 0;
 			}
 
-      PROFILE_START("TNS");
+			STAGE_START();
 			if (TNSFilter(aacDecInfo, ch))
 				return ERR_AAC_TNS;
-      PROFILE_END();
+			STAGE_END(AAC_STAGE_TNS);
 	
-      PROFILE_START("IMDCT");
+			STAGE_START();
 			if (IMDCT(aacDecInfo, ch, baseChan + ch, outbuf))
 				return ERR_AAC_IMDCT;
-      PROFILE_END();
+			STAGE_END(AAC_STAGE_IMDCT);
 		}
 
 #ifdef AAC_ENABLE_SBR
-		if (aacDecInfo->sbrEnabled && (aacDecInfo->currBlockID == AAC_ID_FIL || aacDecInfo->currBlockID == AAC_ID_LFE)) {
+		if (aacDecInfo->sbrEnabled && !aacDecInfo->sbrCoreOnly && (aacDecInfo->currBlockID == AAC_ID_FIL || aacDecInfo->currBlockID == AAC_ID_LFE)) {
 			if (aacDecInfo->currBlockID == AAC_ID_LFE)
 				elementChansSBR = elementNumChans[AAC_ID_LFE];
 			else if (aacDecInfo->currBlockID == AAC_ID_FIL && (aacDecInfo->prevBlockID == AAC_ID_SCE || aacDecInfo->prevBlockID == AAC_ID_CPE))
@@ -426,8 +724,10 @@ int AACDecode(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, sh
 				return ERR_AAC_SBR_NCHANS_TOO_HIGH;
 
 			/* parse SBR extension data if present (contained in a fill element) */
+			STAGE_START();
 			if (DecodeSBRBitstream(aacDecInfo, baseChanSBR))
 				return ERR_AAC_SBR_BITSTREAM;
+			STAGE_END(AAC_STAGE_SBR_BITSTREAM);
 
 			/* apply SBR */
 			if (DecodeSBRData(aacDecInfo, baseChanSBR, outbuf))
@@ -440,6 +740,16 @@ int AACDecode(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, sh
 		baseChan += elementChans;
 	} while (aacDecInfo->currBlockID != AAC_ID_END);
 
+#ifdef AAC_ENABLE_UPSAMPLE
+	/* HE-AAC without SBR: upsample the core output to the SBR output rate */
+	if (aacDecInfo->sbrEnabled && aacDecInfo->sbrCoreOnly) {
+		STAGE_START();
+		if (UpsampleCore(aacDecInfo, outbuf))
+			return ERR_AAC_UPSAMPLE;
+		STAGE_END(AAC_STAGE_UPSAMPLE);
+	}
+#endif
+
 	/* byte align after each raw_data_block */
 	if (bitOffset) {
 		inptr++;
@@ -451,9 +761,38 @@ int AACDecode(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, sh
 
 	/* update pointers */
 	aacDecInfo->frameCount++;
+#ifdef AAC_STAGE_STATS
+	aacDecInfo->stageStats.frames++;
+#endif
 	*bytesLeft -= (inptr - *inbuf);
 	*inbuf = inptr;
 
 	return ERR_AAC_NONE;
 }
 
+
+/**************************************************************************************
+ * Function:    AACDecode
+ *
+ * Description: decode AAC frame, see AACDecodeFrame
+ *
+ * Notes:       with AAC_STACK_STATS the free stack is painted before and checked
+ *                after the frame, the deepest use is kept for AACGetMemInfo()
+ **************************************************************************************/
+int AACDecode(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, short *outbuf)
+{
+#ifdef AAC_STACK_STATS
+	AACDecInfo *aacDecInfo = (AACDecInfo *)hAACDecoder;
+	int err, depth;
+
+	StackPaint();
+	err = AACDecodeFrame(hAACDecoder, inbuf, bytesLeft, outbuf);
+	depth = StackDepth();
+	if (aacDecInfo && depth > aacDecInfo->stackPeak)
+		aacDecInfo->stackPeak = depth;
+
+	return err;
+#else
+	return AACDecodeFrame(hAACDecoder, inbuf, bytesLeft, outbuf);
+#endif
+}
@@ -96,11 +96,53 @@ extern "C" {
 #define AAC_PROFILE_SSR		2
 
 /* define these to enable decoder features */
+/* SBR (HE-AAC) adds 50788 bytes of decoder heap (PSInfoSBR, 79660 in total with the 28752 of LC) and
+ *   doubles the PCM buffers of the player, more than the 64 KB of the Teensy 3.1/3.2 has, so it's
+ *   host-only: on the Teensy HE-AAC streams are decoded core-only (AAC_ENABLE_UPSAMPLE below)
+ */
+#if defined(__MK20DX256__)
 #if defined(HELIX_FEATURE_AUDIO_CODEC_AAC_SBR)
+#error "SBR doesn't fit in the RAM of the Teensy 3.1/3.2, HE-AAC is decoded core-only and upsampled there"
+#endif
+#else
 #define AAC_ENABLE_SBR
-#endif //  HELIX_FEATURE_AUDIO_CODEC_AAC_SBR.
+#endif
+/* HE-AAC streams decoded without SBR (AACSetSBRCoreOnly(), or a build without AAC_ENABLE_SBR) get their
+ *   core output upsampled by 2 instead (upsample.c), so they still play at the SBR output rate. This takes
+ *   the same double-size PCM buffers as SBR but none of its heap. A build without SBR can leave it out
+ *   with -DHELIX_FEATURE_AUDIO_CODEC_AAC_NO_UPSAMPLE, the player rejects HE-AAC streams then (the core
+ *   rate isn't the output rate)
+ */
+#if defined(AAC_ENABLE_SBR) || !defined(HELIX_FEATURE_AUDIO_CODEC_AAC_NO_UPSAMPLE)
+#define AAC_ENABLE_UPSAMPLE
+#endif
 #define AAC_ENABLE_MPEG4
 
+/* per-stage timing of AACDecode, read back with AACGetStageStats()
+ * costs two reads of the cycle counter per stage, so keep it off for normal use
+ */
+//#define AAC_STAGE_STATS
+
+/* peak stack depth of AACDecode, read back with AACGetMemInfo()
+ * paints the free stack before every frame (see common/stackpaint.h), keep it off for normal use
+ */
+//#define AAC_STACK_STATS
+
+/* window sequences, TNS/PNS use and SBR envelopes of the last frame, read back with AACGetFrameStats()
+ * a few stores per channel, for finding out what makes a frame expensive
+ */
+//#define AAC_FRAME_STATS
+
+/* use the C QMF convolutions of SBR (QMFAnalysisConv/QMFSynthesisConv in aac/sbrqmf.c) on ARM as well,
+ * instead of asmqmf_thumb2.S
+ */
+//#define AAC_QMF_C
+
+/* use the C DCT4 kernels (PreMultiply/PostMultiply in aac/dct4.c, the R4FFT passes in aac/fft.c) on ARM as well,
+ * instead of asmfft_thumb2.S
+ */
+//#define AAC_FFT_C
+
 enum {
 	ERR_AAC_NONE                          =   0,
 	ERR_AAC_INDATA_UNDERFLOW              =  -1,
@@ -128,6 +170,7 @@ enum {
 	ERR_AAC_SBR_SINGLERATE_UNSUPPORTED    = -21,
 
 	ERR_AAC_RAWBLOCK_PARAMS               = -22,
+	ERR_AAC_UPSAMPLE                      = -23,
 
 	ERR_AAC_UNKNOWN						= -9999
 };
@@ -146,15 +189,89 @@ typedef struct _AACFrameInfo {
 
 typedef void *HAACDecoder;
 
+#ifdef AAC_STAGE_STATS
+#include <stdint.h>
+
+enum {
+	AAC_STAGE_NOISELESS =	0,	/* DecodeNoiselessData, per channel */
+	AAC_STAGE_DEQUANT,			/* Dequantize, per channel */
+	AAC_STAGE_STEREO,			/* StereoProcess (M/S, intensity), CPE only */
+	AAC_STAGE_PNS,				/* PNS, per channel */
+	AAC_STAGE_TNS,				/* TNSFilter, per channel */
+	AAC_STAGE_IMDCT,			/* IMDCT, per channel */
+	AAC_STAGE_SBR_BITSTREAM,	/* DecodeSBRBitstream */
+	AAC_STAGE_QMF_ANALYSIS,		/* QMFAnalysis, 32 slots per channel */
+	AAC_STAGE_HF_GEN,			/* GenerateHighFreq, per channel */
+	AAC_STAGE_HF_ADJ,			/* AdjustHighFreq, per channel */
+	AAC_STAGE_QMF_SYNTHESIS,	/* QMFSynthesis, 32 slots per channel */
+	AAC_STAGE_UPSAMPLE,			/* UpsampleCore, whole frame (SBR core-only), booked to the last element */
+
+	AAC_NSTAGES
+};
+
+/* channel element the time is booked to (SBR goes to the element it extends) */
+enum {
+	AAC_STATS_SCE =	0,
+	AAC_STATS_CPE,
+	AAC_STATS_LFE,
+
+	AAC_STATS_NELEMS
+};
+
+/* times are CPU cycles on ARM, nanoseconds on the host (see CYCLES() in assembly.h) */
+typedef struct _AACStageStats {
+	uint64_t time[AAC_STATS_NELEMS][AAC_NSTAGES];		/* total */
+	uint32_t maxTime[AAC_STATS_NELEMS][AAC_NSTAGES];	/* longest single call */
+	uint32_t calls[AAC_STATS_NELEMS][AAC_NSTAGES];
+	uint32_t frames;									/* frames decoded without error */
+} AACStageStats;
+#endif
+
+#ifdef AAC_FRAME_STATS
+/* what the last frame asked of the decoder, per output channel */
+typedef struct _AACFrameStats {
+	int nChans;								/* channels decoded */
+	int winSequence[AAC_MAX_NCHANS];		/* 0 = long, 1 = long start, 2 = eight short, 3 = long stop */
+	int maxSFB[AAC_MAX_NCHANS];				/* scale factor bands transmitted (per window for short blocks) */
+	int tns[AAC_MAX_NCHANS];				/* TNS data present */
+	int pns[AAC_MAX_NCHANS];				/* PNS used in at least one band */
+	int sbrEnvelopes[AAC_MAX_NCHANS];		/* SBR envelopes, 0 without SBR data (upsampling only) */
+	int sbrNoiseFloors[AAC_MAX_NCHANS];
+	int sbrBands[AAC_MAX_NCHANS];			/* QMF bands regenerated by SBR */
+} AACFrameStats;
+#endif
+
+/* heap used by one decoder instance, in bytes as requested from malloc() */
+typedef struct _AACMemInfo {
+	int decInfo;			/* AACDecInfo */
+	int psInfoBase;			/* PSInfoBase, baseline LC decoding */
+	int psInfoSBR;			/* PSInfoSBR, 0 without AAC_ENABLE_SBR */
+	int total;
+	int stackPeak;			/* deepest stack use of AACDecode so far, 0 without AAC_STACK_STATS */
+} AACMemInfo;
+
 /* public C API */
 HAACDecoder AACInitDecoder(void);
 void AACFreeDecoder(HAACDecoder hAACDecoder);
 int AACDecode(HAACDecoder hAACDecoder, unsigned char **inbuf, int *bytesLeft, short *outbuf);
 
 int AACFindSyncWord(unsigned char *buf, int nBytes);
+int AACParseESDS(unsigned char *buf, int nBytes, int *nChans, int *sampRate);
 void AACGetLastFrameInfo(HAACDecoder hAACDecoder, AACFrameInfo *aacFrameInfo);
 int AACSetRawBlockParams(HAACDecoder hAACDecoder, int copyLast, AACFrameInfo *aacFrameInfo);
 int AACFlushCodec(HAACDecoder hAACDecoder);
+int AACSetSBRLowPower(HAACDecoder hAACDecoder, int lowPower);
+int AACSetSBRCoreOnly(HAACDecoder hAACDecoder, int coreOnly);
+void AACGetMemInfo(HAACDecoder hAACDecoder, AACMemInfo *memInfo);
+
+#ifdef AAC_STAGE_STATS
+int AACGetStageStats(HAACDecoder hAACDecoder, AACStageStats *stats);
+void AACResetStageStats(HAACDecoder hAACDecoder);
+#endif
+
+#ifdef AAC_FRAME_STATS
+int AACGetFrameStats(HAACDecoder hAACDecoder, AACFrameStats *stats);
+#endif
 
 #ifdef HELIX_CONFIG_AAC_GENERATE_TRIGTABS_FLOAT
 int AACInitTrigtabsFloat(void);
@@ -107,12 +107,13 @@ static __inline void RefillBitstreamCache(BitStreamInfo *bsi)
 	} else if (nBytes == 2) { //FB	
 		unsigned short *Ptr16;
 		Ptr16 =(unsigned short*)bsi->bytePtr;
-		bsi->iCache = REV16(*Ptr16);
+		bsi->iCache = REV16(*Ptr16) << 16;	/* left-justify, GetBits() takes bits from the top */
 		bsi->bytePtr +=2;	
 		bsi->cachedBits = 16;
 		bsi->nBytes -= 2;
 			
-	} /*else { //FB
+	} else {
+		/* last 1 or 3 bytes, all of them go into the cache */
 		bsi->iCache = 0;
 		while (nBytes--) {
 			bsi->iCache |= (*bsi->bytePtr++);
@@ -121,11 +122,6 @@ static __inline void RefillBitstreamCache(BitStreamInfo *bsi)
 		bsi->iCache <<= ((3 - bsi->nBytes)*8);
 		bsi->cachedBits = 8*bsi->nBytes;
 		bsi->nBytes = 0;
-	} */
-	else { //FB		
-		bsi->iCache = (*bsi->bytePtr++) << 24;		
-		bsi->cachedBits = 8;
-		bsi->nBytes = 0;
 	}
 }
 
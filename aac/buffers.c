@@ -135,3 +135,42 @@ void FreeBuffers(AACDecInfo *aacDecInfo)
 	SAFE_FREE(aacDecInfo->psInfoBase);
 	SAFE_FREE(aacDecInfo);
 }
+
+/**************************************************************************************
+ * Function:    AACGetMemInfo
+ *
+ * Description: report the heap used by a decoder instance, per buffer
+ *
+ * Inputs:      AAC decoder instance pointer (HAACDecoder), may be 0 (sizes only)
+ *              pointer to AACMemInfo struct
+ *
+ * Outputs:     filled-in AACMemInfo struct
+ *
+ * Return:      none
+ *
+ * Notes:       sizes as passed to malloc(), without the allocator's overhead
+ **************************************************************************************/
+void AACGetMemInfo(HAACDecoder hAACDecoder, AACMemInfo *memInfo)
+{
+	AACDecInfo *aacDecInfo = (AACDecInfo *)hAACDecoder;
+
+	if (!memInfo)
+		return;
+
+	memInfo->decInfo =    sizeof(AACDecInfo);
+	memInfo->psInfoBase = sizeof(PSInfoBase);
+#ifdef AAC_ENABLE_SBR
+	memInfo->psInfoSBR =  GetSBRMemSize();
+#else
+	memInfo->psInfoSBR =  0;
+#endif
+	memInfo->total = memInfo->decInfo + memInfo->psInfoBase + memInfo->psInfoSBR;
+
+	memInfo->stackPeak = 0;
+#ifdef AAC_STACK_STATS
+	if (aacDecInfo)
+		memInfo->stackPeak = aacDecInfo->stackPeak;
+#else
+	(void)aacDecInfo;
+#endif
+}
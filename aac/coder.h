@@ -86,7 +86,6 @@
 #define CHAN_ELEM_SET_CPE(x)    (((x) & 0x01) << 4)  /* bit 4 = SCE/CPE flag */
 #define CHAN_ELEM_SET_TAG(x)    (((x) & 0x0f) << 0)  /* bits 3-0 = instance tag */
 
-#define MAX_HUFF_BITS                   20
 #define HUFFTAB_SPEC_OFFSET             1
 
 /* do y <<= n, clipping to range [-2^30, 2^30 - 1] (i.e. output has one guard bit) */
@@ -123,14 +122,19 @@
 
 #define NUM_IMDCT_SIZES         2
 
+#define NUM_UPSAMPLE_TAPS       8                                       /* coefficient pairs of the 2x interpolator (upsample.c) */
+#define UPSAMPLE_HIST_LEN       (2*NUM_UPSAMPLE_TAPS - 1)       /* input samples of the previous frame it needs */
+
 /* additional external symbols to name-mangle for static linking */
 #define DecodeProgramConfigElement              STATNAME(DecodeProgramConfigElement)
-#define DecodeHuffmanScalar                             STATNAME(DecodeHuffmanScalar)
 #define DecodeSpectrumLong                              STATNAME(DecodeSpectrumLong)
 #define DecodeSpectrumShort                             STATNAME(DecodeSpectrumShort)
 #define DecodeICSInfo                                   STATNAME(DecodeICSInfo)
 #define DCT4                                                    STATNAME(DCT4)
 #define R4FFT                                                   STATNAME(R4FFT)
+#define PreMultiplyBitRevThumb2                 STATNAME(PreMultiplyBitRevThumb2)
+#define R4FFTPassesThumb2                               STATNAME(R4FFTPassesThumb2)
+#define PostMultiplyThumb2                              STATNAME(PostMultiplyThumb2)
 
 #define DecWindowOverlapNoClip                  STATNAME(DecWindowOverlapNoClip)
 #define DecWindowOverlapLongStartNoClip STATNAME(DecWindowOverlapLongStartNoClip)
@@ -154,12 +158,6 @@
 #define twidTabEven                                     STATNAME(twidTabEven)
 #define twidTabOdd                                      STATNAME(twidTabOdd)
 
-typedef struct _HuffInfo {
-    int maxBits;                                                    /* number of bits in longest codeword */
-    unsigned char count[MAX_HUFF_BITS];         /* count[i] = number of codes with length i+1 bits */
-    int offset;                                                             /* offset into symbol table */
-} HuffInfo;
-
 typedef struct _PulseInfo {
     unsigned char pulseDataPresent;
     unsigned char numPulse;
@@ -310,6 +308,9 @@ typedef struct _PSInfoBase {
     /* state information which must be saved for each element and used in next frame */
     int                   overlap[AAC_MAX_NCHANS][AAC_MAX_NSAMPS];
     int                   prevWinShape[AAC_MAX_NCHANS];
+#ifdef AAC_ENABLE_UPSAMPLE
+    short                 upsampleHist[AAC_MAX_NCHANS][UPSAMPLE_HIST_LEN];
+#endif
 
 } PSInfoBase;
 
@@ -319,7 +320,6 @@ typedef struct _PSInfoBase {
 int DecodeProgramConfigElement(ProgConfigElement *pce, BitStreamInfo *bsi);
 
 /* huffman.c */
-int DecodeHuffmanScalar(const signed short *huffTab, const HuffInfo *huffTabInfo, unsigned int bitBuf, signed int *val);
 void DecodeSpectrumLong(PSInfoBase *psi, BitStreamInfo *bsi, int ch);
 void DecodeSpectrumShort(PSInfoBase *psi, BitStreamInfo *bsi, int ch);
 
@@ -332,6 +332,20 @@ void DCT4(int tabidx, int *coef, int gb);
 /* fft.c */
 void R4FFT(int tabidx, int *x);
 
+/* asmfft_thumb2.S, DCT4 kernels in assembly on ARM, unless AAC_FFT_C is defined in aacdec.h */
+#if defined(__arm__) && !defined(AAC_FFT_C)
+#define AAC_FFT_THUMB2
+#endif
+#ifdef __cplusplus
+extern "C" {
+#endif
+void PreMultiplyBitRevThumb2(int tabidx, int *zbuf1, const int *csptr);
+void R4FFTPassesThumb2(int tabidx, int *x, const int *wtab);
+void PostMultiplyThumb2(int tabidx, int *fft1, const int *csptr);
+#ifdef __cplusplus
+}
+#endif
+
 /* sbrimdct.c */
 void DecWindowOverlapNoClip(int *buf0, int *over0, int *out0, int winTypeCurr, int winTypePrev);
 void DecWindowOverlapLongStartNoClip(int *buf0, int *over0, int *out0, int winTypeCurr, int winTypePrev);
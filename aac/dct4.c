@@ -49,6 +49,9 @@
 static const int nmdctTab[NUM_IMDCT_SIZES] = {128, 1024};
 static const int postSkip[NUM_IMDCT_SIZES] = {15, 1};
 
+/* PreMultiply (bit-reversing its output) and PostMultiply are in asmfft_thumb2.S on ARM */
+#ifndef AAC_FFT_THUMB2
+
 /**************************************************************************************
  * Function:    PreMultiply
  *
@@ -171,6 +174,7 @@ static void PostMultiply(int tabidx, int *fft1)
 		*fft1++ = t + MULSHIFT32(cms2, ar2);	/* cos*ar1 + sin*ai1 */
 	}
 }
+#endif	/* AAC_FFT_THUMB2 */
 
 /**************************************************************************************
  * Function:    PreMultiplyRescale
@@ -330,8 +334,15 @@ void DCT4(int tabidx, int *coef, int gb)
 		R4FFT(tabidx, coef);
 		PostMultiplyRescale(tabidx, coef, es);
 	} else {
+#ifdef AAC_FFT_THUMB2
+		/* the pre-twiddle stores its output bit-reversed, so the FFT skips BitReverse() */
+		PreMultiplyBitRevThumb2(tabidx, coef, cos4sin4tab + cos4sin4tabOffset[tabidx]);
+		R4FFTPassesThumb2(tabidx, coef, tabidx ? twidTabOdd : twidTabEven);
+		PostMultiplyThumb2(tabidx, coef, cos1sin1tab);
+#else
 		PreMultiply(tabidx, coef);
 		R4FFT(tabidx, coef);
 		PostMultiply(tabidx, coef);
+#endif
 	}
 }
@@ -322,11 +322,12 @@ static int DecodeFillElement(AACDecInfo *aacDecInfo, BitStreamInfo *bsi)
 	aacDecInfo->currInstTag = -1;	/* fill elements don't have instance tag */
 	aacDecInfo->fillExtType = 0;
 
-#ifdef AAC_ENABLE_SBR
+#ifdef AAC_ENABLE_UPSAMPLE
 	/* check for SBR 
 	 * aacDecInfo->sbrEnabled is sticky (reset each raw_data_block), so for multichannel 
 	 *    need to verify that all SCE/CPE/ICCE have valid SBR fill element following, and 
 	 *    must upsample by 2 for LFE
+	 * also checked without AAC_ENABLE_SBR, the core is upsampled by 2 then
 	 */
 	if (psi->fillCount > 0) {
 		aacDecInfo->fillExtType = (int)((psi->fillBuf[0] >> 4) & 0x0f);
@@ -93,6 +93,9 @@ static const int nfftlog2Tab[NUM_FFT_SIZES] =	{6, 9};
 	
 }
 
+/* the passes below are in asmfft_thumb2.S on ARM */
+#ifndef AAC_FFT_THUMB2
+
 /**************************************************************************************
  * Function:    R4FirstPass
  *
@@ -355,6 +358,7 @@ static const int nfftlog2Tab[NUM_FFT_SIZES] =	{6, 9};
 	}
 }
 
+#endif	/* AAC_FFT_THUMB2 */
 
 /**************************************************************************************
  * Function:    R4FFT
@@ -375,6 +379,11 @@ static const int nfftlog2Tab[NUM_FFT_SIZES] =	{6, 9};
  **************************************************************************************/
 void R4FFT(int tabidx, int *x)
 {
+#ifdef AAC_FFT_THUMB2
+	/* decimation in time, R8FirstPass/R4FirstPass and R4Core in assembly */
+	BitReverse(x, tabidx);
+	R4FFTPassesThumb2(tabidx, x, (nfftlog2Tab[tabidx] & 0x1) ? twidTabOdd : twidTabEven);
+#else
 	int order = nfftlog2Tab[tabidx];
 	int nfft = nfftTab[tabidx];
 
@@ -390,4 +399,5 @@ void R4FFT(int tabidx, int *x)
 		R4FirstPass(x, nfft >> 2);						/* gain 0 int bits, lose 2 GB */
 		R4Core(x, nfft >> 4, 4, (int *)twidTabEven);	/* gain 4 int bits, lose 1 GB */
 	}
+#endif
 }
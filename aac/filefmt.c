@@ -490,6 +490,9 @@ int FlushCodec(AACDecInfo *aacDecInfo)
 	
 	ClearBuffer(psi->overlap, AAC_MAX_NCHANS * AAC_MAX_NSAMPS * sizeof(int));
 	ClearBuffer(psi->prevWinShape, AAC_MAX_NCHANS * sizeof(int));
+#ifdef AAC_ENABLE_UPSAMPLE
+	ClearBuffer(psi->upsampleHist, AAC_MAX_NCHANS * UPSAMPLE_HIST_LEN * sizeof(short));
+#endif
 
 	return ERR_AAC_NONE;
 }
@@ -534,6 +534,16 @@ int IMDCT(AACDecInfo *aacDecInfo, int ch, int chOut, short *outbuf)
 	icsInfo = (ch == 1 && psi->commonWin == 1) ? &(psi->icsInfo[0]) : &(psi->icsInfo[ch]);
 	outbuf += chOut;
 
+#ifdef AAC_FRAME_STATS
+	if (chOut < AAC_MAX_NCHANS) {
+		aacDecInfo->frameStats.nChans = MAX(aacDecInfo->frameStats.nChans, chOut + 1);
+		aacDecInfo->frameStats.winSequence[chOut] = icsInfo->winSequence;
+		aacDecInfo->frameStats.maxSFB[chOut] = icsInfo->maxSFB;
+		aacDecInfo->frameStats.tns[chOut] = psi->tnsInfo[ch].tnsDataPresent;
+		aacDecInfo->frameStats.pns[chOut] = psi->pnsUsed[ch];
+	}
+#endif
+
 	/* optimized type-IV DCT (operates inplace) */
 	if (icsInfo->winSequence == 2) {
 		/* 8 short blocks */
@@ -557,7 +567,7 @@ int IMDCT(AACDecInfo *aacDecInfo, int ch, int chOut, short *outbuf)
 	else if (icsInfo->winSequence == 3)
 		DecWindowOverlapLongStopNoClip(psi->coef[ch], psi->overlap[chOut], psi->sbrWorkBuf[ch], icsInfo->winShape, psi->prevWinShape[chOut]);
 
-	if (!aacDecInfo->sbrEnabled) {
+	if (!aacDecInfo->sbrEnabled || aacDecInfo->sbrCoreOnly) {
 		for (i = 0; i < AAC_MAX_NSAMPS; i++) {
 			*outbuf = CLIPTOSHORT((psi->sbrWorkBuf[ch][i] + RND_VAL) >> FBITS_OUT_IMDCT);
 			outbuf += aacDecInfo->nChans;
@@ -134,6 +134,22 @@ void FreeSBR(AACDecInfo *aacDecInfo)
 	return;
 }
 
+/**************************************************************************************
+ * Function:    GetSBRMemSize
+ *
+ * Description: size of the SBR state allocated by InitSBR (for AACGetMemInfo)
+ *
+ * Inputs:      none
+ *
+ * Outputs:     none
+ *
+ * Return:      sizeof(PSInfoSBR)
+ **************************************************************************************/
+int GetSBRMemSize(void)
+{
+	return sizeof(PSInfoSBR);
+}
+
 /**************************************************************************************
  * Function:    DecodeSBRBitstream
  *
@@ -239,6 +255,9 @@ int DecodeSBRData(AACDecInfo *aacDecInfo, int chBase, short *outbuf)
 	SBRGrid *sbrGrid;
 	SBRFreq *sbrFreq;
 	SBRChan *sbrChan;
+#ifdef AAC_STAGE_STATS
+	unsigned int stageTime;
+#endif
 
 	/* validate pointers */
 	if (!aacDecInfo || !aacDecInfo->psInfoSBR)
@@ -291,24 +310,43 @@ int DecodeSBRData(AACDecInfo *aacDecInfo, int chBase, short *outbuf)
 			}
 		}
 
+#ifdef AAC_FRAME_STATS
+		if (!upsampleOnly) {
+			aacDecInfo->frameStats.sbrEnvelopes[chBase + ch] = sbrGrid->numEnv;
+			aacDecInfo->frameStats.sbrNoiseFloors[chBase + ch] = sbrGrid->numNoiseFloors;
+			aacDecInfo->frameStats.sbrBands[chBase + ch] = sbrFreq->numQMFBands;
+		}
+#endif
+
 		/* step 1 - analysis QMF */
+		STAGE_START();
 		qmfaBands = sbrFreq->kStart;
 		for (l = 0; l < 32; l++) {
-			gbMask = QMFAnalysis(inbuf + l*32, psi->delayQMFA[chBase + ch], psi->XBuf[l + HF_GEN][0], 
-				aacDecInfo->rawSampleFBits, &(psi->delayIdxQMFA[chBase + ch]), qmfaBands);
+			if (psi->lowPower)
+				gbMask = QMFAnalysisLP(inbuf + l*32, psi->delayQMFA[chBase + ch], psi->XBuf[l + HF_GEN][0], 
+					aacDecInfo->rawSampleFBits, &(psi->delayIdxQMFA[chBase + ch]), qmfaBands);
+			else
+				gbMask = QMFAnalysis(inbuf + l*32, psi->delayQMFA[chBase + ch], psi->XBuf[l + HF_GEN][0], 
+					aacDecInfo->rawSampleFBits, &(psi->delayIdxQMFA[chBase + ch]), qmfaBands);
 
 			gbIdx = ((l + HF_GEN) >> 5) & 0x01;	
 			sbrChan->gbMask[gbIdx] |= gbMask;	/* gbIdx = (0 if i < 32), (1 if i >= 32) */
 		}
+		STAGE_END(AAC_STAGE_QMF_ANALYSIS);
 
 		if (upsampleOnly) {
 			/* no SBR - just run synthesis QMF to upsample by 2x */
+			STAGE_START();
 			qmfsBands = 32;
 			for (l = 0; l < 32; l++) {
 				/* step 4 - synthesis QMF */
-				QMFSynthesis(psi->XBuf[l + HF_ADJ][0], psi->delayQMFS[chBase + ch], &(psi->delayIdxQMFS[chBase + ch]), qmfsBands, outptr, aacDecInfo->nChans);
+				if (psi->lowPower)
+					QMFSynthesisLP(psi->XBuf[l + HF_ADJ][0], psi->delayQMFS[chBase + ch], &(psi->delayIdxQMFS[chBase + ch]), qmfsBands, outptr, aacDecInfo->nChans);
+				else
+					QMFSynthesis(psi->XBuf[l + HF_ADJ][0], psi->delayQMFS[chBase + ch], &(psi->delayIdxQMFS[chBase + ch]), qmfsBands, outptr, aacDecInfo->nChans);
 				outptr += 64*aacDecInfo->nChans;
 			}
+			STAGE_END(AAC_STAGE_QMF_SYNTHESIS);
 		} else {
 			/* if previous frame had lower SBR starting freq than current, zero out the synthesized QMF
 			 *   bands so they aren't used as sources for patching
@@ -323,7 +361,9 @@ int DecodeSBRData(AACDecInfo *aacDecInfo, int chBase, short *outbuf)
 			}
 
 			/* step 2 - HF generation */
+			STAGE_START();
 			GenerateHighFreq(psi, sbrGrid, sbrFreq, sbrChan, ch);
+			STAGE_END(AAC_STAGE_HF_GEN);
 
 			/* restore SBR bands that were cleared before patch generation (time slots 0, 1 no longer needed) */
 			for (k = sbrFreq->kStartPrev; k < sbrFreq->kStart; k++) {
@@ -334,22 +374,32 @@ int DecodeSBRData(AACDecInfo *aacDecInfo, int chBase, short *outbuf)
 			}
 
 			/* step 3 - HF adjustment */
+			STAGE_START();
 			AdjustHighFreq(psi, sbrHdr, sbrGrid, sbrFreq, sbrChan, ch);
+			STAGE_END(AAC_STAGE_HF_ADJ);
 
 			/* step 4 - synthesis QMF */
+			STAGE_START();
 			qmfsBands = sbrFreq->kStartPrev + sbrFreq->numQMFBandsPrev;
 			for (l = 0; l < sbrGrid->envTimeBorder[0]; l++) {
 				/* if new envelope starts mid-frame, use old settings until start of first envelope in this frame */
-				QMFSynthesis(psi->XBuf[l + HF_ADJ][0], psi->delayQMFS[chBase + ch], &(psi->delayIdxQMFS[chBase + ch]), qmfsBands, outptr, aacDecInfo->nChans);
+				if (psi->lowPower)
+					QMFSynthesisLP(psi->XBuf[l + HF_ADJ][0], psi->delayQMFS[chBase + ch], &(psi->delayIdxQMFS[chBase + ch]), qmfsBands, outptr, aacDecInfo->nChans);
+				else
+					QMFSynthesis(psi->XBuf[l + HF_ADJ][0], psi->delayQMFS[chBase + ch], &(psi->delayIdxQMFS[chBase + ch]), qmfsBands, outptr, aacDecInfo->nChans);
 				outptr += 64*aacDecInfo->nChans;
 			}
 
 			qmfsBands = sbrFreq->kStart + sbrFreq->numQMFBands;
 			for (     ; l < 32; l++) {
 				/* use new settings for rest of frame (usually the entire frame, unless the first envelope starts mid-frame) */
-				QMFSynthesis(psi->XBuf[l + HF_ADJ][0], psi->delayQMFS[chBase + ch], &(psi->delayIdxQMFS[chBase + ch]), qmfsBands, outptr, aacDecInfo->nChans);
+				if (psi->lowPower)
+					QMFSynthesisLP(psi->XBuf[l + HF_ADJ][0], psi->delayQMFS[chBase + ch], &(psi->delayIdxQMFS[chBase + ch]), qmfsBands, outptr, aacDecInfo->nChans);
+				else
+					QMFSynthesis(psi->XBuf[l + HF_ADJ][0], psi->delayQMFS[chBase + ch], &(psi->delayIdxQMFS[chBase + ch]), qmfsBands, outptr, aacDecInfo->nChans);
 				outptr += 64*aacDecInfo->nChans;
 			}
+			STAGE_END(AAC_STAGE_QMF_SYNTHESIS);
 		}
 
 		/* save delay */
@@ -394,13 +444,50 @@ int DecodeSBRData(AACDecInfo *aacDecInfo, int chBase, short *outbuf)
 int FlushCodecSBR(AACDecInfo *aacDecInfo)
 {
 	PSInfoSBR *psi;
+	int lowPower;
 
 	/* validate pointers */
 	if (!aacDecInfo || !aacDecInfo->psInfoSBR)
 		return ERR_AAC_NULL_POINTER;
 	psi = (PSInfoSBR *)(aacDecInfo->psInfoSBR);
 
+	/* the mode is a user setting, not stream state */
+	lowPower = psi->lowPower;
 	InitSBRState(psi);
+	psi->lowPower = lowPower;
+
+	return 0;
+}
+
+/**************************************************************************************
+ * Function:    SetSBRLowPower
+ *
+ * Description: select low-power (real-valued) or high-quality (complex) SBR
+ *
+ * Inputs:      valid AACDecInfo struct
+ *              non-zero for low-power SBR, 0 for high-quality SBR
+ *
+ * Outputs:     updated state variables for SBR
+ *
+ * Return:      0 if successful, error code (< 0) if error
+ *
+ * Notes:       the QMF delay lines and HF state of the two modes aren't compatible,
+ *                so changing the mode flushes the SBR state (see FlushCodecSBR)
+ **************************************************************************************/
+int SetSBRLowPower(AACDecInfo *aacDecInfo, int lowPower)
+{
+	PSInfoSBR *psi;
+
+	/* validate pointers */
+	if (!aacDecInfo || !aacDecInfo->psInfoSBR)
+		return ERR_AAC_NULL_POINTER;
+	psi = (PSInfoSBR *)(aacDecInfo->psInfoSBR);
+
+	lowPower = (lowPower ? 1 : 0);
+	if (psi->lowPower != lowPower) {
+		InitSBRState(psi);
+		psi->lowPower = lowPower;
+	}
 
 	return 0;
 }
@@ -75,6 +75,13 @@
 #define MAX_NUM_PATCHES				5
 #define MAX_NUM_SMOOTH_COEFS		5
 
+/* the ARM assembly in aac/armgcc is ARM-mode (.code 32), so it can't run on Thumb-only cores
+ *   like the Cortex-M4, which use the C versions of CVKernel1/2() and QMFAnalysisConv/QMFSynthesisConv()
+ */
+#if (defined (__arm) && defined (__ARMCC_VERSION)) || (defined (_WIN32) && defined (_WIN32_WCE) && defined (ARM)) || (defined(__GNUC__) && defined(__arm__) && defined(__ARM_ARCH_ISA_ARM))
+#define SBR_ARM_ASM
+#endif
+
 #define HF_GEN			8
 #define HF_ADJ			2
 
@@ -96,7 +103,6 @@
 #define FBITS_GLIM_BOOST	24
 #define FBITS_QLIM_BOOST	14
 
-#define MAX_HUFF_BITS		20
 #define NUM_QMF_DELAY_BUFS	10
 #define DELAY_SAMPS_QMFA	(NUM_QMF_DELAY_BUFS * 32)
 #define DELAY_SAMPS_QMFS	(NUM_QMF_DELAY_BUFS * 128)
@@ -115,6 +121,8 @@
 #define SqrtFix							STATNAME(SqrtFix)
 #define QMFAnalysis						STATNAME(QMFAnalysis)
 #define QMFSynthesis					STATNAME(QMFSynthesis)
+#define QMFAnalysisLP					STATNAME(QMFAnalysisLP)
+#define QMFSynthesisLP					STATNAME(QMFSynthesisLP)
 #define GetSampRateIdx					STATNAME(GetSampRateIdx)
 #define UnpackSBRHeader					STATNAME(UnpackSBRHeader)
 #define UnpackSBRSingleChannel			STATNAME(UnpackSBRSingleChannel)
@@ -125,6 +133,8 @@
 #define CVKernel2						STATNAME(CVKernel2)
 #define QMFAnalysisConv					STATNAME(QMFAnalysisConv)
 #define QMFSynthesisConv				STATNAME(QMFSynthesisConv)
+#define QMFAnalysisConvThumb2			STATNAME(QMFAnalysisConvThumb2)
+#define QMFSynthesisConvThumb2			STATNAME(QMFSynthesisConvThumb2)
 
 #define k0Tab							STATNAME(k0Tab)
 #define k2Tab							STATNAME(k2Tab)
@@ -146,12 +156,14 @@
 	} \
 }
 
+#ifndef CLIP_2N	/* assembly.h may have a faster one */
 #define CLIP_2N(y, n) { \
 	int sign = (y) >> 31;  \
 	if (sign != ((y) >> (n)))  { \
 		(y) = sign ^ ((1 << (n)) - 1); \
 	} \
 }
+#endif
 
 enum {
 	SBR_GRID_FIXFIX = 0,
@@ -175,12 +187,6 @@ enum {
 	HuffTabSBR_fNoise30b = 7
 };
 
-typedef struct _HuffInfo {
-	int maxBits;							/* number of bits in longest codeword */
-    unsigned char count[MAX_HUFF_BITS];		/* count[i] = number of codes with length i+1 bits */
-	int offset;								/* offset into symbol table */
-} HuffInfo;
-
 /* need one SBRHeader per element (SCE/CPE), updated only on new header */
 typedef struct _SBRHeader {
 	int                   count;
@@ -273,6 +279,7 @@ typedef struct _PSInfoSBR {
 	/* save for entire file */
 	int                   frameCount;
 	int                   sampRateIdx;
+	int                   lowPower;		/* real-valued (low-power) SBR, set with AACSetSBRLowPower() */
 
 	/* state info that must be saved for each channel */
 	SBRHeader             sbrHdr[AAC_MAX_NCHANS];
@@ -324,7 +331,14 @@ typedef struct _PSInfoSBR {
 	int                   gFiltLast[MAX_QMF_BANDS];
 	int                   qFiltLast[MAX_QMF_BANDS];
 
-	/* large buffers */
+	int                   aliasDeg[MAX_QMF_BANDS];
+	unsigned char         sMappedBuf[MAX_QMF_BANDS];
+
+	/* large buffers
+	 * XBuf and XBufDelay stay complex in low-power mode too (imaginary parts 0), the mode is
+	 *   switched at run time. Real-only buffers would save 14336 bytes, but only in a build
+	 *   without high-quality mode, and would still not bring SBR into the Teensy 3.1/3.2
+	 */
 	int                   delayIdxQMFA[AAC_MAX_NCHANS];
 	int                   delayQMFA[AAC_MAX_NCHANS][DELAY_SAMPS_QMFA];
 	int                   delayIdxQMFS[AAC_MAX_NCHANS];
@@ -345,6 +359,14 @@ void AdjustHighFreq(PSInfoSBR *psi, SBRHeader *sbrHdr, SBRGrid *sbrGrid, SBRFreq
 
 /* sbrhfgen.c */
 void GenerateHighFreq(PSInfoSBR *psi, SBRGrid *sbrGrid, SBRFreq *sbrFreq, SBRChan *sbrChan, int ch);
+#if defined(SBR_ARM_ASM) && defined(__cplusplus)
+extern "C" {
+#endif
+void CVKernel1(int *XBuf, int *accBuf);
+void CVKernel2(int *XBuf, int *accBuf);
+#if defined(SBR_ARM_ASM) && defined(__cplusplus)
+}
+#endif
 
 /* sbrhuff.c */
 void DecodeSBREnvelope(BitStreamInfo *bsi, PSInfoSBR *psi, SBRGrid *sbrGrid, SBRFreq *sbrFreq, SBRChan *sbrChan, int ch);
@@ -360,6 +382,26 @@ int SqrtFix(int x, int fBitsIn, int *fBitsOut);
 /* sbrqmf.c */
 int QMFAnalysis(int *inbuf, int *delay, int *XBuf, int fBitsIn, int *delayIdx, int qmfaBands);
 void QMFSynthesis(int *inbuf, int *delay, int *delayIdx, int qmfsBands, short *outbuf, int nChans);
+int QMFAnalysisLP(int *inbuf, int *delay, int *XBuf, int fBitsIn, int *delayIdx, int qmfaBands);
+void QMFSynthesisLP(int *inbuf, int *delay, int *delayIdx, int qmfsBands, short *outbuf, int nChans);
+#if defined(SBR_ARM_ASM) && defined(__cplusplus)
+extern "C" {
+#endif
+void QMFAnalysisConv(int *cTab, int *delay, int dIdx, int *uBuf);
+void QMFSynthesisConv(int *cPtr, int *delay, int dIdx, short *outbuf, int nChans);
+#if defined(SBR_ARM_ASM) && defined(__cplusplus)
+}
+#endif
+
+/* asmqmf_thumb2.S for Cortex-M4 */
+#ifdef __cplusplus
+extern "C" {
+#endif
+void QMFAnalysisConvThumb2(int *cTab, int *delay, int dIdx, int *uBuf);
+void QMFSynthesisConvThumb2(int *cPtr, int *delay, int dIdx, short *outbuf, int nChans);
+#ifdef __cplusplus
+}
+#endif
 
 /* sbrside.c */
 int GetSampRateIdx(int sampRate);
@@ -44,7 +44,7 @@
  **************************************************************************************/
 
 #include "sbr.h"
-#include "assembly.h"
+//#include "assembly.h"
 
 #define SQRT1_2	0x5a82799a
 
@@ -58,6 +58,9 @@ static const unsigned char bitrevtab32[9] = {
 };
 */
 
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wnarrowing"
+
 /* twiddle table for radix 4 pass, format = Q31 */
 static const int twidTabOdd32[8*6] = {
 	0x40000000, 0x00000000, 0x40000000, 0x00000000, 0x40000000, 0x00000000, 0x539eba45, 0xe7821d59, 
@@ -68,6 +71,8 @@ static const int twidTabOdd32[8*6] = {
 	0xac6145bb, 0x187de2a7, 0xdd5d0b08, 0xe7821d59, 0x4b418bbe, 0xc13ad060, 0xa73abd3b, 0x3536cc52, 
 };
 
+#pragma GCC diagnostic pop
+
 /**************************************************************************************
  * Function:    BitReverse32
  *
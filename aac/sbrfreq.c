@@ -44,7 +44,7 @@
  **************************************************************************************/
 
 #include "sbr.h"
-#include "assembly.h"
+//#include "assembly.h"
 
 /**************************************************************************************
  * Function:    BubbleSort
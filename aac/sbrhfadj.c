@@ -44,7 +44,7 @@
  **************************************************************************************/
 
 #include "sbr.h"
-#include "assembly.h"
+//#include "assembly.h"
 
 /* invBandTab[i] = 1.0 / (i + 1), Q31 */
 static const int invBandTab[64] = {
@@ -73,11 +73,14 @@ static const int invBandTab[64] = {
  * Outputs:     power of each QMF subband, stored as integer (Q0) * 2^N, N >= 0
  *
  * Return:      none
+ *
+ * Notes:       in low-power mode the imaginary parts are 0, and the power of the
+ *                real-valued subbands is doubled to match that of the complex ones
  **************************************************************************************/
 static void EstimateEnvelope(PSInfoSBR *psi, SBRHeader *sbrHdr, SBRGrid *sbrGrid, SBRFreq *sbrFreq, int env)
 {
 	int i, m, iStart, iEnd, xre, xim, nScale, expMax;
-	int p, n, mStart, mEnd, invFact, t;
+	int p, n, mStart, mEnd, invFact, t, lpScale;
 	int *XBuf;
 	U64 eCurr;
 	unsigned char *freqBandTab;
@@ -95,6 +98,7 @@ static void EstimateEnvelope(PSInfoSBR *psi, SBRHeader *sbrHdr, SBRGrid *sbrGrid
 
 	/* ADS should inline MADD64 (smlal) properly, but check to make sure */
 	expMax = 0;
+	lpScale = (psi->lowPower ? 1 : 0);
 	if (sbrHdr->interpFreq) {
 		for (m = 0; m < sbrFreq->numQMFBands; m++) {
 			eCurr.w64 = 0;
@@ -124,7 +128,7 @@ static void EstimateEnvelope(PSInfoSBR *psi, SBRHeader *sbrHdr, SBRGrid *sbrGrid
 
 			invFact = invBandTab[(iEnd - iStart)-1];
 			psi->eCurr[m] = MULSHIFT32(t, invFact);
-			psi->eCurrExp[m] = nScale + 1;	/* +1 for invFact = Q31 */
+			psi->eCurrExp[m] = nScale + 1 + lpScale;	/* +1 for invFact = Q31 */
 			if (psi->eCurrExp[m] > expMax)
 				expMax = psi->eCurrExp[m];
 		}
@@ -161,7 +165,7 @@ static void EstimateEnvelope(PSInfoSBR *psi, SBRHeader *sbrHdr, SBRGrid *sbrGrid
 
 			for (m = mStart; m < mEnd; m++) {
 				psi->eCurr[m - sbrFreq->kStart] = t;
-				psi->eCurrExp[m - sbrFreq->kStart] = nScale + 1;	/* +1 for invFact = Q31 */
+				psi->eCurrExp[m - sbrFreq->kStart] = nScale + 1 + lpScale;	/* +1 for invFact = Q31 */
 			}
 			if (psi->eCurrExp[mStart - sbrFreq->kStart] > expMax)
 				expMax = psi->eCurrExp[mStart - sbrFreq->kStart];
@@ -214,10 +218,11 @@ static int GetSMapped(SBRGrid *sbrGrid, SBRFreq *sbrFreq, SBRChan *sbrChan, int
 }
 
 #define GBOOST_MAX	0x2830afd3	/* Q28, 1.584893192 squared */
+#define SQRT1_2		0x5a82799a	/* sqrt(1/2) in Q31 */
 #define	ACC_SCALE	6
 
 /* squared version of table in 4.6.18.7.5 */
-static const int limGainTab[4] = {0x20138ca7, 0x40000000, 0x7fb27dce, 0x80000000};	/* Q30 (0x80000000 = sentinel for GMAX) */
+static const int limGainTab[4] = {0x20138ca7, 0x40000000, 0x7fb27dce, (int)0x80000000};	/* Q30 (0x80000000 = sentinel for GMAX) */
 
 /**************************************************************************************
  * Function:    CalcMaxGain
@@ -383,6 +388,7 @@ static void CalcComponentGains(PSInfoSBR *psi, SBRGrid *sbrGrid, SBRFreq *sbrFre
 			psi->sBand++;
 			psi->sMapped = GetSMapped(sbrGrid, sbrFreq, sbrChan, env, psi->sBand, psi->la);
 		}
+		psi->sMappedBuf[m] = (unsigned char)psi->sMapped;	/* for AliasingReduction() */
 
 		/* get sIndexMapped for this QMF subband */
 		sIndexMapped = 0;
@@ -621,6 +627,131 @@ static void CalcGain(PSInfoSBR *psi, SBRHeader *sbrHdr, SBRGrid *sbrGrid, SBRFre
 	}
 }
 
+/**************************************************************************************
+ * Function:    AliasingReduction
+ *
+ * Description: smooth the envelope gains over groups of QMF bands that are likely to
+ *                alias into each other in low-power SBR (4.6.18.7.5, low power)
+ *
+ * Inputs:      initialized PSInfoSBR struct, with gLimBoost from CalcGain() and
+ *                aliasDeg from GenerateHighFreq()
+ *              initialized SBRFreq struct for this SCE/CPE block
+ *
+ * Outputs:     updated envelope gain gLimBoost, format = Q(FBITS_GLIM_BOOST)
+ *
+ * Return:      none
+ *
+ * Notes:       each group of consecutive bands with aliasing degree > 0 (and no sinusoid)
+ *                moves its gains towards the energy-weighted average of the group,
+ *                by the aliasing degree of each band, then rescales them to keep the
+ *                total energy of the group unchanged
+ *              works on squared gains, Q(16 + 2*s), with s = guard bits of the
+ *                largest gain in the group (gLimBoost = Q24)
+ **************************************************************************************/
+static void AliasingReduction(PSInfoSBR *psi, SBRFreq *sbrFreq)
+{
+	int m, mStart, mEnd, numBands, alpha, e, g2, gT2, gNew;
+	int expMax, z, zd, s, t, r, eEst, gMask;
+	int g2Buf[MAX_QMF_BANDS];
+	U64 eTot, eTotNew;
+
+	numBands = sbrFreq->numQMFBands;
+	expMax = psi->eCurrExpMax;
+
+	for (mStart = 0; mStart < numBands; mStart = mEnd) {
+		/* find next group: band m starts or continues a group if band m+1 aliases into it */
+		while (mStart < numBands - 1 && (psi->aliasDeg[mStart + 1] == 0 || psi->sMappedBuf[mStart]))
+			mStart++;
+		if (mStart >= numBands - 1)
+			break;
+		mEnd = mStart + 1;
+		while (mEnd < numBands - 1 && psi->aliasDeg[mEnd + 1] != 0 && !psi->sMappedBuf[mEnd])
+			mEnd++;
+		if (mEnd == numBands - 1)
+			mEnd = numBands;
+		else if (!psi->sMappedBuf[mEnd])
+			mEnd++;
+
+		gMask = 0;
+		for (m = mStart; m < mEnd; m++)
+			gMask |= psi->gLimBoost[m];
+		s = (gMask ? CLZ(gMask) - 1 : 0);
+
+		/* total energy before and after gain, at common scale 2^expMax */
+		eEst = 0;
+		eTot.w64 = 0;
+		for (m = mStart; m < mEnd; m++) {
+			e = psi->eCurr[m] >> MIN(expMax - psi->eCurrExp[m] + ACC_SCALE, 31);
+			g2 = psi->gLimBoost[m] << s;
+			g2 = MULSHIFT32(g2, g2);		/* Q(2*(24 + s) - 32) */
+			g2Buf[m] = g2;
+			eEst += e;
+			eTot.w64 = MADD64(eTot.w64, e, g2);
+		}
+		if (eEst == 0)
+			continue;
+
+		/* scale eTot down to 30 bits (1 GB), gT2 = eTot / eEst in same Q format as g2 */
+		z = 0;
+		while ((eTot.w64 >> z) >= (1 << 30))
+			z++;
+		t = (int)(eTot.w64 >> z);
+		zd = CLZ(eEst) - 1;
+		r = InvRNormalized(eEst << zd);		/* Q(29 + 31 - zd) */
+		gT2 = MULSHIFT32(t, r);				/* Q(16 + 2*s - z + 28 - zd) */
+		z = 28 - z - zd;
+		if (z >= 0) {
+			gT2 >>= MIN(z, 31);
+		} else {
+			z = MIN(30, -z);
+			CLIP_2N_SHIFT30(gT2, z);
+		}
+
+		/* mix towards the group average by the aliasing degree (max of this band and the next one) */
+		eTotNew.w64 = 0;
+		for (m = mStart; m < mEnd; m++) {
+			alpha = psi->aliasDeg[m];
+			if (m < numBands - 1 && psi->aliasDeg[m + 1] > alpha)
+				alpha = psi->aliasDeg[m + 1];
+			g2 = g2Buf[m];
+			g2 += MULSHIFT32(alpha, gT2 - g2) << 2;		/* alpha = Q30 */
+			g2Buf[m] = g2;
+			e = psi->eCurr[m] >> MIN(expMax - psi->eCurrExp[m] + ACC_SCALE, 31);
+			eTotNew.w64 = MADD64(eTotNew.w64, e, g2);
+		}
+
+		/* rescale to total energy before mixing: r = eTot / eTotNew, Q(28 - zd) */
+		z = 0;
+		while ((eTot.w64 >> z) >= (1 << 30) || (eTotNew.w64 >> z) >= (1 << 30))
+			z++;
+		t = (int)(eTotNew.w64 >> z);
+		if (t == 0)
+			continue;
+		zd = CLZ(t) - 1;
+		r = InvRNormalized(t << zd);
+		r = MULSHIFT32((int)(eTot.w64 >> z), r);
+
+		for (m = mStart; m < mEnd; m++) {
+			g2 = g2Buf[m];
+			if (g2 <= 0) {
+				psi->gLimBoost[m] = 0;
+				continue;
+			}
+			z = CLZ(g2) - 1;
+			g2 = MULSHIFT32(g2 << z, r);		/* Q(16 + 2*s + z + 28 - zd - 32) */
+			gNew = SqrtFix(g2, 12 + 2*s + z - zd, &z);
+			z -= FBITS_GLIM_BOOST;
+			if (z >= 0) {
+				psi->gLimBoost[m] = gNew >> MIN(z, 31);
+			} else {
+				z = MIN(30, -z);
+				CLIP_2N_SHIFT30(gNew, z);
+				psi->gLimBoost[m] = gNew;
+			}
+		}
+	}
+}
+
 /* hSmooth table from 4.7.18.7.6, format = Q31 */
 static const int hSmoothCoef[MAX_NUM_SMOOTH_COEFS] = {
 	0x2aaaaaab, 0x2697a512, 0x1becfa68, 0x0ebdb043, 0x04130598, 
@@ -652,7 +783,7 @@ static void MapHF(PSInfoSBR *psi, SBRHeader *sbrHdr, SBRGrid *sbrGrid, SBRFreq *
 	int noiseTabIndex, sinIndex, gainNoiseIndex, hSL;
 	int i, iStart, iEnd, m, idx, j, s, n, smre, smim;
 	int gFilt, qFilt, xre, xim, gbMask, gbIdx;
-	int *XBuf;
+	int *XBuf, *gTemp[MAX_NUM_SMOOTH_COEFS], *qTemp[MAX_NUM_SMOOTH_COEFS];
 
 	noiseTabIndex =   sbrChan->noiseTabIndex;
 	sinIndex =        sbrChan->sinIndex;
@@ -689,84 +820,128 @@ static void MapHF(PSInfoSBR *psi, SBRHeader *sbrHdr, SBRGrid *sbrGrid, SBRFreq *
 			}
 		}
 
-		/* see 4.6.18.7.6 */
-		XBuf = psi->XBuf[i + HF_ADJ][sbrFreq->kStart];
-		gbMask = 0;
-		for (m = 0; m < sbrFreq->numQMFBands; m++) {
-			if (env == psi->la || env == sbrChan->laPrev) {
-				/* no smoothing filter for gain, and qFilt = 0 (only need to do once) */
-				if (i == iStart) {
+		/* see 4.6.18.7.6
+		 * the filtered gains only change in the first MAX_NUM_SMOOTH_COEFS slots, so they're
+		 *   updated for all bands before the loop over the bands, instead of testing in it
+		 */
+		if (env == psi->la || env == sbrChan->laPrev) {
+			/* no smoothing filter for gain, and qFilt = 0 (only need to do once) */
+			if (i == iStart) {
+				for (m = 0; m < sbrFreq->numQMFBands; m++) {
 					psi->gFiltLast[m] = sbrChan->gTemp[gainNoiseIndex][m];
 					psi->qFiltLast[m] = 0;
 				}
-			} else if (hSL == 0) {
-				/* no smoothing filter for gain, (only need to do once) */
-				if (i == iStart) {
+			}
+		} else if (hSL == 0) {
+			/* no smoothing filter for gain, (only need to do once) */
+			if (i == iStart) {
+				for (m = 0; m < sbrFreq->numQMFBands; m++) {
 					psi->gFiltLast[m] = sbrChan->gTemp[gainNoiseIndex][m];
 					psi->qFiltLast[m] = sbrChan->qTemp[gainNoiseIndex][m];
 				}
-			} else {
-				/* apply smoothing filter to gain and noise (after MAX_NUM_SMOOTH_COEFS, it's always the same) */
-				if (i - iStart < MAX_NUM_SMOOTH_COEFS) {
-					gFilt = 0;
-					qFilt = 0;
-					idx = gainNoiseIndex;
-					for (j = 0; j < MAX_NUM_SMOOTH_COEFS; j++) {
-						/* sum(abs(hSmoothCoef[j])) for all j < 1.0 */
-						gFilt += MULSHIFT32(sbrChan->gTemp[idx][m], hSmoothCoef[j]);
-						qFilt += MULSHIFT32(sbrChan->qTemp[idx][m], hSmoothCoef[j]);
-						idx--;
-						if (idx < 0)
-							idx += MAX_NUM_SMOOTH_COEFS;
-					}
-					psi->gFiltLast[m] = gFilt << 1;	/* restore to Q(FBITS_GLIM_BOOST) (gain of filter < 1.0, so no overflow) */
-					psi->qFiltLast[m] = qFilt << 1;	/* restore to Q(FBITS_QLIM_BOOST) */
+			}
+		} else if (i - iStart < MAX_NUM_SMOOTH_COEFS) {
+			/* apply smoothing filter to gain and noise (after MAX_NUM_SMOOTH_COEFS, it's always the same) */
+			idx = gainNoiseIndex;
+			for (j = 0; j < MAX_NUM_SMOOTH_COEFS; j++) {
+				gTemp[j] = sbrChan->gTemp[idx];
+				qTemp[j] = sbrChan->qTemp[idx];
+				idx--;
+				if (idx < 0)
+					idx += MAX_NUM_SMOOTH_COEFS;
+			}
+			for (m = 0; m < sbrFreq->numQMFBands; m++) {
+				gFilt = 0;
+				qFilt = 0;
+				for (j = 0; j < MAX_NUM_SMOOTH_COEFS; j++) {
+					/* sum(abs(hSmoothCoef[j])) for all j < 1.0 */
+					gFilt += MULSHIFT32(gTemp[j][m], hSmoothCoef[j]);
+					qFilt += MULSHIFT32(qTemp[j][m], hSmoothCoef[j]);
 				}
+				psi->gFiltLast[m] = gFilt << 1;	/* restore to Q(FBITS_GLIM_BOOST) (gain of filter < 1.0, so no overflow) */
+				psi->qFiltLast[m] = qFilt << 1;	/* restore to Q(FBITS_QLIM_BOOST) */
 			}
+		}
 
-			if (psi->smBoost[m] != 0) {
-				/* add scaled signal and sinusoid, don't add noise (qFilt = 0) */
-				smre = psi->smBoost[m];
-				smim = smre;
-
-				/* sinIndex:  [0] xre += sm   [1] xim += sm*s   [2] xre -= sm   [3] xim -= sm*s  */
-				s = (sinIndex >> 1);	/* if 2 or 3, flip sign to subtract sm */
-				s <<= 31;
-				smre ^= (s >> 31);
-				smre -= (s >> 31);
-				s ^= ((m + sbrFreq->kStart) << 31);
-				smim ^= (s >> 31);
-				smim -= (s >> 31);
-
-				/* if sinIndex == 0 or 2, smim = 0; if sinIndex == 1 or 3, smre = 0 */
-				s = sinIndex << 31;
-				smim &= (s >> 31);
-				s ^= 0x80000000;
-				smre &= (s >> 31);
-
-				noiseTabIndex += 2;		/* noise filtered by 0, but still need to bump index */
-			} else {
-				/* add scaled signal and scaled noise */
-				qFilt = psi->qFiltLast[m];	
-				n = noiseTab[noiseTabIndex++];
-				smre = MULSHIFT32(n, qFilt) >> (FBITS_QLIM_BOOST - 1 - FBITS_OUT_QMFA);
+		XBuf = psi->XBuf[i + HF_ADJ][sbrFreq->kStart];
+		gbMask = 0;
+		if (psi->lowPower) {
+			/* real-valued version, same as below without the imaginary parts
+			 * the sinusoid is only added in the real part (sinIndex = 0 or 2), the 
+			 *   small leakage into the neighboring bands for sinIndex = 1 or 3 is not modeled
+			 * noise is uncorrelated between bands, so the real synthesis QMF doesn't cancel its
+			 *   aliasing, and it comes out 3 dB louder than complex noise with the same power
+			 *   in each part - scale it by sqrt(1/2) to compensate
+			 */
+			for (m = 0; m < sbrFreq->numQMFBands; m++) {
+				if (psi->smBoost[m] != 0) {
+					smre = (sinIndex & 0x01 ? 0 : psi->smBoost[m]);
+					if (sinIndex == 2)
+						smre = -smre;
+				} else {
+					qFilt = psi->qFiltLast[m];
+					n = noiseTab[noiseTabIndex];
+					smre = MULSHIFT32(n, qFilt);
+					smre = MULSHIFT32(smre, SQRT1_2) >> (FBITS_QLIM_BOOST - 2 - FBITS_OUT_QMFA);
+				}
+				noiseTabIndex += 2;
+				noiseTabIndex &= 1023;
+
+				gFilt = psi->gFiltLast[m];
+				xre = MULSHIFT32(gFilt, XBuf[0]);
+				CLIP_2N_SHIFT30(xre, 32 - FBITS_GLIM_BOOST);
+				xre += smre;
+				XBuf[0] = xre;
+				XBuf += 2;
 
-				n = noiseTab[noiseTabIndex++];
-				smim = MULSHIFT32(n, qFilt) >> (FBITS_QLIM_BOOST - 1 - FBITS_OUT_QMFA);
+				gbMask |= FASTABS(xre);
 			}
-			noiseTabIndex &= 1023;	/* 512 complex numbers */
+		} else {
+			for (m = 0; m < sbrFreq->numQMFBands; m++) {
+				if (psi->smBoost[m] != 0) {
+					/* add scaled signal and sinusoid, don't add noise (qFilt = 0) */
+					smre = psi->smBoost[m];
+					smim = smre;
+
+					/* sinIndex:  [0] xre += sm   [1] xim += sm*s   [2] xre -= sm   [3] xim -= sm*s  */
+					s = (sinIndex >> 1);	/* if 2 or 3, flip sign to subtract sm */
+					s <<= 31;
+					smre ^= (s >> 31);
+					smre -= (s >> 31);
+					s ^= ((m + sbrFreq->kStart) << 31);
+					smim ^= (s >> 31);
+					smim -= (s >> 31);
+
+					/* if sinIndex == 0 or 2, smim = 0; if sinIndex == 1 or 3, smre = 0 */
+					s = sinIndex << 31;
+					smim &= (s >> 31);
+					s ^= 0x80000000;
+					smre &= (s >> 31);
+
+					noiseTabIndex += 2;		/* noise filtered by 0, but still need to bump index */
+				} else {
+					/* add scaled signal and scaled noise */
+					qFilt = psi->qFiltLast[m];	
+					n = noiseTab[noiseTabIndex++];
+					smre = MULSHIFT32(n, qFilt) >> (FBITS_QLIM_BOOST - 1 - FBITS_OUT_QMFA);
+
+					n = noiseTab[noiseTabIndex++];
+					smim = MULSHIFT32(n, qFilt) >> (FBITS_QLIM_BOOST - 1 - FBITS_OUT_QMFA);
+				}
+				noiseTabIndex &= 1023;	/* 512 complex numbers */
 
-			gFilt = psi->gFiltLast[m];
-			xre = MULSHIFT32(gFilt, XBuf[0]);
-			xim = MULSHIFT32(gFilt, XBuf[1]);
-			CLIP_2N_SHIFT30(xre, 32 - FBITS_GLIM_BOOST);
-			CLIP_2N_SHIFT30(xim, 32 - FBITS_GLIM_BOOST);
+				gFilt = psi->gFiltLast[m];
+				xre = MULSHIFT32(gFilt, XBuf[0]);
+				xim = MULSHIFT32(gFilt, XBuf[1]);
+				CLIP_2N_SHIFT30(xre, 32 - FBITS_GLIM_BOOST);
+				CLIP_2N_SHIFT30(xim, 32 - FBITS_GLIM_BOOST);
 
-			xre += smre;	*XBuf++ = xre;
-			xim += smim;	*XBuf++ = xim;
+				xre += smre;	*XBuf++ = xre;
+				xim += smim;	*XBuf++ = xim;
 
-			gbMask |= FASTABS(xre);
-			gbMask |= FASTABS(xim);
+				gbMask |= FASTABS(xre);
+				gbMask |= FASTABS(xim);
+			}
 		}
 		/* update circular buffer index */
 		gainNoiseIndex++;
@@ -834,6 +1009,8 @@ void AdjustHighFreq(PSInfoSBR *psi, SBRHeader *sbrHdr, SBRGrid *sbrGrid, SBRFreq
 	for (env = 0; env < sbrGrid->numEnv; env++) {
 		EstimateEnvelope(psi, sbrHdr, sbrGrid, sbrFreq, env);
 		CalcGain(psi, sbrHdr, sbrGrid, sbrFreq, sbrChan, ch, env);
+		if (psi->lowPower)
+			AliasingReduction(psi, sbrFreq);
 		MapHF(psi, sbrHdr, sbrGrid, sbrFreq, sbrChan, env, hfReset);
 		hfReset = 0;	/* only set for first envelope after header reset */
 	}
@@ -44,7 +44,7 @@
  **************************************************************************************/
 
 #include "sbr.h"
-#include "assembly.h"
+//#include "assembly.h"
 
 #define FBITS_LPCOEFS	29	/* Q29 for range of (-4, 4) */
 #define MAG_16			(16 * (1 << (32 - (2*(32-FBITS_LPCOEFS)))))		/* i.e. 16 in Q26 format */
@@ -76,11 +76,8 @@ static const int newBWTab[4][4] = {
  * Notes:       this is carefully written to be efficient on ARM
  *              use the assembly code version in sbrcov.s when building for ARM!
  **************************************************************************************/
-#if (defined (__arm) && defined (__ARMCC_VERSION)) || (defined (_WIN32) && defined (_WIN32_WCE) && defined (ARM)) || (defined(__GNUC__) && defined(__arm__))
-#ifdef __cplusplus
-extern "C"
-#endif
-void CVKernel1(int *XBuf, int *accBuf);
+#ifdef SBR_ARM_ASM
+/* sbrcov.s, declared in sbr.h */
 #else
 void CVKernel1(int *XBuf, int *accBuf)
 {
@@ -141,6 +138,59 @@ void CVKernel1(int *XBuf, int *accBuf)
 }
 #endif
 
+/**************************************************************************************
+ * Function:    CVKernel1LP
+ *
+ * Description: kernel of covariance matrix calculation for p01, p11, p12, p22,
+ *                real-valued version for low-power SBR
+ *
+ * Inputs:      buffer of low-freq samples, starting at time index = 0, 
+ *                freq index = patch subband
+ *
+ * Outputs:     64-bit accumulators for p01re, p01im, p12re, p12im, p11re, p22re
+ *                stored in accBuf (same layout as CVKernel1, imaginary parts = 0)
+ *
+ * Return:      none
+ *
+ * Notes:       the imaginary parts of XBuf are all 0 in low-power mode, so they are
+ *                skipped instead of being multiplied in
+ **************************************************************************************/
+static void CVKernel1LP(int *XBuf, int *accBuf)
+{
+	U64 p01re, p12re, p11re, p22re;
+	int n, x0re, x1re;
+
+	x0re = XBuf[0];
+	XBuf += (2*64);
+	x1re = XBuf[0];
+	XBuf += (2*64);
+
+	p01re.w64 = 0;
+	p11re.w64 = 0;
+	p12re.w64 = MADD64(0, x1re, x0re);
+	p22re.w64 = MADD64(0, x0re, x0re);
+	for (n = (NUM_TIME_SLOTS*SAMPLES_PER_SLOT + 6); n != 0; n--) {
+		x0re = x1re;
+		x1re = XBuf[0];
+
+		p01re.w64 = MADD64(p01re.w64, x1re, x0re);
+		p11re.w64 = MADD64(p11re.w64, x0re, x0re);
+
+		XBuf += (2*64);
+	}
+	p12re.w64 += p01re.w64;
+	p12re.w64 = MADD64(p12re.w64, x1re, -x0re);
+	p22re.w64 += p11re.w64;
+	p22re.w64 = MADD64(p22re.w64, x0re, -x0re);
+
+	accBuf[0]  = p01re.r.lo32;	accBuf[1]  = p01re.r.hi32;
+	accBuf[2]  = 0;				accBuf[3]  = 0;
+	accBuf[4]  = p11re.r.lo32;	accBuf[5]  = p11re.r.hi32;
+	accBuf[6]  = p12re.r.lo32;	accBuf[7]  = p12re.r.hi32;
+	accBuf[8]  = 0;				accBuf[9]  = 0;
+	accBuf[10] = p22re.r.lo32;	accBuf[11] = p22re.r.hi32;
+}
+
 /**************************************************************************************
  * Function:    CalcCovariance1
  *
@@ -148,6 +198,7 @@ void CVKernel1(int *XBuf, int *accBuf)
  *
  * Inputs:      buffer of low-freq samples, starting at time index 0, 
  *                freq index = patch subband
+ *              flag for low-power (real-valued) SBR
  *
  * Outputs:     complex covariance elements p01re, p01im, p12re, p12im, p11re, p22re
  *                (p11im = p22im = 0)
@@ -157,13 +208,16 @@ void CVKernel1(int *XBuf, int *accBuf)
  *
  * Notes:       outputs are normalized to have 1 GB (sign in at least top 2 bits)
  **************************************************************************************/
-static int CalcCovariance1(int *XBuf, int *p01reN, int *p01imN, int *p12reN, int *p12imN, int *p11reN, int *p22reN)
+static int CalcCovariance1(int *XBuf, int *p01reN, int *p01imN, int *p12reN, int *p12imN, int *p11reN, int *p22reN, int lowPower)
 {
 	int accBuf[2*6];
 	int n, z, s, loShift, hiShift, gbMask;
 	U64 p01re, p01im, p12re, p12im, p11re, p22re;
 
-	CVKernel1(XBuf, accBuf);
+	if (lowPower)
+		CVKernel1LP(XBuf, accBuf);
+	else
+		CVKernel1(XBuf, accBuf);
 	p01re.r.lo32 = accBuf[0];	p01re.r.hi32 = accBuf[1];
 	p01im.r.lo32 = accBuf[2];	p01im.r.hi32 = accBuf[3];
 	p11re.r.lo32 = accBuf[4];	p11re.r.hi32 = accBuf[5];
@@ -237,11 +291,8 @@ static int CalcCovariance1(int *XBuf, int *p01reN, int *p01imN, int *p12reN, int
  * Notes:       this is carefully written to be efficient on ARM
  *              use the assembly code version in sbrcov.s when building for ARM!
  **************************************************************************************/
-#if (defined (__arm) && defined (__ARMCC_VERSION)) || (defined (_WIN32) && defined (_WIN32_WCE) && defined (ARM)) || (defined(__GNUC__) && defined(__arm__))
-#ifdef __cplusplus
-extern "C"
-#endif
-void CVKernel2(int *XBuf, int *accBuf);
+#ifdef SBR_ARM_ASM
+/* sbrcov.s, declared in sbr.h */
 #else
 void CVKernel2(int *XBuf, int *accBuf)
 {
@@ -281,6 +332,45 @@ void CVKernel2(int *XBuf, int *accBuf)
 }
 #endif
 
+/**************************************************************************************
+ * Function:    CVKernel2LP
+ *
+ * Description: kernel of covariance matrix calculation for p02,
+ *                real-valued version for low-power SBR
+ *
+ * Inputs:      buffer of low-freq samples, starting at time index = 0, 
+ *                freq index = patch subband
+ *
+ * Outputs:     64-bit accumulators for p02re, p02im stored in accBuf (p02im = 0)
+ *
+ * Return:      none
+ **************************************************************************************/
+static void CVKernel2LP(int *XBuf, int *accBuf)
+{
+	U64 p02re;
+	int n, x0re, x1re, x2re;
+
+	p02re.w64 = 0;
+
+	x0re = XBuf[0];
+	XBuf += (2*64);
+	x1re = XBuf[0];
+	XBuf += (2*64);
+
+	for (n = (NUM_TIME_SLOTS*SAMPLES_PER_SLOT + 6); n != 0; n--) {
+		x2re = XBuf[0];
+		p02re.w64 = MADD64(p02re.w64, x2re, x0re);
+		x0re = x1re;
+		x1re = x2re;
+		XBuf += (2*64);
+	}
+
+	accBuf[0] = p02re.r.lo32;
+	accBuf[1] = p02re.r.hi32;
+	accBuf[2] = 0;
+	accBuf[3] = 0;
+}
+
 /**************************************************************************************
  * Function:    CalcCovariance2
  *
@@ -288,6 +378,7 @@ void CVKernel2(int *XBuf, int *accBuf)
  *
  * Inputs:      buffer of low-freq samples, starting at time index = 0, 
  *                freq index = patch subband
+ *              flag for low-power (real-valued) SBR
  *
  * Outputs:     complex covariance element p02re, p02im
  *              format = integer (Q0) * 2^N, with scalefactor N >= 0
@@ -296,13 +387,16 @@ void CVKernel2(int *XBuf, int *accBuf)
  *
  * Notes:       outputs are normalized to have 1 GB (sign in at least top 2 bits)
  **************************************************************************************/
-static int CalcCovariance2(int *XBuf, int *p02reN, int *p02imN)
+static int CalcCovariance2(int *XBuf, int *p02reN, int *p02imN, int lowPower)
 {
 	U64 p02re, p02im;
 	int n, z, s, loShift, hiShift, gbMask;
 	int accBuf[2*2];
 
-	CVKernel2(XBuf, accBuf);
+	if (lowPower)
+		CVKernel2LP(XBuf, accBuf);
+	else
+		CVKernel2(XBuf, accBuf);
 	p02re.r.lo32 = accBuf[0];
 	p02re.r.hi32 = accBuf[1];
 	p02im.r.lo32 = accBuf[2];
@@ -352,17 +446,22 @@ static int CalcCovariance2(int *XBuf, int *p02reN, int *p02imN)
  *
  * Inputs:      buffer of low-freq samples, starting at time index = 0, 
  *                freq index = patch subband
+ *              pointer to reflection coefficient output, or 0 for high-quality SBR
  *              number of guard bits in input sample buffer
  *
  * Outputs:     complex LP coefficients a0re, a0im, a1re, a1im, format = Q29
+ *              for low-power SBR, reflection coefficient rk = -p01/p11, format = Q30
  *
  * Return:      none
  *
  * Notes:       output coefficients (a0re, a0im, a1re, a1im) clipped to range (-4, 4)
  *              if the comples coefficients have magnitude >= 4.0, they are all
  *                set to 0 (see spec)
+ *              with rk != 0 the real-valued covariance kernels are used, since 
+ *                XBuf has no imaginary parts in low-power mode, and rk is 
+ *                clipped to [-1, 1]
  **************************************************************************************/
-static void CalcLPCoefs(int *XBuf, int *a0re, int *a0im, int *a1re, int *a1im, int gb)
+static void CalcLPCoefs(int *XBuf, int *a0re, int *a0im, int *a1re, int *a1im, int *rk, int gb)
 {
 	int zFlag, n1, n2, nd, d, dInv, tre, tim;
 	int p01re, p01im, p02re, p02im, p12re, p12im, p11re, p22re;
@@ -382,8 +481,8 @@ static void CalcLPCoefs(int *XBuf, int *a0re, int *a0im, int *a1re, int *a1im, i
 	}
 	
 	/* calculate covariance elements */
-	n1 = CalcCovariance1(XBuf, &p01re, &p01im, &p12re, &p12im, &p11re, &p22re);
-	n2 = CalcCovariance2(XBuf, &p02re, &p02im);
+	n1 = CalcCovariance1(XBuf, &p01re, &p01im, &p12re, &p12im, &p11re, &p22re, rk != 0);
+	n2 = CalcCovariance2(XBuf, &p02re, &p02im, rk != 0);
 
 	/* normalize everything to larger power of 2 scalefactor, call it n1 */
 	if (n1 < n2) {
@@ -406,6 +505,8 @@ static void CalcLPCoefs(int *XBuf, int *a0re, int *a0im, int *a1re, int *a1im, i
 	zFlag = 0;
 	*a0re = *a0im = 0;
 	*a1re = *a1im = 0;
+	if (rk)
+		*rk = 0;
 	if (d > 0) {
 		/* input =   Q31  d    = Q(-2*n1 - 32 + nd) = Q31 * 2^(31 + 2*n1 + 32 - nd)
 		 * inverse = Q29  dInv = Q29 * 2^(-31 - 2*n1 - 32 + nd) = Q(29 + 31 + 2*n1 + 32 - nd)
@@ -447,6 +548,15 @@ static void CalcLPCoefs(int *XBuf, int *a0re, int *a0im, int *a1re, int *a1im, i
 		p11re <<= nd;
 		dInv = InvRNormalized(p11re);
 
+		if (rk && nd <= 28) {
+			/* -p01re / p11re = Q(28 - nd), clip to +/- 1.0 and convert to Q30 */
+			tre = MULSHIFT32(p01re, dInv);
+			if (FASTABS(tre) >> (28 - nd))
+				*rk = (tre < 0 ? 0x40000000 : -0x40000000);
+			else
+				*rk = -(tre << (2 + nd));
+		}
+
 		/* a1re, a1im = Q29, so scaled by (n1 + 3) */
 		tre = (p01re >> 3) + MULSHIFT32(p12re, *a1re) + MULSHIFT32(p12im, *a1im);
 		tre = -MULSHIFT32(tre, dInv);
@@ -480,6 +590,52 @@ static void CalcLPCoefs(int *XBuf, int *a0re, int *a0im, int *a1re, int *a1im, i
 	}
 }
 
+/**************************************************************************************
+ * Function:    CalcAliasDegree
+ *
+ * Description: calculate aliasing degree of the low bands for low-power SBR (4.6.18.6.5)
+ *
+ * Inputs:      reflection coefficients rk[0, nBands-1], format = Q30
+ *              number of low bands
+ *
+ * Outputs:     aliasing degree deg[0, nBands-1], format = Q30
+ *
+ * Return:      none
+ *
+ * Notes:       a band is likely to alias into its neighbor when the reflection
+ *                coefficients of the two point at each other (sign depends on the
+ *                band parity, since every other band of the real QMF is spectrally inverted)
+ **************************************************************************************/
+static void CalcAliasDegree(int *rk, int *deg, int nBands)
+{
+	int k, r1sq;
+
+	for (k = 0; k < nBands; k++)
+		deg[k] = 0;
+
+	for (k = 2; k < nBands; k++) {
+		/* 1 - rk[k-1]^2, Q30 */
+		r1sq = 0x40000000 - (MULSHIFT32(rk[k-1], rk[k-1]) << 2);
+		if ((k & 0x01) == 0 && rk[k] < 0) {
+			if (rk[k-1] < 0) {
+				deg[k] = 0x40000000;
+				if (rk[k-2] > 0)
+					deg[k-1] = r1sq;
+			} else if (rk[k-2] > 0) {
+				deg[k] = r1sq;
+			}
+		} else if ((k & 0x01) == 1 && rk[k] > 0) {
+			if (rk[k-1] > 0) {
+				deg[k] = 0x40000000;
+				if (rk[k-2] < 0)
+					deg[k-1] = r1sq;
+			} else if (rk[k-2] < 0) {
+				deg[k] = r1sq;
+			}
+		}
+	}
+}
+
 /**************************************************************************************
  * Function:    GenerateHighFreq
  *
@@ -492,8 +648,13 @@ static void CalcLPCoefs(int *XBuf, int *a0re, int *a0im, int *a1re, int *a1im, i
  *              index of current channel (0 for SCE, 0 or 1 for CPE)
  *
  * Outputs:     new high frequency samples starting at frequency kStart
+ *              aliasing degree of the new bands in psi->aliasDeg (low-power SBR only)
  *
  * Return:      none
+ *
+ * Notes:       in low-power mode the patches are real-valued, and the LP coefficients
+ *                of all the low bands are calculated up front since the aliasing 
+ *                degree needs the reflection coefficients of each one
  **************************************************************************************/
 void GenerateHighFreq(PSInfoSBR *psi, SBRGrid *sbrGrid, SBRFreq *sbrFreq, SBRChan *sbrChan, int ch)
 {
@@ -503,6 +664,9 @@ void GenerateHighFreq(PSInfoSBR *psi, SBRGrid *sbrGrid, SBRFreq *sbrFreq, SBRCha
 	int x1re, x1im, x2re, x2im;
 	int ACCre, ACCim;
 	int *XBufLo, *XBufHi;
+	int lpCoefs[32][4];		/* low bands come from the 32-band analysis QMF */
+	int rk[32], deg[32];
+	unsigned int lpValid;
 
 	/* calculate array of chirp factors */
 	for (band = 0; band < sbrFreq->numNoiseFloorBands; band++) {
@@ -538,6 +702,19 @@ void GenerateHighFreq(PSInfoSBR *psi, SBRGrid *sbrGrid, SBRFreq *sbrFreq, SBRCha
 	gbMask = (sbrChan->gbMask[0] | sbrChan->gbMask[1]);	/* older 32 | newer 8 */
 	gb = CLZ(gbMask) - 1;
 
+	/* the patches reuse the same low bands, so keep the LP coefficients of each one
+	 * not if gb < 3, since then CalcLPCoefs() rescales the low band in place every time
+	 */
+	lpValid = 0;
+
+	if (psi->lowPower) {
+		for (p = 0; p < k; p++)
+			CalcLPCoefs(psi->XBuf[0][p], &lpCoefs[p][0], &lpCoefs[p][1], &lpCoefs[p][2], &lpCoefs[p][3], &rk[p], gb);
+		lpValid = (k == 32 ? 0xffffffff : (1U << k) - 1);
+		rk[0] = 0;
+		CalcAliasDegree(rk, deg, k);
+	}
+
 	for (currPatch = 0; currPatch < sbrFreq->numPatches; currPatch++) {
 		for (x = 0; x < sbrFreq->patchNumSubbands[currPatch]; x++) {
 			/* map k to corresponding noise floor band */
@@ -549,8 +726,49 @@ void GenerateHighFreq(PSInfoSBR *psi, SBRGrid *sbrGrid, SBRFreq *sbrFreq, SBRCha
 		
 			p = sbrFreq->patchStartSubband[currPatch] + x;	/* low QMF band */
 			XBufHi = psi->XBuf[iStart][k];
-			if (bw) {
-				CalcLPCoefs(psi->XBuf[0][p], &a0re, &a0im, &a1re, &a1im, gb);
+			if (psi->lowPower)
+				psi->aliasDeg[k - sbrFreq->kStart] = (x ? deg[p] : 0);
+
+			if (bw && psi->lowPower) {
+				a0re = MULSHIFT32(bw,   lpCoefs[p][0]);	/* Q31 * Q29 = Q28 */
+				a1re = MULSHIFT32(bwsq, lpCoefs[p][2]);
+
+				XBufLo = psi->XBuf[iStart-2][p];
+				x2re = XBufLo[0];
+				XBufLo += (64*2);
+				x1re = XBufLo[0];
+				XBufLo += (64*2);
+
+				/* same as below, without the imaginary parts (all 0) */
+				for (i = iStart; i < iEnd; i++) {
+					ACCre = MULSHIFT32(x2re, a1re) + MULSHIFT32(x1re, a0re);
+					x2re = x1re;
+					x1re = XBufLo[0];
+					XBufLo += (64*2);
+
+					CLIP_2N_SHIFT30(ACCre, 4);
+					ACCre += x1re;
+
+					XBufHi[0] = ACCre;
+					XBufHi[1] = 0;
+					XBufHi += (64*2);
+
+					gbIdx = (i >> 5) & 0x01;
+					sbrChan->gbMask[gbIdx] |= FASTABS(ACCre);
+				}
+			} else if (bw) {
+				if (gb < 3) {
+					CalcLPCoefs(psi->XBuf[0][p], &a0re, &a0im, &a1re, &a1im, 0, gb);
+				} else {
+					if (!(lpValid & (1U << p))) {
+						CalcLPCoefs(psi->XBuf[0][p], &lpCoefs[p][0], &lpCoefs[p][1], &lpCoefs[p][2], &lpCoefs[p][3], 0, gb);
+						lpValid |= (1U << p);
+					}
+					a0re = lpCoefs[p][0];
+					a0im = lpCoefs[p][1];
+					a1re = lpCoefs[p][2];
+					a1im = lpCoefs[p][3];
+				}
 
 				a0re = MULSHIFT32(bw, a0re);	/* Q31 * Q29 = Q28 */
 				a0im = MULSHIFT32(bw, a0im);
@@ -44,51 +44,7 @@
  **************************************************************************************/
 
 #include "sbr.h"
-#include "assembly.h"
-
-/**************************************************************************************
- * Function:    DecodeHuffmanScalar
- *
- * Description: decode one Huffman symbol from bitstream
- *
- * Inputs:      pointers to Huffman table and info struct
- *              left-aligned bit buffer with >= huffTabInfo->maxBits bits
- *
- * Outputs:     decoded symbol in *val
- *
- * Return:      number of bits in symbol
- *
- * Notes:       assumes canonical Huffman codes:
- *                first CW always 0, we have "count" CW's of length "nBits" bits
- *                starting CW for codes of length nBits+1 = 
- *                  (startCW[nBits] + count[nBits]) << 1
- *                if there are no codes at nBits, then we just keep << 1 each time 
- *                  (since count[nBits] = 0)
- **************************************************************************************/
-static int DecodeHuffmanScalar(const signed short *huffTab, const HuffInfo *huffTabInfo, unsigned int bitBuf, signed int *val)
-{
-    unsigned int count, start, shift, t;
-	const unsigned char *countPtr;
-	const signed short *map;
-
-	map = huffTab + huffTabInfo->offset;
-	countPtr = huffTabInfo->count;
-
-	start = 0;
-	count = 0;
-	shift = 32;
-	do {
-		start += count;
-		start <<= 1;
-		map += count;
-		count = *countPtr++;
-		shift--;
-		t = (bitBuf >> shift) - start;
-	} while (t >= count);
-	
-	*val = (signed int)map[t];
-	return (countPtr - huffTabInfo->count);
-}
+//#include "assembly.h"
 
 /**************************************************************************************
  * Function:    DecodeOneSymbol
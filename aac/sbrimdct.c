@@ -44,7 +44,7 @@
  **************************************************************************************/
 
 #include "coder.h"
-#include "assembly.h"
+//#include "assembly.h"
 
 /**************************************************************************************
  * Function:    DecWindowOverlapNoClip
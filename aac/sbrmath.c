@@ -44,7 +44,7 @@
  **************************************************************************************/
 
 #include "sbr.h"
-#include "assembly.h"
+//#include "assembly.h"
 
 #define Q28_2	0x20000000	/* Q28: 2.0 */
 #define Q28_15	0x30000000	/* Q28: 1.5 */
@@ -139,10 +139,30 @@ int RatioPowInv(int a, int b, int c)
 	return y;
 }
 
+/* sqrtTab[i - 32] = round(sqrt((i + 0.5) * 2^23)), initial guess for SqrtFix() from the top 8 bits of
+ *   the normalized input
+ */
+static const unsigned short sqrtTab[256 - 32] = {
+	16512, 16764, 17012, 17257, 17498, 17736, 17971, 18203, 18432, 18658, 18882, 19102, 19321, 19537, 19750, 19961,
+	20170, 20377, 20582, 20785, 20986, 21185, 21382, 21577, 21771, 21962, 22153, 22341, 22528, 22713, 22897, 23080,
+	23261, 23440, 23619, 23796, 23971, 24146, 24319, 24491, 24661, 24831, 24999, 25166, 25332, 25497, 25661, 25824,
+	25986, 26147, 26307, 26466, 26624, 26781, 26937, 27092, 27247, 27400, 27553, 27705, 27856, 28006, 28155, 28304,
+	28452, 28599, 28745, 28891, 29035, 29180, 29323, 29466, 29608, 29749, 29890, 30030, 30169, 30308, 30446, 30583,
+	30720, 30856, 30992, 31127, 31261, 31395, 31529, 31661, 31794, 31925, 32056, 32187, 32317, 32446, 32575, 32704,
+	32832, 32959, 33086, 33213, 33339, 33465, 33590, 33714, 33839, 33962, 34086, 34208, 34331, 34453, 34574, 34695,
+	34816, 34936, 35056, 35176, 35295, 35413, 35531, 35649, 35767, 35884, 36001, 36117, 36233, 36348, 36464, 36578,
+	36693, 36807, 36921, 37034, 37147, 37260, 37372, 37485, 37596, 37708, 37819, 37929, 38040, 38150, 38260, 38369,
+	38478, 38587, 38696, 38804, 38912, 39020, 39127, 39234, 39341, 39447, 39553, 39659, 39765, 39870, 39975, 40080,
+	40185, 40289, 40393, 40497, 40600, 40703, 40806, 40909, 41011, 41113, 41215, 41317, 41418, 41519, 41620, 41721,
+	41821, 41922, 42021, 42121, 42221, 42320, 42419, 42518, 42616, 42714, 42813, 42910, 43008, 43105, 43203, 43300,
+	43396, 43493, 43589, 43685, 43781, 43877, 43972, 44068, 44163, 44258, 44352, 44447, 44541, 44635, 44729, 44823,
+	44916, 45009, 45103, 45195, 45288, 45381, 45473, 45565, 45657, 45749, 45840, 45932, 46023, 46114, 46205, 46296,
+};
+
 /**************************************************************************************
  * Function:    SqrtFix
  *
- * Description: use binary search to calculate sqrt(q)
+ * Description: calculate sqrt(q) with one Newton step from a table guess
  *
  * Inputs:      q = Q30
  *              number of fraction bits in input
@@ -152,12 +172,16 @@ int RatioPowInv(int a, int b, int c)
  * Return:      lo = Q(fBitsOut)
  *
  * Notes:       absolute precision varies depending on fBitsIn
- *              normalizes input to range [0x200000000, 0x7fffffff] and takes 
+ *              normalizes input to range [0x10000000, 0x7fffffff] and takes 
  *                floor(sqrt(input)), and sets fBitsOut appropriately
+ *              the guess is within 128 of sqrt(input), so after the Newton step the
+ *                result is floor(sqrt(input)) or one more, same result as the binary
+ *                search this replaces for every input (checked exhaustively)
  **************************************************************************************/
 int SqrtFix(int q, int fBitsIn, int *fBitsOut)
 {
-	int z, lo, hi, mid;
+	int z;
+	unsigned int s, x;
 
 	if (q <= 0) {
 		*fBitsOut = fBitsIn;
@@ -169,27 +193,17 @@ int SqrtFix(int q, int fBitsIn, int *fBitsOut)
 	q >>= z;
 	fBitsIn -= z;
 
-	/* for max precision, normalize to [0x20000000, 0x7fffffff] */
+	/* for max precision, normalize to [0x10000000, 0x7fffffff] */
 	z = (CLZ(q) - 1);
 	z >>= 1;
 	q <<= (2*z);
 
-	/* choose initial bounds */
-	lo = 1;
-	if (q >= 0x10000000)
-		lo = 16384;	/* (int)sqrt(0x10000000) */
-	hi = 46340;		/* (int)sqrt(0x7fffffff) */
-
-	/* do binary search with 32x32->32 multiply test */
-	do {
-		mid = (lo + hi) >> 1;
-		if (mid*mid > q)
-			hi = mid - 1;
-		else
-			lo = mid + 1;
-	} while (hi >= lo);
-	lo--;
+	/* one Newton step, x >= floor(sqrt(q)) since (s + q/s)/2 >= sqrt(q) */
+	s = sqrtTab[(q >> 23) - 32];
+	x = (s + (unsigned int)q / s) >> 1;
+	if (x*x > (unsigned int)q)
+		x--;
 
 	*fBitsOut = ((fBitsIn + 2*z) >> 1);
-	return lo;
+	return (int)x;
 }
@@ -44,7 +44,18 @@
  **************************************************************************************/
 
 #include "sbr.h"
-#include "assembly.h"
+//#include "assembly.h"
+
+/* QMF convolutions in assembly on Thumb-2 ARMs (asmqmf_thumb2.S), unless AAC_QMF_C is defined in aacdec.h
+ *   ARM-mode cores use the ones of aac/armgcc instead (SBR_ARM_ASM)
+ */
+#if defined(__arm__) && !defined(SBR_ARM_ASM) && !defined(AAC_QMF_C)
+#define QMFAnalysisConvSel		QMFAnalysisConvThumb2
+#define QMFSynthesisConvSel		QMFSynthesisConvThumb2
+#else
+#define QMFAnalysisConvSel		QMFAnalysisConv
+#define QMFSynthesisConvSel		QMFSynthesisConv
+#endif
 
 /* PreMultiply64() table
  * format = Q30
@@ -89,6 +100,43 @@ static const int cos1sin1tab64[34] = {
 	0x5a82799a, 0x2d413ccd,
 };
 
+/* QMFAnalysisLP() and QMFSynthesisLP() tables for the recursive (Lee) DCTs
+ * hsecTabN[k] = 1 / (2 * cos(pi*(2k+1)/(2N))), k = [0, N/2-1]
+ * format = Q(33 - log2(N)), so the largest entry of each table fits
+ */
+static const int hsecTab2[1] = {
+	0x5a82799a,
+};
+
+static const int hsecTab4[2] = {
+	0x22a2f4f8, 0x539eba45,
+};
+
+static const int hsecTab8[4] = {
+	0x10503ed1, 0x133e37a2, 0x1ccc9af0, 0x52036742,
+};
+
+static const int hsecTab16[8] = {
+	0x0809e8ce, 0x085c2782, 0x091233e9, 0x0a5961cc, 0x0c9c4806, 0x10f8892a, 0x1b8f24b0, 0x519e4e04,
+};
+
+static const int hsecTab32[16] = {
+	0x04013c25, 0x040b345c, 0x041fa2d7, 0x043f9342, 0x046cc1bc, 0x04a9d9cf, 0x04fae371, 0x056601ea,
+	0x05f4cf6f, 0x06b6fcf2, 0x07c7d1db, 0x095b0353, 0x0bdf91b3, 0x107655e4, 0x1b42c834, 0x518522fb,
+};
+
+static const int hsecTab64[32] = {
+	0x0200277d, 0x0201641c, 0x0203e131, 0x0207a686, 0x020cc015, 0x02133e66, 0x021b3715, 0x0224c58b,
+	0x02300be9, 0x023d344c, 0x024c7269, 0x025e05ae, 0x02723c17, 0x028975ef, 0x02a42ae0, 0x02c2f0e9,
+	0x02e685ff, 0x030fddb4, 0x034034fa, 0x03792f5b, 0x03bd037c, 0x040ec10a, 0x0472c2e7, 0x04ef71d9,
+	0x058ea313, 0x06603a45, 0x077fab0f, 0x0920d1bc, 0x0bb2d1cb, 0x1056a449, 0x1b2fdf6b, 0x517ed9eb,
+};
+
+/* x * hsecTabN[k], undoing the Q format of the table (s = log2(N) - 1)
+ * rounded 64-bit product, so the error stays within 0.5 LSB instead of 2^s
+ */
+#define MULHSEC(x, N, k, s)	((int)(((Word64)(x) * hsecTab##N[k] + (1 << (31 - (s)))) >> (32 - (s))))
+
 /**************************************************************************************
  * Function:    PreMultiply64
  *
@@ -221,41 +269,44 @@ static void PostMultiply64(int *fft1, int nSampsOut)
  *
  * Notes:       this is carefully written to be efficient on ARM
  *              use the assembly code version in sbrqmfak.s when building for ARM!
+ *              asmqmf_thumb2.S is the Thumb-2 version for Cortex-M4
  **************************************************************************************/
-#if (defined (__arm) && defined (__ARMCC_VERSION)) || (defined (_WIN32) && defined (_WIN32_WCE) && defined (ARM)) || (defined(__GNUC__) && defined(__arm__))
-#ifdef __cplusplus
-extern "C"
-#endif
-void QMFAnalysisConv(int *cTab, int *delay, int dIdx, int *uBuf);
+#ifdef SBR_ARM_ASM
+/* sbrqmfak.s, declared in sbr.h */
 #else
 void QMFAnalysisConv(int *cTab, int *delay, int dIdx, int *uBuf)
 {
-	int k, dOff;
+	int j, k;
 	int *cPtr0, *cPtr1;
+	int *dPtr[NUM_QMF_DELAY_BUFS];
 	U64 u64lo, u64hi;
 
-	dOff = dIdx*32 + 31;
+	/* last sample of each block of 32 in the delay ring buffer, newest first,
+	 *   so the taps below don't need a wraparound check each
+	 */
+	for (j = 0; j < NUM_QMF_DELAY_BUFS; j++)
+		dPtr[j] = delay + (dIdx - j < 0 ? dIdx - j + NUM_QMF_DELAY_BUFS : dIdx - j)*32 + 31;
+
 	cPtr0 = cTab;
 	cPtr1 = cTab + 33*5 - 1;
 
 	/* special first pass since we need to flip sign to create cTab[384], cTab[512] */
 	u64lo.w64 = 0;
 	u64hi.w64 = 0;
-	u64lo.w64 = MADD64(u64lo.w64,  *cPtr0++,   delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-	u64hi.w64 = MADD64(u64hi.w64,  *cPtr0++,   delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-	u64lo.w64 = MADD64(u64lo.w64,  *cPtr0++,   delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-	u64hi.w64 = MADD64(u64hi.w64,  *cPtr0++,   delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-	u64lo.w64 = MADD64(u64lo.w64,  *cPtr0++,   delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-	u64hi.w64 = MADD64(u64hi.w64,  *cPtr1--,   delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-	u64lo.w64 = MADD64(u64lo.w64, -(*cPtr1--), delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-	u64hi.w64 = MADD64(u64hi.w64,  *cPtr1--,   delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-	u64lo.w64 = MADD64(u64lo.w64, -(*cPtr1--), delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-	u64hi.w64 = MADD64(u64hi.w64,  *cPtr1--,   delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
+	u64lo.w64 = MADD64(u64lo.w64,  *cPtr0++,   *dPtr[0]);
+	u64hi.w64 = MADD64(u64hi.w64,  *cPtr0++,   *dPtr[1]);
+	u64lo.w64 = MADD64(u64lo.w64,  *cPtr0++,   *dPtr[2]);
+	u64hi.w64 = MADD64(u64hi.w64,  *cPtr0++,   *dPtr[3]);
+	u64lo.w64 = MADD64(u64lo.w64,  *cPtr0++,   *dPtr[4]);
+	u64hi.w64 = MADD64(u64hi.w64,  *cPtr1--,   *dPtr[5]);
+	u64lo.w64 = MADD64(u64lo.w64, -(*cPtr1--), *dPtr[6]);
+	u64hi.w64 = MADD64(u64hi.w64,  *cPtr1--,   *dPtr[7]);
+	u64lo.w64 = MADD64(u64lo.w64, -(*cPtr1--), *dPtr[8]);
+	u64hi.w64 = MADD64(u64hi.w64,  *cPtr1--,   *dPtr[9]);
 
 	uBuf[0]  = u64lo.r.hi32;
 	uBuf[32] = u64hi.r.hi32;
 	uBuf++;
-	dOff--;
 
 	/* max gain for any sample in uBuf, after scaling by cTab, ~= 0.99 
 	 * so we can just sum the uBuf values with no overflow problems
@@ -263,59 +314,46 @@ void QMFAnalysisConv(int *cTab, int *delay, int dIdx, int *uBuf)
 	for (k = 1; k <= 31; k++) {
 		u64lo.w64 = 0;
 		u64hi.w64 = 0;
-		u64lo.w64 = MADD64(u64lo.w64, *cPtr0++, delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-		u64hi.w64 = MADD64(u64hi.w64, *cPtr0++, delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-		u64lo.w64 = MADD64(u64lo.w64, *cPtr0++, delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-		u64hi.w64 = MADD64(u64hi.w64, *cPtr0++, delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-		u64lo.w64 = MADD64(u64lo.w64, *cPtr0++, delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-		u64hi.w64 = MADD64(u64hi.w64, *cPtr1--, delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-		u64lo.w64 = MADD64(u64lo.w64, *cPtr1--, delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-		u64hi.w64 = MADD64(u64hi.w64, *cPtr1--, delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-		u64lo.w64 = MADD64(u64lo.w64, *cPtr1--, delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
-		u64hi.w64 = MADD64(u64hi.w64, *cPtr1--, delay[dOff]);	dOff -= 32; if (dOff < 0) {dOff += 320;}
+		u64lo.w64 = MADD64(u64lo.w64, *cPtr0++, dPtr[0][-k]);
+		u64hi.w64 = MADD64(u64hi.w64, *cPtr0++, dPtr[1][-k]);
+		u64lo.w64 = MADD64(u64lo.w64, *cPtr0++, dPtr[2][-k]);
+		u64hi.w64 = MADD64(u64hi.w64, *cPtr0++, dPtr[3][-k]);
+		u64lo.w64 = MADD64(u64lo.w64, *cPtr0++, dPtr[4][-k]);
+		u64hi.w64 = MADD64(u64hi.w64, *cPtr1--, dPtr[5][-k]);
+		u64lo.w64 = MADD64(u64lo.w64, *cPtr1--, dPtr[6][-k]);
+		u64hi.w64 = MADD64(u64hi.w64, *cPtr1--, dPtr[7][-k]);
+		u64lo.w64 = MADD64(u64lo.w64, *cPtr1--, dPtr[8][-k]);
+		u64hi.w64 = MADD64(u64hi.w64, *cPtr1--, dPtr[9][-k]);
 
 		uBuf[0]  = u64lo.r.hi32;
 		uBuf[32] = u64hi.r.hi32;
 		uBuf++;
-		dOff--;
 	}
 }
 #endif
 
 /**************************************************************************************
- * Function:    QMFAnalysis
+ * Function:    LoadDelayQMFA
  *
- * Description: 32-subband analysis QMF (4.6.18.4.1)
+ * Description: copy new PCM into the analysis QMF delay buffer, converting to Q(FBITS_IN_QMFA)
  *
  * Inputs:      32 consecutive samples of decoded 32-bit PCM, format = Q(fBitsIn)
- *              delay buffer of size 32*10 = 320 PCM samples
+ *              pointer to the oldest block of 32 samples in the delay buffer
  *              number of fraction bits in input PCM
- *              index for delay ring buffer (range = [0, 9])
- *              number of subbands to calculate (range = [0, 32])
  *
- * Outputs:     qmfaBands complex subband samples, format = Q(FBITS_OUT_QMFA)
- *              updated delay buffer
- *              updated delay index
+ * Outputs:     32 samples in the delay buffer, with 1 GB
  *
- * Return:      guard bit mask
+ * Return:      none
  *
- * Notes:       output stored as RE{X0}, IM{X0}, RE{X1}, IM{X1}, ... RE{X31}, IM{X31}
- *              output stored in int buffer of size 64*2 = 128 
- *                (zero-filled from XBuf[2*qmfaBands] to XBuf[127])
+ * Notes:       shared by the high-quality and low-power analysis filters
  **************************************************************************************/
-int QMFAnalysis(int *inbuf, int *delay, int *XBuf, int fBitsIn, int *delayIdx, int qmfaBands)
+static void LoadDelayQMFA(int *inbuf, int *delayPtr, int fBitsIn)
 {
-	int n, y, shift, gbMask;
-	int *delayPtr, *uBuf, *tBuf;
-
-	/* use XBuf[128] as temp buffer for reordering */
-	uBuf = XBuf;		/* first 64 samples */
-	tBuf = XBuf + 64;	/* second 64 samples */
+	int n, y, shift;
 
 	/* overwrite oldest PCM with new PCM
 	 * delay[n] has 1 GB after shifting (either << or >>)
 	 */
-	delayPtr = delay + (*delayIdx * 32);
 	if (fBitsIn > FBITS_IN_QMFA) {
 		shift = MIN(fBitsIn - FBITS_IN_QMFA, 31);
 		for (n = 32; n != 0; n--) {
@@ -331,8 +369,41 @@ int QMFAnalysis(int *inbuf, int *delay, int *XBuf, int fBitsIn, int *delayIdx, i
 			*delayPtr++ = y;
 		}
 	}
+}
+
+/**************************************************************************************
+ * Function:    QMFAnalysis
+ *
+ * Description: 32-subband analysis QMF (4.6.18.4.1)
+ *
+ * Inputs:      32 consecutive samples of decoded 32-bit PCM, format = Q(fBitsIn)
+ *              delay buffer of size 32*10 = 320 PCM samples
+ *              number of fraction bits in input PCM
+ *              index for delay ring buffer (range = [0, 9])
+ *              number of subbands to calculate (range = [0, 32])
+ *
+ * Outputs:     qmfaBands complex subband samples, format = Q(FBITS_OUT_QMFA)
+ *              updated delay buffer
+ *              updated delay index
+ *
+ * Return:      guard bit mask
+ *
+ * Notes:       output stored as RE{X0}, IM{X0}, RE{X1}, IM{X1}, ... RE{X31}, IM{X31}
+ *              output stored in int buffer of size 64*2 = 128 
+ *                (zero-filled from XBuf[2*qmfaBands] to XBuf[127])
+ **************************************************************************************/
+int QMFAnalysis(int *inbuf, int *delay, int *XBuf, int fBitsIn, int *delayIdx, int qmfaBands)
+{
+	int n, gbMask;
+	int *uBuf, *tBuf;
+
+	/* use XBuf[128] as temp buffer for reordering */
+	uBuf = XBuf;		/* first 64 samples */
+	tBuf = XBuf + 64;	/* second 64 samples */
+
+	LoadDelayQMFA(inbuf, delay + (*delayIdx * 32), fBitsIn);
 	
-	QMFAnalysisConv((int *)cTabA, delay, *delayIdx, uBuf);
+	QMFAnalysisConvSel((int *)cTabA, delay, *delayIdx, uBuf);
 	
 	/* uBuf has at least 2 GB right now (1 from clipping to Q(FBITS_IN_QMFA), one from
 	 *   the scaling by cTab (MULSHIFT32(*delayPtr--, *cPtr++), with net gain of < 1.0)
@@ -373,9 +444,212 @@ int QMFAnalysis(int *inbuf, int *delay, int *XBuf, int fBitsIn, int *delayIdx, i
 	return gbMask;
 }
 
+/**************************************************************************************
+ * Function:    DCT3x8
+ *
+ * Description: 8-point DCT-III, X[k] = sum(y[j] * cos(pi*j*(2k+1)/16)), j = [0, 7]
+ *
+ * Inputs:      buffer of 8 samples
+ *
+ * Outputs:     transformed samples in same buffer
+ *
+ * Return:      none
+ *
+ * Notes:       Lee's recursion, split into even and odd-pair inputs, then 
+ *                X[k] = A[k] + B[k] * hsecTab[k], X[N-1-k] = A[k] - B[k] * hsecTab[k]
+ *              12 multiplies, all in registers
+ *              gain of at most 8 (sum of |cos| terms)
+ **************************************************************************************/
+static void DCT3x8(int *x)
+{
+	int a0, a1, a2, a3, b0, b1, b2, b3, t;
+
+	/* even inputs, 4-point DCT-III */
+	a0 = x[0] + MULHSEC(x[4], 2, 0, 1);
+	a1 = x[0] - MULHSEC(x[4], 2, 0, 1);
+	t  = MULHSEC(x[2] + x[6], 2, 0, 1);
+	b0 = x[2] + t;
+	b1 = x[2] - t;
+	t  = MULHSEC(b0, 4, 0, 2);	a2 = a0 - t;	a0 = a0 + t;
+	t  = MULHSEC(b1, 4, 1, 2);	a3 = a1 - t;	a1 = a1 + t;
+
+	/* odd inputs, summed pairwise, 4-point DCT-III */
+	b0 = x[1];
+	b1 = x[3] + x[1];
+	b2 = x[5] + x[3];
+	b3 = x[7] + x[5];
+	t  = MULHSEC(b2, 2, 0, 1);
+	x[0] = b0 + t;
+	x[1] = b0 - t;
+	t  = MULHSEC(b1 + b3, 2, 0, 1);
+	b0 = b1 + t;
+	b1 = b1 - t;
+	t  = MULHSEC(b0, 4, 0, 2);	b3 = x[0] - t;	b0 = x[0] + t;
+	t  = MULHSEC(b1, 4, 1, 2);	b2 = x[1] - t;	b1 = x[1] + t;
+	/* (a0, a1, a3, a2) = A[0..3], (b0, b1, b2, b3) = B[0..3] */
+
+	t = MULHSEC(b0, 8, 0, 3);	x[0] = a0 + t;	x[7] = a0 - t;
+	t = MULHSEC(b1, 8, 1, 3);	x[1] = a1 + t;	x[6] = a1 - t;
+	t = MULHSEC(b2, 8, 2, 3);	x[2] = a3 + t;	x[5] = a3 - t;
+	t = MULHSEC(b3, 8, 3, 3);	x[3] = a2 + t;	x[4] = a2 - t;
+}
+
+/**************************************************************************************
+ * Function:    DCT2x8
+ *
+ * Description: 8-point DCT-II, Y[m] = sum(x[n] * cos(pi*(2n+1)*m/16)), n = [0, 7]
+ *
+ * Inputs:      buffer of 8 samples
+ *
+ * Outputs:     transformed samples in same buffer
+ *
+ * Return:      none
+ *
+ * Notes:       Lee's recursion, transpose of DCT3x8 (split into sums and scaled 
+ *                differences, then Y[2k] = A[k], Y[2k+1] = B[k] + B[k+1])
+ *              12 multiplies, all in registers
+ *              gain of at most 8 (sum of |cos| terms)
+ **************************************************************************************/
+static void DCT2x8(int *x)
+{
+	int a0, a1, a2, a3, b0, b1, b2, b3, t;
+
+	a0 = x[0] + x[7];	b0 = MULHSEC(x[0] - x[7], 8, 0, 3);
+	a1 = x[1] + x[6];	b1 = MULHSEC(x[1] - x[6], 8, 1, 3);
+	a2 = x[2] + x[5];	b2 = MULHSEC(x[2] - x[5], 8, 2, 3);
+	a3 = x[3] + x[4];	b3 = MULHSEC(x[3] - x[4], 8, 3, 3);
+
+	/* 4-point DCT-II of sums */
+	t  = a0 + a3;	a3 = MULHSEC(a0 - a3, 4, 0, 2);	a0 = t;
+	t  = a1 + a2;	a2 = MULHSEC(a1 - a2, 4, 1, 2);	a1 = t;
+	x[0] = a0 + a1;
+	x[4] = MULHSEC(a0 - a1, 2, 0, 1);
+	t    = MULHSEC(a3 - a2, 2, 0, 1);
+	x[2] = a3 + a2 + t;
+	x[6] = t;
+
+	/* 4-point DCT-II of differences */
+	t  = b0 + b3;	b3 = MULHSEC(b0 - b3, 4, 0, 2);	b0 = t;
+	t  = b1 + b2;	b2 = MULHSEC(b1 - b2, 4, 1, 2);	b1 = t;
+	a0 = b0 + b1;
+	a2 = MULHSEC(b0 - b1, 2, 0, 1);
+	t  = MULHSEC(b3 - b2, 2, 0, 1);
+	a1 = b3 + b2 + t;
+	a3 = t;
+	/* (a0, a1, a2, a3) = B[0..3] */
+
+	x[1] = a0 + a1;
+	x[3] = a1 + a2;
+	x[5] = a2 + a3;
+	x[7] = a3;
+}
+
+/**************************************************************************************
+ * Function:    QMFAnalysisLP
+ *
+ * Description: 32-subband real-valued analysis QMF for low-power SBR (4.6.18.4.1)
+ *
+ * Inputs:      32 consecutive samples of decoded 32-bit PCM, format = Q(fBitsIn)
+ *              delay buffer of size 32*10 = 320 PCM samples
+ *              number of fraction bits in input PCM
+ *              index for delay ring buffer (range = [0, 9])
+ *              number of subbands to calculate (range = [0, 32])
+ *
+ * Outputs:     qmfaBands real subband samples, format = Q(FBITS_OUT_QMFA)
+ *              updated delay buffer
+ *              updated delay index
+ *
+ * Return:      guard bit mask
+ *
+ * Notes:       same layout as QMFAnalysis, with the imaginary parts all set to zero
+ *              the cosine modulation folds uBuf into 32 samples y[j], leaving a 
+ *                32-point DCT-III, done with Lee's recursion (80 multiplies)
+ **************************************************************************************/
+int QMFAnalysisLP(int *inbuf, int *delay, int *XBuf, int fBitsIn, int *delayIdx, int qmfaBands)
+{
+	int k, n, p, q, r, t, gbMask;
+	int *uBuf, *yBuf, *tBuf;
+
+	uBuf = XBuf;
+	yBuf = XBuf + 64;
+	tBuf = XBuf + 96;
+
+	LoadDelayQMFA(inbuf, delay + (*delayIdx * 32), fBitsIn);
+
+	QMFAnalysisConvSel((int *)cTabA, delay, *delayIdx, uBuf);
+
+	/* fold uBuf (2 GB) by the symmetries of the modulation
+	 *   y[m] = uBuf[16+m] + uBuf[16-m], y[32-m] = uBuf[48-m] - uBuf[48+m]
+	 * 1 GB after folding, 5 GB out (implicit scaling by 1/16)
+	 * no node of the DCT below exceeds 20.9 times max(|y|), so this leaves 0.6 GB
+	 */
+	yBuf[0] = (uBuf[16] + 8) >> 4;
+	for (n = 1; n < 16; n++) {
+		yBuf[n]      = (uBuf[16 + n] + uBuf[16 - n] + 8) >> 4;
+		yBuf[32 - n] = (uBuf[48 - n] - uBuf[48 + n] + 8) >> 4;
+	}
+	yBuf[16] = (uBuf[32] + uBuf[0] + 8) >> 4;
+
+	/* first two levels of the 32-point DCT-III: four 8-point DCT-III's of
+	 *   y[4k], y[4k+2] + y[4k-2], y[4k+1] + y[4k-1], and the sum of y[4k-3] to y[4k+3] with odd index
+	 */
+	tBuf[0]  = yBuf[0];
+	tBuf[8]  = yBuf[2];
+	tBuf[16] = yBuf[1];
+	tBuf[24] = yBuf[3] + yBuf[1];
+	for (k = 1; k < 8; k++) {
+		n = 4*k;
+		tBuf[k]      = yBuf[n];
+		tBuf[8 + k]  = yBuf[n + 2] + yBuf[n - 2];
+		tBuf[16 + k] = yBuf[n + 1] + yBuf[n - 1];
+		tBuf[24 + k] = yBuf[n + 3] + yBuf[n + 1] + yBuf[n - 1] + yBuf[n - 3];
+	}
+
+	DCT3x8(tBuf + 0);
+	DCT3x8(tBuf + 8);
+	DCT3x8(tBuf + 16);
+	DCT3x8(tBuf + 24);
+
+	/* last two levels
+	 * gain 3 GB to match the output Q format of QMFAnalysis (total implicit scaling by 1/128)
+	 */
+	for (k = 0; k < 8; k++) {
+		t = MULHSEC(tBuf[8 + k],  16, k, 4);
+		p = tBuf[k] + t;
+		q = tBuf[k] - t;
+		t = MULHSEC(tBuf[24 + k], 16, k, 4);
+		r = tBuf[16 + k] + t;
+		t = tBuf[16 + k] - t;
+
+		r = MULHSEC(r, 32, k, 5);
+		XBuf[2*k]            = (p + r) >> 3;
+		XBuf[2*(31 - k)]     = (p - r) >> 3;
+		t = MULHSEC(t, 32, 15 - k, 5);
+		XBuf[2*(15 - k)]     = (q + t) >> 3;
+		XBuf[2*(16 + k)]     = (q - t) >> 3;
+	}
+
+	gbMask = 0;
+	for (n = 0; n < qmfaBands; n++) {
+		gbMask |= FASTABS(XBuf[2*n+0]);
+		XBuf[2*n+1] = 0;
+	}
+
+	/* fill top section with zeros for HF generation */
+	for (    ; n < 64; n++) {
+		XBuf[2*n+0] = 0;
+		XBuf[2*n+1] = 0;
+	}
+
+	*delayIdx = (*delayIdx == NUM_QMF_DELAY_BUFS - 1 ? 0 : *delayIdx + 1);
+
+	/* minimum of 2 GB in output */
+	return gbMask;
+}
+
 /* lose FBITS_LOST_DCT4_64 in DCT4, gain 6 for implicit scaling by 1/64, lose 1 for cTab multiply (Q31) */
 #define FBITS_OUT_QMFS	(FBITS_IN_QMFS - FBITS_LOST_DCT4_64 + 6 - 1)
-#define RND_VAL			(1 << (FBITS_OUT_QMFS-1))
+#define RND_VAL_QMFS			(1 << (FBITS_OUT_QMFS-1))
 
 /**************************************************************************************
  * Function:    QMFSynthesisConv
@@ -394,40 +668,38 @@ int QMFAnalysis(int *inbuf, int *delay, int *XBuf, int fBitsIn, int *delayIdx, i
  *
  * Notes:       this is carefully written to be efficient on ARM
  *              use the assembly code version in sbrqmfsk.s when building for ARM!
+ *              asmqmf_thumb2.S is the Thumb-2 version for Cortex-M4
  **************************************************************************************/
-#if (defined (__arm) && defined (__ARMCC_VERSION)) || (defined (_WIN32) && defined (_WIN32_WCE) && defined (ARM)) || (defined(__GNUC__) && defined(__arm__))
-#ifdef __cplusplus
-extern "C"
-#endif
-void QMFSynthesisConv(int *cPtr, int *delay, int dIdx, short *outbuf, int nChans);
+#ifdef SBR_ARM_ASM
+/* sbrqmfsk.s, declared in sbr.h */
 #else
 void QMFSynthesisConv(int *cPtr, int *delay, int dIdx, short *outbuf, int nChans)
 {
-	int k, dOff0, dOff1;
+	int j, k;
+	int *dPtr[NUM_QMF_DELAY_BUFS];
 	U64 sum64;
 
-	dOff0 = (dIdx)*128;
-	dOff1 = dOff0 - 1;
-	if (dOff1 < 0)
-		dOff1 += 1280;
+	/* blocks of 128 in the delay ring buffer, newest first, the even ones are read
+	 *   forwards from the first sample and the odd ones backwards from the last
+	 */
+	for (j = 0; j < NUM_QMF_DELAY_BUFS; j++)
+		dPtr[j] = delay + (dIdx - j < 0 ? dIdx - j + NUM_QMF_DELAY_BUFS : dIdx - j)*128 + (j & 0x01 ? 127 : 0);
 
 	/* scaling note: total gain of coefs (cPtr[0]-cPtr[9] for any k) is < 2.0, so 1 GB in delay values is adequate */
 	for (k = 0; k <= 63; k++) {
 		sum64.w64 = 0;
-		sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff0]);	dOff0 -= 256; if (dOff0 < 0) {dOff0 += 1280;}
-		sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff1]);	dOff1 -= 256; if (dOff1 < 0) {dOff1 += 1280;}
-		sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff0]);	dOff0 -= 256; if (dOff0 < 0) {dOff0 += 1280;}
-		sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff1]);	dOff1 -= 256; if (dOff1 < 0) {dOff1 += 1280;}
-		sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff0]);	dOff0 -= 256; if (dOff0 < 0) {dOff0 += 1280;}
-		sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff1]);	dOff1 -= 256; if (dOff1 < 0) {dOff1 += 1280;}
-		sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff0]);	dOff0 -= 256; if (dOff0 < 0) {dOff0 += 1280;}
-		sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff1]);	dOff1 -= 256; if (dOff1 < 0) {dOff1 += 1280;}
-		sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff0]);	dOff0 -= 256; if (dOff0 < 0) {dOff0 += 1280;}
-		sum64.w64 = MADD64(sum64.w64, *cPtr++, delay[dOff1]);	dOff1 -= 256; if (dOff1 < 0) {dOff1 += 1280;}
-
-		dOff0++;
-		dOff1--;
-		*outbuf = CLIPTOSHORT((sum64.r.hi32 + RND_VAL) >> FBITS_OUT_QMFS);
+		sum64.w64 = MADD64(sum64.w64, *cPtr++, dPtr[0][ k]);
+		sum64.w64 = MADD64(sum64.w64, *cPtr++, dPtr[1][-k]);
+		sum64.w64 = MADD64(sum64.w64, *cPtr++, dPtr[2][ k]);
+		sum64.w64 = MADD64(sum64.w64, *cPtr++, dPtr[3][-k]);
+		sum64.w64 = MADD64(sum64.w64, *cPtr++, dPtr[4][ k]);
+		sum64.w64 = MADD64(sum64.w64, *cPtr++, dPtr[5][-k]);
+		sum64.w64 = MADD64(sum64.w64, *cPtr++, dPtr[6][ k]);
+		sum64.w64 = MADD64(sum64.w64, *cPtr++, dPtr[7][-k]);
+		sum64.w64 = MADD64(sum64.w64, *cPtr++, dPtr[8][ k]);
+		sum64.w64 = MADD64(sum64.w64, *cPtr++, dPtr[9][-k]);
+
+		*outbuf = CLIPTOSHORT((sum64.r.hi32 + RND_VAL_QMFS) >> FBITS_OUT_QMFS);
 		outbuf += nChans;
 	}
 }
@@ -521,7 +793,129 @@ void QMFSynthesis(int *inbuf, int *delay, int *delayIdx, int qmfsBands, short *o
 		delay[dOff1++] = (b1 + a1);
 	}
 
-	QMFSynthesisConv((int *)cTabS, delay, dIdx, outbuf, nChans);
+	QMFSynthesisConvSel((int *)cTabS, delay, dIdx, outbuf, nChans);
+
+	*delayIdx = (*delayIdx == NUM_QMF_DELAY_BUFS - 1 ? 0 : *delayIdx + 1);
+}
+
+/**************************************************************************************
+ * Function:    QMFSynthesisLP
+ *
+ * Description: 64-subband real-valued synthesis QMF for low-power SBR (4.6.18.4.2)
+ *
+ * Inputs:      64 consecutive complex subband QMF samples, format = Q(FBITS_IN_QMFS)
+ *                (only the real parts are used)
+ *              delay buffer of size 64*10 = 640 complex samples (1280 ints)
+ *              index for delay ring buffer (range = [0, 9])
+ *              number of QMF subbands to process (range = [0, 64])
+ *              number of channels
+ *
+ * Outputs:     64 consecutive 16-bit PCM samples, interleaved by factor of nChans
+ *              updated delay buffer
+ *              updated delay index
+ *
+ * Return:      none
+ *
+ * Notes:       assumes MIN_GBITS_IN_QMFS guard bits in input, like QMFSynthesis
+ *              the cosine modulation is a 64-point DCT-II of the real subband samples,
+ *                done with Lee's recursion (192 multiplies), each output giving the 
+ *                two (mirrored) samples of the block it appears in
+ *              writes the same delay buffer layout as QMFSynthesis, so the 
+ *                convolution is shared
+ **************************************************************************************/
+void QMFSynthesisLP(int *inbuf, int *delay, int *delayIdx, int qmfsBands, short *outbuf, int nChans)
+{
+	int n, k, dIdx, x0, x1, x2, x3, a0, a1, b0, b1;
+	int *vBuf, *zPtr, *vPtr;
+	int zBuf[64];
+
+	dIdx = *delayIdx;
+	vBuf = delay + dIdx*128;
+
+	/* first two levels of the 64-point DCT-II, split into sums and scaled differences
+	 *   of X[n], X[63-n] and of X[31-n], X[32+n], then the same again on each half
+	 * only the real parts of the first qmfsBands samples are used
+	 * 2 GB in, 7 GB after implicit scaling by 1/32
+	 * no node of the DCT exceeds 115.5 times max(|X|), so this leaves 0.1 GB
+	 */
+	for (n = 0; n < 16; n++) {
+		x0 = (n      < qmfsBands ? (inbuf[2*n]        + 16) >> 5 : 0);
+		x1 = (63 - n < qmfsBands ? (inbuf[2*(63 - n)] + 16) >> 5 : 0);
+		x2 = (31 - n < qmfsBands ? (inbuf[2*(31 - n)] + 16) >> 5 : 0);
+		x3 = (32 + n < qmfsBands ? (inbuf[2*(32 + n)] + 16) >> 5 : 0);
+
+		a0 = x0 + x1;	b0 = MULHSEC(x0 - x1, 64, n, 6);
+		a1 = x2 + x3;	b1 = MULHSEC(x2 - x3, 64, 31 - n, 6);
+
+		zBuf[n]      = a0 + a1;	zBuf[16 + n] = MULHSEC(a0 - a1, 32, n, 5);
+		zBuf[32 + n] = b0 + b1;	zBuf[48 + n] = MULHSEC(b0 - b1, 32, n, 5);
+	}
+
+	/* third level, split each block of 16 into two blocks of 8 (vBuf[0-63] is scratch) */
+	for (k = 0; k < 64; k += 16) {
+		zPtr = zBuf + k;
+		vPtr = vBuf + k;
+		for (n = 0; n < 8; n++) {
+			vPtr[n]     = zPtr[n] + zPtr[15 - n];
+			vPtr[8 + n] = MULHSEC(zPtr[n] - zPtr[15 - n], 16, n, 4);
+		}
+	}
+
+	for (k = 0; k < 64; k += 8)
+		DCT2x8(vBuf + k);
+
+	/* merge pairs of blocks of 8 back into blocks of 16, Z[2k] = A[k], Z[2k+1] = B[k] + B[k+1] */
+	for (k = 0; k < 64; k += 16) {
+		zPtr = zBuf + k;
+		vPtr = vBuf + k;
+		for (n = 0; n < 7; n++) {
+			zPtr[2*n + 0] = vPtr[n];
+			zPtr[2*n + 1] = vPtr[8 + n] + vPtr[8 + n + 1];
+		}
+		zPtr[14] = vPtr[7];
+		zPtr[15] = vPtr[15];
+	}
+
+	/* merge the four blocks of 16 (Z0-Z3) into the 64 outputs C[m], two levels at once
+	 *   C[4k] = Z0[k], C[4k+2] = Z1[k] + Z1[k+1]
+	 *   C[4k+1] = Z2[k] + Z3[k] + Z3[k+1], C[4k+3] = Z3[k] + Z3[k+1] + Z2[k+1]
+	 * and write the same delay buffer layout as QMFSynthesis:
+	 *   vBuf[95 +/- m] = C[m] (m < 32), vBuf[96-m] = C[m], vBuf[m-32] = -C[m] (m > 32)
+	 *   vBuf[127] = C[32], vBuf[0] = -C[32], vBuf[32] = 0
+	 * upper half first, so the m = 32 case of vBuf[96-m] is overwritten with C[31] below
+	 * gain 1 GB for a total implicit scaling by 1/64, matching QMFSynthesis
+	 */
+	for (k = 8; k < 16; k++) {
+		n = 4*k;
+		x0 = zBuf[k];
+		x1 = zBuf[16 + k] + (k < 15 ? zBuf[16 + k + 1] : 0);
+		x3 = zBuf[48 + k] + (k < 15 ? zBuf[48 + k + 1] : 0);
+		x2 = zBuf[32 + k] + x3;
+		x3 = x3 + (k < 15 ? zBuf[32 + k + 1] : 0);
+		x0 = (x0 + 1) >> 1;	x1 = (x1 + 1) >> 1;	x2 = (x2 + 1) >> 1;	x3 = (x3 + 1) >> 1;
+		vBuf[96 - n] = x0;	vBuf[n - 32] = -x0;
+		vBuf[95 - n] = x2;	vBuf[n - 31] = -x2;
+		vBuf[94 - n] = x1;	vBuf[n - 30] = -x1;
+		vBuf[93 - n] = x3;	vBuf[n - 29] = -x3;
+	}
+	vBuf[127] = -vBuf[0];
+	vBuf[32] = 0;
+
+	for (k = 0; k < 8; k++) {
+		n = 4*k;
+		x0 = zBuf[k];
+		x1 = zBuf[16 + k] + zBuf[16 + k + 1];
+		x3 = zBuf[48 + k] + zBuf[48 + k + 1];
+		x2 = zBuf[32 + k] + x3;
+		x3 = x3 + zBuf[32 + k + 1];
+		x0 = (x0 + 1) >> 1;	x1 = (x1 + 1) >> 1;	x2 = (x2 + 1) >> 1;	x3 = (x3 + 1) >> 1;
+		vBuf[95 - n] = x0;	vBuf[95 + n] = x0;
+		vBuf[94 - n] = x2;	vBuf[96 + n] = x2;
+		vBuf[93 - n] = x1;	vBuf[97 + n] = x1;
+		vBuf[92 - n] = x3;	vBuf[98 + n] = x3;
+	}
+
+	QMFSynthesisConvSel((int *)cTabS, delay, dIdx, outbuf, nChans);
 
 	*delayIdx = (*delayIdx == NUM_QMF_DELAY_BUFS - 1 ? 0 : *delayIdx + 1);
 }
@@ -78,6 +78,7 @@
 #define Dequantize				STATNAME(Dequantize)
 #define StereoProcess			STATNAME(StereoProcess)
 #define DeinterleaveShortBlocks	STATNAME(DeinterleaveShortBlocks)
+#define AddStageTime			STATNAME(AddStageTime)
 #define PNS						STATNAME(PNS)
 #define TNSFilter				STATNAME(TNSFilter)
 #define IMDCT					STATNAME(IMDCT)
@@ -86,6 +87,7 @@
 #define DecodeSBRBitstream		STATNAME(DecodeSBRBitstream)
 #define DecodeSBRData			STATNAME(DecodeSBRData)
 #define FreeSBR					STATNAME(FreeSBR)
+#define GetSBRMemSize			STATNAME(GetSBRMemSize)
 #define FlushCodecSBR			STATNAME(FlushCodecSBR)
 
 /* global ROM tables */
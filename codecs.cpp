@@ -43,6 +43,7 @@
 #include "SD.h"
 
 int lastError = ERR_CODEC_NONE;
+AudioCodecEvent codecEvents[CODEC_EVENTS];
 
 //upgrade original audiointerrupt if needed (hackish...)
 void init_interrupt()
@@ -79,6 +80,76 @@ size_t fillReadBuffer(File file, uint8_t *sd_buf, uint8_t *data, size_t dataLeft
 	return read;
 }
 
+// SD input ring
+void readRingInit(AudioCodecRing *ring, uint8_t *buf, size_t pre, size_t size)
+{
+	ring->start = buf + pre;
+	ring->size = size;
+	ring->pre = pre;
+	ring->rd = ring->start;
+	ring->wr = ring->start;
+	ring->left = 0;
+}
+
+size_t fillReadRing(File file, AudioCodecRing *ring)
+{
+	uint8_t *end = ring->start + ring->size;
+	size_t read = 0;
+
+	if (ring->left == 0) {
+		//empty, start over for the longest contiguous run
+		ring->rd = ring->start;
+		ring->wr = ring->start;
+	}
+
+	//bytes in the ring itself, the spare bytes in front of it don't count
+	size_t used = ring->left;
+	if (ring->rd < ring->start) used -= ring->start - ring->rd;
+	size_t spaceLeft = ring->size - used;
+
+	while (spaceLeft > 0) {
+		size_t chunk = end - ring->wr;
+		if (chunk > spaceLeft) chunk = spaceLeft;
+		size_t n = file.read(ring->wr, chunk);
+		ring->wr += n;
+		if (ring->wr == end) ring->wr = ring->start;
+		ring->left += n;
+		read += n;
+		spaceLeft -= n;
+		if (n < chunk) break;	//EOF
+	}
+
+	return read;
+}
+
+size_t readRingContiguous(AudioCodecRing *ring, size_t want)
+{
+	uint8_t *end = ring->start + ring->size;
+	size_t tail = end - ring->rd;
+
+	if (ring->rd < ring->start) return ring->left;	//moved already
+	if (tail >= ring->left) {
+		//no wrap: enough, or the end of the file. Move that too, so the
+		//decoder can't read beyond the buffer while it checks a header.
+		if (ring->left >= want) return ring->left;
+		tail = ring->left;
+		ring->wr = ring->start;
+	} else if (tail >= want) return tail;
+
+	//move the rest up to the end of the ring in front of its start, the
+	//wrapped part continues right behind it (tail < want <= pre)
+	memcpy(ring->start - tail, ring->rd, tail);
+	ring->rd = ring->start - tail;
+	return ring->left;
+}
+
+void readRingSkip(AudioCodecRing *ring, size_t n)
+{
+	ring->rd += n;
+	ring->left -= n;
+	if (ring->rd == ring->start + ring->size) ring->rd = ring->start;
+}
+
 //read big endian 16-Bit from fileposition(position)
 uint16_t fread16(File file, size_t position)
 {
@@ -121,8 +192,68 @@ size_t skipID3(uint8_t *sd_buf)
 	else return 0;
 }
 
+void histogramAdd(AudioCodecHistogram *h, uint32_t cycles)
+{
+	int n = 0;
+	if (cycles >= (1u << CODEC_HIST_MIN_LOG2)) {
+		int lg = 31 - __builtin_clz(cycles);
+		n = 1 + 2 * (lg - CODEC_HIST_MIN_LOG2) + ((cycles >> (lg - 1)) & 1);
+		if (n > CODEC_HIST_BUCKETS - 1) n = CODEC_HIST_BUCKETS - 1;
+	}
+	h->bucket[n]++;
+	h->count++;
+	if (cycles > h->max) h->max = cycles;
+}
+
+uint32_t histogramBucketCycles(int bucket)
+{
+	if (bucket <= 0) return 0;
+	uint32_t c = 1u << (CODEC_HIST_MIN_LOG2 + (bucket - 1) / 2);
+	if (!(bucket & 1)) c += c >> 1;
+	return c;
+}
+
+//called from update() or decode()
+void codecEvent(int event, uint32_t frame)
+{
+	codecEvents[event].count++;
+	codecEvents[event].millis = millis();
+	codecEvents[event].frame = frame;
+}
+
+#ifndef __arm__
+//C version of memcpy_frominterleaved.S, for host builds
+void memcpy_frominterleaved(short *dst1, short *dst2, short *src)
+{
+	for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+		dst1[i] = src[2 * i];
+		dst2[i] = src[2 * i + 1];
+	}
+}
+#endif
+
 int	AudioCodec::getLastError(void)
 {
 	return lastError;
 }
 
+void AudioCodec::getEvents(AudioCodecEvent *events)
+{
+	__disable_irq();
+	memcpy(events, codecEvents, sizeof(codecEvents));
+	__enable_irq();
+}
+
+uint32_t AudioCodec::getEventCount(int event)
+{
+	if (event < 0 || event >= CODEC_EVENTS) return 0;
+	return codecEvents[event].count;
+}
+
+void AudioCodec::resetEvents(void)
+{
+	__disable_irq();
+	memset(codecEvents, 0, sizeof(codecEvents));
+	__enable_irq();
+}
+
@@ -36,7 +36,7 @@
 
  */
 
-#ifndef __MK20DX256__
+#if !defined(__MK20DX256__) && !defined(AUDIOCODECS_HOST)
 #error	This platform is not supported.
 #endif
 
@@ -60,9 +60,11 @@
 
 #define AUDIOCODECS_SAMPLE_RATE			(((int)(AUDIO_SAMPLE_RATE / 100)) * 100) //44100
 
+#ifndef AUDIOCODECS_HOST	//the host stand-in (extras/host) emulates these
 #define NVIC_STIR			(*(volatile uint32_t *)0xE000EF00) //Software Trigger Interrupt Register
 #define NVIC_TRIGGER_INTERRUPT(x)    NVIC_STIR=(x)
 #define NVIC_IS_ACTIVE(n)	(*((volatile uint32_t *)0xE000E300 + ((n) >> 5)) & (1 << ((n) & 31)))
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -74,8 +76,56 @@ void memcpy_frominterleaved(short *dst1, short *dst2, short *src);
 
 extern int lastError;
 
+//Log-scale histogram of cycles, two buckets per octave:
+//bucket 0 counts everything below 2^CODEC_HIST_MIN_LOG2 cycles, bucket n>0 starts at
+//2^(CODEC_HIST_MIN_LOG2 + (n-1)/2), times 1.5 for even n. The last bucket is open-ended.
+#define CODEC_HIST_BUCKETS		32
+#define CODEC_HIST_MIN_LOG2		10
+
+typedef struct _AudioCodecHistogram {
+	uint32_t bucket[CODEC_HIST_BUCKETS];
+	uint32_t count;
+	uint32_t max;
+} AudioCodecHistogram;
+
+void histogramAdd(AudioCodecHistogram *h, uint32_t cycles);
+uint32_t histogramBucketCycles(int bucket);	//lower bound of a bucket in cycles
+
+//Playback events, counted by the players, see AudioCodec::getEvents()
+#define CODEC_EVENT_UNDERRUN		0	//update() found no decoded samples to play
+#define CODEC_EVENT_LATE			1	//a frame was decoded after an underrun, i.e. too late
+#define CODEC_EVENT_SKIPPED			2	//update() did not transmit an audio block
+#define CODEC_EVENT_ALLOCATE		3	//allocate() returned no audio block
+#define CODEC_EVENT_DECODE_ERROR	4	//the decoder returned an error (or dropped a frame)
+#define CODEC_EVENTS				5
+
+typedef struct _AudioCodecEvent {
+	uint32_t count;
+	uint32_t millis;	//time of the last event
+	uint32_t frame;		//number of frames decoded so far at the last event
+} AudioCodecEvent;
+
+extern AudioCodecEvent codecEvents[CODEC_EVENTS];
+void codecEvent(int event, uint32_t frame);
+
+//SD input ring: the SD card writes into the free space, the decoder reads in place.
+//A frame which would cross the end of the ring is made contiguous by moving the
+//unread bytes before the end in front of the ring, into 'pre' spare bytes.
+typedef struct _AudioCodecRing {
+	uint8_t *start;		//of the ring, the spare bytes are below
+	size_t	size;
+	size_t	pre;
+	uint8_t *rd;		//next byte for the decoder, can be in the spare bytes
+	uint8_t *wr;		//next byte from the SD card
+	size_t	left;		//unread bytes, may wrap
+} AudioCodecRing;
+
 void init_interrupt();
 size_t fillReadBuffer(File file, uint8_t *sd_buf, uint8_t *data, size_t dataLeft, size_t sd_bufsize);
+void readRingInit(AudioCodecRing *ring, uint8_t *buf, size_t pre, size_t size);	//buf holds pre + size bytes
+size_t fillReadRing(File file, AudioCodecRing *ring);	//returns the bytes read, 0 at EOF
+size_t readRingContiguous(AudioCodecRing *ring, size_t want);	//unread bytes at ring->rd, at least want (<= pre) unless near EOF
+void readRingSkip(AudioCodecRing *ring, size_t n);	//n <= readRingContiguous()
 uint16_t fread16(File file, size_t position);
 uint32_t fread32(File file, size_t position);
 size_t skipID3(uint8_t *sd_buf);
@@ -85,6 +135,9 @@ class AudioCodec : public AudioStream
 public:
 	AudioCodec(void) : AudioStream(0, NULL) {};
 	int	getLastError(void);
+	void getEvents(AudioCodecEvent *events);	//copies all CODEC_EVENTS entries, kept across tracks
+	uint32_t getEventCount(int event);
+	void resetEvents(void);
 protected:
 
 };
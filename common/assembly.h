@@ -426,6 +426,12 @@ static inline Word64 MADD64(Word64 sum64, int x, int y)
 	return u.w64;
 }
 
+//Cycle counter (ARM_DWT_CYCCNT), time base of the optional decoder statistics
+static inline unsigned int CYCLES(void)
+{
+	return *(volatile unsigned int *)0xE0001004;
+}
+
 /* toolchain:           x86 gcc
  * target architecture: x86
  */
@@ -500,6 +506,49 @@ static __inline Word64 MADD64(Word64 sum64, int x, int y)
 	return sum64;
 }
 
+static __inline Word64 SAR64(Word64 x, int n)
+{
+	return x >> n;
+}
+
+/* portable versions of the helpers the ARM gcc section adds (host builds) */
+#define CLIP_2N(y, n) { \
+	int sign = (y) >> 31;  \
+	if (sign != (y) >> (n))  { \
+		(y) = sign ^ ((1 << (n)) - 1); \
+	} \
+}
+
+#define CLIP_2N_SHIFT(y, n) {                   \
+        int sign = (y) >> 31;                   \
+        if (sign != (y) >> (30 - (n)))  {       \
+            (y) = sign ^ (0x3fffffff);          \
+        } else {                                \
+            (y) = (y) << (n);                   \
+        }                                       \
+    }
+
+//Reverse byte order (16 bit)
+static __inline unsigned int REV16(unsigned int value)
+{
+	return ((value & 0x00ff00ff) << 8) | ((value >> 8) & 0x00ff00ff);
+}
+
+//Reverse byte order (32 bit)
+static __inline unsigned int REV32(unsigned int value)
+{
+	return __builtin_bswap32(value);
+}
+
+//Time base of the optional decoder statistics, nanoseconds on the host
+#include <time.h>
+static __inline unsigned int CYCLES(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned int)(ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
 #elif defined(__GNUC__) && (defined(__powerpc__) || defined(__POWERPC__)) || (defined (_SOLARIS) && !defined (__GNUC__) && !defined (_SOLARISX86))
 
 typedef long long Word64;
@@ -0,0 +1,53 @@
+/* stack high-water mark of the decoders, see MP3_STACK_STATS / AAC_STACK_STATS
+ *
+ * StackPaint() fills STACK_PAINT_BYTES of the free stack below the caller with a
+ * pattern, StackDepth() - called from the same function after the decode - finds
+ * the lowest word that was overwritten and returns the depth in bytes, relative to
+ * the caller's stack pointer. Interrupts arriving in between are counted too,
+ * they use the same stack.
+ *
+ * At least STACK_PAINT_BYTES must be free below the stack pointer - on Teensy the
+ * heap grows towards the stack, so keep this off for normal use.
+ */
+
+#ifndef _STACKPAINT_H
+#define _STACKPAINT_H
+
+#ifndef STACK_PAINT_BYTES
+#define STACK_PAINT_BYTES	4096
+#endif
+#define STACK_PAINT_SKIP	256			/* frame of StackPaint itself (and x86 red zone) */
+#define STACK_PAINT_PATTERN	0xdeadbeef
+
+#if defined(__GNUC__)
+#define STACK_NOINLINE	__attribute__((noinline))
+#else
+#define STACK_NOINLINE
+#endif
+
+static STACK_NOINLINE void StackPaint(void)
+{
+	volatile unsigned int marker;
+	unsigned long sp = (unsigned long)&marker;
+	volatile unsigned int *p = (volatile unsigned int *)(sp - STACK_PAINT_BYTES);
+	volatile unsigned int *end = (volatile unsigned int *)(sp - STACK_PAINT_SKIP);
+
+	while (p < end)
+		*p++ = STACK_PAINT_PATTERN;
+}
+
+static STACK_NOINLINE int StackDepth(void)
+{
+	volatile unsigned int marker;
+	unsigned long sp = (unsigned long)&marker;
+	volatile unsigned int *p = (volatile unsigned int *)(sp - STACK_PAINT_BYTES);
+	volatile unsigned int *end = (volatile unsigned int *)(sp - STACK_PAINT_SKIP);
+
+	/* a result of STACK_PAINT_BYTES means: at least that much, increase it */
+	while (p < end && *p == STACK_PAINT_PATTERN)
+		p++;
+
+	return (int)(sp - (unsigned long)p);
+}
+
+#endif	/* _STACKPAINT_H */
@@ -0,0 +1,131 @@
+/*
+	Helix library Arduino interface - host stand-in for the Teensy core
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* Single threaded NVIC model: an interrupt runs when it is triggered and
+    more urgent (lower priority value) than whatever is executing at the
+    moment, otherwise it stays pending until the running handler returns.
+    That is enough to reproduce update() -> IRQ_AUDIOCODEC chaining. */
+
+#include "Arduino.h"
+#include <time.h>
+
+void (* _VectorsRam[NVIC_NUM_INTERRUPTS + 16])(void);
+
+static uint8_t	nvic_prio[NVIC_NUM_INTERRUPTS];
+static uint8_t	nvic_enabled[NVIC_NUM_INTERRUPTS];
+static uint8_t	nvic_pending[NVIC_NUM_INTERRUPTS];
+static uint8_t	nvic_active[NVIC_NUM_INTERRUPTS];
+static int		exec_prio = 256;	//thread mode
+
+static bool		prio_init;
+
+static void nvic_init(void)
+{
+	if (prio_init) return;
+	memset(nvic_prio, 128, sizeof(nvic_prio));	//Teensyduino default
+	prio_init = true;
+}
+
+uint64_t host_nanos(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+uint32_t host_cyccnt(void)
+{
+	return (uint32_t)(host_nanos() * (F_CPU / 1000000) / 1000);
+}
+
+void host_nvic_set_priority(int irq, int prio)
+{
+	nvic_init();
+	nvic_prio[irq] = prio;
+}
+
+int host_nvic_get_priority(int irq)
+{
+	nvic_init();
+	return nvic_prio[irq];
+}
+
+void host_nvic_enable_irq(int irq)
+{
+	nvic_enabled[irq] = 1;
+	host_nvic_service();
+}
+
+void host_nvic_disable_irq(int irq)
+{
+	nvic_enabled[irq] = 0;
+}
+
+int host_nvic_is_active(int irq)
+{
+	return nvic_active[irq];
+}
+
+void host_nvic_trigger(int irq)
+{
+	nvic_pending[irq] = 1;
+	host_nvic_service();
+}
+
+//run pending interrupts which would preempt the current execution priority
+void host_nvic_service(void)
+{
+	nvic_init();
+	for (;;) {
+		int irq = -1;
+		for (int i = 0; i < NVIC_NUM_INTERRUPTS; i++) {
+			if (nvic_pending[i] && nvic_enabled[i] && !nvic_active[i] && _VectorsRam[i + 16] &&
+				nvic_prio[i] < exec_prio && (irq < 0 || nvic_prio[i] < nvic_prio[irq]))
+				irq = i;
+		}
+		if (irq < 0) return;
+
+		int prev_prio = exec_prio;
+		nvic_pending[irq] = 0;
+		nvic_active[irq] = 1;
+		exec_prio = nvic_prio[irq];
+		_VectorsRam[irq + 16]();
+		exec_prio = prev_prio;
+		nvic_active[irq] = 0;
+	}
+}
@@ -0,0 +1,98 @@
+/*
+	Helix library Arduino interface - host (x86-64 Linux) stand-in for the Teensy core
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* Only what codecs.h, play_sd_mp3.cpp and play_sd_aac.cpp need from the Teensy core:
+    NVIC, the RAM vector table, the DWT cycle counter and a few helpers.
+    The cycle counter runs at F_CPU, derived from CLOCK_MONOTONIC.
+    Build everything with -DAUDIOCODECS_HOST and -I extras/host. */
+
+#ifndef host_arduino_h_
+#define host_arduino_h_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef F_CPU
+#define F_CPU					96000000	//Teensy 3.1 default
+#endif
+
+#define NVIC_NUM_INTERRUPTS		95
+#define IRQ_SOFTWARE			94			//used by AudioStream::update_all()
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern void (* _VectorsRam[NVIC_NUM_INTERRUPTS + 16])(void);
+
+uint32_t host_cyccnt(void);
+uint64_t host_nanos(void);
+
+void host_nvic_set_priority(int irq, int prio);
+int  host_nvic_get_priority(int irq);
+void host_nvic_enable_irq(int irq);
+void host_nvic_disable_irq(int irq);
+void host_nvic_trigger(int irq);
+int  host_nvic_is_active(int irq);
+void host_nvic_service(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define ARM_DWT_CYCCNT				(host_cyccnt())
+
+#define NVIC_SET_PRIORITY(irq, prio)	host_nvic_set_priority((irq), (prio))
+#define NVIC_GET_PRIORITY(irq)		host_nvic_get_priority(irq)
+#define NVIC_ENABLE_IRQ(irq)		host_nvic_enable_irq(irq)
+#define NVIC_DISABLE_IRQ(irq)		host_nvic_disable_irq(irq)
+#define NVIC_SET_PENDING(irq)		host_nvic_trigger(irq)
+#define NVIC_TRIGGER_INTERRUPT(irq)	host_nvic_trigger(irq)
+#define NVIC_IS_ACTIVE(irq)			host_nvic_is_active(irq)
+
+//single threaded: "interrupts" only run from host_nvic_service(), nothing to mask
+#define __disable_irq()				do {} while (0)
+#define __enable_irq()				do {} while (0)
+
+static inline uint32_t millis(void) { return (uint32_t)(host_nanos() / 1000000); }
+static inline uint32_t micros(void) { return (uint32_t)(host_nanos() / 1000); }
+
+#endif
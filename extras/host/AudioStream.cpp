@@ -0,0 +1,177 @@
+/*
+	Helix library Arduino interface - host stand-in for the Teensy AudioStream
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+#include "AudioStream.h"
+
+audio_block_t **	AudioStream::memory_pool;
+unsigned int		AudioStream::memory_pool_size;
+unsigned int		AudioStream::memory_pool_free;
+uint16_t			AudioStream::memory_used;
+uint16_t			AudioStream::memory_used_max;
+uint16_t			AudioStream::cpu_cycles_total;
+uint16_t			AudioStream::cpu_cycles_total_max;
+AudioStream *		AudioStream::first_update;
+
+AudioStream::AudioStream(unsigned char ninput, audio_block_t **iqueue) :
+	num_inputs(ninput), inputQueue(iqueue)
+{
+	active = false;
+	destination_list = NULL;
+	for (int i = 0; i < num_inputs; i++) inputQueue[i] = NULL;
+	cpu_cycles = 0;
+	cpu_cycles_max = 0;
+
+	next_update = NULL;
+	if (first_update == NULL) {
+		first_update = this;
+	} else {
+		AudioStream *p;
+		for (p = first_update; p->next_update; p = p->next_update) ;
+		p->next_update = this;
+	}
+}
+
+void AudioStream::initialize_memory(audio_block_t *data, unsigned int num)
+{
+	free(memory_pool);
+	memory_pool = (audio_block_t **) malloc(num * sizeof(audio_block_t *));
+	for (unsigned int i = 0; i < num; i++) {
+		data[i].ref_count = 0;
+		data[i].memory_pool_index = i;
+		memory_pool[i] = &data[i];
+	}
+	memory_pool_size = num;
+	memory_pool_free = num;
+	memory_used = 0;
+	memory_used_max = 0;
+
+	_VectorsRam[IRQ_SOFTWARE + 16] = software_isr;
+	NVIC_SET_PRIORITY(IRQ_SOFTWARE, 208);
+	NVIC_ENABLE_IRQ(IRQ_SOFTWARE);
+}
+
+audio_block_t * AudioStream::allocate(void)
+{
+	if (memory_pool_free == 0) return NULL;
+	audio_block_t *block = memory_pool[--memory_pool_free];
+	block->ref_count = 1;
+	memory_used = memory_pool_size - memory_pool_free;
+	if (memory_used > memory_used_max) memory_used_max = memory_used;
+	return block;
+}
+
+void AudioStream::release(audio_block_t *block)
+{
+	if (--block->ref_count > 0) return;
+	memory_pool[memory_pool_free++] = block;
+	memory_used = memory_pool_size - memory_pool_free;
+}
+
+void AudioStream::transmit(audio_block_t *block, unsigned char index)
+{
+	for (AudioConnection *c = destination_list; c != NULL; c = c->next_dest) {
+		if (c->src_index == index) {
+			if (c->dst.inputQueue[c->dest_index] == NULL) {
+				c->dst.inputQueue[c->dest_index] = block;
+				block->ref_count++;
+			}
+		}
+	}
+}
+
+audio_block_t * AudioStream::receiveReadOnly(unsigned int index)
+{
+	if (index >= num_inputs) return NULL;
+	audio_block_t *in = inputQueue[index];
+	inputQueue[index] = NULL;
+	return in;
+}
+
+audio_block_t * AudioStream::receiveWritable(unsigned int index)
+{
+	audio_block_t *in = receiveReadOnly(index);
+	if (in && in->ref_count > 1) {
+		audio_block_t *p = allocate();
+		if (p) memcpy(p->data, in->data, sizeof(p->data));
+		in->ref_count--;
+		in = p;
+	}
+	return in;
+}
+
+AudioConnection::AudioConnection(AudioStream &source, unsigned char sourceOutput,
+	AudioStream &destination, unsigned char destinationInput) :
+	src(source), dst(destination), src_index(sourceOutput), dest_index(destinationInput)
+{
+	next_dest = NULL;
+	if (src.destination_list == NULL) {
+		src.destination_list = this;
+	} else {
+		AudioConnection *p;
+		for (p = src.destination_list; p->next_dest; p = p->next_dest) ;
+		p->next_dest = this;
+	}
+	src.active = true;
+	dst.active = true;
+}
+
+//one audio block period: IRQ_SOFTWARE, followed by any interrupt it chained
+void AudioStream::update_all(void)
+{
+	NVIC_SET_PENDING(IRQ_SOFTWARE);
+}
+
+void software_isr(void)
+{
+	uint32_t totalcycles = ARM_DWT_CYCCNT;
+
+	for (AudioStream *p = AudioStream::first_update; p; p = p->next_update) {
+		if (p->active) {
+			uint32_t cycles = ARM_DWT_CYCCNT;
+			p->update();
+			cycles = (ARM_DWT_CYCCNT - cycles) >> 4;
+			p->cpu_cycles = cycles;
+			if (cycles > p->cpu_cycles_max) p->cpu_cycles_max = cycles;
+		}
+	}
+
+	totalcycles = (ARM_DWT_CYCCNT - totalcycles) >> 4;
+	AudioStream::cpu_cycles_total = totalcycles;
+	if (totalcycles > AudioStream::cpu_cycles_total_max)
+		AudioStream::cpu_cycles_total_max = totalcycles;
+}
@@ -0,0 +1,136 @@
+/*
+	Helix library Arduino interface - host stand-in for the Teensy AudioStream
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* Same interface as the Teensy Audio library's AudioStream, minus the parts
+    the players don't use. update_all() plays the role of the IRQ_SOFTWARE
+    audio interrupt: it calls update() of every object, then runs whatever
+    lower priority interrupt (e.g. IRQ_AUDIOCODEC) has been triggered. */
+
+#ifndef host_audiostream_h_
+#define host_audiostream_h_
+
+#include "Arduino.h"
+
+#define AUDIO_BLOCK_SAMPLES		128
+#define AUDIO_SAMPLE_RATE_EXACT	44117.64706
+#define AUDIO_SAMPLE_RATE		AUDIO_SAMPLE_RATE_EXACT
+
+class AudioStream;
+class AudioConnection;
+
+void software_isr(void);
+
+typedef struct audio_block_struct {
+	unsigned char ref_count;
+	unsigned char memory_pool_index;
+	unsigned char reserved1;
+	unsigned char reserved2;
+	int16_t data[AUDIO_BLOCK_SAMPLES];
+} audio_block_t;
+
+class AudioConnection
+{
+public:
+	AudioConnection(AudioStream &source, unsigned char sourceOutput,
+		AudioStream &destination, unsigned char destinationInput);
+protected:
+	AudioStream &src;
+	AudioStream &dst;
+	unsigned char src_index;
+	unsigned char dest_index;
+	AudioConnection *next_dest;
+	friend class AudioStream;
+};
+
+#define AudioMemory(num) ({ \
+	static audio_block_t data[num]; \
+	AudioStream::initialize_memory(data, num); \
+})
+
+#define CYCLE_COUNTER_APPROX_PERCENT(n) (((n) + (F_CPU / 32 / AUDIO_SAMPLE_RATE * AUDIO_BLOCK_SAMPLES / 100)) / (F_CPU / 16 / AUDIO_SAMPLE_RATE * AUDIO_BLOCK_SAMPLES / 100))
+
+#define AudioProcessorUsage() (CYCLE_COUNTER_APPROX_PERCENT(AudioStream::cpu_cycles_total))
+#define AudioProcessorUsageMax() (CYCLE_COUNTER_APPROX_PERCENT(AudioStream::cpu_cycles_total_max))
+#define AudioProcessorUsageMaxReset() (AudioStream::cpu_cycles_total_max = AudioStream::cpu_cycles_total)
+#define AudioMemoryUsage() (AudioStream::memory_used)
+#define AudioMemoryUsageMax() (AudioStream::memory_used_max)
+#define AudioMemoryUsageMaxReset() (AudioStream::memory_used_max = AudioStream::memory_used)
+
+class AudioStream
+{
+public:
+	AudioStream(unsigned char ninput, audio_block_t **iqueue);
+	virtual ~AudioStream() {}
+
+	static void initialize_memory(audio_block_t *data, unsigned int num);
+	static void update_all(void);
+
+	int processorUsage(void) { return CYCLE_COUNTER_APPROX_PERCENT(cpu_cycles); }
+	int processorUsageMax(void) { return CYCLE_COUNTER_APPROX_PERCENT(cpu_cycles_max); }
+	void processorUsageMaxReset(void) { cpu_cycles_max = cpu_cycles; }
+
+	uint16_t cpu_cycles;
+	uint16_t cpu_cycles_max;
+	static uint16_t cpu_cycles_total;
+	static uint16_t cpu_cycles_total_max;
+	static uint16_t memory_used;
+	static uint16_t memory_used_max;
+
+protected:
+	bool active;
+	unsigned char num_inputs;
+	static audio_block_t * allocate(void);
+	static void release(audio_block_t * block);
+	void transmit(audio_block_t *block, unsigned char index = 0);
+	audio_block_t * receiveReadOnly(unsigned int index = 0);
+	audio_block_t * receiveWritable(unsigned int index = 0);
+	friend class AudioConnection;
+	friend void software_isr(void);
+
+private:
+	AudioConnection *destination_list;
+	audio_block_t **inputQueue;
+	AudioStream *next_update;
+	virtual void update(void) = 0;
+	static AudioStream *first_update;
+	static audio_block_t **memory_pool;
+	static unsigned int memory_pool_size;
+	static unsigned int memory_pool_free;
+};
+
+#endif
@@ -0,0 +1,122 @@
+/*
+	Helix library Arduino interface - host stand-in for the SD library
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+#include "SD.h"
+
+SDClass SD;
+
+File::File(FILE *f) : fp(f), fsize(0)
+{
+	if (fp) {
+		fseek(fp, 0, SEEK_END);
+		fsize = ftell(fp);
+		fseek(fp, 0, SEEK_SET);
+	}
+}
+
+int File::read(void)
+{
+	if (!fp) return -1;
+	return fgetc(fp);
+}
+
+int File::read(void *buf, uint32_t nbyte)
+{
+	if (!fp) return -1;
+	return fread(buf, 1, nbyte, fp);
+}
+
+int File::available(void)
+{
+	if (!fp) return 0;
+	return fsize - position();
+}
+
+bool File::seek(uint32_t pos)
+{
+	if (!fp || pos > fsize) return false;
+	return fseek(fp, pos, SEEK_SET) == 0;
+}
+
+uint32_t File::position(void)
+{
+	if (!fp) return 0;
+	return ftell(fp);
+}
+
+void File::close(void)
+{
+	if (fp) fclose(fp);
+	fp = NULL;
+}
+
+bool SDClass::begin(uint8_t /*csPin*/)
+{
+	root[0] = 0;
+	return true;
+}
+
+bool SDClass::begin(const char *rootdir)
+{
+	snprintf(root, sizeof(root), "%s", rootdir ? rootdir : "");
+	return true;
+}
+
+void SDClass::path(char *out, size_t n, const char *filepath)
+{
+	if (root[0] && filepath[0] != '/')
+		snprintf(out, n, "%s/%s", root, filepath);
+	else
+		snprintf(out, n, "%s", filepath);
+}
+
+File SDClass::open(const char *filepath, uint8_t /*mode*/)
+{
+	char p[1024];
+	path(p, sizeof(p), filepath);
+	return File(fopen(p, "rb"));
+}
+
+bool SDClass::exists(const char *filepath)
+{
+	char p[1024];
+	path(p, sizeof(p), filepath);
+	FILE *f = fopen(p, "rb");
+	if (f) fclose(f);
+	return f != NULL;
+}
@@ -0,0 +1,86 @@
+/*
+	Helix library Arduino interface - host stand-in for the SD library
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* File/SD backed by stdio. Like the real SD library, File is a shallow
+    handle: copies share the position, close() ends all of them.
+    Paths are relative to the directory given to SD.begin(). */
+
+#ifndef host_sd_h_
+#define host_sd_h_
+
+#include "Arduino.h"
+#include <stdio.h>
+
+#define FILE_READ	0
+
+class File
+{
+public:
+	File(void) : fp(NULL), fsize(0) {}
+	File(FILE *f);
+
+	int read(void);
+	int read(void *buf, uint32_t nbyte);
+	int available(void);
+	bool seek(uint32_t pos);
+	uint32_t position(void);
+	uint32_t size(void) { return fsize; }
+	void close(void);
+	operator bool() { return fp != NULL; }
+
+private:
+	FILE		*fp;
+	uint32_t	fsize;
+};
+
+class SDClass
+{
+public:
+	bool begin(uint8_t csPin = 0);
+	bool begin(const char *rootdir);
+	File open(const char *filepath, uint8_t mode = FILE_READ);
+	bool exists(const char *filepath);
+
+private:
+	void path(char *out, size_t n, const char *filepath);
+	char root[512];
+};
+
+extern SDClass SD;
+
+#endif
@@ -0,0 +1,795 @@
+/*
+	Helix library Arduino interface - synthetic AAC-LC and HE-AAC streams for the host tools
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* see aacsynth.h
+    Links against the decoder of aac.cpp, built with AAC_ENABLE_SBR, which checks each frame. */
+
+#include <string.h>
+
+#include "aac/coder.h"
+#include "aac/sbr.h"
+#include "aacsynth.h"
+
+#define SYNTH_ATTEMPTS	8	// draws per frame, each with half the scalefactor bands and fewer envelopes
+
+// field layout of the codebook symbols, as in huffman.c
+#define GET_QUAD_SIGNBITS(v)	(((unsigned int)(v) << 17) >> 29)
+#define GET_PAIR_SIGNBITS(v)	(((unsigned int)(v) << 20) >> 30)
+#define GET_ESC_SIGNBITS(v)		(((unsigned int)(v) << 18) >> 30)
+#define GET_ESC_Y(v)			(((signed int)(v) << 20) >>   26)
+#define GET_ESC_Z(v)			(((signed int)(v) << 26) >>   26)
+
+struct aacBitWriter {
+	std::vector<uint8_t>	buf;
+	int						bits;
+};
+
+static void putBits(aacBitWriter &w, uint32_t val, int n)
+{
+	while (n--) {
+		if ((w.bits >> 3) == (int)w.buf.size()) w.buf.push_back(0);
+		if ((val >> n) & 1) w.buf[w.bits >> 3] |= 0x80 >> (w.bits & 7);
+		w.bits++;
+	}
+}
+
+static void byteAlign(aacBitWriter &w)
+{
+	while (w.bits & 7) putBits(w, 0, 1);
+}
+
+// xorshift32, as in kernelbench.h
+static uint32_t synthRandom(uint32_t &x)
+{
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+
+static int synthRange(uint32_t &x, int n)
+{
+	return (int)(synthRandom(x) % (uint32_t)n);
+}
+
+// a codeword drawn the way the decoder reads one: 32 random bits, of which it takes the first n
+static int synthCode(uint32_t &x, const signed short *tab, const HuffInfo *info, uint32_t *code, int *val)
+{
+	uint32_t r = synthRandom(x);
+	int n = DecodeHuffmanScalar(tab, info, r, val);
+	*code = r >> (32 - n);
+	return n;
+}
+
+// Huffman coded difference to prev, drawn again until prev + (difference << shift) lies in [lo, hi]
+static int putDelta(aacBitWriter &w, uint32_t &x, const signed short *tab, const HuffInfo *info, int prev, int shift, int lo, int hi)
+{
+	uint32_t code;
+	int n, val;
+	do n = synthCode(x, tab, info, &code, &val); while (prev + val * (1 << shift) < lo || prev + val * (1 << shift) > hi);
+	putBits(w, code, n);
+	return prev + val * (1 << shift);
+}
+
+/* ---- AAC core (14496-3, 4.4.2) ---- */
+
+struct synthICS {
+	int		winSequence, winShape, maxSFB, sfGroup;
+	int		numWinGroup, winGroupLen[MAX_WIN_GROUPS];
+};
+
+// long (0), start (1), short (2) and stop (3) windows, a short run always opens with start and closes with stop
+static int synthWinSequence(uint32_t &x, int windows, int prev)
+{
+	if (!(windows & AAC_SYNTH_SHORT)) return 0;
+	if (!(windows & AAC_SYNTH_LONG)) return 2;
+	int toShort = (synthRange(x, 3) == 0);
+	if (prev == 0 || prev == 3) return (toShort ? 1 : 0);
+	return (toShort ? 2 : 3);
+}
+
+// shift > 0 codes only the lower 1/2^shift of the scalefactor bands, for frames that came out too large
+static void synthICSInfo(uint32_t &x, int srIdx, int winSequence, int shift, synthICS &ics)
+{
+	int total = (winSequence == 2 ? sfBandTotalShort[srIdx] : sfBandTotalLong[srIdx]) >> shift;
+
+	ics.winSequence = winSequence;
+	ics.winShape = synthRandom(x) & 1;
+	ics.maxSFB = total - synthRange(x, total / 2 + 1);
+	ics.sfGroup = (winSequence == 2 ? synthRandom(x) & 0x7f : 0);
+
+	//grouping as in DecodeICSInfo
+	ics.numWinGroup = 1;
+	ics.winGroupLen[0] = 1;
+	if (winSequence == 2) {
+		for (int mask = 0x40; mask; mask >>= 1) {
+			if (ics.sfGroup & mask) ics.winGroupLen[ics.numWinGroup - 1]++;
+			else ics.winGroupLen[ics.numWinGroup++] = 1;
+		}
+	}
+}
+
+static void packICSInfo(aacBitWriter &w, const synthICS &ics)
+{
+	putBits(w, 0, 1);		//icsResBit
+	putBits(w, ics.winSequence, 2);
+	putBits(w, ics.winShape, 1);
+	if (ics.winSequence == 2) {
+		putBits(w, ics.maxSFB, 4);
+		putBits(w, ics.sfGroup, 7);
+	} else {
+		putBits(w, ics.maxSFB, 6);
+		putBits(w, 0, 1);	//predictorDataPresent
+	}
+}
+
+// 1-11 spectral, 13 noise (PNS), 14/15 intensity, 0 zero
+static int synthCodebook(uint32_t &x, int tools, int isAllowed)
+{
+	int r = synthRange(x, 16);
+	if (r == 0) return 0;
+	if (r == 1 && (tools & AAC_SYNTH_PNS)) return 13;
+	if (r == 2 && isAllowed) return 14 + (synthRandom(x) & 1);
+	return 1 + synthRange(x, 11);
+}
+
+static void synthTNSFilter(aacBitWriter &w, uint32_t &x, int coefRes, int order, int orderBits)
+{
+	putBits(w, order, orderBits);
+	if (order) {
+		int compress = synthRandom(x) & 1;
+		putBits(w, synthRandom(x) & 1, 1);	//direction
+		putBits(w, compress, 1);
+		for (int i = 0; i < order; i++)
+			putBits(w, synthRandom(x), coefRes + 3 - compress);
+	}
+}
+
+// escape sequence for a 16 in codebook 11: n ones, a zero and 4 + n bits, for (1 << (4 + n)) + bits
+static void synthEscape(aacBitWriter &w, uint32_t &x)
+{
+	int n = (synthRange(x, 8) ? 0 : 1 + synthRange(x, 4));
+	putBits(w, (1 << n) - 1, n);
+	putBits(w, 0, 1);
+	putBits(w, synthRandom(x), 4 + n);
+}
+
+// nVals coefficients in the layout of UnpackQuads, UnpackPairsNoEsc and UnpackPairsEsc
+static void synthSpectrum(aacBitWriter &w, uint32_t &x, int cb, int nVals)
+{
+	const HuffInfo *info = &huffTabSpecInfo[cb - HUFFTAB_SPEC_OFFSET];
+
+	for (int i = 0; i < nVals; i += (cb <= 4 ? 4 : 2)) {
+		uint32_t code;
+		int val;
+		int n = synthCode(x, huffTabSpec, info, &code, &val);
+		putBits(w, code, n);
+		if (cb <= 4)		putBits(w, synthRandom(x), GET_QUAD_SIGNBITS(val));
+		else if (cb <= 10)	putBits(w, synthRandom(x), GET_PAIR_SIGNBITS(val));
+		else {
+			putBits(w, synthRandom(x), GET_ESC_SIGNBITS(val));
+			if (GET_ESC_Y(val) == 16) synthEscape(w, x);
+			if (GET_ESC_Z(val) == 16) synthEscape(w, x);
+		}
+	}
+}
+
+// individual_channel_stream() in the order of DecodeICS and DecodeSpectrumLong/Short
+static void synthChannel(aacBitWriter &w, uint32_t &x, const aacSynthParams &p, const synthICS &ics, int packInfo, int isAllowed)
+{
+	const short *sfbTab = (ics.winSequence == 2 ? sfBandTabShort + sfBandTabShortOffset[p.srIdx] : sfBandTabLong + sfBandTabLongOffset[p.srIdx]);
+	int sectLenBits = (ics.winSequence == 2 ? 3 : 5);
+	int sectEscapeVal = (1 << sectLenBits) - 1;
+	unsigned char cbs[MAX_SF_BANDS];
+	int globalGain = 100 + synthRange(x, 40);
+
+	putBits(w, globalGain, 8);
+	if (packInfo) packICSInfo(w, ics);
+
+	for (int g = 0; g < ics.numWinGroup; g++) {
+		for (int sfb = 0; sfb < ics.maxSFB; ) {
+			int len = 1 + synthRange(x, MIN(ics.maxSFB - sfb, 12));
+			int cb = synthCodebook(x, p.tools, isAllowed);
+			putBits(w, cb, 4);
+			for (int l = len; ; l -= sectEscapeVal) {
+				putBits(w, MIN(l, sectEscapeVal), sectLenBits);
+				if (l < sectEscapeVal) break;
+			}
+			while (len--) cbs[g * ics.maxSFB + sfb++] = cb;
+		}
+	}
+
+	//scalefactors stay within 40 below and 20 above the global gain, noise energies and intensity positions near 0
+	int sf = globalGain, nrg = globalGain - 90 - 256, is = 0, npf = 1;
+	for (int i = 0; i < ics.numWinGroup * ics.maxSFB; i++) {
+		if (cbs[i] == 14 || cbs[i] == 15) {
+			is = putDelta(w, x, huffTabScaleFact, &huffTabScaleFactInfo, is, 0, -30, 30);
+		} else if (cbs[i] == 13) {
+			if (npf) {
+				int first = 20 + synthRange(x, 40);
+				putBits(w, first - nrg, 9);
+				nrg = first;
+				npf = 0;
+			} else {
+				nrg = putDelta(w, x, huffTabScaleFact, &huffTabScaleFactInfo, nrg, 0, 20, 60);
+			}
+		} else if (cbs[i]) {
+			sf = putDelta(w, x, huffTabScaleFact, &huffTabScaleFactInfo, sf, 0, MAX(globalGain - 40, 0), MIN(globalGain + 20, 255));
+		}
+	}
+
+	int pulse = (ics.winSequence != 2 && ics.maxSFB > 0 && (p.tools & AAC_SYNTH_PULSE) && synthRange(x, 4) == 0);
+	putBits(w, pulse, 1);
+	if (pulse) {
+		int numPulse = 1 + synthRange(x, MAX_PULSES), startSFB;
+		do startSFB = synthRange(x, ics.maxSFB); while (sfbTab[startSFB] + numPulse * 31 >= NSAMPS_LONG);
+		putBits(w, numPulse - 1, 2);
+		putBits(w, startSFB, 6);
+		for (int i = 0; i < numPulse; i++) {
+			putBits(w, synthRange(x, 32), 5);
+			putBits(w, synthRange(x, 16), 4);
+		}
+	}
+
+	//filter orders up to tnsMaxOrderShort/Long of LC, lengths are clamped by the decoder
+	int tns = ((p.tools & AAC_SYNTH_TNS) && synthRange(x, 4) == 0);
+	putBits(w, tns, 1);
+	if (tns) {
+		if (ics.winSequence == 2) {
+			for (int win = 0; win < NWINDOWS_SHORT; win++) {
+				int numFilt = synthRandom(x) & 1;
+				putBits(w, numFilt, 1);
+				if (numFilt) {
+					int coefRes = synthRandom(x) & 1;
+					putBits(w, coefRes, 1);
+					putBits(w, synthRange(x, 16), 4);
+					synthTNSFilter(w, x, coefRes, synthRange(x, 8), 3);
+				}
+			}
+		} else {
+			int numFilt = synthRange(x, 4);
+			putBits(w, numFilt, 2);
+			if (numFilt) {
+				int coefRes = synthRandom(x) & 1;
+				putBits(w, coefRes, 1);
+				for (int f = 0; f < numFilt; f++) {
+					putBits(w, synthRange(x, 64), 6);
+					synthTNSFilter(w, x, coefRes, synthRange(x, 13), 5);
+				}
+			}
+		}
+	}
+	putBits(w, 0, 1);	//gainControlDataPresent
+
+	for (int g = 0; g < ics.numWinGroup; g++) {
+		for (int sfb = 0; sfb < ics.maxSFB; sfb++) {
+			int cb = cbs[g * ics.maxSFB + sfb];
+			if (cb >= 1 && cb <= 11)
+				for (int win = 0; win < ics.winGroupLen[g]; win++)
+					synthSpectrum(w, x, cb, sfbTab[sfb + 1] - sfbTab[sfb]);
+		}
+	}
+}
+
+// SCE or CPE with instance tag 0, both channels of a CPE switch windows together
+static void synthElement(aacBitWriter &w, uint32_t &x, const aacSynthParams &p, int winSequence, int shift)
+{
+	synthICS ics[2];
+
+	putBits(w, p.nChans == 1 ? AAC_ID_SCE : AAC_ID_CPE, NUM_SYN_ID_BITS);
+	putBits(w, 0, NUM_INST_TAG_BITS);
+	synthICSInfo(x, p.srIdx, winSequence, shift, ics[0]);
+	if (p.nChans == 1) {
+		synthChannel(w, x, p, ics[0], 1, 0);
+		return;
+	}
+
+	int commonWin = synthRandom(x) & 1;
+	putBits(w, commonWin, 1);
+	if (commonWin) {
+		packICSInfo(w, ics[0]);
+		int msMaskPresent = ((p.tools & AAC_SYNTH_MS) ? synthRange(x, 3) : 0);
+		putBits(w, msMaskPresent, 2);
+		if (msMaskPresent == 1)
+			for (int i = 0; i < ics[0].numWinGroup * ics[0].maxSFB; i++)
+				putBits(w, synthRandom(x), 1);
+		ics[1] = ics[0];
+	} else {
+		synthICSInfo(x, p.srIdx, winSequence, shift, ics[1]);
+	}
+	synthChannel(w, x, p, ics[0], !commonWin, 0);
+	synthChannel(w, x, p, ics[1], !commonWin, commonWin && (p.tools & AAC_SYNTH_IS));
+}
+
+/* ---- SBR (14496-3, 4.4.2.8) ---- */
+
+struct sbrChanState {
+	int		trail;			// trailing border of the last grid, in time slots
+	int		valid;			// the values below can be delta coded against (no reset since)
+	int		coupled, ampRes, freqRes;
+	int		env[MAX_QMF_BANDS];
+	int		noise[MAX_NUM_NOISE_FLOOR_BANDS];
+};
+
+struct sbrState {
+	SBRHeader		hdr;
+	SBRFreq			freq;
+	sbrChanState	ch[MAX_NCHANS_ELEM];
+};
+
+struct sbrGridDraw {
+	int		frameClass, numEnv, ampResFrame, pointer, freqRes[MAX_NUM_ENV];
+	int		abs0, abs1, numRel0, numRel1, rel0[3], rel1[3];	// relative borders as coded, 2*rel + 2 time slots
+	int		numNoiseFloors, trail;
+};
+
+/* cLog2[i] = ceil(log2(i)), as in sbrside.c */
+static const unsigned char cLog2[9] = {0, 0, 1, 2, 2, 3, 3, 3, 3};
+
+/* random header whose frequency tables stay inside the limits of 4.6.18.3.6 and the decoder's arrays,
+ * with prev the start or stop frequency changes so the decoder resets
+ */
+static void synthHeader(uint32_t &x, int sampRateIdx, const SBRHeader *prev, SBRHeader &h, SBRFreq &f)
+{
+	int maxBands = (sampRateIdx <= 3 ? 32 : sampRateIdx == 4 ? 35 : 48);
+
+	for (;;) {
+		memset(&h, 0, sizeof(h));
+		h.ampRes = synthRandom(x) & 1;
+		h.startFreq = synthRange(x, 16);
+		h.stopFreq = synthRange(x, 16);
+		h.crossOverBand = (synthRange(x, 4) ? 0 : synthRange(x, 8));
+		h.hdrExtra1 = synthRandom(x) & 1;
+		h.hdrExtra2 = synthRandom(x) & 1;
+		h.freqScale = (h.hdrExtra1 ? synthRange(x, 4) : 2);
+		h.alterScale = (h.hdrExtra1 ? synthRandom(x) & 1 : 1);
+		h.noiseBands = (h.hdrExtra1 ? synthRange(x, 4) : 2);
+		h.limiterBands = (h.hdrExtra2 ? synthRange(x, 4) : 2);
+		h.limiterGains = (h.hdrExtra2 ? synthRange(x, 4) : 2);
+		h.interpFreq = (h.hdrExtra2 ? synthRandom(x) & 1 : 1);
+		h.smoothMode = (h.hdrExtra2 ? synthRandom(x) & 1 : 1);
+		if (prev && h.startFreq == prev->startFreq && h.stopFreq == prev->stopFreq)
+			continue;
+
+		//CalcFreqTables assumes 0 < k2 - k0 <= 48
+		int k0 = k0Tab[sampRateIdx][h.startFreq];
+		int k2 = (h.stopFreq == 14 ? 2 * k0 : h.stopFreq == 15 ? 3 * k0 : k2Tab[sampRateIdx][h.stopFreq]);
+		k2 = MIN(k2, 64);
+		if (k2 <= k0 || k2 - k0 > maxBands)
+			continue;
+
+		memset(&f, 0, sizeof(f));
+		CalcFreqTables(&h, &f, sampRateIdx);
+		if (f.nMaster <= 0 || f.nHigh <= 0 || f.nHigh > MAX_QMF_BANDS || f.nLow <= 0 || f.kStart > 32 ||
+			f.numNoiseFloorBands < 1 || f.numNoiseFloorBands > MAX_NUM_NOISE_FLOOR_BANDS ||
+			f.numPatches < 1 || f.numPatches > MAX_NUM_PATCHES || f.nLimiter < 1)
+			continue;
+		int sum = 0;
+		for (int i = 0; i < f.numPatches; i++)
+			sum += f.patchNumSubbands[i];
+		if (sum == f.numQMFBands)
+			return;
+	}
+}
+
+// bit layout of UnpackSBRHeader
+static void packHeader(aacBitWriter &w, const SBRHeader &h)
+{
+	putBits(w, h.ampRes, 1);
+	putBits(w, h.startFreq, 4);
+	putBits(w, h.stopFreq, 4);
+	putBits(w, h.crossOverBand, 3);
+	putBits(w, 0, 2);		//resBitsHdr
+	putBits(w, h.hdrExtra1, 1);
+	putBits(w, h.hdrExtra2, 1);
+	if (h.hdrExtra1) {
+		putBits(w, h.freqScale, 2);
+		putBits(w, h.alterScale, 1);
+		putBits(w, h.noiseBands, 2);
+	}
+	if (h.hdrExtra2) {
+		putBits(w, h.limiterBands, 2);
+		putBits(w, h.limiterGains, 2);
+		putBits(w, h.interpFreq, 1);
+		putBits(w, h.smoothMode, 1);
+	}
+}
+
+/* time grid that starts where the last one of the channel ended (prevTrail), so FIXFIX and FIXVAR
+ * only follow grids that end on the frame boundary; every envelope spans at least one time slot
+ */
+static void synthGrid(uint32_t &x, int prevTrail, int ampRes, int maxEnv, sbrGridDraw &g)
+{
+	int lead = prevTrail - NUM_TIME_SLOTS;
+
+	memset(&g, 0, sizeof(g));
+	g.frameClass = (lead ? SBR_GRID_VARFIX + (synthRandom(x) & 1) : synthRange(x, 4));
+	g.ampResFrame = ampRes;
+	g.trail = NUM_TIME_SLOTS;
+
+	switch (g.frameClass) {
+	case SBR_GRID_FIXFIX:
+		g.numEnv = 1 << synthRange(x, maxEnv >= 4 ? 3 : maxEnv >= 2 ? 2 : 1);
+		if (g.numEnv == 1)
+			g.ampResFrame = 0;
+		g.freqRes[0] = synthRandom(x) & 1;
+		for (int env = 1; env < g.numEnv; env++)
+			g.freqRes[env] = g.freqRes[0];
+		break;
+
+	case SBR_GRID_FIXVAR:
+		g.abs1 = synthRange(x, 4);
+		g.numRel1 = synthRange(x, MIN(maxEnv, 4));
+		break;
+
+	case SBR_GRID_VARFIX:
+		g.abs0 = lead;
+		g.numRel0 = synthRange(x, MIN(maxEnv, 4));
+		break;
+
+	case SBR_GRID_VARVAR: {
+		int numRel = synthRange(x, MIN(maxEnv, MAX_NUM_ENV));
+		int minRel0 = MAX(numRel - 3, 0);
+		g.abs0 = lead;
+		g.abs1 = synthRange(x, 4);
+		g.numRel0 = minRel0 + synthRange(x, MIN(numRel, 3) - minRel0 + 1);
+		g.numRel1 = numRel - g.numRel0;
+		break;
+	}
+	}
+
+	if (g.frameClass != SBR_GRID_FIXFIX) {
+		int sum;
+		g.numEnv = g.numRel0 + g.numRel1 + 1;
+		g.trail = NUM_TIME_SLOTS + g.abs1;
+		do {
+			sum = 0;
+			for (int i = 0; i < g.numRel0; i++) {
+				g.rel0[i] = synthRange(x, 4);
+				sum += 2 * g.rel0[i] + 2;
+			}
+			for (int i = 0; i < g.numRel1; i++) {
+				g.rel1[i] = synthRange(x, 4);
+				sum += 2 * g.rel1[i] + 2;
+			}
+		} while (g.abs0 + sum >= g.trail);
+		g.pointer = synthRange(x, g.numEnv + 1);
+		for (int env = 0; env < g.numEnv; env++)
+			g.freqRes[env] = synthRandom(x) & 1;
+	}
+	g.numNoiseFloors = (g.numEnv > 1 ? 2 : 1);
+}
+
+// bit layout of UnpackSBRGrid
+static void packGrid(aacBitWriter &w, const sbrGridDraw &g)
+{
+	int pBits = cLog2[g.numEnv + 1];
+
+	putBits(w, g.frameClass, 2);
+	switch (g.frameClass) {
+	case SBR_GRID_FIXFIX:
+		putBits(w, g.numEnv == 4 ? 2 : g.numEnv - 1, 2);
+		putBits(w, g.freqRes[0], 1);
+		return;
+
+	case SBR_GRID_FIXVAR:
+		putBits(w, g.abs1, 2);
+		putBits(w, g.numRel1, 2);
+		for (int i = 0; i < g.numRel1; i++)
+			putBits(w, g.rel1[i], 2);
+		putBits(w, g.pointer, pBits);
+		for (int env = g.numEnv - 1; env >= 0; env--)
+			putBits(w, g.freqRes[env], 1);
+		return;
+
+	case SBR_GRID_VARFIX:
+		putBits(w, g.abs0, 2);
+		putBits(w, g.numRel0, 2);
+		for (int i = 0; i < g.numRel0; i++)
+			putBits(w, g.rel0[i], 2);
+		break;
+
+	case SBR_GRID_VARVAR:
+		putBits(w, g.abs0, 2);
+		putBits(w, g.abs1, 2);
+		putBits(w, g.numRel0, 2);
+		putBits(w, g.numRel1, 2);
+		for (int i = 0; i < g.numRel0; i++)
+			putBits(w, g.rel0[i], 2);
+		for (int i = 0; i < g.numRel1; i++)
+			putBits(w, g.rel1[i], 2);
+		break;
+	}
+	putBits(w, g.pointer, pBits);
+	for (int env = 0; env < g.numEnv; env++)
+		putBits(w, g.freqRes[env], 1);
+}
+
+/* time differences only against an envelope of the same resolution, amplitude resolution and coupling,
+ * and never across a reset
+ */
+static void synthDeltaFlags(aacBitWriter &w, uint32_t &x, const sbrGridDraw &g, const sbrChanState &s, int coupling, int *dtEnv, int *dtNoise)
+{
+	int cont = (s.valid && s.coupled == coupling);
+
+	for (int env = 0; env < g.numEnv; env++) {
+		int same = (env ? g.freqRes[env] == g.freqRes[env - 1] : cont && s.ampRes == g.ampResFrame && s.freqRes == g.freqRes[0]);
+		dtEnv[env] = same && (synthRandom(x) & 1);
+		putBits(w, dtEnv[env], 1);
+	}
+	for (int nf = 0; nf < g.numNoiseFloors; nf++) {
+		dtNoise[nf] = (nf || cont) && (synthRandom(x) & 1);
+		putBits(w, dtNoise[nf], 1);
+	}
+}
+
+/* envelope scalefactors as DecodeSBREnvelope reads them, the right channel of a coupled pair holds
+ * the balance at twice the step size (dShift = 1)
+ */
+static void synthEnvelope(aacBitWriter &w, uint32_t &x, const sbrGridDraw &g, const SBRFreq &f, sbrChanState &s, int coupledRight, const int *dtEnv)
+{
+	int dShift = coupledRight, tab, lo, hi;
+
+	if (coupledRight)	tab = (g.ampResFrame ? HuffTabSBR_tEnv30b : HuffTabSBR_tEnv15b);
+	else				tab = (g.ampResFrame ? HuffTabSBR_tEnv30 : HuffTabSBR_tEnv15);
+	if (coupledRight)	{ lo = 0; hi = (g.ampResFrame ? 24 : 48); }
+	else				{ lo = (g.ampResFrame ? 10 : 20); hi = (g.ampResFrame ? 28 : 56); }
+	int startBits = (g.ampResFrame ? 6 : 7) - dShift;
+
+	for (int env = 0; env < g.numEnv; env++) {
+		int nBands = (g.freqRes[env] ? f.nHigh : f.nLow);
+		if (!dtEnv[env]) {
+			int first = (lo >> dShift) + synthRange(x, ((hi - lo) >> dShift) + 1);
+			putBits(w, first, startBits);
+			s.env[0] = first << dShift;
+			for (int band = 1; band < nBands; band++)
+				s.env[band] = putDelta(w, x, huffTabSBR, &huffTabSBRInfo[tab + 1], s.env[band - 1], dShift, lo, hi);
+		} else {
+			for (int band = 0; band < nBands; band++)
+				s.env[band] = putDelta(w, x, huffTabSBR, &huffTabSBRInfo[tab], s.env[band], dShift, lo, hi);
+		}
+	}
+	s.ampRes = g.ampResFrame;
+	s.freqRes = g.freqRes[g.numEnv - 1];
+}
+
+static void synthNoise(aacBitWriter &w, uint32_t &x, const sbrGridDraw &g, const SBRFreq &f, sbrChanState &s, int coupledRight, const int *dtNoise)
+{
+	int dShift = coupledRight;
+	int hi = (coupledRight ? 24 : 30);
+	int tabT = (coupledRight ? HuffTabSBR_tNoise30b : HuffTabSBR_tNoise30);
+	int tabF = (coupledRight ? HuffTabSBR_fNoise30b : HuffTabSBR_fNoise30);
+
+	for (int nf = 0; nf < g.numNoiseFloors; nf++) {
+		if (!dtNoise[nf]) {
+			int first = synthRange(x, (hi >> dShift) + 1);
+			putBits(w, first, 5);
+			s.noise[0] = first << dShift;
+			for (int band = 1; band < f.numNoiseFloorBands; band++)
+				s.noise[band] = putDelta(w, x, huffTabSBR, &huffTabSBRInfo[tabF], s.noise[band - 1], dShift, 0, hi);
+		} else {
+			for (int band = 0; band < f.numNoiseFloorBands; band++)
+				s.noise[band] = putDelta(w, x, huffTabSBR, &huffTabSBRInfo[tabT], s.noise[band], dShift, 0, hi);
+		}
+	}
+}
+
+static void synthInverseFilterMode(aacBitWriter &w, uint32_t &x, const SBRFreq &f)
+{
+	for (int band = 0; band < f.numNoiseFloorBands; band++)
+		putBits(w, synthRandom(x), 2);
+}
+
+static void synthSinusoids(aacBitWriter &w, uint32_t &x, const SBRFreq &f)
+{
+	int addHarmonicFlag = (synthRange(x, 4) == 0);
+	putBits(w, addHarmonicFlag, 1);
+	for (int band = 0; band < f.nHigh && addHarmonicFlag; band++)
+		putBits(w, synthRange(x, 8) == 0, 1);
+}
+
+/* SBR extension payload of the fill element, byte aligned: the layout of DecodeSBRBitstream and
+ * UnpackSBRSingleChannel/ChannelPair, with at most maxEnv envelopes per channel
+ */
+static void synthSBR(aacBitWriter &w, uint32_t &x, const aacSynthParams &p, sbrState &sbr, int sendHdr, int maxEnv)
+{
+	const SBRFreq &f = sbr.freq;
+	sbrGridDraw g[MAX_NCHANS_ELEM];
+	int dtEnv[MAX_NCHANS_ELEM][MAX_NUM_ENV], dtNoise[MAX_NCHANS_ELEM][MAX_NUM_NOISE_FLOORS];
+
+	int crc = (synthRange(x, 4) == 0);
+	putBits(w, crc ? EXT_SBR_DATA_CRC : EXT_SBR_DATA, 4);
+	if (crc)
+		putBits(w, synthRandom(x), 10);		//not checked by the decoder
+	putBits(w, sendHdr, 1);
+	if (sendHdr)
+		packHeader(w, sbr.hdr);
+
+	int dataExtra = (synthRange(x, 8) == 0);
+	putBits(w, dataExtra, 1);
+	if (dataExtra)
+		putBits(w, synthRandom(x), 4 * p.nChans);
+
+	if (p.nChans == 1) {
+		synthGrid(x, sbr.ch[0].trail, sbr.hdr.ampRes, maxEnv, g[0]);
+		packGrid(w, g[0]);
+		synthDeltaFlags(w, x, g[0], sbr.ch[0], 0, dtEnv[0], dtNoise[0]);
+		synthInverseFilterMode(w, x, f);
+		synthEnvelope(w, x, g[0], f, sbr.ch[0], 0, dtEnv[0]);
+		synthNoise(w, x, g[0], f, sbr.ch[0], 0, dtNoise[0]);
+		sbr.ch[0].coupled = 0;
+	} else {
+		//coupling shares the grid, so both channels must have ended on the same border
+		int coupling = (sbr.ch[0].trail == sbr.ch[1].trail && (synthRandom(x) & 1));
+		putBits(w, coupling, 1);
+		synthGrid(x, sbr.ch[0].trail, sbr.hdr.ampRes, maxEnv, g[0]);
+		packGrid(w, g[0]);
+		if (coupling) {
+			g[1] = g[0];
+		} else {
+			synthGrid(x, sbr.ch[1].trail, sbr.hdr.ampRes, maxEnv, g[1]);
+			packGrid(w, g[1]);
+		}
+		synthDeltaFlags(w, x, g[0], sbr.ch[0], coupling, dtEnv[0], dtNoise[0]);
+		synthDeltaFlags(w, x, g[1], sbr.ch[1], coupling, dtEnv[1], dtNoise[1]);
+		synthInverseFilterMode(w, x, f);
+		if (coupling) {
+			synthEnvelope(w, x, g[0], f, sbr.ch[0], 0, dtEnv[0]);
+			synthNoise(w, x, g[0], f, sbr.ch[0], 0, dtNoise[0]);
+			synthEnvelope(w, x, g[1], f, sbr.ch[1], 1, dtEnv[1]);
+			synthNoise(w, x, g[1], f, sbr.ch[1], 1, dtNoise[1]);
+		} else {
+			synthInverseFilterMode(w, x, f);
+			synthEnvelope(w, x, g[0], f, sbr.ch[0], 0, dtEnv[0]);
+			synthEnvelope(w, x, g[1], f, sbr.ch[1], 0, dtEnv[1]);
+			synthNoise(w, x, g[0], f, sbr.ch[0], 0, dtNoise[0]);
+			synthNoise(w, x, g[1], f, sbr.ch[1], 0, dtNoise[1]);
+		}
+		sbr.ch[0].coupled = sbr.ch[1].coupled = coupling;
+	}
+
+	for (int ch = 0; ch < p.nChans; ch++) {
+		synthSinusoids(w, x, f);
+		sbr.ch[ch].trail = g[ch].trail;
+		sbr.ch[ch].valid = 1;
+	}
+
+	int extendedDataPresent = (synthRange(x, 8) == 0);
+	putBits(w, extendedDataPresent, 1);
+	if (extendedDataPresent) {
+		int size = 1 + synthRange(x, 3);
+		putBits(w, size, 4);
+		for (int i = 0; i < size; i++)
+			putBits(w, synthRandom(x), 8);
+	}
+	byteAlign(w);
+}
+
+int aacSynthesize(const aacSynthParams &p, std::vector<uint8_t> &out)
+{
+	uint32_t x = p.seed * 2654435761u + 1;
+	int winSequence = 0, fallbacks = 0;
+
+	if (p.nChans < 1 || p.nChans > MAX_NCHANS_ELEM || p.srIdx < 0 || p.srIdx >= NUM_SAMPLE_RATES)
+		return -1;
+	int sbrRateIdx = (p.sbr ? GetSampRateIdx(2 * sampRateTab[p.srIdx]) : 0);	//SBR runs at twice the core rate
+	if (sbrRateIdx < 0 || sbrRateIdx >= NUM_SAMPLE_RATES_SBR)
+		return -1;
+
+	sbrState sbr;
+	memset(&sbr, 0, sizeof(sbr));
+	sbr.ch[0].trail = sbr.ch[1].trail = NUM_TIME_SLOTS;
+	if (p.sbr)
+		synthHeader(x, sbrRateIdx, 0, sbr.hdr, sbr.freq);
+
+	HAACDecoder dec = AACInitDecoder();
+	if (!dec) return -1;
+	std::vector<short> pcm(2 * AAC_MAX_NCHANS * AAC_MAX_NSAMPS);
+
+	int n;
+	for (n = 0; n < p.frames; n++) {
+		winSequence = synthWinSequence(x, p.windows, winSequence);
+		int newHdr = (p.sbr == 2 && n == p.frames / 2);
+		int sendHdr = (n == 0 || newHdr || synthRange(x, 8) == 0);
+		if (newHdr) {
+			SBRHeader prev = sbr.hdr;
+			synthHeader(x, sbrRateIdx, &prev, sbr.hdr, sbr.freq);
+			sbr.ch[0].valid = sbr.ch[1].valid = 0;
+		}
+
+		sbrState sbrFrame = sbr;
+		aacBitWriter w;
+		int attempt;
+		for (attempt = 0; attempt < SYNTH_ATTEMPTS; attempt++) {
+			sbr = sbrFrame;
+			w.buf.clear();
+			w.bits = 0;
+			putBits(w, 0, 8 * ADTS_HEADER_BYTES);
+			synthElement(w, x, p, winSequence, attempt);
+
+			if (p.sbr) {
+				aacBitWriter e;
+				e.bits = 0;
+				synthSBR(e, x, p, sbr, sendHdr, MAX(MAX_NUM_ENV - attempt, 1));
+				int count = e.bits >> 3;
+				if (count > FILL_BUF_SIZE)
+					continue;
+				putBits(w, AAC_ID_FIL, NUM_SYN_ID_BITS);
+				putBits(w, MIN(count, 15), 4);
+				if (count >= 15)
+					putBits(w, count - 14, 8);
+				for (int i = 0; i < count; i++)
+					putBits(w, e.buf[i], 8);
+			}
+			putBits(w, AAC_ID_END, NUM_SYN_ID_BITS);
+			byteAlign(w);
+			if (w.bits / 8 - ADTS_HEADER_BYTES <= 768 * p.nChans)
+				break;
+		}
+		if (attempt == SYNTH_ATTEMPTS)
+			break;
+		if (attempt)
+			fallbacks++;
+
+		//ADTS header, MPEG-2 LC without CRC, one raw data block
+		int frameBytes = w.bits / 8;
+		aacBitWriter h;
+		h.bits = 0;
+		putBits(h, 0xfff, 12);
+		putBits(h, 1, 1);			//id
+		putBits(h, 0, 2);			//layer
+		putBits(h, 1, 1);			//protectBit (absent)
+		putBits(h, AAC_PROFILE_LC, 2);
+		putBits(h, p.srIdx, 4);
+		putBits(h, 0, 1);			//privateBit
+		putBits(h, p.nChans, 3);	//channelConfig
+		putBits(h, 0, 4);			//origCopy, home, copyBit, copyStart
+		putBits(h, frameBytes, 13);
+		putBits(h, 0x7ff, 11);		//bufferFull (VBR)
+		putBits(h, 0, 2);			//numRawDataBlocks - 1
+		memcpy(&w.buf[0], &h.buf[0], ADTS_HEADER_BYTES);
+
+		unsigned char *inbuf = &w.buf[0];
+		int bytesLeft = frameBytes;
+		if (AACDecode(dec, &inbuf, &bytesLeft, &pcm[0]) != ERR_AAC_NONE || bytesLeft != 0)
+			break;
+		out.insert(out.end(), w.buf.begin(), w.buf.end());
+	}
+	AACFreeDecoder(dec);
+	return (n == p.frames ? fallbacks : -1);
+}
@@ -0,0 +1,79 @@
+/*
+	Helix library Arduino interface - synthetic AAC-LC and HE-AAC streams for the host tools
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* Generates valid ADTS AAC-LC streams with random content, optionally with
+    SBR fill elements (HE-AAC): window sequences, section data, scalefactors,
+    Huffman codes, M/S, intensity, PNS, TNS and pulse data of the core, and
+    the SBR header, time grid, envelopes, noise floors and sinusoids are all
+    drawn at random inside the ranges of 14496-3. Every frame is decoded with
+    AACDecode before it is accepted, so the whole stream decodes without
+    errors and reaches the QMF banks, HF generator and HF adjuster the way a
+    real encoder's output does. */
+
+#ifndef aacsynth_h_
+#define aacsynth_h_
+
+#include <stdint.h>
+#include <vector>
+
+// window sequences allowed in aacSynthParams.windows, start and stop windows are inserted as needed
+#define AAC_SYNTH_LONG		0x01
+#define AAC_SYNTH_SHORT		0x02
+
+// coding tools allowed in aacSynthParams.tools
+#define AAC_SYNTH_MS		0x01	// mid/side (CPE)
+#define AAC_SYNTH_IS		0x02	// intensity stereo (CPE)
+#define AAC_SYNTH_PNS		0x04
+#define AAC_SYNTH_TNS		0x08
+#define AAC_SYNTH_PULSE		0x10
+#define AAC_SYNTH_ALLTOOLS	0x1f
+
+struct aacSynthParams {
+	int			srIdx;		// of the ADTS header (the core rate): 3 = 48 kHz, 4 = 44.1 kHz, 6 = 24 kHz, 7 = 22.05 kHz...
+	int			nChans;		// 1 (SCE) or 2 (CPE)
+	int			windows;	// AAC_SYNTH_xxx
+	int			tools;		// AAC_SYNTH_xxx
+	int			sbr;		// 0 AAC-LC, 1 SBR at twice the core rate, 2 same with a new SBR header (decoder reset) halfway
+	int			frames;
+	uint32_t	seed;
+};
+
+// appends the stream to out, returns the number of frames that had to be drawn again with fewer bands, -1 on error
+int aacSynthesize(const aacSynthParams &p, std::vector<uint8_t> &out);
+
+#endif
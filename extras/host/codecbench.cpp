@@ -0,0 +1,406 @@
+/*
+	Helix library Arduino interface - decode benchmark for MP3Decode/AACDecode on the host
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* usage: codecbench [-n repeat] [-m] [-lp] [-core] [-c dir] file...
+    Decodes each file in memory through MP3Decode (*.mp3) or AACDecode (ADTS,
+    MP4/M4A) in a tight loop, using the same unity builds as the library
+    (mp3.cpp, aac.cpp). Prints frames per second, real-time factor,
+    p50/p99/max nanoseconds per frame and a checksum of the PCM output.
+
+    g++ -O2 -I. extras/host/codecbench.cpp extras/host/mediafile.cpp extras/host/thumbemu.cpp mp3.cpp aac.cpp -o codecbench
+
+    With -DMP3_STAGE_STATS / -DAAC_STAGE_STATS the time spent in each stage
+    of MP3Decode / AACDecode is listed below each file.
+
+    -m lists the heap used by the decoder instance, and with -DMP3_STACK_STATS /
+    -DAAC_STACK_STATS the peak stack depth of MP3Decode / AACDecode.
+
+    -lp decodes HE-AAC with low-power (real-valued) SBR, see AACSetSBRLowPower().
+    -core decodes only the core of HE-AAC and upsamples it, see AACSetSBRCoreOnly().
+
+    -c dir decodes each AAC frame once more with the whole decoder compiled for
+    the Cortex-M4 (m4dec_aac.c, m4dec_aac.s in dir) in thumbemu, and prints
+    emulated cycles per frame instead of ns, frames/s and x rt at 96 MHz. Its
+    PCM must be the same as that of the host decoder, which finds the frames.
+    The C library calls (memset, memcpy) count 1 and 2 cycles per word, what
+    STM and LDM/STM loops take. MP3 files are skipped. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+
+#include "mediafile.h"
+#include "thumbemu.h"
+
+struct benchResult {
+	uint32_t	frames;
+	uint32_t	errors;
+	double		audioSecs;
+	uint32_t	checksum;
+	std::vector<uint32_t> ns;	// per frame
+#ifdef MP3_STAGE_STATS
+	MP3StageStats mp3Stages;
+#endif
+#ifdef AAC_STAGE_STATS
+	AACStageStats aacStages;
+#endif
+	int			heap;		// decoder instance, bytes
+	int			stackPeak;
+	uint32_t	m4Mismatch;	// -c: frames that don't match the host decoder
+};
+
+static uint32_t pcmChecksum(uint32_t checksum, const short *pcm, int n)
+{
+	for (int i = 0; i < n; i++)
+		checksum = (checksum * 31) + (uint16_t)pcm[i];
+	return checksum;
+}
+
+static bool sbrLowPower = false;
+static bool sbrCoreOnly = false;
+static const char *m4Dir = 0;
+static double tickRate = 1e9;		// of benchResult.ns: 1/ns, or 96 MHz with -c
+
+/* -c: the decoder of m4dec_aac.s in thumbemu, with its input file and PCM buffer */
+struct m4Decoder {
+	thumbEmu	e;
+	uint32_t	h;
+	uint32_t	data, pcm, p, left, info;
+};
+
+static void emuCalloc(thumbEmu &e)
+{
+	e.r[0] = emuAlloc(e, emuArg(e, 0) * emuArg(e, 1));	// never used before, so 0
+}
+
+static void emuFree(thumbEmu &e)
+{
+}
+
+static void emuMemclr(thumbEmu &e)
+{
+	memset(emuPtr(e, emuArg(e, 0)), 0, emuArg(e, 1));
+	e.cycles += (emuArg(e, 1) + 3) / 4;
+}
+
+static void emuMemset(thumbEmu &e)
+{
+	memset(emuPtr(e, emuArg(e, 0)), (int)emuArg(e, 2), emuArg(e, 1));
+	e.cycles += (emuArg(e, 1) + 3) / 4;
+}
+
+static void emuMemcpy(thumbEmu &e)
+{
+	memmove(emuPtr(e, emuArg(e, 0)), emuPtr(e, emuArg(e, 1)), emuArg(e, 2));
+	e.cycles += 2 * ((emuArg(e, 2) + 3) / 4);
+}
+
+static bool m4Open(m4Decoder &m, mediaFile &f)
+{
+	std::string path = std::string(m4Dir) + "/m4dec_aac.s";
+	if (!emuLoad(m.e, path.c_str(), (1 << 20) + ((f.size + 7) & ~7))) return false;
+	emuFunction(m.e, "calloc", emuCalloc);
+	emuFunction(m.e, "free", emuFree);
+	emuFunction(m.e, "__aeabi_memclr", emuMemclr);
+	emuFunction(m.e, "__aeabi_memclr4", emuMemclr);
+	emuFunction(m.e, "__aeabi_memset", emuMemset);
+	emuFunction(m.e, "__aeabi_memcpy", emuMemcpy);
+	emuFunction(m.e, "__aeabi_memcpy4", emuMemcpy);
+	emuFunction(m.e, "__aeabi_memmove4", emuMemcpy);
+	m.data = emuAlloc(m.e, f.size);
+	m.pcm = emuAlloc(m.e, MEDIA_PCM_SIZE * sizeof(short));
+	m.p = emuAlloc(m.e, 4);
+	m.left = emuAlloc(m.e, 4);
+	m.info = emuAlloc(m.e, sizeof(AACFrameInfo));
+	memcpy(emuPtr(m.e, m.data), f.data, f.size);
+
+	m.h = emuCall(m.e, "AACInitDecoder", {});
+	if (!m.h) return false;
+	if (f.sampleOffset.size()) {
+		//MP4: as mediaOpen
+		AACFrameInfo info;
+		memset(&info, 0, sizeof(AACFrameInfo));
+		info.nChans = f.channels;
+		info.sampRateCore = f.samplerate;
+		info.profile = AAC_PROFILE_LC;
+		memcpy(emuPtr(m.e, m.info), &info, sizeof(AACFrameInfo));
+		emuCall(m.e, "AACSetRawBlockParams", { m.h, 0, m.info });
+	}
+	if (sbrLowPower) emuCall(m.e, "AACSetSBRLowPower", { m.h, 1 });
+	if (sbrCoreOnly) emuCall(m.e, "AACSetSBRCoreOnly", { m.h, 1 });
+	return true;
+}
+
+/* the frame the host decoder just decoded, fr.ns becomes emulated cycles */
+static void m4DecodeFrame(m4Decoder &m, mediaDecoder &d, mediaFrame &fr, const short *pcm, benchResult &r)
+{
+	mediaFile &f = *d.f;
+	uint32_t p = m.data + fr.offset;
+	int32_t left = f.sampleOffset.size() ? (int32_t)f.sampleSize[d.block - 1] : (int32_t)(f.size - fr.offset);
+
+	memcpy(emuPtr(m.e, m.p), &p, 4);
+	memcpy(emuPtr(m.e, m.left), &left, 4);
+	m.e.cycles = 0;
+	int err = (int)emuCall(m.e, "AACDecode", { m.h, m.p, m.left, m.pcm });
+	fr.ns = (uint32_t)m.e.cycles;
+	if (err != fr.err || (!err && memcmp(emuPtr(m.e, m.pcm), pcm, fr.samples * sizeof(short))))
+		r.m4Mismatch++;
+}
+
+static void benchDecode(mediaFile &f, benchResult &r)
+{
+	static short pcm[MEDIA_PCM_SIZE];
+	mediaDecoder d;
+	mediaFrame fr;
+
+	if (!mediaOpen(d, f)) return;
+	if (d.aac && sbrLowPower) AACSetSBRLowPower(d.aac, 1);
+	if (d.aac && sbrCoreOnly) AACSetSBRCoreOnly(d.aac, 1);
+	m4Decoder *m = 0;
+	if (m4Dir) {
+		m = new m4Decoder();
+		if (!m4Open(*m, f)) {
+			fprintf(stderr, "%s/m4dec_aac.s: can't start the decoder\n", m4Dir);
+			exit(1);
+		}
+	}
+	while (mediaDecodeFrame(d, pcm, fr)) {
+		if (m) m4DecodeFrame(*m, d, fr, pcm, r);
+		if (fr.err) {
+			r.errors++;
+			continue;
+		}
+		r.ns.push_back(fr.ns);
+		r.frames++;
+		r.audioSecs += (double)fr.samples / fr.nChans / fr.samprate;
+		r.checksum = pcmChecksum(r.checksum, pcm, fr.samples);
+	}
+#ifdef MP3_STAGE_STATS
+	if (d.mp3) MP3GetStageStats(d.mp3, &r.mp3Stages);
+#endif
+#ifdef AAC_STAGE_STATS
+	if (d.aac) AACGetStageStats(d.aac, &r.aacStages);
+#endif
+	if (d.mp3) {
+		MP3MemInfo mem;
+		MP3GetMemInfo(d.mp3, &mem);
+		r.heap = mem.total;
+		r.stackPeak = mem.stackPeak;
+	} else {
+		AACMemInfo mem;
+		AACGetMemInfo(d.aac, &mem);
+		r.heap = mem.total;
+		r.stackPeak = mem.stackPeak;
+	}
+	delete m;
+	mediaClose(d);
+}
+
+static uint32_t percentile(std::vector<uint32_t> &v, int pct)
+{
+	if (!v.size()) return 0;
+	std::sort(v.begin(), v.end());
+	return v[(v.size() - 1) * pct / 100];
+}
+
+static void printResult(const char *name, benchResult &r)
+{
+	uint64_t total = 0;
+	for (size_t i = 0; i < r.ns.size(); i++) total += r.ns[i];
+	double secs = total / tickRate;
+	uint32_t p50 = percentile(r.ns, 50);
+	uint32_t p99 = percentile(r.ns, 99);
+	uint32_t max = r.ns.size() ? r.ns.back() : 0;
+
+	printf("%-24s %7u %9.0f %8.1f %8u %8u %8u  %08x", name, r.frames,
+		secs > 0 ? r.ns.size() / secs : 0.0, secs > 0 ? r.audioSecs / secs : 0.0,
+		p50, p99, max, r.checksum);
+	if (r.errors) printf("  %u errors", r.errors);
+	if (r.m4Mismatch) printf("  %u frames differ from the host decoder", r.m4Mismatch);
+	printf("\n");
+}
+
+#ifdef MP3_STAGE_STATS
+static void addMp3Stages(MP3StageStats &sum, const MP3StageStats &s)
+{
+	for (int i = 0; i < MP3_NSTAGES; i++) {
+		sum.time[i] += s.time[i];
+		sum.calls[i] += s.calls[i];
+		if (s.maxTime[i] > sum.maxTime[i]) sum.maxTime[i] = s.maxTime[i];
+	}
+	sum.frames += s.frames;
+}
+
+static void printMp3Stages(const MP3StageStats &s)
+{
+	static const char *names[MP3_NSTAGES] = {
+		"sideinfo", "maindata", "scalefact", "huffman", "dequant", "imdct", "subband"
+	};
+	uint64_t total = 0;
+
+	for (int i = 0; i < MP3_NSTAGES; i++) total += s.time[i];
+	for (int i = 0; i < MP3_NSTAGES; i++) {
+		printf("  %-10s %5.1f%% %8u calls %8.0f ns/frame %8u ns max\n", names[i],
+			total ? 100.0 * s.time[i] / total : 0.0, s.calls[i],
+			s.frames ? (double)s.time[i] / s.frames : 0.0, s.maxTime[i]);
+	}
+}
+#endif
+
+#ifdef AAC_STAGE_STATS
+static void addAacStages(AACStageStats &sum, const AACStageStats &s)
+{
+	for (int e = 0; e < AAC_STATS_NELEMS; e++) {
+		for (int i = 0; i < AAC_NSTAGES; i++) {
+			sum.time[e][i] += s.time[e][i];
+			sum.calls[e][i] += s.calls[e][i];
+			if (s.maxTime[e][i] > sum.maxTime[e][i]) sum.maxTime[e][i] = s.maxTime[e][i];
+		}
+	}
+	sum.frames += s.frames;
+}
+
+static void printAacStages(const AACStageStats &s)
+{
+	static const char *elems[AAC_STATS_NELEMS] = { "SCE", "CPE", "LFE" };
+	static const char *names[AAC_NSTAGES] = {
+		"noiseless", "dequant", "stereo", "pns", "tns", "imdct",
+		"sbr-bits", "qmf-ana", "hf-gen", "hf-adj", "qmf-syn", "upsample"
+	};
+	uint64_t total = 0;
+
+	for (int e = 0; e < AAC_STATS_NELEMS; e++)
+		for (int i = 0; i < AAC_NSTAGES; i++) total += s.time[e][i];
+	for (int e = 0; e < AAC_STATS_NELEMS; e++) {
+		for (int i = 0; i < AAC_NSTAGES; i++) {
+			if (!s.calls[e][i]) continue;
+			printf("  %s %-10s %5.1f%% %8u calls %8.0f ns/frame %8u ns max\n", elems[e], names[i],
+				total ? 100.0 * s.time[e][i] / total : 0.0, s.calls[e][i],
+				s.frames ? (double)s.time[e][i] / s.frames : 0.0, s.maxTime[e][i]);
+		}
+	}
+}
+#endif
+
+int main(int argc, char **argv)
+{
+	int repeat = 1;
+	bool mem = false;
+	int i;
+
+	for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+		if (!strcmp(argv[i], "-n") && i + 1 < argc) repeat = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-m")) mem = true;
+		else if (!strcmp(argv[i], "-lp")) sbrLowPower = true;
+		else if (!strcmp(argv[i], "-core")) sbrCoreOnly = true;
+		else if (!strcmp(argv[i], "-c") && i + 1 < argc) m4Dir = argv[++i];
+		else break;
+	}
+	if (i >= argc || repeat < 1) {
+		fprintf(stderr, "usage: %s [-n repeat] [-m] [-lp] [-core] [-c dir] file...\n", argv[0]);
+		return 1;
+	}
+
+	const char *unit = "ns";
+	if (m4Dir) {
+		tickRate = 96e6;
+		unit = "cyc";
+	}
+	printf("%-24s %7s %9s %8s %5s %-2s %5s %-2s %5s %-2s  %s\n", "file", "frames", "frames/s", "x rt",
+		"p50", unit, "p99", unit, "max", unit, "checksum");
+
+	benchResult all = benchResult();
+	int failed = 0;
+	for ( ; i < argc; i++) {
+		mediaFile f;
+		if (!mediaLoad(argv[i], f)) {
+			perror(argv[i]);
+			failed++;
+			continue;
+		}
+		if (m4Dir && f.mp3) {
+			fprintf(stderr, "%s: -c is AAC only\n", argv[i]);
+			mediaFree(f);
+			continue;
+		}
+		benchResult r = benchResult();
+		for (int n = 0; n < repeat; n++) {
+			benchResult pass = benchResult();
+			benchDecode(f, pass);
+			//frames, time and checksum are those of a single pass
+			r.frames = pass.frames;
+			r.errors = pass.errors;
+			r.audioSecs += pass.audioSecs;
+			r.checksum = pass.checksum;
+			r.ns.insert(r.ns.end(), pass.ns.begin(), pass.ns.end());
+			r.heap = pass.heap;
+			r.m4Mismatch += pass.m4Mismatch;
+			if (pass.stackPeak > r.stackPeak) r.stackPeak = pass.stackPeak;
+#ifdef MP3_STAGE_STATS
+			addMp3Stages(r.mp3Stages, pass.mp3Stages);
+#endif
+#ifdef AAC_STAGE_STATS
+			addAacStages(r.aacStages, pass.aacStages);
+#endif
+		}
+
+		const char *name = strrchr(argv[i], '/');
+		printResult(name ? name + 1 : argv[i], r);
+		if (!r.frames || r.m4Mismatch) failed++;
+		if (mem) printf("  decoder heap %d bytes, stack peak %d bytes\n", r.heap, r.stackPeak);
+#ifdef MP3_STAGE_STATS
+		if (f.mp3) printMp3Stages(r.mp3Stages);
+#endif
+#ifdef AAC_STAGE_STATS
+		if (!f.mp3) printAacStages(r.aacStages);
+#endif
+
+		all.frames += r.frames;
+		all.errors += r.errors;
+		all.m4Mismatch += r.m4Mismatch;
+		all.audioSecs += r.audioSecs;
+		all.checksum = (all.checksum * 31) + r.checksum;
+		all.ns.insert(all.ns.end(), r.ns.begin(), r.ns.end());
+		mediaFree(f);
+	}
+	printResult("total", all);
+	return failed ? 1 : 0;
+}
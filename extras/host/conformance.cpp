@@ -0,0 +1,508 @@
+/*
+	Helix library Arduino interface - bit-exact conformance and golden-PCM regression test
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* usage: conformance [-u] [-w dir] [manifest...]
+    Decodes a corpus and compares the PCM output with golden hashes, so a
+    rewrite of a kernel or decoder stage can be shown not to change the audio.
+
+    Without a manifest the built-in synthetic vectors are used: MP3 (see
+    mp3synth.h) with MPEG-1, MPEG-2 and MPEG-2.5, every block type mix,
+    mid/side and intensity stereo, all Huffman tables, VBR, CRC and the bit
+    reservoir, a lowpassed stream (only the lower 16 subbands active) and one
+    ending in digital silence (the subband transform skips the channel once
+    the polyphase buffer is zero), and ADTS AAC (see aacsynth.h) with long and short windows, M/S,
+    intensity, PNS, TNS and pulse data, plain LC and HE-AAC with SBR header
+    resets. The HE-AAC vectors are decoded again with low-power SBR (-lp, see
+    AACSetSBRLowPower), and some core-only with the half-band upsampler
+    instead of SBR (-core, see AACSetSBRCoreOnly), each with its own hashes.
+    The quiet MP3 vectors (SYNTH_QUIET, they don't clip) are also compared
+    with the floating point Layer III decoder of mp3ref.h, the accuracy is
+    printed as for a manifest reference below.
+
+    Every stream, built-in or from a manifest, also runs through the assembly
+    kernels in the Cortex-M4 emulator (thumbemu.h): asmpoly_thumb2.S redoes
+    the last subband block of each MP3 frame (mono, stereo, planar stereo) and
+    memcpy_frominterleaved.S splits the stereo output into audio blocks. Both
+    must match the C output exactly, a difference fails the stream.
+
+    Not covered: the built-in float reference skips intensity stereo, the
+    loud vectors and the MPEG-2.5 8 kHz mixed blocks (see mp3ref.h), and has
+    nothing for AAC; use a manifest with reference decoder output for those.
+    The other assembly (FDCT32, IMDCT, R4FFT/DCT4, QMF) is only checked by
+    kernelbench, on synthetic input. There are no free format MP3 vectors,
+    and the decoders have no Layer I/II or AAC main/SSR/LTP to test.
+
+    A manifest lists one stream per line, paths relative to the manifest,
+    # starts a comment:
+
+        file  hash  [reference]
+
+    file       *.mp3, ADTS *.aac or MP4/M4A (e.g. the ISO 11172-4 / 13818-4 /
+               14496-4 bitstreams: Layer III, AAC LC with and without TNS/PNS, HE-AAC)
+    hash       FNV-1a of the decoded 16 bit PCM (little endian), - if not known yet
+    reference  output of a floating point reference decoder for this stream,
+               *.wav (16/24/32 bit integer or 32 bit float) or raw 16 bit *.pcm.
+               The maximum absolute and RMS error are printed in 16 bit LSBs,
+               with the accuracy class of ISO 11172-4: full (RMS < 2^-15/sqrt(12)
+               and max <= 2^-14 of full scale), limited (RMS < 2^-11/sqrt(12))
+               or none.
+
+    -u  write the hashes of this build back to the manifest (or print them
+        for the built-in vectors), after an intended change of the output
+    -w  also write the synthetic vectors to dir as *.mp3 and *.aac
+
+    g++ -O2 -I. extras/host/conformance.cpp extras/host/mediafile.cpp extras/host/mp3synth.cpp extras/host/mp3ref.cpp extras/host/aacsynth.cpp extras/host/thumbemu.cpp mp3.cpp aac.cpp -o conformance */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "mediafile.h"
+#include "mp3/coder.h"
+#include "mp3synth.h"
+#include "mp3ref.h"
+#include "aacsynth.h"
+#include "thumbemu.h"
+
+struct synthVector {
+	const char		*name;
+	mp3SynthParams	params;
+	uint32_t		reference;	// hash of the PCM output
+};
+
+#define FRAMES	40
+
+static const synthVector vectors[] = {
+	// name						 ver sr mode modeExt blockTypes					br     crc gains        lines           frames  silent  seed
+	{ "mpeg1-44k-stereo-long",	{ 0, 0, 0,  0, SYNTH_LONG,						9,  9, 0, SYNTH_QUIET, SYNTH_FULLBAND, FRAMES,  0,  1 }, 0xf41fd994 },
+	{ "mpeg1-44k-stereo-blocks",{ 0, 0, 0,  0, SYNTH_ALLBLOCKS,					9, 14, 0, SYNTH_QUIET, SYNTH_FULLBAND, FRAMES,  0,  2 }, 0xb9dcd4da },
+	{ "mpeg1-48k-joint-ms",		{ 0, 1, 1,  2, SYNTH_ALLBLOCKS,				   11, 11, 0, SYNTH_QUIET, SYNTH_FULLBAND, FRAMES,  0,  3 }, 0x6949a7a6 },
+	{ "mpeg1-44k-joint-is",		{ 0, 0, 1,  1, SYNTH_ALLBLOCKS,					9,  9, 0, SYNTH_LOUD,  SYNTH_FULLBAND, FRAMES,  0,  4 }, 0xa4434f19 },
+	{ "mpeg1-32k-joint-ms-is",	{ 0, 2, 1,  3, SYNTH_ALLBLOCKS,					8,  8, 1, SYNTH_LOUD,  SYNTH_FULLBAND, FRAMES,  0,  5 }, 0x3d36483a },
+	{ "mpeg1-44k-joint-vbr",	{ 0, 0, 1, -1, SYNTH_ALLBLOCKS,					1, 14, 0, SYNTH_LOUD,  SYNTH_FULLBAND, FRAMES,  0,  6 }, 0xc0ef61fc },
+	{ "mpeg1-48k-dual",			{ 0, 1, 2,  0, SYNTH_LONG | SYNTH_SHORT,		10, 10, 0, SYNTH_QUIET, SYNTH_FULLBAND, FRAMES,  0,  7 }, 0x500b4943 },
+	{ "mpeg1-44k-mono-short",	{ 0, 0, 3,  0, SYNTH_SHORT | SYNTH_MIXED,		5,  5, 1, SYNTH_QUIET, SYNTH_FULLBAND, FRAMES,  0,  8 }, 0x0f25cfb1 },
+	{ "mpeg1-44k-320k",			{ 0, 0, 1, -1, SYNTH_ALLBLOCKS,				   14, 14, 0, SYNTH_LOUD,  SYNTH_FULLBAND, FRAMES,  0,  9 }, 0x895757ee },
+	{ "mpeg2-22k-stereo",		{ 1, 0, 0,  0, SYNTH_ALLBLOCKS,					8, 10, 0, SYNTH_QUIET, SYNTH_FULLBAND, FRAMES,  0, 10 }, 0x6a73a406 },
+	{ "mpeg2-24k-joint",		{ 1, 1, 1, -1, SYNTH_ALLBLOCKS,					1, 14, 0, SYNTH_LOUD,  SYNTH_FULLBAND, FRAMES,  0, 11 }, 0xd3a37c45 },
+	{ "mpeg2-16k-mono",			{ 1, 2, 3,  0, SYNTH_ALLBLOCKS,					6,  6, 1, SYNTH_QUIET, SYNTH_FULLBAND, FRAMES,  0, 12 }, 0xea45a5f5 },
+	{ "mpeg25-11k-joint",		{ 2, 0, 1, -1, SYNTH_ALLBLOCKS,					4,  8, 0, SYNTH_LOUD,  SYNTH_FULLBAND, FRAMES,  0, 13 }, 0x5bebb099 },
+	{ "mpeg25-8k-mono",			{ 2, 2, 3,  0, SYNTH_ALLBLOCKS,					3,  3, 1, SYNTH_LOUD,  SYNTH_FULLBAND, FRAMES,  0, 14 }, 0x5d9f37e1 },
+	{ "mpeg1-44k-lowpass",		{ 0, 0, 1,  2, SYNTH_ALLBLOCKS,					9,  9, 0, SYNTH_QUIET, SYNTH_LOWPASS,  FRAMES,  0, 15 }, 0xd69f4e46 },
+	{ "mpeg1-44k-silence",		{ 0, 0, 0,  0, SYNTH_ALLBLOCKS,					9,  9, 0, SYNTH_QUIET, SYNTH_FULLBAND, FRAMES, 32, 16 }, 0xe2e06fc6 },
+};
+
+#define AAC_SYNTH_BLOCKS	(AAC_SYNTH_LONG | AAC_SYNTH_SHORT)
+
+// how the HE-AAC vectors are decoded, see aacdec.h
+#define SBR_HQ		0	// high-quality (complex) SBR, the default
+#define SBR_LP		1	// low-power (real-valued) SBR, AACSetSBRLowPower()
+#define SBR_CORE	2	// no SBR, the core is upsampled, AACSetSBRCoreOnly()
+
+struct aacSynthVector {
+	const char		*name;
+	aacSynthParams	params;
+	int				sbrMode;
+	uint32_t		reference;
+};
+
+static const aacSynthVector aacVectors[] = {
+	// name						 sr ch windows			 tools								sbr frames  seed   mode
+	{ "aac-44k-mono-long",		{ 4, 1, AAC_SYNTH_LONG,	  0,									0, FRAMES, 21 }, SBR_HQ, 0x88810ca6 },
+	{ "aac-48k-stereo-ms-is",	{ 3, 2, AAC_SYNTH_BLOCKS, AAC_SYNTH_MS | AAC_SYNTH_IS,			0, FRAMES, 22 }, SBR_HQ, 0xf788edef },
+	{ "aac-44k-stereo-tools",	{ 4, 2, AAC_SYNTH_BLOCKS, AAC_SYNTH_ALLTOOLS,					0, FRAMES, 23 }, SBR_HQ, 0x3c9d9b44 },
+	{ "aac-32k-mono-short",		{ 5, 1, AAC_SYNTH_SHORT,  AAC_SYNTH_PNS | AAC_SYNTH_TNS,		0, FRAMES, 24 }, SBR_HQ, 0xf99e4e88 },
+	{ "heaac-22k-stereo",		{ 7, 2, AAC_SYNTH_BLOCKS, AAC_SYNTH_ALLTOOLS,					1, FRAMES, 25 }, SBR_HQ, 0x7a10bbd1 },
+	{ "heaac-24k-mono",			{ 6, 1, AAC_SYNTH_BLOCKS, AAC_SYNTH_ALLTOOLS,					1, FRAMES, 26 }, SBR_HQ, 0xe561c379 },
+	{ "heaac-24k-stereo-reset",	{ 6, 2, AAC_SYNTH_BLOCKS, AAC_SYNTH_ALLTOOLS,					2, FRAMES, 27 }, SBR_HQ, 0x342a386e },
+	{ "heaac-16k-stereo-long",	{ 8, 2, AAC_SYNTH_LONG,	  AAC_SYNTH_MS | AAC_SYNTH_PNS,			1, FRAMES, 28 }, SBR_HQ, 0x8dbab89b },
+	{ "heaac-11k-mono-reset",	{10, 1, AAC_SYNTH_BLOCKS, AAC_SYNTH_ALLTOOLS,					2, FRAMES, 29 }, SBR_HQ, 0x1f1d4e6f },
+	{ "heaac-22k-stereo-lp",	{ 7, 2, AAC_SYNTH_BLOCKS, AAC_SYNTH_ALLTOOLS,					1, FRAMES, 25 }, SBR_LP, 0xd60ee72a },
+	{ "heaac-24k-mono-lp",		{ 6, 1, AAC_SYNTH_BLOCKS, AAC_SYNTH_ALLTOOLS,					1, FRAMES, 26 }, SBR_LP, 0x03d424fd },
+	{ "heaac-24k-stereo-reset-lp",{ 6, 2, AAC_SYNTH_BLOCKS, AAC_SYNTH_ALLTOOLS,					2, FRAMES, 27 }, SBR_LP, 0x6a503315 },
+	{ "heaac-16k-stereo-long-lp",{ 8, 2, AAC_SYNTH_LONG,	  AAC_SYNTH_MS | AAC_SYNTH_PNS,			1, FRAMES, 28 }, SBR_LP, 0x8fbe8d95 },
+	{ "heaac-11k-mono-reset-lp",{10, 1, AAC_SYNTH_BLOCKS, AAC_SYNTH_ALLTOOLS,					2, FRAMES, 29 }, SBR_LP, 0xc667d238 },
+	{ "heaac-22k-stereo-core",	{ 7, 2, AAC_SYNTH_BLOCKS, AAC_SYNTH_ALLTOOLS,					1, FRAMES, 25 }, SBR_CORE, 0x88a5c7b8 },
+	{ "heaac-24k-mono-core",	{ 6, 1, AAC_SYNTH_BLOCKS, AAC_SYNTH_ALLTOOLS,					1, FRAMES, 26 }, SBR_CORE, 0xadce5515 },
+	{ "heaac-11k-mono-reset-core",{10, 1, AAC_SYNTH_BLOCKS, AAC_SYNTH_ALLTOOLS,					2, FRAMES, 29 }, SBR_CORE, 0x1eb28f1f },
+};
+
+struct decodeResult {
+	uint32_t	frames;
+	uint32_t	errors;
+	uint32_t	hash;
+	uint32_t	asmCalls;	// of the assembly kernels in the emulator
+	uint32_t	asmDiffs;	// calls whose output differs from the C decoder's
+	std::vector<short> pcm;
+};
+
+static uint32_t	asmCallsTotal;
+
+static uint32_t fnv1a(uint32_t h, const short *pcm, int n)
+{
+	for (int i = 0; i < n; i++) {
+		h = (h ^ (uint8_t)(pcm[i] & 0xff)) * 16777619u;
+		h = (h ^ (uint8_t)((uint16_t)pcm[i] >> 8)) * 16777619u;
+	}
+	return h;
+}
+
+#define COPY_BLOCK	128		// samples per channel of memcpy_frominterleaved (AUDIO_BLOCK_SAMPLES)
+
+static thumbEmu	emuPoly, emuCopy;
+static uint32_t	emuVbuf, emuCoef, emuPcm, emuSrc, emuLeft, emuRight;
+
+static void emuSetup(void)
+{
+	if (!emuLoad(emuPoly, emuSource("asmpoly_thumb2.S")) || !emuLoad(emuCopy, emuSource("memcpy_frominterleaved.S")))
+		exit(1);
+	emuVbuf = emuAlloc(emuPoly, sizeof(((SubbandInfo *)0)->vbuf));
+	emuCoef = emuAlloc(emuPoly, sizeof(polyCoef));
+	emuPcm = emuAlloc(emuPoly, MAX_NCHAN * NBANDS * sizeof(short));
+	memcpy(emuPtr(emuPoly, emuCoef), polyCoef, sizeof(polyCoef));
+	emuSrc = emuAlloc(emuCopy, 2 * COPY_BLOCK * sizeof(short));
+	emuLeft = emuAlloc(emuCopy, COPY_BLOCK * sizeof(short));
+	emuRight = emuAlloc(emuCopy, COPY_BLOCK * sizeof(short));
+}
+
+/* asmpoly_thumb2.S redoes the last subband block of the frame from the decoder's vbuf (the
+ * earlier ones are partly overwritten by then), mono, interleaved and planar stereo
+ */
+static void checkPolyphase(HMP3Decoder h, const short *pcm, int nChans, int samples, decodeResult &r)
+{
+	SubbandInfo *sbi = (SubbandInfo *)((MP3DecInfo *)h)->SubbandInfoPS;
+	const short *last = pcm + samples - nChans * NBANDS;
+	uint32_t vbuf = emuVbuf + 4 * (((sbi->vindex + 1) & 7) + VBUF_LENGTH);	// vindex before the odd block
+
+	memcpy(emuPtr(emuPoly, emuVbuf), sbi->vbuf, sizeof(sbi->vbuf));
+	if (nChans == 1) {
+		emuCall(emuPoly, "xmp3_PolyphaseMono", { emuPcm, vbuf, emuCoef });
+		r.asmDiffs += (memcmp(emuPtr(emuPoly, emuPcm), last, NBANDS * sizeof(short)) != 0);
+		r.asmCalls++;
+		return;
+	}
+
+	emuCall(emuPoly, "xmp3_PolyphaseStereo", { emuPcm, vbuf, emuCoef });
+	r.asmDiffs += (memcmp(emuPtr(emuPoly, emuPcm), last, 2 * NBANDS * sizeof(short)) != 0);
+	emuCall(emuPoly, "xmp3_PolyphaseStereoPlanar", { emuPcm, emuPcm + 2 * NBANDS, vbuf, emuCoef });
+	const short *planar = (const short *)emuPtr(emuPoly, emuPcm);
+	int diff = 0;
+	for (int i = 0; i < NBANDS; i++)
+		diff |= (planar[i] != last[2 * i]) | (planar[NBANDS + i] != last[2 * i + 1]);
+	r.asmDiffs += diff;
+	r.asmCalls += 2;
+}
+
+// memcpy_frominterleaved.S (the players' stereo split) on every whole audio block of the frame
+static void checkDeinterleave(const short *pcm, int samples, decodeResult &r)
+{
+	const short *left = (const short *)emuPtr(emuCopy, emuLeft), *right = (const short *)emuPtr(emuCopy, emuRight);
+
+	for (int n = 0; n + 2 * COPY_BLOCK <= samples; n += 2 * COPY_BLOCK) {
+		memcpy(emuPtr(emuCopy, emuSrc), pcm + n, 2 * COPY_BLOCK * sizeof(short));
+		emuCall(emuCopy, "memcpy_frominterleaved", { emuLeft, emuRight, emuSrc });
+		int diff = 0;
+		for (int i = 0; i < COPY_BLOCK; i++)
+			diff |= (left[i] != pcm[n + 2 * i]) | (right[i] != pcm[n + 2 * i + 1]);
+		r.asmDiffs += diff;
+		r.asmCalls++;
+	}
+}
+
+static bool decode(mediaFile &f, decodeResult &r, bool keepPcm, int sbrMode = SBR_HQ)
+{
+	static short pcm[MEDIA_PCM_SIZE];
+	mediaDecoder d;
+	mediaFrame fr;
+
+	if (!emuPoly.linked) emuSetup();
+	r.frames = r.errors = r.asmCalls = r.asmDiffs = 0;
+	r.hash = 2166136261u;
+	if (!mediaOpen(d, f)) return false;
+	if (d.aac && sbrMode == SBR_LP) AACSetSBRLowPower(d.aac, 1);
+	if (d.aac && sbrMode == SBR_CORE) AACSetSBRCoreOnly(d.aac, 1);
+	while (mediaDecodeFrame(d, pcm, fr)) {
+		if (fr.err) {
+			r.errors++;
+			continue;
+		}
+		r.frames++;
+		r.hash = fnv1a(r.hash, pcm, fr.samples);
+		if (d.mp3) checkPolyphase(d.mp3, pcm, fr.nChans, fr.samples, r);
+		if (fr.nChans == 2) checkDeinterleave(pcm, fr.samples, r);
+		if (keepPcm) r.pcm.insert(r.pcm.end(), pcm, pcm + fr.samples);
+	}
+	mediaClose(d);
+	asmCallsTotal += r.asmCalls;
+	return true;
+}
+
+static uint32_t rd32le(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+//reference samples in 16 bit LSBs, returns false if the file can't be read
+static bool loadReference(const char *filename, std::vector<double> &ref)
+{
+	mediaFile f;
+	if (!mediaLoad(filename, f)) return false;
+
+	const uint8_t *p = f.data;
+	uint32_t size = f.size;
+	int format = 1, bits = 16;
+	const char *ext = strrchr(filename, '.');
+	if (ext && !strcmp(ext, ".wav")) {
+		if (size < 12 || memcmp(p, "RIFF", 4) || memcmp(p + 8, "WAVE", 4)) {
+			mediaFree(f);
+			return false;
+		}
+		uint32_t posi = 12;
+		size = 0;
+		while (posi + 8 <= f.size) {
+			uint32_t len = rd32le(f.data + posi + 4);
+			if (!memcmp(f.data + posi, "fmt ", 4) && len >= 16) {
+				format = f.data[posi + 8] | (f.data[posi + 9] << 8);
+				bits = f.data[posi + 22] | (f.data[posi + 23] << 8);
+				if (format == 0xfffe && len >= 26) format = f.data[posi + 32];	//WAVE_FORMAT_EXTENSIBLE: first byte of the GUID
+			} else if (!memcmp(f.data + posi, "data", 4)) {
+				p = f.data + posi + 8;
+				size = std::min(len, f.size - posi - 8);
+				break;
+			}
+			posi += 8 + len + (len & 1);
+		}
+	}
+
+	int bytes = bits / 8;
+	if ((format != 1 && format != 3) || (format == 3 && bits != 32) || (bits != 16 && bits != 24 && bits != 32)) {
+		mediaFree(f);
+		return false;
+	}
+	for (uint32_t i = 0; i + bytes <= size; i += bytes) {
+		double v;
+		if (format == 3) {
+			uint32_t u = rd32le(p + i);
+			float fl;
+			memcpy(&fl, &u, sizeof(fl));
+			v = fl * 32768.0;
+		} else if (bits == 16) {
+			v = (int16_t)(p[i] | (p[i + 1] << 8));
+		} else if (bits == 24) {
+			v = ((int32_t)((p[i] << 8) | (p[i + 1] << 16) | ((uint32_t)p[i + 2] << 24)) >> 8) / 256.0;
+		} else {
+			v = (int32_t)rd32le(p + i) / 65536.0;
+		}
+		ref.push_back(v);
+	}
+	mediaFree(f);
+	return true;
+}
+
+static void printReference(const std::vector<short> &pcm, const std::vector<double> &ref)
+{
+	size_t n = std::min(pcm.size(), ref.size());
+	double maxErr = 0, sum = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		double e = fabs(pcm[i] - ref[i]);
+		if (e > maxErr) maxErr = e;
+		sum += e * e;
+	}
+	double rms = n ? sqrt(sum / n) : 0;
+	const char *accuracy = (rms < 1 / sqrt(12.0) && maxErr <= 2) ? "full" : rms < 16 / sqrt(12.0) ? "limited" : "none";
+
+	printf("  max %.2f  rms %.3f LSB  %s accuracy", maxErr, rms, accuracy);
+	if (pcm.size() != ref.size()) printf("  (%zu samples, reference %zu)", pcm.size(), ref.size());
+	printf("\n");
+}
+
+static void printStatus(const char *name, const decodeResult &r, uint32_t reference, bool known, bool update)
+{
+	bool ok = known && r.hash == reference;
+	printf("%-28s %6u %6u  %08x %s\n", name, r.frames, r.errors, r.hash,
+		ok ? "ok" : update ? "(updated)" : known ? "MISMATCH" : "(no hash)");
+	if (r.asmDiffs) printf("  %u of %u emulated assembly kernel calls differ from C\n", r.asmDiffs, r.asmCalls);
+}
+
+// decodes one synthetic stream and compares the output with its hash, returns 1 if it fails
+static int checkVector(const char *name, const std::vector<uint8_t> &stream, bool mp3, int sbrMode, int fallbacks, int frames,
+	uint32_t reference, bool update, const char *writeDir, const std::vector<double> *floatRef = 0)
+{
+	if (stream.empty()) {
+		fprintf(stderr, "%s: no stream\n", name);
+		return 1;
+	}
+	if (writeDir && sbrMode == SBR_HQ) {	// the same stream for every mode
+		std::string path = std::string(writeDir) + "/" + name + (mp3 ? ".mp3" : ".aac");
+		FILE *fp = fopen(path.c_str(), "wb");
+		if (!fp || fwrite(&stream[0], 1, stream.size(), fp) != stream.size()) perror(path.c_str());
+		if (fp) fclose(fp);
+	}
+
+	mediaFile f;
+	decodeResult r;
+	if (!mediaLoadBuffer(&stream[0], stream.size(), mp3, f) || !decode(f, r, floatRef != 0, sbrMode)) {
+		fprintf(stderr, "%s: out of memory\n", name);
+		return 1;
+	}
+	mediaFree(f);
+
+	printStatus(name, r, reference, true, update);
+	if (fallbacks > 0) printf("  %d of %d frames %s\n", fallbacks, frames, mp3 ? "without main data" : "with fewer scalefactor bands");
+	if (floatRef) printReference(r.pcm, *floatRef);
+	return ((r.hash != reference || r.errors || fallbacks < 0) && !update) || r.asmDiffs;
+}
+
+static int runVectors(bool update, const char *writeDir)
+{
+	int failed = 0;
+
+	for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+		const synthVector &v = vectors[i];
+		std::vector<uint8_t> stream;
+		std::vector<mp3SynthGranule> granules;
+		std::vector<double> floatRef;
+		int fallbacks = mp3Synthesize(v.params, stream, &granules);
+		bool covered = (v.params.gains == SYNTH_QUIET && mp3RefDecode(granules, floatRef));
+		failed += checkVector(v.name, stream, true, SBR_HQ, fallbacks, v.params.frames, v.reference, update, writeDir,
+			covered ? &floatRef : 0);
+	}
+	for (size_t i = 0; i < sizeof(aacVectors) / sizeof(aacVectors[0]); i++) {
+		const aacSynthVector &v = aacVectors[i];
+		std::vector<uint8_t> stream;
+		int fallbacks = aacSynthesize(v.params, stream);
+		failed += checkVector(v.name, stream, false, v.sbrMode, fallbacks, v.params.frames, v.reference, update, writeDir);
+	}
+	return failed;
+}
+
+static int runManifest(const char *manifest, bool update)
+{
+	FILE *fp = fopen(manifest, "r");
+	if (!fp) {
+		perror(manifest);
+		return 1;
+	}
+
+	std::string dir(manifest);
+	size_t slash = dir.rfind('/');
+	dir = (slash == std::string::npos) ? "" : dir.substr(0, slash + 1);
+
+	std::vector<std::string> lines;
+	char line[1024];
+	int failed = 0;
+	while (fgets(line, sizeof(line), fp)) {
+		char file[512], hash[32], ref[512];
+		lines.push_back(line);
+
+		char *comment = strchr(line, '#');
+		if (comment) *comment = 0;
+		int fields = sscanf(line, "%511s %31s %511s", file, hash, ref);
+		if (fields < 1) continue;
+
+		bool known = (fields >= 2 && strcmp(hash, "-"));
+		uint32_t reference = known ? strtoul(hash, 0, 16) : 0;
+		std::string path = (file[0] == '/') ? file : dir + file;
+
+		mediaFile f;
+		decodeResult r;
+		if (!mediaLoad(path.c_str(), f)) {
+			perror(path.c_str());
+			failed++;
+			continue;
+		}
+		bool decoded = decode(f, r, fields >= 3);
+		mediaFree(f);
+		if (!decoded || !r.frames || (r.hash != reference && !update) || r.asmDiffs) failed++;
+		printStatus(file, r, reference, known, update);
+
+		if (fields >= 3) {
+			std::string refPath = (ref[0] == '/') ? ref : dir + ref;
+			std::vector<double> samples;
+			if (loadReference(refPath.c_str(), samples)) printReference(r.pcm, samples);
+			else printf("  %s: can't read reference (wav: 16/24/32 bit int or 32 bit float, raw: 16 bit)\n", ref);
+		}
+
+		if (update && r.hash != reference) {
+			char buf[1100];
+			if (fields >= 3) snprintf(buf, sizeof(buf), "%s %08x %s\n", file, r.hash, ref);
+			else snprintf(buf, sizeof(buf), "%s %08x\n", file, r.hash);
+			lines.back() = buf;
+		}
+	}
+	fclose(fp);
+
+	if (update) {
+		fp = fopen(manifest, "w");
+		if (!fp) {
+			perror(manifest);
+			return failed + 1;
+		}
+		for (size_t i = 0; i < lines.size(); i++) fputs(lines[i].c_str(), fp);
+		fclose(fp);
+	}
+	return failed;
+}
+
+int main(int argc, char **argv)
+{
+	bool update = false;
+	const char *writeDir = 0;
+	int i;
+
+	for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+		if (!strcmp(argv[i], "-u")) update = true;
+		else if (!strcmp(argv[i], "-w") && i + 1 < argc) writeDir = argv[++i];
+		else {
+			fprintf(stderr, "usage: %s [-u] [-w dir] [manifest...]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	printf("%-28s %6s %6s  %-8s %s\n", "stream", "frames", "errors", "hash", "");
+	int failed = 0;
+	if (i >= argc) failed += runVectors(update, writeDir);
+	for ( ; i < argc; i++) failed += runManifest(argv[i], update);
+	printf("%u assembly kernel calls in the emulator\n", asmCallsTotal);
+	return failed ? 1 : 0;
+}
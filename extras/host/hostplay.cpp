@@ -0,0 +1,200 @@
+/*
+	Helix library Arduino interface - plays files through AudioPlaySdMp3/AudioPlaySdAac on the host
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* usage: hostplay [-d sdroot] [-o out.raw] [-h] [-core] [-lp] file...
+    Runs the unmodified players, one update_all() per audio block, and
+    writes the transmitted blocks as interleaved 16-bit stereo PCM.
+    -core plays HE-AAC without SBR, see AudioPlaySdAac::sbrCoreOnly().
+    -lp plays HE-AAC with low-power SBR, see AudioPlaySdAac::sbrLowPower(). */
+
+#include <stdio.h>
+#include "AudioStream.h"
+#include "SD.h"
+#include "play_sd_mp3.h"
+#include "play_sd_aac.h"
+
+class AudioOutputHost : public AudioStream
+{
+public:
+	AudioOutputHost(void) : AudioStream(2, inputQueueArray), out(NULL), blocks(0), checksum(0) {}
+	virtual void update(void);
+
+	FILE		*out;
+	uint32_t	blocks;
+	uint32_t	checksum;
+private:
+	audio_block_t *inputQueueArray[2];
+};
+
+void AudioOutputHost::update(void)
+{
+	audio_block_t *block[2];
+	int16_t pcm[AUDIO_BLOCK_SAMPLES * 2];
+
+	block[0] = receiveReadOnly(0);
+	block[1] = receiveReadOnly(1);
+	if (!block[0] && !block[1]) return;
+
+	for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+		pcm[2 * i + 0] = block[0] ? block[0]->data[i] : 0;
+		pcm[2 * i + 1] = block[1] ? block[1]->data[i] : 0;
+		checksum = (checksum * 31) + (uint16_t)pcm[2 * i + 0];
+		checksum = (checksum * 31) + (uint16_t)pcm[2 * i + 1];
+	}
+	if (out) fwrite(pcm, sizeof(pcm), 1, out);
+	blocks++;
+
+	if (block[0]) release(block[0]);
+	if (block[1]) release(block[1]);
+}
+
+AudioPlaySdMp3		playMp31;
+AudioPlaySdAac		playAac1;
+AudioOutputHost		out1;
+AudioConnection		patchCord1(playMp31, 0, out1, 0);
+AudioConnection		patchCord2(playMp31, 1, out1, 1);
+AudioConnection		patchCord3(playAac1, 0, out1, 0);
+AudioConnection		patchCord4(playAac1, 1, out1, 1);
+
+static bool isMp3(const char *filename)
+{
+	const char *ext = strrchr(filename, '.');
+	return ext && strcasecmp(ext, ".mp3") == 0;
+}
+
+static void printHistogram(const char *name, const AudioCodecHistogram *h)
+{
+	printf("  %s: %u runs, max %u cycles\n", name, h->count, h->max);
+	for (int n = 0; n < CODEC_HIST_BUCKETS; n++) {
+		if (!h->bucket[n]) continue;
+		printf("    >= %9u cycles: %6u (%5.1f%%)\n", histogramBucketCycles(n), h->bucket[n],
+			100.0 * h->bucket[n] / h->count);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const char *root = NULL;
+	const char *outname = NULL;
+	bool hist = false;
+	int i;
+
+	for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+		if (!strcmp(argv[i], "-d") && i + 1 < argc) root = argv[++i];
+		else if (!strcmp(argv[i], "-o") && i + 1 < argc) outname = argv[++i];
+		else if (!strcmp(argv[i], "-h")) hist = true;
+		else if (!strcmp(argv[i], "-core")) playAac1.sbrCoreOnly(true);
+		else if (!strcmp(argv[i], "-lp")) playAac1.sbrLowPower(true);
+		else {
+			fprintf(stderr, "usage: %s [-d sdroot] [-o out.raw] [-h] [-core] [-lp] file...\n", argv[0]);
+			return 1;
+		}
+	}
+
+	AudioMemory(8);
+	SD.begin(root);
+
+	if (outname) {
+		out1.out = fopen(outname, "wb");
+		if (!out1.out) {
+			perror(outname);
+			return 1;
+		}
+	}
+
+	int failed = 0;
+	for ( ; i < argc; i++) {
+		AudioCodec *codec;
+		int err;
+
+		out1.blocks = 0;
+		out1.checksum = 0;
+		codec = &playMp31;
+		codec->resetEvents();
+		playMp31.processorUsageHistogramReset();
+		playAac1.processorUsageHistogramReset();
+		uint64_t t = host_nanos();
+
+		if (isMp3(argv[i])) {
+			err = playMp31.play(argv[i]);
+			codec = &playMp31;
+			while (playMp31.isPlaying()) AudioStream::update_all();
+		} else {
+			err = playAac1.play(argv[i]);
+			codec = &playAac1;
+			while (playAac1.isPlaying()) AudioStream::update_all();
+		}
+		t = host_nanos() - t;
+
+		if (err) {
+			printf("%s: error %d\n", argv[i], err);
+			failed++;
+			continue;
+		}
+
+		double secs = (double)out1.blocks * AUDIO_BLOCK_SAMPLES / AUDIO_SAMPLE_RATE_EXACT;
+		printf("%s: %u blocks, %.2f s audio, %.3f s wall, %.1fx realtime, checksum %08x, lastError %d\n",
+			argv[i], out1.blocks, secs, t / 1e9, t ? secs / (t / 1e9) : 0.0, out1.checksum, codec->getLastError());
+		if (isMp3(argv[i])) {
+			MP3MemInfo mem;
+			playMp31.memoryUsageDecoder(&mem);
+			printf("  decoder max %.2f%%, SD max %.2f%%\n", playMp31.processorUsageMaxDecoder(), playMp31.processorUsageMaxSD());
+			printf("  heap: decoder %d, buffers %u bytes, stack peak %d bytes\n", mem.total, (unsigned)playMp31.memoryUsageBuffers(), mem.stackPeak);
+		} else {
+			AACMemInfo mem;
+			playAac1.memoryUsageDecoder(&mem);
+			printf("  decoder max %.2f%%, SD max %.2f%%\n", playAac1.processorUsageMaxDecoder(), playAac1.processorUsageMaxSD());
+			printf("  heap: decoder %d, buffers %u bytes, stack peak %d bytes\n", mem.total, (unsigned)playAac1.memoryUsageBuffers(), mem.stackPeak);
+		}
+		AudioCodecEvent ev[CODEC_EVENTS];
+		codec->getEvents(ev);
+		printf("  underruns %u, late %u, skipped %u, allocate failed %u, decoder errors %u\n",
+			ev[CODEC_EVENT_UNDERRUN].count, ev[CODEC_EVENT_LATE].count, ev[CODEC_EVENT_SKIPPED].count,
+			ev[CODEC_EVENT_ALLOCATE].count, ev[CODEC_EVENT_DECODE_ERROR].count);
+		if (hist) {
+			AudioCodecHistogram hdec, hsd;
+			if (isMp3(argv[i])) playMp31.processorUsageHistogram(&hdec, &hsd);
+			else playAac1.processorUsageHistogram(&hdec, &hsd);
+			printHistogram("decoder", &hdec);
+			printHistogram("SD", &hsd);
+		}
+	}
+
+	if (out1.out) fclose(out1.out);
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,188 @@
+/*
+	Helix library Arduino interface - DSP kernel microbenchmarks on the host
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* usage: kernelbench [-t seconds] [-u] [-c dir] [kernel...]
+    Runs the hot DSP kernels of both decoders in isolation:
+      mp3: FDCT32, FDCT32Half (and FDCT32HalfFull, the same input through all 32 subbands),
+           PolyphaseMono, PolyphaseStereo, PolyphaseStereoPlanar, idct9, imdct12,
+           AntiAliasIMDCT36, IMDCT12x3 (long and short blocks of HybridTransform),
+           DecodeHuffman, DequantChannel, DequantChannelJS (joint stereo)
+      aac: R4FFT, DCT4 (short and long blocks)
+      sbr: QMFAnalysisConv, QMFSynthesisConv
+    Each kernel is fed reproducible random input (xorshift32, seeds
+    1..KERNEL_SEEDS). The hash of all outputs must match the reference in the
+    kernel table, so a rewrite can be checked for bit-exactness before it is
+    timed. Prints ns per kernel call (median and minimum of the runs).
+    The ...Thumb2 kernels run the Cortex-M4 assembly in the emulator
+    (thumbemu.h) on the same input and have the hash of the C version. They
+    print emulated cycles per call (mean over the seeds) instead of ns. The
+    .S files are read from the library directory at run time.
+    The ...M4 kernels do the same with the C versions as a compiler builds
+    them for the Cortex-M4, so the assembly can be compared with what it
+    replaces. They need the output of m4ref_mp3.c and m4ref_aac.c (see there
+    for the command) in the directory given with -c.
+
+    -t  time per kernel, default 0.5 s
+    -u  print the hashes as they are now, to update the tables after an
+        intended change of the output
+    -c  directory of m4ref_mp3.s and m4ref_aac.s, runs the ...M4 kernels
+
+    g++ -O2 -I. extras/host/kernelbench.cpp extras/host/kernels_mp3.cpp extras/host/kernels_aac.cpp extras/host/kernels_sbr.cpp extras/host/thumbemu.cpp -o kernelbench */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "kernelbench.h"
+
+const char *m4RefDir = 0;
+
+const char *m4RefSource(const char *file)
+{
+	static std::string path;
+	path = std::string(m4RefDir) + "/" + file;
+	return path.c_str();
+}
+
+static bool m4RefKernel(const benchKernel &k)
+{
+	size_t n = strlen(k.name);
+	return n > 2 && !strcmp(k.name + n - 2, "M4");
+}
+
+static uint64_t nanos(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint32_t kernelHash(const benchKernel &k, double *cycles)
+{
+	uint32_t h = BENCH_HASH_INIT;
+
+	*cycles = 0;
+	for (uint32_t seed = 1; seed <= KERNEL_SEEDS; seed++) {
+		k.init(seed);
+		k.prepare();
+		k.run();
+		uint32_t out = k.hash();
+		h = benchHash(h, &out, sizeof(out));
+		if (k.cycles) *cycles += k.cycles();
+	}
+	*cycles /= KERNEL_SEEDS;
+	return h;
+}
+
+static void kernelTime(const benchKernel &k, double seconds, double *median, double *min)
+{
+	std::vector<uint32_t> ns;
+	uint64_t end = nanos() + (uint64_t)(seconds * 1e9);
+
+	k.init(1);
+	do {
+		k.prepare();
+		uint64_t t = nanos();
+		k.run();
+		ns.push_back((uint32_t)(nanos() - t));
+	} while (nanos() < end);
+
+	std::sort(ns.begin(), ns.end());
+	*median = (double)ns[ns.size() / 2] / k.batch;
+	*min = (double)ns[0] / k.batch;
+}
+
+static bool selected(const char *name, int argc, char **argv, int first)
+{
+	if (first >= argc) return true;
+	for (int i = first; i < argc; i++)
+		if (!strcmp(argv[i], name)) return true;
+	return false;
+}
+
+int main(int argc, char **argv)
+{
+	double seconds = 0.5;
+	bool update = false;
+	int i;
+
+	for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+		if (!strcmp(argv[i], "-t") && i + 1 < argc) seconds = atof(argv[++i]);
+		else if (!strcmp(argv[i], "-u")) update = true;
+		else if (!strcmp(argv[i], "-c") && i + 1 < argc) m4RefDir = argv[++i];
+		else {
+			fprintf(stderr, "usage: %s [-t seconds] [-u] [-c dir] [kernel...]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	const struct { const benchKernel *k; int n; } tables[] = {
+		{ mp3Kernels, mp3NumKernels },
+		{ aacKernels, aacNumKernels },
+		{ sbrKernels, sbrNumKernels },
+	};
+
+	printf("%-28s %6s %10s %10s  %-8s %s\n", "kernel", "batch", "median ns", "min ns", "hash", "");
+	int failed = 0;
+	for (size_t t = 0; t < sizeof(tables) / sizeof(tables[0]); t++) {
+		for (int n = 0; n < tables[t].n; n++) {
+			const benchKernel &k = tables[t].k[n];
+			if (!selected(k.name, argc, argv, i)) continue;
+			if (m4RefKernel(k) && !m4RefDir) continue;
+
+			double cycles;
+			uint32_t h = kernelHash(k, &cycles);
+			bool ok = (h == k.reference);
+			if (!ok && !update) failed++;
+			const char *result = ok ? "ok" : update ? "(updated)" : "MISMATCH";
+
+			if (k.cycles) {
+				printf("%-28s %6d %10.0f %10s  %08x %s\n", k.name, k.batch, cycles, "cycles", h, result);
+				continue;
+			}
+			double median = 0, min = 0;
+			if (ok || update) kernelTime(k, seconds, &median, &min);
+			printf("%-28s %6d %10.1f %10.1f  %08x %s\n", k.name, k.batch, median, min, h, result);
+		}
+	}
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,96 @@
+/*
+	Helix library Arduino interface - DSP kernel microbenchmarks on the host
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* Shared between kernelbench.cpp and the kernels_*.cpp files, see kernelbench.cpp */
+
+#ifndef kernelbench_h_
+#define kernelbench_h_
+
+#include <stdint.h>
+
+struct benchKernel {
+	const char	*name;
+	int			batch;					// kernel calls per run()
+	void		(*init)(uint32_t seed);	// random input
+	void		(*prepare)(void);		// copy the input to the work buffers (not timed)
+	void		(*run)(void);			// batch calls of the kernel
+	uint32_t	(*hash)(void);			// of the output
+	uint32_t	reference;				// hash of seeds 1..KERNEL_SEEDS, see kernelbench.cpp
+	double		(*cycles)(void);		// assembly kernels run in thumbemu: emulated cycles per call of the last run(), 0 for host kernels
+};
+
+#define KERNEL_SEEDS	16
+
+// kernelbench -c: the ...M4 kernels run the C kernels compiled for the Cortex-M4 (m4ref_*.c)
+// from this directory, without -c they are skipped
+extern const char *m4RefDir;
+const char *m4RefSource(const char *file);
+
+extern const benchKernel mp3Kernels[];
+extern const int mp3NumKernels;
+extern const benchKernel aacKernels[];
+extern const int aacNumKernels;
+extern const benchKernel sbrKernels[];
+extern const int sbrNumKernels;
+
+// xorshift32, reproducible on every host
+static inline uint32_t benchRandom(uint32_t *state)
+{
+	uint32_t x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return *state = x;
+}
+
+// n values with gb guard bits (range +- 2^(31-gb))
+static inline void benchFill(int *buf, int n, int gb, uint32_t *state)
+{
+	for (int i = 0; i < n; i++) buf[i] = (int)benchRandom(state) >> gb;
+}
+
+static inline uint32_t benchHash(uint32_t h, const void *buf, int bytes)
+{
+	const uint8_t *p = (const uint8_t *)buf;
+	for (int i = 0; i < bytes; i++) h = (h ^ p[i]) * 16777619u;	//FNV-1a
+	return h;
+}
+
+#define BENCH_HASH_INIT	2166136261u
+
+#endif
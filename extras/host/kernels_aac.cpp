@@ -0,0 +1,305 @@
+/*
+	Helix library Arduino interface - AAC kernels for kernelbench
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* R4FFT (aac/fft.c) and DCT4 (aac/dct4.c), for short (tabidx 0) and long
+    (tabidx 1) blocks - one run is one channel of one frame. The ...Thumb2
+    kernels run the same input through asmfft_thumb2.S in thumbemu and must
+    give the same hashes. Their cycles are per transform, the BitReverse() in
+    front of R4FFTPassesThumb2 is C and not counted. The ...M4 kernels
+    (kernelbench -c) run the C versions compiled for the Cortex-M4
+    (m4ref_aac.c), R4FFT without BitReverse() as well.
+    Upsample is UpsampleCore (aac/upsample.c) of one stereo frame, it has no
+    assembly, UpsampleM4 gives its Cortex-M4 cycles. */
+
+#include <string.h>
+#include "aac.cpp"
+#include "kernelbench.h"
+#include "thumbemu.h"
+
+static int		input[2 * 1024];
+static int		work[2 * 1024];
+
+static uint32_t seedState(uint32_t seed)
+{
+	return seed * 2654435761u + 2;
+}
+
+static void prepareWork(void)
+{
+	memcpy(work, input, sizeof(work));
+}
+
+static uint32_t hashWork(void)
+{
+	return benchHash(BENCH_HASH_INIT, work, sizeof(work));
+}
+
+/* R4FFT, complex interleaved input, guard bits as after PreMultiply */
+static void initR4FFT64(uint32_t seed)
+{
+	uint32_t s = seedState(seed);
+	benchFill(input, 8 * 2 * 64, 5, &s);
+}
+
+static void runR4FFT64(void)
+{
+	for (int i = 0; i < 8; i++)
+		R4FFT(0, work + i * 2 * 64);
+}
+
+static void initR4FFT512(uint32_t seed)
+{
+	uint32_t s = seedState(seed);
+	benchFill(input, 2 * 512, 8, &s);
+}
+
+static void runR4FFT512(void)
+{
+	R4FFT(1, work);
+}
+
+/* DCT4 as called by IMDCT(), minimum guard bits in */
+static void initDCT4(uint32_t seed)
+{
+	uint32_t s = seedState(seed);
+	benchFill(input, 1024, GBITS_IN_DCT4, &s);
+}
+
+static void runDCT4_128(void)
+{
+	for (int i = 0; i < 8; i++)
+		DCT4(0, work + i * 128, GBITS_IN_DCT4);
+}
+
+static void runDCT4_1024(void)
+{
+	DCT4(1, work, GBITS_IN_DCT4);
+}
+
+/* UpsampleCore, stereo: interleaved full-scale core PCM in front of the room for
+   the output, then the history of both channels */
+#define UP_PCM		(2 * 2 * AAC_MAX_NSAMPS)
+#define UP_SHORTS	(UP_PCM + 2 * UPSAMPLE_HIST_LEN)
+
+static short	upInput[UP_SHORTS];
+static short	upWork[UP_SHORTS];
+
+static void initUpsample(uint32_t seed)
+{
+	uint32_t s = seedState(seed);
+	memset(upInput, 0, sizeof(upInput));
+	for (int i = 0; i < 2 * AAC_MAX_NSAMPS; i++)
+		upInput[i] = (short)(benchRandom(&s) >> 16);
+	for (int i = 0; i < 2 * UPSAMPLE_HIST_LEN; i++)
+		upInput[UP_PCM + i] = (short)(benchRandom(&s) >> 16);
+}
+
+static void prepareUpsample(void)
+{
+	memcpy(upWork, upInput, sizeof(upWork));
+}
+
+static uint32_t hashUpsample(void)
+{
+	return benchHash(BENCH_HASH_INIT, upWork, sizeof(upWork));
+}
+
+static void runUpsample(void)
+{
+	UpsampleChannel(upWork, 2, upWork + UP_PCM);
+	UpsampleChannel(upWork + 1, 2, upWork + UP_PCM + UPSAMPLE_HIST_LEN);
+}
+
+/* asmfft_thumb2.S, emulated */
+static thumbEmu	emu;
+static uint32_t	emuCos4Sin4, emuCos1Sin1, emuTwidEven, emuTwidOdd, emuWork;
+static int		emuCalls;
+
+static void emuSetup(void)
+{
+	if (emu.linked) return;
+	if (!emuLoad(emu, emuSource("asmfft_thumb2.S"))) exit(1);
+	emuCos4Sin4 = emuAlloc(emu, sizeof(cos4sin4tab));
+	emuCos1Sin1 = emuAlloc(emu, sizeof(cos1sin1tab));
+	emuTwidEven = emuAlloc(emu, sizeof(twidTabEven));
+	emuTwidOdd = emuAlloc(emu, sizeof(twidTabOdd));
+	emuWork = emuAlloc(emu, sizeof(work));
+	memcpy(emuPtr(emu, emuCos4Sin4), cos4sin4tab, sizeof(cos4sin4tab));
+	memcpy(emuPtr(emu, emuCos1Sin1), cos1sin1tab, sizeof(cos1sin1tab));
+	memcpy(emuPtr(emu, emuTwidEven), twidTabEven, sizeof(twidTabEven));
+	memcpy(emuPtr(emu, emuTwidOdd), twidTabOdd, sizeof(twidTabOdd));
+}
+
+/* n transforms of size len, as R4FFT() or the normal path of DCT4() do on ARM */
+static void runEmu(int tabidx, int n, int len, bool dct4)
+{
+	emuSetup();
+	if (!dct4) {
+		for (int i = 0; i < n; i++)
+			BitReverse(work + i * len, tabidx);
+	}
+	memcpy(emuPtr(emu, emuWork), work, sizeof(work));
+	emu.cycles = 0;
+	emuCalls = n;
+	for (int i = 0; i < n; i++) {
+		uint32_t x = emuWork + 4 * i * len;
+		if (dct4)
+			emuCall(emu, "raac_PreMultiplyBitRevThumb2", { (uint32_t)tabidx, x, emuCos4Sin4 + 4 * cos4sin4tabOffset[tabidx] });
+		emuCall(emu, "raac_R4FFTPassesThumb2", { (uint32_t)tabidx, x, tabidx ? emuTwidOdd : emuTwidEven });
+		if (dct4)
+			emuCall(emu, "raac_PostMultiplyThumb2", { (uint32_t)tabidx, x, emuCos1Sin1 });
+	}
+	memcpy(work, emuPtr(emu, emuWork), sizeof(work));
+}
+
+static void runR4FFT64Thumb2(void)
+{
+	runEmu(0, 8, 2 * 64, false);
+}
+
+static void runR4FFT512Thumb2(void)
+{
+	runEmu(1, 1, 2 * 512, false);
+}
+
+static void runDCT4_128Thumb2(void)
+{
+	runEmu(0, 8, 128, true);
+}
+
+static void runDCT4_1024Thumb2(void)
+{
+	runEmu(1, 1, 1024, true);
+}
+
+static double emuCycles(void)
+{
+	return (double)emu.cycles / emuCalls;
+}
+
+/* the C R4FFT, DCT4 and UpsampleCore compiled for the Cortex-M4 (m4ref_aac.s), emulated */
+static thumbEmu	emuM4;
+static uint32_t	emuM4Work, emuM4Up;
+
+static void emuMemclr(thumbEmu &e)
+{
+	memset(emuPtr(e, emuArg(e, 0)), 0, emuArg(e, 1));
+}
+
+static void emuM4Setup(void)
+{
+	if (!emuM4.linked) {
+		if (!emuLoad(emuM4, m4RefSource("m4ref_aac.s"))) exit(1);
+		emuFunction(emuM4, "__aeabi_memclr4", emuMemclr);
+		emuM4Work = emuAlloc(emuM4, sizeof(work));
+		emuM4Up = emuAlloc(emuM4, sizeof(upWork));
+	}
+}
+
+static void runM4(int tabidx, int n, int len, bool dct4)
+{
+	emuM4Setup();
+	if (!dct4) {
+		for (int i = 0; i < n; i++)
+			BitReverse(work + i * len, tabidx);
+	}
+	memcpy(emuPtr(emuM4, emuM4Work), work, sizeof(work));
+	emuM4.cycles = 0;
+	emuCalls = n;
+	for (int i = 0; i < n; i++) {
+		uint32_t x = emuM4Work + 4 * i * len;
+		if (dct4)
+			emuCall(emuM4, "raac_DCT4", { (uint32_t)tabidx, x, GBITS_IN_DCT4 });
+		else
+			emuCall(emuM4, "m4ref_R4FFTPasses", { (uint32_t)tabidx, x });
+	}
+	memcpy(work, emuPtr(emuM4, emuM4Work), sizeof(work));
+}
+
+static void runR4FFT64M4(void)
+{
+	runM4(0, 8, 2 * 64, false);
+}
+
+static void runR4FFT512M4(void)
+{
+	runM4(1, 1, 2 * 512, false);
+}
+
+static void runDCT4_128M4(void)
+{
+	runM4(0, 8, 128, true);
+}
+
+static void runDCT4_1024M4(void)
+{
+	runM4(1, 1, 1024, true);
+}
+
+static void runUpsampleM4(void)
+{
+	emuM4Setup();
+	memcpy(emuPtr(emuM4, emuM4Up), upWork, sizeof(upWork));
+	emuM4.cycles = 0;
+	emuCalls = 1;
+	emuCall(emuM4, "m4ref_UpsampleStereo", { emuM4Up, emuM4Up + 2 * UP_PCM });
+	memcpy(upWork, emuPtr(emuM4, emuM4Up), sizeof(upWork));
+}
+
+static double emuM4Cycles(void)
+{
+	return (double)emuM4.cycles / emuCalls;
+}
+
+const benchKernel aacKernels[] = {
+	{ "R4FFT-64",	8,	initR4FFT64,	prepareWork,	runR4FFT64,		hashWork,	0xe6a72904,	0 },
+	{ "R4FFT-512",	1,	initR4FFT512,	prepareWork,	runR4FFT512,	hashWork,	0xccefbb24,	0 },
+	{ "DCT4-128",	8,	initDCT4,		prepareWork,	runDCT4_128,	hashWork,	0x3d942cbb,	0 },
+	{ "DCT4-1024",	1,	initDCT4,		prepareWork,	runDCT4_1024,	hashWork,	0xa2f4d0f1,	0 },
+	{ "Upsample",	1,	initUpsample,	prepareUpsample,	runUpsample,	hashUpsample,	0x8f3e08c6,	0 },
+	{ "R4FFT-64Thumb2",		8,	initR4FFT64,	prepareWork,	runR4FFT64Thumb2,	hashWork,	0xe6a72904,	emuCycles },
+	{ "R4FFT-512Thumb2",	1,	initR4FFT512,	prepareWork,	runR4FFT512Thumb2,	hashWork,	0xccefbb24,	emuCycles },
+	{ "DCT4-128Thumb2",		8,	initDCT4,		prepareWork,	runDCT4_128Thumb2,	hashWork,	0x3d942cbb,	emuCycles },
+	{ "DCT4-1024Thumb2",	1,	initDCT4,		prepareWork,	runDCT4_1024Thumb2,	hashWork,	0xa2f4d0f1,	emuCycles },
+	{ "R4FFT-64M4",			8,	initR4FFT64,	prepareWork,	runR4FFT64M4,		hashWork,	0xe6a72904,	emuM4Cycles },
+	{ "R4FFT-512M4",		1,	initR4FFT512,	prepareWork,	runR4FFT512M4,		hashWork,	0xccefbb24,	emuM4Cycles },
+	{ "DCT4-128M4",			8,	initDCT4,		prepareWork,	runDCT4_128M4,		hashWork,	0x3d942cbb,	emuM4Cycles },
+	{ "DCT4-1024M4",		1,	initDCT4,		prepareWork,	runDCT4_1024M4,		hashWork,	0xa2f4d0f1,	emuM4Cycles },
+	{ "UpsampleM4",			1,	initUpsample,	prepareUpsample,	runUpsampleM4,		hashUpsample,	0x8f3e08c6,	emuM4Cycles },
+};
+const int aacNumKernels = sizeof(aacKernels) / sizeof(aacKernels[0]);
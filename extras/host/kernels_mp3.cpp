@@ -0,0 +1,690 @@
+/*
+	Helix library Arduino interface - MP3 kernels for kernelbench
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* FDCT32, PolyphaseMono/Stereo/StereoPlanar (mp3/dct32.c, mp3/polyphase.c) and the static
+    idct9/imdct12 of mp3/imdct.c - the whole decoder is included to reach them.
+    The ...Thumb2 kernels run the same input through the assembly in thumbemu
+    and must give the same hashes, the ...M4 kernels (kernelbench -c) the C
+    versions compiled for the Cortex-M4 (m4ref_mp3.c). */
+
+#include <string.h>
+#include "mp3.cpp"
+#include "kernelbench.h"
+#include "thumbemu.h"
+
+#define NBLOCKS	18	// subband blocks per granule
+
+static int		input[NBLOCKS * 32];
+static int		work[NBLOCKS * 32];
+static int		vbufIn[MAX_NCHAN * VBUF_LENGTH];
+static int		vbuf[MAX_NCHAN * VBUF_LENGTH];
+static short	pcm[NBLOCKS * NBANDS * MAX_NCHAN];
+
+static uint32_t seedState(uint32_t seed)
+{
+	return seed * 2654435761u + 1;
+}
+
+/* FDCT32, as called by Subband(), 6 guard bits in */
+static void initFDCT32(uint32_t seed)
+{
+	uint32_t s = seedState(seed);
+	benchFill(input, NBLOCKS * 32, 6, &s);
+}
+
+static void prepareFDCT32(void)
+{
+	memcpy(work, input, sizeof(work));
+	memset(vbuf, 0, sizeof(vbuf));
+}
+
+static void runFDCT32(void)
+{
+	int vindex = 0;
+	for (int b = 0; b < NBLOCKS; b++) {
+		FDCT32(work + 32 * b, vbuf, vindex, (b & 0x01), 6, 32);
+		vindex = (vindex - (b & 0x01)) & 7;
+	}
+}
+
+static uint32_t hashFDCT32(void)
+{
+	return benchHash(BENCH_HASH_INIT, vbuf, sizeof(vbuf));
+}
+
+/* FDCT32 on band-limited input (upper 16 subbands zero), as for 11 kHz lowpassed streams.
+   FDCT32Half skips the upper half (nActive = 16), FDCT32HalfFull transforms all 32 subbands
+   of the same input, both must have the same hash */
+static void initFDCT32Half(uint32_t seed)
+{
+	initFDCT32(seed);
+	for (int b = 0; b < NBLOCKS; b++)
+		memset(input + 32 * b + 16, 0, 16 * sizeof(int));
+}
+
+static void runFDCT32Half(void)
+{
+	int vindex = 0;
+	for (int b = 0; b < NBLOCKS; b++) {
+		FDCT32(work + 32 * b, vbuf, vindex, (b & 0x01), 6, 16);
+		vindex = (vindex - (b & 0x01)) & 7;
+	}
+}
+
+/* FDCT32Thumb2 (asmdct32_thumb2.S), emulated, falls back to the C FDCT32 for gb < 6 */
+static thumbEmu	emuDct;
+static uint32_t	emuDctWork, emuDctVbuf;
+
+static void emuFDCT32(thumbEmu &e)
+{
+	FDCT32((int *)emuPtr(e, emuArg(e, 0)), (int *)emuPtr(e, emuArg(e, 1)), emuArg(e, 2), emuArg(e, 3), emuArg(e, 4), emuArg(e, 5));
+}
+
+static void runFDCT32Emu(thumbEmu &e, uint32_t eWork, uint32_t eVbuf, const char *func, int nActive)
+{
+	memcpy(emuPtr(e, eWork), work, sizeof(work));
+	memcpy(emuPtr(e, eVbuf), vbuf, sizeof(vbuf));
+	e.cycles = 0;
+	int vindex = 0;
+	for (int b = 0; b < NBLOCKS; b++) {
+		emuCall(e, func, { eWork + 4 * 32 * b, eVbuf, (uint32_t)vindex, (uint32_t)(b & 0x01), 6, (uint32_t)nActive });
+		vindex = (vindex - (b & 0x01)) & 7;
+	}
+	memcpy(work, emuPtr(e, eWork), sizeof(work));
+	memcpy(vbuf, emuPtr(e, eVbuf), sizeof(vbuf));
+}
+
+static void emuDctSetup(void)
+{
+	if (emuDct.linked) return;
+	if (!emuLoad(emuDct, emuSource("asmdct32_thumb2.S"))) exit(1);
+	emuFunction(emuDct, "xmp3_FDCT32", emuFDCT32);
+	emuDctWork = emuAlloc(emuDct, sizeof(work));
+	emuDctVbuf = emuAlloc(emuDct, sizeof(vbuf));
+}
+
+static void runFDCT32Thumb2(void)
+{
+	emuDctSetup();
+	runFDCT32Emu(emuDct, emuDctWork, emuDctVbuf, "xmp3_FDCT32Thumb2", 32);
+}
+
+static void runFDCT32HalfThumb2(void)
+{
+	emuDctSetup();
+	runFDCT32Emu(emuDct, emuDctWork, emuDctVbuf, "xmp3_FDCT32Thumb2", 16);
+}
+
+static double emuDctCycles(void)
+{
+	return (double)emuDct.cycles / NBLOCKS;
+}
+
+/* PolyphaseMono/Stereo on a random vbuf, 3 guard bits */
+static void initPolyphase(uint32_t seed)
+{
+	uint32_t s = seedState(seed);
+	benchFill(vbufIn, MAX_NCHAN * VBUF_LENGTH, 3, &s);
+}
+
+static void preparePolyphase(void)
+{
+	memcpy(vbuf, vbufIn, sizeof(vbuf));
+}
+
+static void runPolyphaseMono(void)
+{
+	int vindex = 0;
+	for (int b = 0; b < NBLOCKS; b++) {
+		PolyphaseMono(pcm + b * NBANDS, vbuf + vindex + VBUF_LENGTH * (b & 0x01), polyCoef);
+		vindex = (vindex - (b & 0x01)) & 7;
+	}
+}
+
+static void runPolyphaseStereo(void)
+{
+	int vindex = 0;
+	for (int b = 0; b < NBLOCKS; b++) {
+		PolyphaseStereo(pcm + b * NBANDS * 2, vbuf + vindex + VBUF_LENGTH * (b & 0x01), polyCoef);
+		vindex = (vindex - (b & 0x01)) & 7;
+	}
+}
+
+static void runPolyphaseStereoPlanar(void)
+{
+	int vindex = 0;
+	for (int b = 0; b < NBLOCKS; b++) {
+		PolyphaseStereoPlanar(pcm + b * NBANDS, pcm + (NBLOCKS + b) * NBANDS, vbuf + vindex + VBUF_LENGTH * (b & 0x01), polyCoef);
+		vindex = (vindex - (b & 0x01)) & 7;
+	}
+}
+
+static uint32_t hashPolyphaseMono(void)
+{
+	return benchHash(BENCH_HASH_INIT, pcm, NBLOCKS * NBANDS * sizeof(short));
+}
+
+static uint32_t hashPolyphaseStereo(void)
+{
+	return benchHash(BENCH_HASH_INIT, pcm, NBLOCKS * NBANDS * 2 * sizeof(short));
+}
+
+/* hashed interleaved, so it has to match PolyphaseStereo */
+static uint32_t hashPolyphaseStereoPlanar(void)
+{
+	short lr[NBLOCKS * NBANDS * 2];
+	for (int i = 0; i < NBLOCKS * NBANDS; i++) {
+		lr[2 * i + 0] = pcm[i];
+		lr[2 * i + 1] = pcm[NBLOCKS * NBANDS + i];
+	}
+	return benchHash(BENCH_HASH_INIT, lr, sizeof(lr));
+}
+
+/* the same in asmpoly_thumb2.S, emulated */
+static thumbEmu	emuPoly;
+static uint32_t	emuPolyVbuf, emuPolyCoef, emuPolyPcm;
+
+static void runPolyphaseEmu(int nChans, bool planar)
+{
+	if (!emuPoly.linked) {
+		if (!emuLoad(emuPoly, emuSource("asmpoly_thumb2.S"))) exit(1);
+		emuPolyVbuf = emuAlloc(emuPoly, sizeof(vbuf));
+		emuPolyCoef = emuAlloc(emuPoly, sizeof(polyCoef));
+		emuPolyPcm = emuAlloc(emuPoly, sizeof(pcm));
+		memcpy(emuPtr(emuPoly, emuPolyCoef), polyCoef, sizeof(polyCoef));
+	}
+	memcpy(emuPtr(emuPoly, emuPolyVbuf), vbuf, sizeof(vbuf));
+	emuPoly.cycles = 0;
+	int vindex = 0;
+	for (int b = 0; b < NBLOCKS; b++) {
+		uint32_t v = emuPolyVbuf + 4 * (vindex + VBUF_LENGTH * (b & 0x01));
+		if (planar)
+			emuCall(emuPoly, "xmp3_PolyphaseStereoPlanar", { emuPolyPcm + 2 * b * NBANDS, emuPolyPcm + 2 * (NBLOCKS + b) * NBANDS, v, emuPolyCoef });
+		else if (nChans == 2)
+			emuCall(emuPoly, "xmp3_PolyphaseStereo", { emuPolyPcm + 2 * b * NBANDS * 2, v, emuPolyCoef });
+		else
+			emuCall(emuPoly, "xmp3_PolyphaseMono", { emuPolyPcm + 2 * b * NBANDS, v, emuPolyCoef });
+		vindex = (vindex - (b & 0x01)) & 7;
+	}
+	memcpy(pcm, emuPtr(emuPoly, emuPolyPcm), sizeof(pcm));
+}
+
+static void runPolyphaseMonoThumb2(void)
+{
+	runPolyphaseEmu(1, false);
+}
+
+static void runPolyphaseStereoThumb2(void)
+{
+	runPolyphaseEmu(2, false);
+}
+
+static void runPolyphaseStereoPlanarThumb2(void)
+{
+	runPolyphaseEmu(2, true);
+}
+
+static double emuPolyCycles(void)
+{
+	return (double)emuPoly.cycles / NBLOCKS;
+}
+
+/* idct9, even and odd half of each long block (IMDCT36), 3 guard bits */
+static void initIdct9(uint32_t seed)
+{
+	uint32_t s = seedState(seed);
+	benchFill(input, NBLOCKS * 32, 3, &s);
+}
+
+static void prepareWork(void)
+{
+	memcpy(work, input, sizeof(work));
+}
+
+static void runIdct9(void)
+{
+	for (int b = 0; b < 2 * NBLOCKS * 32 / 18; b++)
+		idct9(work + 9 * b);
+}
+
+static uint32_t hashWork(void)
+{
+	return benchHash(BENCH_HASH_INIT, work, sizeof(work));
+}
+
+/* imdct12, three interleaved short blocks per subband (IMDCT12x3), 4 guard bits */
+static void initImdct12(uint32_t seed)
+{
+	uint32_t s = seedState(seed);
+	benchFill(input, NBLOCKS * 32, 4, &s);
+}
+
+static void runImdct12(void)
+{
+	for (int b = 0; b < NBLOCKS * 32 / 18; b++) {
+		imdct12(input + 18 * b + 0, work + 18 * b + 0);
+		imdct12(input + 18 * b + 1, work + 18 * b + 6);
+		imdct12(input + 18 * b + 2, work + 18 * b + 12);
+	}
+}
+
+/* the long blocks of HybridTransform() with window type 0 (AntiAlias + IMDCT36, the
+   butterflies across all but the last upper edge) and its short blocks (IMDCT12x3, all
+   previous window types), one granule of 32 subbands with 7 guard bits - the cases
+   asmimdct_thumb2.S covers. The output, the overlap and mOut are hashed. */
+static int		hybPrevIn[NBANDS * 9], hybPrev[NBANDS * 9];
+static int		hybY[BLOCK_SIZE][NBANDS];
+static int		hybMOut;
+
+static void initHybrid(uint32_t seed)
+{
+	uint32_t s = seedState(seed);
+	benchFill(input, NBANDS * 18, 7, &s);
+	benchFill(hybPrevIn, NBANDS * 9, 3, &s);
+}
+
+static void prepareHybrid(void)
+{
+	memcpy(work, input, sizeof(work));
+	memcpy(hybPrev, hybPrevIn, sizeof(hybPrev));
+	memset(hybY, 0, sizeof(hybY));
+	hybMOut = 0;
+}
+
+static void runIMDCT36(void)
+{
+	for (int i = 0; i < NBANDS; i++) {
+		if (i < NBANDS - 1)
+			AntiAlias(work + 18 * i, 1);
+		hybMOut |= IMDCT36(work + 18 * i, hybPrev + 9 * i, &hybY[0][i], 0, 0, i, 7);
+	}
+}
+
+static void runIMDCT12x3(void)
+{
+	for (int i = 0; i < NBANDS; i++)
+		hybMOut |= IMDCT12x3(work + 18 * i, hybPrev + 9 * i, &hybY[0][i], i & 0x03, i, 7);
+}
+
+static uint32_t hashHybrid(void)
+{
+	uint32_t h = benchHash(BENCH_HASH_INIT, hybY, sizeof(hybY));
+	h = benchHash(h, hybPrev, sizeof(hybPrev));
+	return benchHash(h, &hybMOut, sizeof(hybMOut));
+}
+
+/* AntiAliasIMDCT36Thumb2 and IMDCT12x3Thumb2 (asmimdct_thumb2.S), emulated */
+static thumbEmu	emuImdct;
+static uint32_t	emuImX, emuImPrev, emuImY;
+
+static void emuImdctSetup(void)
+{
+	if (emuImdct.linked) return;
+	if (!emuLoad(emuImdct, emuSource("asmimdct_thumb2.S"))) exit(1);
+	uint32_t t = emuAlloc(emuImdct, sizeof(csa));
+	memcpy(emuPtr(emuImdct, t), csa, sizeof(csa));
+	emuSymbol(emuImdct, "xmp3_csa", t);
+	t = emuAlloc(emuImdct, sizeof(imdctWin));
+	memcpy(emuPtr(emuImdct, t), imdctWin, sizeof(imdctWin));
+	emuSymbol(emuImdct, "xmp3_imdctWin", t);
+	emuImX = emuAlloc(emuImdct, sizeof(work));
+	emuImPrev = emuAlloc(emuImdct, sizeof(hybPrev));
+	emuImY = emuAlloc(emuImdct, sizeof(hybY));
+}
+
+/* func36 (long blocks) or func12 (short blocks) with the arguments of the Thumb2 kernels */
+static void runHybridEmu(thumbEmu &e, uint32_t eX, uint32_t ePrev, uint32_t eY, const char *func36, const char *func12, bool shortBlocks)
+{
+	memcpy(emuPtr(e, eX), work, sizeof(work));
+	memcpy(emuPtr(e, ePrev), hybPrev, sizeof(hybPrev));
+	memcpy(emuPtr(e, eY), hybY, sizeof(hybY));
+	e.cycles = 0;
+	for (uint32_t i = 0; i < NBANDS; i++) {
+		uint32_t x = eX + 4 * 18 * i, prev = ePrev + 4 * 9 * i, y = eY + 4 * i;
+		if (shortBlocks)
+			hybMOut |= emuCall(e, func12, { x, prev, y, i & 0x03, i });
+		else
+			hybMOut |= emuCall(e, func36, { x, prev, y, i, i < NBANDS - 1 });
+	}
+	memcpy(work, emuPtr(e, eX), sizeof(work));
+	memcpy(hybPrev, emuPtr(e, ePrev), sizeof(hybPrev));
+	memcpy(hybY, emuPtr(e, eY), sizeof(hybY));
+}
+
+static void runAntiAliasIMDCT36Thumb2(void)
+{
+	emuImdctSetup();
+	runHybridEmu(emuImdct, emuImX, emuImPrev, emuImY, "xmp3_AntiAliasIMDCT36Thumb2", "xmp3_IMDCT12x3Thumb2", false);
+}
+
+static void runIMDCT12x3Thumb2(void)
+{
+	emuImdctSetup();
+	runHybridEmu(emuImdct, emuImX, emuImPrev, emuImY, "xmp3_AntiAliasIMDCT36Thumb2", "xmp3_IMDCT12x3Thumb2", true);
+}
+
+static double emuImdctCycles(void)
+{
+	return (double)emuImdct.cycles / NBANDS;
+}
+
+/* the C FDCT32, AntiAlias + IMDCT36 and IMDCT12x3 compiled for the Cortex-M4 (m4ref_mp3.s), emulated */
+static thumbEmu	emuM4;
+static uint32_t	emuM4Work, emuM4Vbuf, emuM4X, emuM4Prev, emuM4Y;
+static int		emuM4Calls;
+
+static void emuM4Setup(void)
+{
+	if (emuM4.linked) return;
+	if (!emuLoad(emuM4, m4RefSource("m4ref_mp3.s"))) exit(1);
+	emuM4Work = emuAlloc(emuM4, sizeof(work));
+	emuM4Vbuf = emuAlloc(emuM4, sizeof(vbuf));
+	emuM4X = emuAlloc(emuM4, sizeof(work));
+	emuM4Prev = emuAlloc(emuM4, sizeof(hybPrev));
+	emuM4Y = emuAlloc(emuM4, sizeof(hybY));
+}
+
+static void runFDCT32M4(void)
+{
+	emuM4Setup();
+	emuM4Calls = NBLOCKS;
+	runFDCT32Emu(emuM4, emuM4Work, emuM4Vbuf, "xmp3_FDCT32", 32);
+}
+
+static void runFDCT32HalfM4(void)
+{
+	emuM4Setup();
+	emuM4Calls = NBLOCKS;
+	runFDCT32Emu(emuM4, emuM4Work, emuM4Vbuf, "xmp3_FDCT32", 16);
+}
+
+static void runAntiAliasIMDCT36M4(void)
+{
+	emuM4Setup();
+	emuM4Calls = NBANDS;
+	runHybridEmu(emuM4, emuM4X, emuM4Prev, emuM4Y, "m4ref_AntiAliasIMDCT36", "m4ref_IMDCT12x3", false);
+}
+
+static void runIMDCT12x3M4(void)
+{
+	emuM4Setup();
+	emuM4Calls = NBANDS;
+	runHybridEmu(emuM4, emuM4X, emuM4Prev, emuM4Y, "m4ref_AntiAliasIMDCT36", "m4ref_IMDCT12x3", true);
+}
+
+static double emuM4Cycles(void)
+{
+	return (double)emuM4.cycles / emuM4Calls;
+}
+
+/* DecodeHuffmanPairs on every used table and DecodeHuffmanQuads on both count1
+   tables, one granule (576 values) each. Random bits hit the codewords with
+   probability 2^-length, which is the distribution the tables were built for.
+   Every other call gets a short bitsLeft, so the end-of-data paths are hashed too. */
+#define HUFF_BUFBYTES	4096
+#define HUFF_CALLS		(HUFF_PAIRTABS - 2 + 2)
+
+static unsigned char	huffBuf[HUFF_BUFBYTES];
+static int				huffBits[HUFF_CALLS], huffOffset[HUFF_CALLS];
+static int				huffOut[HUFF_CALLS][MAX_NSAMP + 1];
+
+static void initHuffman(uint32_t seed)
+{
+	uint32_t s = seedState(seed);
+	for (int i = 0; i < HUFF_BUFBYTES; i++) huffBuf[i] = (unsigned char)benchRandom(&s);
+	for (int c = 0; c < HUFF_CALLS; c++) {
+		huffOffset[c] = benchRandom(&s) & 0x07;
+		huffBits[c] = (c & 0x01) ? (int)(benchRandom(&s) % 2048) : (HUFF_BUFBYTES - 8) * 8;
+	}
+}
+
+static void prepareHuffman(void)
+{
+	memset(huffOut, 0, sizeof(huffOut));
+}
+
+static void runHuffman(void)
+{
+	int c = 0;
+	for (int t = 0; t < HUFF_PAIRTABS; t++) {
+		if (huffTabLookup[t].tabType == invalidTab) continue;
+		huffOut[c][MAX_NSAMP] = DecodeHuffmanPairs(huffOut[c], MAX_NSAMP, t, huffBits[c], huffBuf, huffOffset[c]);
+		c++;
+	}
+	for (int t = 0; t < 2; t++, c++)
+		huffOut[c][MAX_NSAMP] = DecodeHuffmanQuads(huffOut[c], MAX_NSAMP, t, huffBits[c], huffBuf, huffOffset[c]);
+}
+
+static uint32_t hashHuffman(void)
+{
+	return benchHash(BENCH_HASH_INIT, huffOut, sizeof(huffOut));
+}
+
+/* DequantChannel on long, short and mixed granules (44.1 kHz MPEG 1 bands). The codewords
+   follow roughly what music gives: mostly 0..3, some up to 15, a few big ones (linbits)
+   and rarely very big ones. Random scalefactors and gains, some of them out of range on
+   purpose so the clipping is hashed too. */
+#define DQ_CALLS		8
+
+static int					dqIn[DQ_CALLS][MAX_NSAMP];
+static int					dqOut[DQ_CALLS][MAX_NSAMP + 2];
+static int					dqWork[MAX_REORDER_SAMPS];
+static SideInfoSub			dqSis[DQ_CALLS];
+static ScaleFactorInfoSub	dqSfis[DQ_CALLS];
+static CriticalBandInfo		dqCbi[DQ_CALLS];
+
+static void dqCodewords(int *x, int n, uint32_t *s)
+{
+	for (int i = 0; i < n; i++) {
+		uint32_t r = benchRandom(s);
+		int v, p = r % 100;
+		if (p < 50)			v = 0;
+		else if (p < 80)	v = 1 + (r >> 8) % 3;
+		else if (p < 95)	v = 4 + (r >> 8) % 12;
+		else if (p < 99)	v = 16 + (r >> 8) % 48;
+		else				v = 64 + (r >> 8) % (15 + 8191 - 64);
+		x[i] = (v && (r & 0x80000000)) ? (v | 0x80000000) : v;
+	}
+}
+
+static void initDequant(uint32_t seed)
+{
+	uint32_t s = seedState(seed);
+	for (int c = 0; c < DQ_CALLS; c++) {
+		dqCodewords(dqIn[c], MAX_NSAMP, &s);
+		memset(&dqSis[c], 0, sizeof(SideInfoSub));
+		dqSis[c].blockType = (c < 4 ? 0 : 2);
+		dqSis[c].mixedBlock = (c == 7);
+		dqSis[c].globalGain = (c == 3 ? 20 : 130 + (int)(benchRandom(&s) % 80));
+		dqSis[c].sfactScale = c & 0x01;
+		dqSis[c].preFlag = (c == 1);
+		for (int w = 0; w < 3; w++) dqSis[c].subBlockGain[w] = benchRandom(&s) & 0x07;
+		for (int b = 0; b < 23; b++) dqSfis[c].l[b] = benchRandom(&s) & 0x0f;
+		for (int b = 0; b < 13; b++)
+			for (int w = 0; w < 3; w++) dqSfis[c].s[b][w] = benchRandom(&s) & 0x0f;
+	}
+}
+
+static void prepareDequant(void)
+{
+	for (int c = 0; c < DQ_CALLS; c++) memcpy(dqOut[c], dqIn[c], sizeof(dqIn[c]));
+	memset(dqCbi, 0, sizeof(dqCbi));
+}
+
+static void runDequant(void)
+{
+	FrameHeader fh;
+	memset(&fh, 0, sizeof(fh));
+	fh.ver = MPEG1;
+	fh.sfBand = &sfBandTable[MPEG1][0];
+	for (int c = 0; c < DQ_CALLS; c++) {
+		fh.modeExt = (c & 0x02) ? 2 : 0;
+		dqOut[c][MAX_NSAMP + 1] = (c == 2 ? 300 : MAX_NSAMP);	/* nonZeroBound */
+		dqOut[c][MAX_NSAMP] = DequantChannel(dqOut[c], dqWork, &dqOut[c][MAX_NSAMP + 1], &fh, &dqSis[c], &dqSfis[c], &dqCbi[c], 0);
+	}
+}
+
+static uint32_t hashDequant(void)
+{
+	return benchHash(benchHash(BENCH_HASH_INIT, dqOut, sizeof(dqOut)), dqCbi, sizeof(dqCbi));
+}
+
+/* Joint stereo inside DequantChannel (DequantBlockJS, ReorderJS), called like Dequantize():
+   right channel first, then StereoSetup() and the left channel with the StereoInfo. Mid-side
+   and intensity, long and short blocks, MPEG 1 and MPEG 2 intensity positions. The right
+   channel stops early so there is an intensity region. */
+#define JS_PAIRS		6
+
+struct jsPair {
+	int		ver;		// MPEG1 or MPEG2
+	int		modeExt;	// 2 mid-side, 1 intensity, 3 both
+	int		blockType;
+	int		nzRight;	// nonZeroBound of the right channel
+};
+
+static const jsPair jsPairs[JS_PAIRS] = {
+	{ MPEG1, 2, 0, MAX_NSAMP },
+	{ MPEG1, 3, 0, 300 },
+	{ MPEG1, 3, 2, 330 },
+	{ MPEG1, 1, 2, 200 },
+	{ MPEG2, 1, 0, 250 },
+	{ MPEG2, 3, 2, 280 },
+};
+
+static int					jsIn[JS_PAIRS][2][MAX_NSAMP];
+static int					jsOut[JS_PAIRS][2][MAX_NSAMP + 2];
+static int					jsGb[JS_PAIRS][2];
+static SideInfoSub			jsSis[JS_PAIRS][2];
+static ScaleFactorInfoSub	jsSfis[JS_PAIRS][2];
+static CriticalBandInfo		jsCbi[JS_PAIRS][2];
+
+static void initDequantJS(uint32_t seed)
+{
+	uint32_t s = seedState(seed);
+	for (int c = 0; c < JS_PAIRS; c++) {
+		for (int ch = 0; ch < 2; ch++) {
+			dqCodewords(jsIn[c][ch], MAX_NSAMP, &s);
+			if (ch == 1) memset(jsIn[c][1] + jsPairs[c].nzRight, 0, (MAX_NSAMP - jsPairs[c].nzRight) * sizeof(int));
+			memset(&jsSis[c][ch], 0, sizeof(SideInfoSub));
+			jsSis[c][ch].blockType = jsPairs[c].blockType;
+			jsSis[c][ch].globalGain = 130 + (int)(benchRandom(&s) % 80);
+			jsSis[c][ch].sfactScale = c & 0x01;
+			for (int w = 0; w < 3; w++) jsSis[c][ch].subBlockGain[w] = benchRandom(&s) & 0x07;
+			for (int b = 0; b < 23; b++) jsSfis[c][ch].l[b] = benchRandom(&s) & 0x0f;
+			for (int b = 0; b < 13; b++)
+				for (int w = 0; w < 3; w++) jsSfis[c][ch].s[b][w] = benchRandom(&s) & 0x0f;
+		}
+	}
+}
+
+static void prepareDequantJS(void)
+{
+	for (int c = 0; c < JS_PAIRS; c++)
+		for (int ch = 0; ch < 2; ch++) memcpy(jsOut[c][ch], jsIn[c][ch], sizeof(jsIn[c][ch]));
+	memset(jsCbi, 0, sizeof(jsCbi));
+}
+
+static void runDequantJS(void)
+{
+	FrameHeader fh;
+	ScaleFactorJS sfjs;
+	StereoInfo sti;
+
+	memset(&fh, 0, sizeof(fh));
+	sfjs.intensityScale = 1;
+	for (int r = 0; r < 4; r++) sfjs.slen[r] = 4 - (r >> 1);
+	for (int c = 0; c < JS_PAIRS; c++) {
+		const jsPair &p = jsPairs[c];
+		int *xl = jsOut[c][0], *xr = jsOut[c][1];
+		fh.ver = (MPEGVersion)p.ver;
+		fh.sfBand = &sfBandTable[p.ver][0];
+		fh.modeExt = p.modeExt;
+		for (int r = 0; r < 4; r++) sfjs.nr[r] = (p.blockType == 2 ? 3 : (r ? 5 : 6));
+
+		xl[MAX_NSAMP + 1] = MAX_NSAMP;
+		xr[MAX_NSAMP + 1] = p.nzRight;
+		jsGb[c][1] = DequantChannel(xr, dqWork, &xr[MAX_NSAMP + 1], &fh, &jsSis[c][1], &jsSfis[c][1], &jsCbi[c][1], 0);
+		if (jsGb[c][1] < 1) {
+			for (int i = 0; i < xr[MAX_NSAMP + 1]; i++) {
+				if (xr[i] < -0x3fffffff) xr[i] = -0x3fffffff;
+				if (xr[i] >  0x3fffffff) xr[i] =  0x3fffffff;
+			}
+		}
+
+		StereoSetup(&sti, &fh, &jsSfis[c][1], &jsCbi[c][1], &sfjs, xr[MAX_NSAMP + 1]);
+		sti.xr = xr;
+		sti.mOut[0] = sti.mOut[1] = 0;
+		DequantChannel(xl, dqWork, &xl[MAX_NSAMP + 1], &fh, &jsSis[c][0], &jsSfis[c][0], &jsCbi[c][0], &sti);
+		jsGb[c][0] = CLZ(sti.mOut[0]) - 1;
+		jsGb[c][1] = CLZ(sti.mOut[1]) - 1;
+	}
+}
+
+static uint32_t hashDequantJS(void)
+{
+	uint32_t h = benchHash(BENCH_HASH_INIT, jsOut, sizeof(jsOut));
+	return benchHash(benchHash(h, jsGb, sizeof(jsGb)), jsCbi, sizeof(jsCbi));
+}
+
+const benchKernel mp3Kernels[] = {
+	{ "FDCT32",				NBLOCKS,					initFDCT32,		prepareFDCT32,		runFDCT32,			hashFDCT32,				0x1d897354,	0 },
+	{ "FDCT32Half",			NBLOCKS,					initFDCT32Half,	prepareFDCT32,		runFDCT32Half,		hashFDCT32,				0x8bd9401a,	0 },
+	{ "FDCT32HalfFull",		NBLOCKS,					initFDCT32Half,	prepareFDCT32,		runFDCT32,			hashFDCT32,				0x8bd9401a,	0 },
+	{ "FDCT32Thumb2",		NBLOCKS,					initFDCT32,		prepareFDCT32,		runFDCT32Thumb2,	hashFDCT32,				0x1d897354,	emuDctCycles },
+	{ "FDCT32HalfThumb2",	NBLOCKS,					initFDCT32Half,	prepareFDCT32,		runFDCT32HalfThumb2,	hashFDCT32,			0x8bd9401a,	emuDctCycles },
+	{ "FDCT32M4",			NBLOCKS,					initFDCT32,		prepareFDCT32,		runFDCT32M4,		hashFDCT32,				0x1d897354,	emuM4Cycles },
+	{ "FDCT32HalfM4",		NBLOCKS,					initFDCT32Half,	prepareFDCT32,		runFDCT32HalfM4,	hashFDCT32,				0x8bd9401a,	emuM4Cycles },
+	{ "PolyphaseMono",		NBLOCKS,					initPolyphase,	preparePolyphase,	runPolyphaseMono,	hashPolyphaseMono,		0x1200a9ea,	0 },
+	{ "PolyphaseStereo",	NBLOCKS,					initPolyphase,	preparePolyphase,	runPolyphaseStereo,	hashPolyphaseStereo,	0x41f15a44,	0 },
+	{ "PolyphaseStereoPlanar",	NBLOCKS,				initPolyphase,	preparePolyphase,	runPolyphaseStereoPlanar,	hashPolyphaseStereoPlanar,	0x41f15a44,	0 },
+	{ "PolyphaseMonoThumb2",	NBLOCKS,				initPolyphase,	preparePolyphase,	runPolyphaseMonoThumb2,		hashPolyphaseMono,		0x1200a9ea,	emuPolyCycles },
+	{ "PolyphaseStereoThumb2",	NBLOCKS,				initPolyphase,	preparePolyphase,	runPolyphaseStereoThumb2,	hashPolyphaseStereo,	0x41f15a44,	emuPolyCycles },
+	{ "PolyphaseStereoPlanarThumb2",	NBLOCKS,		initPolyphase,	preparePolyphase,	runPolyphaseStereoPlanarThumb2,	hashPolyphaseStereoPlanar,	0x41f15a44,	emuPolyCycles },
+	{ "idct9",				2 * NBLOCKS * 32 / 18,		initIdct9,		prepareWork,		runIdct9,			hashWork,				0xabb7e588,	0 },
+	{ "imdct12",			3 * NBLOCKS * 32 / 18,		initImdct12,	prepareWork,		runImdct12,			hashWork,				0xe272077e,	0 },
+	{ "AntiAliasIMDCT36",	NBANDS,						initHybrid,		prepareHybrid,		runIMDCT36,			hashHybrid,				0x3e604708,	0 },
+	{ "AntiAliasIMDCT36Thumb2",	NBANDS,					initHybrid,		prepareHybrid,		runAntiAliasIMDCT36Thumb2,	hashHybrid,		0x3e604708,	emuImdctCycles },
+	{ "AntiAliasIMDCT36M4",	NBANDS,						initHybrid,		prepareHybrid,		runAntiAliasIMDCT36M4,	hashHybrid,			0x3e604708,	emuM4Cycles },
+	{ "IMDCT12x3",			NBANDS,						initHybrid,		prepareHybrid,		runIMDCT12x3,		hashHybrid,				0xe8dc73ab,	0 },
+	{ "IMDCT12x3Thumb2",	NBANDS,						initHybrid,		prepareHybrid,		runIMDCT12x3Thumb2,	hashHybrid,				0xe8dc73ab,	emuImdctCycles },
+	{ "IMDCT12x3M4",		NBANDS,						initHybrid,		prepareHybrid,		runIMDCT12x3M4,		hashHybrid,				0xe8dc73ab,	emuM4Cycles },
+	{ "DecodeHuffman",		HUFF_CALLS,					initHuffman,	prepareHuffman,		runHuffman,			hashHuffman,			0x359f1715,	0 },
+	{ "DequantChannel",		DQ_CALLS,					initDequant,	prepareDequant,		runDequant,			hashDequant,			0xbb127fce,	0 },
+	{ "DequantChannelJS",	JS_PAIRS,					initDequantJS,	prepareDequantJS,	runDequantJS,		hashDequantJS,			0x6772e0f4,	0 },
+};
+const int mp3NumKernels = sizeof(mp3Kernels) / sizeof(mp3Kernels[0]);
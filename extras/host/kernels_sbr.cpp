@@ -0,0 +1,193 @@
+/*
+	Helix library Arduino interface - SBR QMF kernels for kernelbench
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* QMFAnalysisConv and QMFSynthesisConv (aac/sbrqmf.c), linked from the
+    aac.cpp that kernels_aac.cpp builds. One run is one channel of one frame,
+    32 QMF slots. The ...Thumb2 kernels run the same input through
+    asmqmf_thumb2.S in thumbemu and must give the same hashes, the ...M4
+    kernels (kernelbench -c) the C versions compiled for the Cortex-M4
+    (m4ref_aac.c). */
+
+#include <string.h>
+#include "common/assembly.h"
+#include "aac/aacdec.h"
+#include "aac/sbr.h"
+#include "kernelbench.h"
+#include "thumbemu.h"
+
+#define NSLOTS	32
+
+static int		delayA[10 * 32];
+static int		delayS[10 * 128];
+static int		uBuf[NSLOTS * 64];
+static short	pcm[NSLOTS * 64];
+
+static uint32_t seedState(uint32_t seed)
+{
+	return seed * 2654435761u + 3;
+}
+
+/* the delay lines are only read, so there is nothing to prepare */
+static void prepareNone(void)
+{
+}
+
+/* analysis: 32-bit PCM from the AAC core, synthesis: QMF samples with MIN_GBITS_IN_QMFS */
+static void initQMF(uint32_t seed)
+{
+	uint32_t s = seedState(seed);
+	benchFill(delayA, 10 * 32, 8, &s);
+	benchFill(delayS, 10 * 128, MIN_GBITS_IN_QMFS, &s);
+}
+
+static void runQMFAnalysisConv(void)
+{
+	for (int i = 0; i < NSLOTS; i++)
+		QMFAnalysisConv((int *)cTabA, delayA, i % 10, uBuf + i * 64);
+}
+
+static uint32_t hashQMFAnalysisConv(void)
+{
+	return benchHash(BENCH_HASH_INIT, uBuf, sizeof(uBuf));
+}
+
+static void runQMFSynthesisConv(void)
+{
+	for (int i = 0; i < NSLOTS; i++)
+		QMFSynthesisConv((int *)cTabS, delayS, i % 10, pcm + i * 64, 1);
+}
+
+static uint32_t hashQMFSynthesisConv(void)
+{
+	return benchHash(BENCH_HASH_INIT, pcm, sizeof(pcm));
+}
+
+/* asmqmf_thumb2.S and the C convolutions compiled for the Cortex-M4 (m4ref_aac.s), emulated */
+struct qmfEmu {
+	thumbEmu	e;
+	uint32_t	tabA, tabS, delayA, delayS, u, pcm;
+};
+static qmfEmu	emu, emuM4;
+
+static void emuSetup(qmfEmu &q, const char *path)
+{
+	if (q.e.linked) return;
+	if (!emuLoad(q.e, path)) exit(1);
+	q.tabA = emuAlloc(q.e, sizeof(cTabA));
+	q.tabS = emuAlloc(q.e, sizeof(cTabS));
+	q.delayA = emuAlloc(q.e, sizeof(delayA));
+	q.delayS = emuAlloc(q.e, sizeof(delayS));
+	q.u = emuAlloc(q.e, sizeof(uBuf));
+	q.pcm = emuAlloc(q.e, sizeof(pcm));
+	memcpy(emuPtr(q.e, q.tabA), cTabA, sizeof(cTabA));
+	memcpy(emuPtr(q.e, q.tabS), cTabS, sizeof(cTabS));
+}
+
+static void runAnalysisEmu(qmfEmu &q, const char *func)
+{
+	memcpy(emuPtr(q.e, q.delayA), delayA, sizeof(delayA));
+	q.e.cycles = 0;
+	for (int i = 0; i < NSLOTS; i++)
+		emuCall(q.e, func, { q.tabA, q.delayA, (uint32_t)(i % 10), q.u + i * 64 * 4 });
+	memcpy(uBuf, emuPtr(q.e, q.u), sizeof(uBuf));
+}
+
+static void runSynthesisEmu(qmfEmu &q, const char *func)
+{
+	memcpy(emuPtr(q.e, q.delayS), delayS, sizeof(delayS));
+	q.e.cycles = 0;
+	for (int i = 0; i < NSLOTS; i++)
+		emuCall(q.e, func, { q.tabS, q.delayS, (uint32_t)(i % 10), q.pcm + i * 64 * 2, 1 });
+	memcpy(pcm, emuPtr(q.e, q.pcm), sizeof(pcm));
+}
+
+static void runQMFAnalysisConvThumb2(void)
+{
+	emuSetup(emu, emuSource("asmqmf_thumb2.S"));
+	runAnalysisEmu(emu, "raac_QMFAnalysisConvThumb2");
+}
+
+static void runQMFSynthesisConvThumb2(void)
+{
+	emuSetup(emu, emuSource("asmqmf_thumb2.S"));
+	runSynthesisEmu(emu, "raac_QMFSynthesisConvThumb2");
+}
+
+static double emuCycles(void)
+{
+	return (double)emu.e.cycles / NSLOTS;
+}
+
+static void emuMemclr(thumbEmu &e)
+{
+	memset(emuPtr(e, emuArg(e, 0)), 0, emuArg(e, 1));
+}
+
+static void emuM4Setup(void)
+{
+	if (emuM4.e.linked) return;
+	emuSetup(emuM4, m4RefSource("m4ref_aac.s"));
+	emuFunction(emuM4.e, "__aeabi_memclr4", emuMemclr);
+}
+
+static void runQMFAnalysisConvM4(void)
+{
+	emuM4Setup();
+	runAnalysisEmu(emuM4, "raac_QMFAnalysisConv");
+}
+
+static void runQMFSynthesisConvM4(void)
+{
+	emuM4Setup();
+	runSynthesisEmu(emuM4, "raac_QMFSynthesisConv");
+}
+
+static double emuM4Cycles(void)
+{
+	return (double)emuM4.e.cycles / NSLOTS;
+}
+
+const benchKernel sbrKernels[] = {
+	{ "QMFAnalysisConv",	NSLOTS,	initQMF,	prepareNone,	runQMFAnalysisConv,		hashQMFAnalysisConv,	0xb49de3ce,	0 },
+	{ "QMFSynthesisConv",	NSLOTS,	initQMF,	prepareNone,	runQMFSynthesisConv,	hashQMFSynthesisConv,	0xe042dbc4,	0 },
+	{ "QMFAnalysisConvThumb2",	NSLOTS,	initQMF,	prepareNone,	runQMFAnalysisConvThumb2,	hashQMFAnalysisConv,	0xb49de3ce,	emuCycles },
+	{ "QMFSynthesisConvThumb2",	NSLOTS,	initQMF,	prepareNone,	runQMFSynthesisConvThumb2,	hashQMFSynthesisConv,	0xe042dbc4,	emuCycles },
+	{ "QMFAnalysisConvM4",		NSLOTS,	initQMF,	prepareNone,	runQMFAnalysisConvM4,		hashQMFAnalysisConv,	0xb49de3ce,	emuM4Cycles },
+	{ "QMFSynthesisConvM4",		NSLOTS,	initQMF,	prepareNone,	runQMFSynthesisConvM4,		hashQMFSynthesisConv,	0xe042dbc4,	emuM4Cycles },
+};
+const int sbrNumKernels = sizeof(sbrKernels) / sizeof(sbrKernels[0]);
@@ -0,0 +1,51 @@
+/*
+	Helix library Arduino interface - AAC decoder for the Cortex-M4 cycle count
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* The whole AAC decoder (aac.cpp, with SBR and the C versions of the kernels that
+    have Cortex-M4 assembly), for compiling to Cortex-M4 assembly. codecbench -c runs
+    the output in thumbemu and prints emulated cycles per frame, see m4ref_mp3.c.
+    -fno-jump-tables because thumbemu has no tbb/tbh for the switch statements:
+
+    arm-none-eabi-gcc -mcpu=cortex-m4 -mthumb -O2 -fno-jump-tables -S -I. -Iaac extras/host/m4dec_aac.c -o m4dec_aac.s */
+
+#define AAC_FFT_C			/* the C kernels, not asmfft_thumb2.S / asmqmf_thumb2.S */
+#define AAC_QMF_C
+
+#include <stdlib.h>
+#include <string.h>
+#include "aac.cpp"
@@ -0,0 +1,80 @@
+/*
+	Helix library Arduino interface - C AAC kernels for the Cortex-M4 reference
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* The C versions of the AAC and SBR kernels that have Cortex-M4 assembly (R4FFT,
+    DCT4, QMFAnalysisConv, QMFSynthesisConv), and the core-only upsampler that has
+    none (upsample.c), for compiling to Cortex-M4 assembly.
+    kernelbench -c runs the output in thumbemu as the ...M4 kernels, see m4ref_mp3.c:
+
+    arm-none-eabi-gcc -mcpu=cortex-m4 -mthumb -O2 -S -I. -Iaac extras/host/m4ref_aac.c -o m4ref_aac.s */
+
+#define AAC_FFT_C			/* the C kernels, not asmfft_thumb2.S / asmqmf_thumb2.S */
+#define AAC_QMF_C
+
+#include <stdlib.h>
+#include "common/assembly.h"
+#include "aac/aacdec.h"
+#include "aac/sbr.h"
+#include "aac/fft.c"
+#include "aac/dct4.c"
+#include "aac/trigtabs.c"
+#include "aac/upsample.c"
+#include "aac/sbrfft.c"
+#include "aac/sbrqmf.c"
+#include "aac/sbrtabs.c"
+
+/* R4FFT without its BitReverse(), what R4FFTPassesThumb2 does */
+void m4ref_R4FFTPasses(int tabidx, int *x)
+{
+	int nfft = nfftTab[tabidx];
+
+	if (nfftlog2Tab[tabidx] & 0x1) {
+		R8FirstPass(x, nfft >> 3);
+		R4Core(x, nfft >> 5, 8, (int *)twidTabOdd);
+	} else {
+		R4FirstPass(x, nfft >> 2);
+		R4Core(x, nfft >> 4, 4, (int *)twidTabEven);
+	}
+}
+
+/* UpsampleCore() of a stereo frame, without the AACDecInfo around it */
+void m4ref_UpsampleStereo(short *pcm, short *hist)
+{
+	UpsampleChannel(pcm, 2, hist);
+	UpsampleChannel(pcm + 1, 2, hist + UPSAMPLE_HIST_LEN);
+}
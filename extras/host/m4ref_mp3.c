@@ -0,0 +1,70 @@
+/*
+	Helix library Arduino interface - C MP3 kernels for the Cortex-M4 reference
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* The C versions of the MP3 kernels that have Cortex-M4 assembly (FDCT32,
+    AntiAlias + IMDCT36, IMDCT12x3), for compiling to Cortex-M4 assembly. kernelbench -c
+    runs the output in thumbemu as the ...M4 kernels, so the C code as the compiler
+    builds it for the Teensy can be compared with the hand-written assembly:
+
+    arm-none-eabi-gcc -mcpu=cortex-m4 -mthumb -O2 -S -I. -Imp3 extras/host/m4ref_mp3.c -o m4ref_mp3.s
+
+    Only the .s file is used, there is nothing to link. */
+
+#define MP3_FDCT32_C		/* the C kernels, not asmdct32_thumb2.S / asmimdct_thumb2.S */
+#define MP3_IMDCT_C
+
+#include <stdlib.h>
+#include "common/assembly.h"
+#include "mp3/coder.h"
+#include "mp3/dct32.c"
+#include "mp3/imdct.c"
+#include "mp3/trigtabs.c"
+
+/* what AntiAliasIMDCT36Thumb2 does for one long block with window type 0 */
+int m4ref_AntiAliasIMDCT36(int *xCurr, int *xPrev, int *y, int blockIdx, int antiAlias)
+{
+	if (antiAlias)
+		AntiAlias(xCurr, 1);
+	return IMDCT36(xCurr, xPrev, y, 0, 0, blockIdx, 7);
+}
+
+/* what IMDCT12x3Thumb2 does for one short block */
+int m4ref_IMDCT12x3(int *xCurr, int *xPrev, int *y, int btPrev, int blockIdx)
+{
+	return IMDCT12x3(xCurr, xPrev, y, btPrev, blockIdx, 7);
+}
@@ -0,0 +1,294 @@
+/*
+	Helix library Arduino interface - file loading and frame-by-frame decoding for the host tools
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* see mediafile.h */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#include "mediafile.h"
+
+static uint64_t nanos(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint32_t rd32(const uint8_t *p)
+{
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+//returns position of the atom's header, or 0
+static uint32_t findAtom(mediaFile &f, const char *atom, uint32_t posi, uint32_t end)
+{
+	while (posi + 8 <= end) {
+		uint32_t size = rd32(f.data + posi);
+		if (!memcmp(f.data + posi + 4, atom, 4)) return posi;
+		if (size < 8) break;
+		posi += size;
+	}
+	return 0;
+}
+
+static uint32_t atomEnd(mediaFile &f, uint32_t atom)
+{
+	return atom + rd32(f.data + atom);
+}
+
+//build the sample table (stsz/stsc/stco) of the first track, returns false if no MP4
+static bool setupMp4(mediaFile &f)
+{
+	if (f.size < 8 || memcmp(f.data + 4, "ftyp", 4)) return false;	//findAtom() returns 0 for not found
+
+	uint32_t moov = findAtom(f, "moov", 0, f.size);
+	uint32_t trak = moov ? findAtom(f, "trak", moov + 8, atomEnd(f, moov)) : 0;
+	uint32_t mdia = trak ? findAtom(f, "mdia", trak + 8, atomEnd(f, trak)) : 0;
+	uint32_t minf = mdia ? findAtom(f, "minf", mdia + 8, atomEnd(f, mdia)) : 0;
+	uint32_t stbl = minf ? findAtom(f, "stbl", minf + 8, atomEnd(f, minf)) : 0;
+	if (!stbl) return false;
+	uint32_t e = atomEnd(f, stbl);
+	uint32_t stsd = findAtom(f, "stsd", stbl + 8, e);
+	uint32_t stsz = findAtom(f, "stsz", stbl + 8, e);
+	uint32_t stsc = findAtom(f, "stsc", stbl + 8, e);
+	uint32_t stco = findAtom(f, "stco", stbl + 8, e);
+	if (!stsd || !stsz || !stsc || !stco) return false;
+
+	//same fields as AudioPlaySdAac::setupMp4()
+	f.channels = (f.data[stsd + 8 + 0x20] << 8) | f.data[stsd + 8 + 0x21];
+	f.samplerate = rd32(f.data + stsd + 8 + 0x26) & 0xffff;
+	int ascChannels, ascSamplerate;
+	uint32_t esds = stsd + 8 + 0x2c;
+	if (esds < e && AACParseESDS(f.data + esds, e - esds, &ascChannels, &ascSamplerate) == ERR_AAC_NONE) {
+		if (ascChannels) f.channels = ascChannels;
+		f.samplerate = ascSamplerate;
+	}
+
+	uint32_t fixedSize = rd32(f.data + stsz + 12);
+	uint32_t nSamples = rd32(f.data + stsz + 16);
+	uint32_t nChunks = rd32(f.data + stco + 12);
+	uint32_t nStsc = rd32(f.data + stsc + 12);
+	uint32_t sample = 0;
+
+	for (uint32_t chunk = 0; chunk < nChunks && sample < nSamples; chunk++) {
+		//samples per chunk: last stsc entry with firstChunk <= chunk + 1
+		uint32_t perChunk = 0;
+		for (uint32_t i = 0; i < nStsc; i++) {
+			if (rd32(f.data + stsc + 16 + i * 12) > chunk + 1) break;
+			perChunk = rd32(f.data + stsc + 16 + i * 12 + 4);
+		}
+		uint32_t offset = rd32(f.data + stco + 16 + chunk * 4);
+		for (uint32_t i = 0; i < perChunk && sample < nSamples; i++, sample++) {
+			uint32_t size = fixedSize ? fixedSize : rd32(f.data + stsz + 20 + sample * 4);
+			if (offset + size > f.size) return true;
+			f.sampleOffset.push_back(offset);
+			f.sampleSize.push_back(size);
+			offset += size;
+		}
+	}
+	return true;
+}
+
+static uint32_t skipID3(const uint8_t *buf, uint32_t size)
+{
+	if (size >= 10 && buf[0] == 'I' && buf[1] == 'D' && buf[2] == '3' &&
+		buf[3] < 0xff && buf[4] < 0xff &&
+		buf[6] < 0x80 && buf[7] < 0x80 && buf[8] < 0x80 && buf[9] < 0x80)
+		return 10 + (((buf[6] & 0x7f) << 21) | ((buf[7] & 0x7f) << 14) | ((buf[8] & 0x7f) << 7) | (buf[9] & 0x7f));
+	return 0;
+}
+
+bool mediaIsMp3(const char *filename)
+{
+	const char *ext = strrchr(filename, '.');
+	return ext && strcasecmp(ext, ".mp3") == 0;
+}
+
+bool mediaLoadBuffer(const uint8_t *buf, uint32_t size, bool mp3, mediaFile &f)
+{
+	f = mediaFile();
+	f.data = (uint8_t *) malloc(size + 8);	//decoders may read a few bytes ahead
+	if (!f.data) return false;
+	memcpy(f.data, buf, size);
+	memset(f.data + size, 0, 8);
+	f.size = size;
+	f.mp3 = mp3;
+	if (!mp3) setupMp4(f);
+	return true;
+}
+
+bool mediaLoad(const char *filename, mediaFile &f)
+{
+	f = mediaFile();
+	FILE *fp = fopen(filename, "rb");
+	if (!fp) return false;
+	fseek(fp, 0, SEEK_END);
+	f.size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	f.data = (uint8_t *) malloc(f.size + 8);
+	if (!f.data || fread(f.data, 1, f.size, fp) != f.size) {
+		fclose(fp);
+		mediaFree(f);
+		return false;
+	}
+	memset(f.data + f.size, 0, 8);
+	fclose(fp);
+
+	f.mp3 = mediaIsMp3(filename);
+	if (!f.mp3) setupMp4(f);
+	return true;
+}
+
+void mediaFree(mediaFile &f)
+{
+	free(f.data);
+	f = mediaFile();
+}
+
+bool mediaOpen(mediaDecoder &d, mediaFile &f)
+{
+	d = mediaDecoder();
+	d.f = &f;
+	if (f.mp3) {
+		d.mp3 = MP3InitDecoder();
+		if (!d.mp3) return false;
+	} else {
+		d.aac = AACInitDecoder();
+		if (!d.aac) return false;
+		if (f.sampleOffset.size()) {
+			//MP4: raw blocks, parameters from stsd
+			AACFrameInfo info;
+			memset(&info, 0, sizeof(AACFrameInfo));
+			info.nChans = f.channels;
+			info.sampRateCore = f.samplerate;
+			info.profile = AAC_PROFILE_LC;
+			AACSetRawBlockParams(d.aac, 0, &info);
+			return true;
+		}
+	}
+	uint32_t skip = skipID3(f.data, f.size);
+	d.p = f.data + (skip < f.size ? skip : 0);
+	d.left = f.data + f.size - d.p;
+	return true;
+}
+
+static bool decodeMp3(mediaDecoder &d, short *pcm, mediaFrame &fr)
+{
+	if (d.left <= 0) return false;
+	int ofs = MP3FindNextFrame(d.mp3, d.p, d.left);
+	if (ofs < 0) return false;
+	d.p += ofs;
+	d.left -= ofs;
+	fr.offset = d.p - d.f->data;
+
+	uint64_t t = nanos();
+	fr.err = MP3Decode(d.mp3, &d.p, &d.left, pcm, 0);
+	fr.ns = (uint32_t)(nanos() - t);
+
+	if (fr.err == ERR_MP3_INDATA_UNDERFLOW) return false;
+	if (fr.err) {
+		//skip this sync word, as the player does
+		if (fr.err != ERR_MP3_MAINDATA_UNDERFLOW && d.left > 0) {
+			d.p++;
+			d.left--;
+		}
+		return true;
+	}
+	MP3FrameInfo info;
+	MP3GetLastFrameInfo(d.mp3, &info);
+	fr.samples = info.outputSamps;
+	fr.nChans = info.nChans;
+	fr.samprate = info.samprate;
+	return true;
+}
+
+static bool decodeAac(mediaDecoder &d, short *pcm, mediaFrame &fr)
+{
+	mediaFile &f = *d.f;
+
+	if (f.sampleOffset.size()) {
+		if (d.block >= f.sampleOffset.size()) return false;
+		d.p = f.data + f.sampleOffset[d.block];
+		d.left = f.sampleSize[d.block];
+		d.block++;
+	} else {
+		if (d.left <= 0) return false;
+		int ofs = AACFindSyncWord(d.p, d.left);
+		if (ofs < 0) return false;
+		d.p += ofs;
+		d.left -= ofs;
+	}
+	fr.offset = d.p - f.data;
+
+	uint64_t t = nanos();
+	fr.err = AACDecode(d.aac, &d.p, &d.left, pcm);
+	fr.ns = (uint32_t)(nanos() - t);
+
+	if (fr.err) {
+		if (f.sampleOffset.size()) return true;
+		if (fr.err == ERR_AAC_INDATA_UNDERFLOW) return false;
+		if (d.left > 0) {
+			d.p++;
+			d.left--;
+		}
+		return true;
+	}
+	AACFrameInfo info;
+	AACGetLastFrameInfo(d.aac, &info);
+	fr.samples = info.outputSamps;
+	fr.nChans = info.nChans;
+	fr.samprate = info.sampRateOut;
+	return true;
+}
+
+bool mediaDecodeFrame(mediaDecoder &d, short *pcm, mediaFrame &fr)
+{
+	fr = mediaFrame();
+	return d.f->mp3 ? decodeMp3(d, pcm, fr) : decodeAac(d, pcm, fr);
+}
+
+void mediaClose(mediaDecoder &d)
+{
+	if (d.mp3) MP3FreeDecoder(d.mp3);
+	if (d.aac) AACFreeDecoder(d.aac);
+	d = mediaDecoder();
+}
@@ -0,0 +1,94 @@
+/*
+	Helix library Arduino interface - file loading and frame-by-frame decoding for the host tools
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* Shared by codecbench, conformance and the other host tools: loads a whole
+    file into memory and walks it frame by frame through MP3Decode (*.mp3) or
+    AACDecode (ADTS, or MP4/M4A raw blocks from the sample table of the
+    first track). */
+
+#ifndef mediafile_h_
+#define mediafile_h_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "mp3/mp3dec.h"
+#include "aac/aacdec.h"
+
+#define MEDIA_PCM_SIZE	(AAC_MAX_NSAMPS * AAC_MAX_NCHANS * 2)	// shorts, enough for either decoder
+
+struct mediaFile {
+	uint8_t		*data;
+	uint32_t	size;
+	bool		mp3;
+	// MP4/M4A: one entry per AAC raw data block
+	std::vector<uint32_t> sampleOffset;
+	std::vector<uint32_t> sampleSize;
+	int			channels;
+	int			samplerate;
+};
+
+struct mediaFrame {
+	int			err;		// of MP3Decode/AACDecode, the frame is skipped if != 0
+	int			samples;	// outputSamps, all channels
+	int			nChans;
+	int			samprate;
+	uint32_t	ns;			// time spent in MP3Decode/AACDecode
+	uint32_t	offset;		// of the frame in the file
+};
+
+struct mediaDecoder {
+	mediaFile	*f;
+	HMP3Decoder	mp3;
+	HAACDecoder	aac;
+	unsigned char *p;
+	int			left;
+	size_t		block;		// next MP4 raw block
+};
+
+bool mediaIsMp3(const char *filename);
+bool mediaLoad(const char *filename, mediaFile &f);		// false if the file can't be read
+bool mediaLoadBuffer(const uint8_t *buf, uint32_t size, bool mp3, mediaFile &f);
+void mediaFree(mediaFile &f);
+
+bool mediaOpen(mediaDecoder &d, mediaFile &f);			// false if the decoder can't be allocated
+bool mediaDecodeFrame(mediaDecoder &d, short *pcm, mediaFrame &fr);	// false at the end of the file
+void mediaClose(mediaDecoder &d);
+
+#endif
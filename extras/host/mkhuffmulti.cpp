@@ -0,0 +1,201 @@
+/*
+	Helix library Arduino interface - generator for the multi-symbol MP3 Huffman tables
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* usage: mkhuffmulti > mp3/huffmulti.c
+    Builds the first-level tables for the multi-symbol fast path of
+    DecodeHuffmanPairs/DecodeHuffmanQuads (mp3/huffman.c) from huffTable and
+    quadTable. Every 8 bit pattern is decoded with the same table walk as the
+    decoder; the entry lists the one or two complete codewords (sign bits
+    included) that fit in these 8 bits. Pairs that need linbits are left to
+    the decoder. Run it again whenever hufftabs.c changes.
+
+    g++ -O2 -I. extras/host/mkhuffmulti.cpp -o mkhuffmulti */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mp3/coder.h"
+#include "mp3/hufftabs.c"
+
+#define PEEK	HUFF_MULTI_BITS
+
+// one pair codeword plus its sign bits, from the top of the cache; returns the bits used
+static int decodePair(int tabIdx, unsigned int cache, int *x, int *y)
+{
+	const unsigned short *tCurr = huffTable + huffTabOffset[tabIdx];
+	int used = 0, maxBits, len;
+	unsigned short cw;
+
+	if (huffTabLookup[tabIdx].tabType == oneShot) {
+		maxBits = tCurr[0] & 0x0f;
+		cw = tCurr[(cache >> (32 - maxBits)) + 1];
+	} else {
+		for (;;) {
+			maxBits = tCurr[0] & 0x0f;
+			cw = tCurr[(cache >> (32 - maxBits)) + 1];
+			if (cw >> 12) break;
+			used += maxBits;
+			cache <<= maxBits;
+			tCurr += cw;
+		}
+	}
+	len = cw >> 12;
+	used += len;
+	cache <<= len;
+
+	*x = (cw >> 4) & 0x0f;
+	*y = (cw >> 8) & 0x0f;
+	if (*x) { *x |= (cache >> 27) & 0x10; cache <<= 1; used++; }
+	if (*y) { *y |= (cache >> 27) & 0x10; cache <<= 1; used++; }
+	return used;
+}
+
+static bool pairFits(int tabIdx, int x, int y)
+{
+	if (huffTabLookup[tabIdx].tabType != loopLinbits) return true;
+	return (x & 0x0f) != 15 && (y & 0x0f) != 15;
+}
+
+static unsigned int pairEntry(int tabIdx, unsigned int bits)
+{
+	unsigned int cache = bits << (32 - PEEK);
+	int x1, y1, x2, y2, len1, len2;
+
+	len1 = decodePair(tabIdx, cache, &x1, &y1);
+	if (len1 > PEEK || !pairFits(tabIdx, x1, y1)) return 0;
+
+	len2 = len1 + decodePair(tabIdx, cache << len1, &x2, &y2);
+	if (len2 > PEEK || !pairFits(tabIdx, x2, y2)) len2 = x2 = y2 = 0;
+
+	return len1 | (len2 << 4) | (x1 << 8) | (y1 << 13) | (x2 << 18) | (y2 << 23);
+}
+
+// one quad codeword plus its sign bits, two bits (magnitude, sign) per value
+static int decodeQuad(int tabIdx, unsigned int cache, unsigned int *q)
+{
+	unsigned char cw = quadTable[quadTabOffset[tabIdx] + (cache >> (32 - quadTabMaxBits[tabIdx]))];
+	int used = cw >> 4;
+
+	cache <<= used;
+	*q = 0;
+	for (int k = 0; k < 4; k++) {
+		if (cw & (0x08 >> k)) {
+			*q |= (0x01 | (cache >> 30 & 0x02)) << (2 * k);
+			cache <<= 1;
+			used++;
+		}
+	}
+	return used;
+}
+
+static unsigned int quadEntry(int tabIdx, unsigned int bits)
+{
+	unsigned int cache = bits << (32 - PEEK), q1, q2;
+	int len1, len2;
+
+	len1 = decodeQuad(tabIdx, cache, &q1);
+	if (len1 > PEEK) return 0;
+
+	len2 = len1 + decodeQuad(tabIdx, cache << len1, &q2);
+	if (len2 > PEEK) len2 = q2 = 0;
+
+	return len1 | (len2 << 4) | (q1 << 8) | (q2 << 16);
+}
+
+static void printTable(const char *name, unsigned int (*entry)(int, unsigned int), int tabIdx, bool first)
+{
+	printf("%s\t/* %s[%d] */\n", first ? "" : "\n", name, 1 << PEEK);
+	for (unsigned int bits = 0; bits < (1 << PEEK); bits++)
+		printf("%s0x%08x,%s", (bits & 7) ? " " : "\t", entry(tabIdx, bits), (bits & 7) == 7 ? "\n" : "");
+}
+
+// tables with the same codes (16-23, 24-31) share their entries
+static int sameCodes(int tabIdx)
+{
+	for (int t = 0; t < tabIdx; t++) {
+		HuffTabType type = huffTabLookup[t].tabType;
+		if (type != noBits && type != invalidTab && huffTabOffset[t] == huffTabOffset[tabIdx])
+			return t;
+	}
+	return -1;
+}
+
+int main(void)
+{
+	int offset[HUFF_PAIRTABS], n = 0;
+	char name[32];
+
+	printf("/* generated by extras/host/mkhuffmulti.cpp from hufftabs.c - do not edit */\n\n");
+	printf("#include \"coder.h\"\n\n");
+	printf("/* first-level tables for the multi-symbol fast path in huffman.c, indexed by the\n");
+	printf(" *   next %d bits of the stream\n", PEEK);
+	printf(" *\n");
+	printf(" * pair tables: bits 0-3 = length of the first codeword incl. sign bits (0 = use huffTable)\n");
+	printf(" *   bits 4-7 = length of both codewords (0 = only the first one fits), then x1, y1, x2, y2\n");
+	printf(" *   with 5 bits each (sign in bit 4, magnitude in bits 0-3). Pairs with linbits are not\n");
+	printf(" *   listed. Tables 16-23 and 24-31 share one table each, like in huffTable\n");
+	printf(" * quad tables: the same two lengths, then two quads of 2 bits per value\n");
+	printf(" *   (magnitude in bit 0, sign in bit 1), v in the lowest bits\n");
+	printf(" */\n");
+	printf("const unsigned int huffMultiTable[] = {\n");
+	for (int t = 0; t < HUFF_PAIRTABS; t++) {
+		HuffTabType type = huffTabLookup[t].tabType;
+		offset[t] = 0;
+		if (type == noBits || type == invalidTab) continue;
+		if (sameCodes(t) >= 0) {
+			offset[t] = offset[sameCodes(t)];
+			continue;
+		}
+		offset[t] = n;
+		snprintf(name, sizeof(name), "huffMulti%02d", t);
+		printTable(name, pairEntry, t, n == 0);
+		n += 1 << PEEK;
+	}
+	printf("};\n\n");
+
+	printf("const int huffMultiOffset[HUFF_PAIRTABS] = {\n");
+	for (int t = 0; t < HUFF_PAIRTABS; t++)
+		printf("\t%d,\n", offset[t]);
+	printf("};\n\n");
+
+	printf("const unsigned int quadMultiTable[2 << HUFF_MULTI_BITS] = {\n");
+	printTable("table A", quadEntry, 0, true);
+	printTable("table B", quadEntry, 1, false);
+	printf("};\n");
+	return 0;
+}
@@ -0,0 +1,226 @@
+/*
+	Helix library Arduino interface - floating point Layer III reference for the host tools
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* see mp3ref.h */
+
+#include <math.h>
+#include <string.h>
+
+#include "mp3/coder.h"
+#include "mp3ref.h"
+
+#define NSB		32		// subbands
+#define NSS		18		// samples per subband and granule
+
+// preemphasis of the long block scalefactors (table B.6)
+static const int pretab[23] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3, 3, 3, 2, 0, 0 };
+
+// alias reduction coefficients c[i] (table B.9)
+static const double aliasC[8] = { -0.6, -0.535, -0.33, -0.185, -0.095, -0.041, -0.0142, -0.0037 };
+
+struct refChannel {
+	double	prev[NSB][NSS];		// second half of the last IMDCT, for the overlap-add
+	double	v[1024];			// synthesis FIFO
+};
+
+static double	window[512];	// D[] of table 3-B.3
+
+/* polyCoef (Q18) holds D[r + 32*j], r = 0..15, at 16*r + j for even j and at 16*r + 16 - j
+ * for odd j (PolyphaseMono reads the odd taps backwards), and -D[48 + 64*x] at 256 + x
+ * for r = 16 (D[16 + 64*x] meets V[16 + 128*x] = 0), the rest is D[i] = -D[512 - i]
+ */
+static void initWindow(void)
+{
+	for (int r = 0; r < 16; r++)
+		for (int j = 0; j < 16; j++)
+			window[r + 32 * j] = polyCoef[16 * r + ((j & 1) ? 16 - j : j)] / 262144.0;
+	for (int x = 0; x < 8; x++)
+		window[48 + 64 * x] = -polyCoef[256 + x] / 262144.0;
+	for (int i = 1; i < 512; i++) {
+		if ((i & 31) > 16 || (i & 63) == 16)
+			window[i] = -window[512 - i];
+	}
+}
+
+// xr = sign(v) * |v|^(4/3) * 2^(gain / 4)
+static double requantize(int v, double gain)
+{
+	double a = pow(fabs((double)v), 4.0 / 3.0) * pow(2.0, gain / 4);
+	return v < 0 ? -a : a;
+}
+
+// requantized and reordered spectrum of one granule
+static void dequantize(const mp3SynthGranule &g, const SFBandTable *sfBand, double *xr)
+{
+	double sfMult = (g.sfactScale ? 2 : 1) * 2;	// quarter steps per scalefactor step
+	int longEnd = 576, shortStart = 13;
+
+	memset(xr, 0, 576 * sizeof(double));
+	if (g.blockType == 2) {
+		longEnd = g.mixedBlock ? 36 : 0;
+		shortStart = g.mixedBlock ? 3 : 0;
+	}
+
+	for (int sfb = 0; sfb < 22 && sfBand->l[sfb] < longEnd; sfb++) {
+		double gain = g.globalGain - 210 - sfMult * (g.sfl[sfb] + g.preFlag * pretab[sfb]);
+		for (int i = sfBand->l[sfb]; i < sfBand->l[sfb + 1] && i < longEnd; i++)
+			xr[i] = requantize(g.values[i], gain);
+	}
+
+	//short bands are sent window by window, the IMDCT wants the three windows of a line together
+	for (int sfb = shortStart; sfb < 13; sfb++) {
+		int start = 3 * sfBand->s[sfb], width = sfBand->s[sfb + 1] - sfBand->s[sfb];
+		for (int w = 0; w < 3; w++) {
+			double gain = g.globalGain - 210 - 8 * g.subBlockGain[w] - sfMult * g.sfs[sfb][w];
+			for (int j = 0; j < width; j++)
+				xr[start + 3 * j + w] = requantize(g.values[start + w * width + j], gain);
+		}
+	}
+}
+
+// alias reduction, IMDCT, overlap-add and frequency inversion: sub[time][subband]
+static void hybrid(const mp3SynthGranule &g, double *xr, refChannel &c, double sub[NSS][NSB])
+{
+	int nAlias = (g.blockType != 2 ? NSB - 1 : g.mixedBlock ? 1 : 0);
+	for (int sb = 1; sb <= nAlias; sb++) {
+		for (int i = 0; i < 8; i++) {
+			double cs = 1 / sqrt(1 + aliasC[i] * aliasC[i]), ca = aliasC[i] * cs;
+			double a = xr[NSS * sb - 1 - i], b = xr[NSS * sb + i];
+			xr[NSS * sb - 1 - i] = a * cs - b * ca;
+			xr[NSS * sb + i] = b * cs + a * ca;
+		}
+	}
+
+	for (int sb = 0; sb < NSB; sb++) {
+		const double *x = xr + NSS * sb;
+		double z[36];
+		memset(z, 0, sizeof(z));
+
+		if (g.blockType != 2 || (g.mixedBlock && sb < 2)) {
+			int bt = (g.blockType == 2 ? 0 : g.blockType);
+			for (int i = 0; i < 36; i++) {
+				double s = 0, w;
+				for (int k = 0; k < NSS; k++)
+					s += x[k] * cos(M_PI / 72 * (2 * i + 1 + 18) * (2 * k + 1));
+				if (bt == 1)
+					w = i < 18 ? sin(M_PI / 36 * (i + 0.5)) : i < 24 ? 1 : i < 30 ? sin(M_PI / 12 * (i - 18 + 0.5)) : 0;
+				else if (bt == 3)
+					w = i < 6 ? 0 : i < 12 ? sin(M_PI / 12 * (i - 6 + 0.5)) : i < 18 ? 1 : sin(M_PI / 36 * (i + 0.5));
+				else
+					w = sin(M_PI / 36 * (i + 0.5));
+				z[i] = s * w;
+			}
+		} else {
+			for (int w = 0; w < 3; w++) {
+				for (int i = 0; i < 12; i++) {
+					double s = 0;
+					for (int k = 0; k < 6; k++)
+						s += x[3 * k + w] * cos(M_PI / 24 * (2 * i + 1 + 6) * (2 * k + 1));
+					z[6 + 6 * w + i] += s * sin(M_PI / 12 * (i + 0.5));
+				}
+			}
+		}
+
+		for (int i = 0; i < NSS; i++) {
+			sub[i][sb] = z[i] + c.prev[sb][i];
+			c.prev[sb][i] = z[i + NSS];
+			if ((sb & 1) && (i & 1)) sub[i][sb] = -sub[i][sb];
+		}
+	}
+}
+
+// 32 output samples from one sample of each subband
+static void synthesis(refChannel &c, const double *s, double *out)
+{
+	memmove(c.v + 64, c.v, (1024 - 64) * sizeof(double));
+	for (int i = 0; i < 64; i++) {
+		double v = 0;
+		for (int k = 0; k < NSB; k++)
+			v += cos((16 + i) * (2 * k + 1) * M_PI / 64) * s[k];
+		c.v[i] = v;
+	}
+	for (int j = 0; j < 32; j++) {
+		double sum = 0;
+		for (int i = 0; i < 8; i++) {
+			sum += c.v[128 * i + j] * window[64 * i + j];
+			sum += c.v[128 * i + 96 + j] * window[64 * i + 32 + j];
+		}
+		out[j] = sum;
+	}
+}
+
+bool mp3RefDecode(const std::vector<mp3SynthGranule> &granules, std::vector<double> &pcm)
+{
+	static refChannel ch[2];
+	double xr[2][576], sub[NSS][NSB], out[2][NSS * 32];
+
+	initWindow();
+	memset(ch, 0, sizeof(ch));
+	for (size_t n = 0; n < granules.size(); ) {
+		int nChans = granules[n].nChans;
+		if (n + nChans > granules.size()) return false;
+
+		for (int c = 0; c < nChans; c++) {
+			const mp3SynthGranule &g = granules[n + c];
+			const SFBandTable *sfBand = &sfBandTable[g.version][g.srIdx];
+			if (g.modeExt & 1) return false;		//intensity stereo
+			if (g.blockType == 2 && g.mixedBlock && sfBand->l[g.version == MPEG1 ? 8 : 6] != 36) return false;
+			dequantize(g, sfBand, xr[c]);
+		}
+		if (nChans == 2 && (granules[n].modeExt & 2)) {
+			for (int i = 0; i < 576; i++) {
+				double m = xr[0][i], s = xr[1][i];
+				xr[0][i] = (m + s) / sqrt(2.0);
+				xr[1][i] = (m - s) / sqrt(2.0);
+			}
+		}
+		for (int c = 0; c < nChans; c++) {
+			hybrid(granules[n + c], xr[c], ch[c], sub);
+			for (int t = 0; t < NSS; t++)
+				synthesis(ch[c], sub[t], out[c] + 32 * t);
+		}
+		for (int i = 0; i < NSS * 32; i++) {
+			for (int c = 0; c < nChans; c++) {
+				double v = out[c][i] * 32768;
+				pcm.push_back(v > 32767 ? 32767 : v < -32768 ? -32768 : v);
+			}
+		}
+		n += nChans;
+	}
+	return true;
+}
@@ -0,0 +1,59 @@
+/*
+	Helix library Arduino interface - floating point Layer III reference for the host tools
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* Decodes the granules that mp3Synthesize() recorded with the formulas of
+    ISO 11172-3 in double precision: requantization, mid/side stereo, short
+    block reordering, alias reduction, IMDCT with the four window shapes and
+    the polyphase synthesis filterbank. The decoder's parsers (Huffman,
+    scalefactors) are lossless and are not repeated here. Only the band
+    tables and the synthesis window are shared with the decoder: D[] of
+    table 3-B.3 is rebuilt from polyCoef, which rounds it to 2^-18.
+    Not covered: intensity stereo, and mixed blocks whose long part is not
+    the first 36 lines (MPEG-2.5 8 kHz). */
+
+#ifndef mp3ref_h_
+#define mp3ref_h_
+
+#include <vector>
+#include "mp3synth.h"
+
+// appends the PCM in 16 bit LSBs (interleaved if stereo, clipped like the decoder's output),
+// returns false for streams the reference doesn't cover
+bool mp3RefDecode(const std::vector<mp3SynthGranule> &granules, std::vector<double> &pcm);
+
+#endif
@@ -0,0 +1,355 @@
+/*
+	Helix library Arduino interface - synthetic MP3 streams for the host tools
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* see mp3synth.h
+    Links against the decoder of mp3.cpp, whose parsers check each frame. */
+
+#include <string.h>
+
+#include "mp3/coder.h"
+#include "mp3synth.h"
+
+#define SYNTH_ATTEMPTS	8	// side info draws per frame before falling back to empty granules
+
+struct bitWriter {
+	uint8_t		buf[40];
+	int			bits;
+};
+
+static void putBits(bitWriter &w, uint32_t val, int n)
+{
+	while (n--) {
+		if ((val >> n) & 1) w.buf[w.bits >> 3] |= 0x80 >> (w.bits & 7);
+		w.bits++;
+	}
+}
+
+// xorshift32, as in kernelbench.h
+static uint32_t synthRandom(uint32_t &x)
+{
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+
+static int synthRange(uint32_t &x, int n)
+{
+	return (int)(synthRandom(x) % (uint32_t)n);
+}
+
+// ISO 11172-3 CRC-16 (x^16 + x^15 + x^2 + 1) over the bits after the CRC-protected header bytes
+static uint16_t crc16(uint16_t crc, const uint8_t *buf, int bits)
+{
+	for (int i = 0; i < bits; i++) {
+		int bit = (buf[i >> 3] >> (7 - (i & 7))) & 1;
+		int top = crc >> 15;
+		crc <<= 1;
+		if (top ^ bit) crc ^= 0x8005;
+	}
+	return crc;
+}
+
+static int synthTable(uint32_t &x)
+{
+	int t;
+	do t = synthRange(x, HUFF_PAIRTABS); while (huffTabLookup[t].tabType == invalidTab);
+	return t;
+}
+
+static int synthBlockType(uint32_t &x, int mask, int *mixed)
+{
+	int bt;
+	do bt = synthRange(x, 5); while (!(mask & (1 << bt)));
+	*mixed = (bt == 4);
+	return (bt == 4 ? 2 : bt);
+}
+
+/* random side info for one frame, part23Length already set in sis
+ * empty = 1 gives granules without scalefactors and Huffman codes
+ */
+static void synthSideInfo(const mp3SynthParams &p, uint32_t &x, SideInfo &si, int nGrans, int nChans, int modeExt, int maxBigvals, int empty)
+{
+	for (int ch = 0; ch < nChans; ch++)
+		for (int bd = 0; bd < MAX_SCFBD; bd++)
+			si.scfsi[ch][bd] = (p.version == MPEG1 && !empty ? synthRandom(x) & 1 : 0);
+
+	for (int gr = 0; gr < nGrans; gr++) {
+		for (int ch = 0; ch < nChans; ch++) {
+			SideInfoSub &sis = si.sis[gr][ch];
+			int part23Length = sis.part23Length;
+
+			memset(&sis, 0, sizeof(SideInfoSub));
+			sis.part23Length = part23Length;
+			sis.globalGain = 100 + synthRange(x, p.gains);
+			if (empty) continue;
+
+			if (ch == 1 && modeExt) {
+				//joint stereo: both channels switch windows together
+				sis.blockType = si.sis[gr][0].blockType;
+				sis.mixedBlock = si.sis[gr][0].mixedBlock;
+			} else {
+				sis.blockType = synthBlockType(x, p.blockTypes, &sis.mixedBlock);
+			}
+			sis.winSwitchFlag = (sis.blockType != 0);
+			sis.nBigvals = synthRange(x, maxBigvals + 1);
+			sis.sfCompress = synthRange(x, p.version == MPEG1 ? 16 : 512);
+			sis.tableSelect[0] = synthTable(x);
+			sis.tableSelect[1] = synthTable(x);
+			if (sis.winSwitchFlag) {
+				for (int w = 0; w < 3; w++)
+					sis.subBlockGain[w] = synthRange(x, 8);
+			} else {
+				sis.tableSelect[2] = synthTable(x);
+				sis.region0Count = synthRange(x, 16);
+				sis.region1Count = MIN(synthRange(x, 8), 20 - sis.region0Count);	//keep the regions inside sfBand->l
+			}
+			sis.preFlag = (p.version == MPEG1 ? synthRandom(x) & 1 : 0);
+			sis.sfactScale = synthRandom(x) & 1;
+			sis.count1TableSelect = synthRandom(x) & 1;
+		}
+	}
+
+	//no scalefactor sharing if either granule has short blocks (ISO 11172-3 2.4.3.4), the decoder
+	//would copy granule 0's long scalefactors that were never sent
+	for (int ch = 0; ch < nChans; ch++) {
+		for (int gr = 0; gr < nGrans; gr++) {
+			if (si.sis[gr][ch].blockType == 2)
+				memset(si.scfsi[ch], 0, sizeof(si.scfsi[ch]));
+		}
+	}
+}
+
+// bit layout of UnpackSideInfo
+static void packSideInfo(bitWriter &w, const SideInfo &si, int version, int nGrans, int nChans)
+{
+	if (version == MPEG1) {
+		putBits(w, si.mainDataBegin, 9);
+		putBits(w, 0, nChans == 1 ? 5 : 3);
+		for (int ch = 0; ch < nChans; ch++)
+			for (int bd = 0; bd < MAX_SCFBD; bd++)
+				putBits(w, si.scfsi[ch][bd], 1);
+	} else {
+		putBits(w, si.mainDataBegin, 8);
+		putBits(w, 0, nChans == 1 ? 1 : 2);
+	}
+	for (int gr = 0; gr < nGrans; gr++) {
+		for (int ch = 0; ch < nChans; ch++) {
+			const SideInfoSub &sis = si.sis[gr][ch];
+			putBits(w, sis.part23Length, 12);
+			putBits(w, sis.nBigvals, 9);
+			putBits(w, sis.globalGain, 8);
+			putBits(w, sis.sfCompress, version == MPEG1 ? 4 : 9);
+			putBits(w, sis.winSwitchFlag, 1);
+			if (sis.winSwitchFlag) {
+				putBits(w, sis.blockType, 2);
+				putBits(w, sis.mixedBlock, 1);
+				putBits(w, sis.tableSelect[0], 5);
+				putBits(w, sis.tableSelect[1], 5);
+				for (int i = 0; i < 3; i++)
+					putBits(w, sis.subBlockGain[i], 3);
+			} else {
+				for (int i = 0; i < 3; i++)
+					putBits(w, sis.tableSelect[i], 5);
+				putBits(w, sis.region0Count, 4);
+				putBits(w, sis.region1Count, 3);
+			}
+			if (version == MPEG1)
+				putBits(w, sis.preFlag, 1);
+			putBits(w, sis.sfactScale, 1);
+			putBits(w, sis.count1TableSelect, 1);
+		}
+	}
+}
+
+// parsed granule of the scratch decoder, see mp3SynthGranule
+static void recordGranule(MP3DecInfo *dec, int gr, int ch, std::vector<mp3SynthGranule> &granules)
+{
+	const FrameHeader *fh = (const FrameHeader *)dec->FrameHeaderPS;
+	const SideInfoSub &sis = ((const SideInfo *)dec->SideInfoPS)->sis[gr][ch];
+	const ScaleFactorInfoSub &sfis = ((const ScaleFactorInfo *)dec->ScaleFactorInfoPS)->sfis[gr][ch];
+	mp3SynthGranule g;
+
+	g.version = fh->ver;
+	g.srIdx = fh->srIdx;
+	g.nChans = dec->nChans;
+	g.modeExt = fh->modeExt;
+	g.blockType = sis.blockType;
+	g.mixedBlock = sis.mixedBlock;
+	g.globalGain = sis.globalGain;
+	for (int w = 0; w < 3; w++)
+		g.subBlockGain[w] = sis.subBlockGain[w];
+	g.preFlag = sis.preFlag;
+	g.sfactScale = sis.sfactScale;
+	for (int sfb = 0; sfb < 23; sfb++)
+		g.sfl[sfb] = sfis.l[sfb];
+	for (int sfb = 0; sfb < 13; sfb++)
+		for (int w = 0; w < 3; w++)
+			g.sfs[sfb][w] = sfis.s[sfb][w];
+	const int *huff = ((const HuffmanInfo *)dec->HuffmanInfoPS)->huffDecBuf[ch];
+	for (int i = 0; i < 576; i++)
+		g.values[i] = (huff[i] < 0 ? -(huff[i] & 0x7fffffff) : huff[i]);	//sign and magnitude, see ApplySign()
+	granules.push_back(g);
+}
+
+// same steps as the granule loop in MP3DecodeFrame, on the scratch decoder, false if it fails
+// or a granule has non-zero spectral lines from index lines on
+static bool checkFrame(MP3DecInfo *dec, unsigned char *frame, unsigned char *mainData, int mainDataBytes, int lines,
+	std::vector<mp3SynthGranule> &granules)
+{
+	int fhBytes = UnpackFrameHeader(dec, frame);
+	if (fhBytes < 0 || UnpackSideInfo(dec, frame + fhBytes) < 0)
+		return false;
+
+	unsigned char *mainPtr = mainData;
+	int bitOffset = 0;
+	int mainBits = mainDataBytes * 8;
+	for (int gr = 0; gr < dec->nGrans; gr++) {
+		for (int ch = 0; ch < dec->nChans; ch++) {
+			int prevBitOffset = bitOffset;
+			int offset = UnpackScaleFactors(dec, mainPtr, &bitOffset, mainBits, gr, ch);
+			int sfBlockBits = 8*offset - prevBitOffset + bitOffset;
+			int huffBlockBits = dec->part23Length[gr][ch] - sfBlockBits;
+			mainPtr += offset;
+			mainBits -= sfBlockBits;
+			if (offset < 0 || mainBits < huffBlockBits)
+				return false;
+
+			prevBitOffset = bitOffset;
+			offset = DecodeHuffman(dec, mainPtr, &bitOffset, huffBlockBits, gr, ch);
+			if (offset < 0 || ((HuffmanInfo *)dec->HuffmanInfoPS)->nonZeroBound[ch] > lines)
+				return false;
+			recordGranule(dec, gr, ch, granules);
+			mainPtr += offset;
+			mainBits -= (8*offset - prevBitOffset + bitOffset);
+		}
+	}
+	return true;
+}
+
+int mp3Synthesize(const mp3SynthParams &p, std::vector<uint8_t> &out, std::vector<mp3SynthGranule> *granules)
+{
+	uint32_t x = p.seed * 2654435761u + 1;
+	int nChans = (p.mode == Mono ? 1 : 2);
+	int nGrans = (p.version == MPEG1 ? NGRANS_MPEG1 : NGRANS_MPEG2);
+	int maxBegin = (p.version == MPEG1 ? 511 : 255);
+	int sideBytes = sideBytesTab[p.version][nChans == 1 ? 0 : 1];
+	int fallbacks = 0;
+
+	std::vector<uint8_t> mainStream;	//the main data slots of all frames, back to back
+	int prevEnd = 0;					//end of the main data of the previous frame in mainStream
+	MP3DecInfo *dec = AllocateBuffers();
+	if (!dec) return -1;
+
+	for (int n = 0; n < p.frames; n++) {
+		int brIdx = p.brMin + synthRange(x, p.brMax - p.brMin + 1);
+		int pad = synthRandom(x) & 1;
+		int modeExt = (p.mode == Joint ? (p.modeExt < 0 ? synthRandom(x) & 3 : p.modeExt) : 0);
+		int hdrBytes = 4 + (p.crc ? 2 : 0);
+		int nSlots = slotTab[p.version][p.srIdx][brIdx] + pad - 4 - (p.crc ? 2 : 0) - sideBytes;
+
+		uint8_t frame[4 + 2 + 32 + 8];
+		memset(frame, 0, sizeof(frame));
+		frame[0] = 0xff;
+		frame[1] = 0xe0 | ((p.version == MPEG1 ? 3 : p.version == MPEG2 ? 2 : 0) << 3) | (1 << 1) | (p.crc ? 0 : 1);
+		frame[2] = (brIdx << 4) | (p.srIdx << 2) | (pad << 1);
+		frame[3] = (p.mode << 6) | (modeExt << 4) | (1 << 2);
+
+		int S = mainStream.size();
+		for (int i = 0; i < nSlots; i++)
+			mainStream.push_back(synthRandom(x) >> 24);
+		for (int i = 0; i < 8; i++)
+			mainStream.push_back(0);		//decoder reads ahead, removed below
+
+		SideInfo si;
+		std::vector<mp3SynthGranule> parsed;
+		int E = 0;
+		int silent = (n >= p.frames - p.silent);
+		for (int attempt = 0; attempt < SYNTH_ATTEMPTS; attempt++) {
+			int empty = (attempt == SYNTH_ATTEMPTS - 1 || silent);
+			memset(&si, 0, sizeof(SideInfo));
+
+			//reservoir: start anywhere in the bytes the previous frames left over
+			si.mainDataBegin = synthRange(x, MIN(S - prevEnd, maxBegin) + 1);
+			int avail = si.mainDataBegin + nSlots;
+			int used = avail - synthRange(x, avail / 4 + 1);
+			used = MIN(used, nGrans * nChans * 4095 / 8);
+			int bits = MAX(used * 8 - synthRange(x, 8), 0);
+			if (p.lines < SYNTH_FULLBAND)
+				bits = MIN(bits, nGrans * nChans * p.lines / 2);	//count1 quads take 1 bit and more
+			if (empty) {
+				bits = 0;
+				fallbacks += !silent;
+			}
+
+			int weight[MAX_NGRAN * MAX_NCHAN], sum = 0, total = 0;
+			for (int i = 0; i < nGrans * nChans; i++)
+				sum += (weight[i] = 1 + synthRange(x, 16));
+			for (int i = 0; i < nGrans * nChans; i++) {
+				int len = MIN((int)((int64_t)bits * weight[i] / sum), 4095);
+				si.sis[i / nChans][i % nChans].part23Length = len;
+				total += len;
+			}
+			synthSideInfo(p, x, si, nGrans, nChans, modeExt, (p.lines / 2) >> attempt, empty);
+
+			bitWriter w;
+			memset(&w, 0, sizeof(w));
+			packSideInfo(w, si, p.version, nGrans, nChans);
+			memcpy(frame + hdrBytes, w.buf, sideBytes);
+			if (p.crc) {
+				uint16_t crc = crc16(0xffff, frame + 2, 16);
+				crc = crc16(crc, frame + hdrBytes, sideBytes * 8);
+				frame[4] = crc >> 8;
+				frame[5] = crc & 0xff;
+			}
+
+			E = S - si.mainDataBegin + (total + 7) / 8;
+			parsed.clear();
+			if (checkFrame(dec, frame, &mainStream[S - si.mainDataBegin], avail, p.lines, parsed))
+				break;
+		}
+		if (granules) granules->insert(granules->end(), parsed.begin(), parsed.end());
+		mainStream.resize(S + nSlots);
+		prevEnd = E;
+
+		out.insert(out.end(), frame, frame + hdrBytes + sideBytes);
+		out.insert(out.end(), mainStream.begin() + S, mainStream.end());
+	}
+	FreeBuffers(dec);
+	return fallbacks;
+}
@@ -0,0 +1,106 @@
+/*
+	Helix library Arduino interface - synthetic MP3 streams for the host tools
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* Generates valid MPEG-1/2/2.5 Layer III streams with random content: the frame
+    headers and side info are chosen from the ranges in mp3SynthParams, the
+    main data (scalefactors, Huffman codes) is random. Every frame is parsed
+    with the decoder's own UnpackScaleFactors/DecodeHuffman before it is
+    accepted, so the whole stream decodes without errors and reaches every
+    block type, stereo mode, Huffman table and the bit reservoir. A stream can
+    also be band-limited (lines) or end in frames without main data (silent). */
+
+#ifndef mp3synth_h_
+#define mp3synth_h_
+
+#include <stdint.h>
+#include <vector>
+
+// block types allowed in mp3SynthParams.blockTypes
+#define SYNTH_LONG		0x01
+#define SYNTH_START		0x02
+#define SYNTH_SHORT		0x04
+#define SYNTH_STOP		0x08
+#define SYNTH_MIXED		0x10	// short, long in the lowest subbands
+#define SYNTH_ALLBLOCKS	0x1f
+
+// mp3SynthParams.gains: global gains 100..119 stay below full scale, 100..159 clip most of the time
+#define SYNTH_QUIET		20
+#define SYNTH_LOUD		60
+
+// mp3SynthParams.lines: all of the spectrum, or the lower half (subbands 0..15, lowpassed at a quarter of the sample rate)
+#define SYNTH_FULLBAND	576
+#define SYNTH_LOWPASS	288
+
+struct mp3SynthParams {
+	int			version;	// 0 = MPEG-1, 1 = MPEG-2, 2 = MPEG-2.5
+	int			srIdx;		// sample rate index 0..2
+	int			mode;		// as in the header: 0 stereo, 1 joint stereo, 2 dual channel, 3 mono
+	int			modeExt;	// joint stereo: bit 1 mid/side, bit 0 intensity, -1 random per frame
+	int			blockTypes;	// SYNTH_xxx
+	int			brMin;		// bitrate index range, VBR if brMax > brMin
+	int			brMax;
+	int			crc;
+	int			gains;		// number of global gains from 100 up, SYNTH_QUIET or SYNTH_LOUD
+	int			lines;		// spectral lines per granule that may be non-zero, SYNTH_FULLBAND or SYNTH_LOWPASS
+	int			frames;
+	int			silent;		// the last silent frames have no main data (digital silence)
+	uint32_t	seed;
+};
+
+// one channel of one granule as the decoder's parsers read it, the input of the float reference (mp3ref.h)
+struct mp3SynthGranule {
+	int			version;
+	int			srIdx;
+	int			nChans;
+	int			modeExt;		// 0 unless joint stereo
+	int			blockType;
+	int			mixedBlock;
+	int			globalGain;
+	int			subBlockGain[3];
+	int			preFlag;		// MPEG-2: set by the scalefactor unpacking
+	int			sfactScale;
+	int			sfl[23];		// scalefactors [band]
+	int			sfs[13][3];		// [band][window]
+	int			values[576];	// quantized spectrum, signed, in bitstream order
+};
+
+// appends the stream to out, returns the number of frames that had to fall back to empty granules
+// granules, if given, gets the parsed content of every granule and channel in stream order
+int mp3Synthesize(const mp3SynthParams &p, std::vector<uint8_t> &out, std::vector<mp3SynthGranule> *granules = 0);
+
+#endif
@@ -0,0 +1,1555 @@
+/*
+	Helix library Arduino interface - Thumb-2 assembly emulator for the host tools
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* see thumbemu.h */
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "thumbemu.h"
+
+#define EMU_RET			0x7ffffff0	// return address of emuCall
+#define EMU_FUNC		0x40000000	// code addresses from here on are emuFunctions
+#define EMU_NULL		0x100		// no data below (catches null pointers)
+#define EMU_STACK		0x100		// the stack starts this far below the end of the memory
+#define EMU_MAXSTEPS	100000000	// per emuCall, against endless loops
+
+enum {
+	OP_MOV, OP_MVN, OP_ADD, OP_SUB, OP_RSB, OP_ADC, OP_SBC, OP_AND, OP_ORR, OP_EOR, OP_BIC,
+	OP_LSL, OP_LSR, OP_ASR, OP_ROR, OP_MUL, OP_MLA, OP_MLS, OP_SDIV, OP_UDIV,
+	OP_SMULL, OP_UMULL, OP_SMLAL, OP_UMLAL, OP_SMMUL, OP_SMMLA, OP_SMMLS,
+	OP_SMULXY, OP_SMLAXY, OP_SMULWY, OP_SMLAWY, OP_SMUAD, OP_SMLAD, OP_SMLALD,
+	OP_QADD, OP_QSUB, OP_QDADD, OP_QDSUB, OP_SSAT, OP_USAT,
+	OP_CLZ, OP_RBIT, OP_REV, OP_REV16, OP_SXTH, OP_UXTH, OP_SXTB, OP_UXTB, OP_SXTAH, OP_UXTAH, OP_SXTAB, OP_UXTAB,
+	OP_PKHBT, OP_PKHTB, OP_SBFX, OP_UBFX, OP_BFI, OP_BFC,
+	OP_CMP, OP_CMN, OP_TST, OP_TEQ,
+	OP_LDR, OP_LDRLIT, OP_STR, OP_LDRD, OP_STRD, OP_LDM, OP_STM, OP_PUSH, OP_POP,
+	OP_MOVW, OP_MOVT, OP_ADR, OP_B, OP_BL, OP_BX, OP_BLX, OP_CBZ, OP_CBNZ, OP_IT, OP_NOP
+};
+
+// emuMnemonic.flags
+#define F_S			0x01	// sets the flags
+#define F_R			0x02	// rounds (smmulr...)
+#define F_X			0x04	// exchanges the halves of the second operand (smladx...)
+#define F_SUB		0x08	// difference of the products (smusd, smlsd, smlsld)
+#define F_XT		0x10	// top half of the first operand (smultb...)
+#define F_YT		0x20	// top half of the second operand (smulbt, smulwt...)
+#define F_DB		0x40	// ldm/stm decrement before
+#define F_SIGNED	0x80	// ldrsh, ldrsb
+
+enum { SH_LSL, SH_LSR, SH_ASR, SH_ROR };
+enum { AM_OFFSET, AM_PRE, AM_POST };
+
+#define NOREG		0xff
+
+struct emuMnemonic {
+	const char	*name;
+	uint8_t		op, flags, size;
+};
+
+static const emuMnemonic mnemonics[] = {
+	{ "mov", OP_MOV, 0, 0 }, { "movs", OP_MOV, F_S, 0 }, { "mvn", OP_MVN, 0, 0 }, { "mvns", OP_MVN, F_S, 0 },
+	{ "add", OP_ADD, 0, 0 }, { "adds", OP_ADD, F_S, 0 }, { "sub", OP_SUB, 0, 0 }, { "subs", OP_SUB, F_S, 0 },
+	{ "addw", OP_ADD, 0, 0 }, { "subw", OP_SUB, 0, 0 },
+	{ "adc", OP_ADC, 0, 0 }, { "adcs", OP_ADC, F_S, 0 }, { "sbc", OP_SBC, 0, 0 }, { "sbcs", OP_SBC, F_S, 0 },
+	{ "rsb", OP_RSB, 0, 0 }, { "rsbs", OP_RSB, F_S, 0 }, { "and", OP_AND, 0, 0 }, { "ands", OP_AND, F_S, 0 },
+	{ "orr", OP_ORR, 0, 0 }, { "orrs", OP_ORR, F_S, 0 }, { "eor", OP_EOR, 0, 0 }, { "eors", OP_EOR, F_S, 0 },
+	{ "bic", OP_BIC, 0, 0 }, { "bics", OP_BIC, F_S, 0 },
+	{ "lsl", OP_LSL, 0, 0 }, { "lsls", OP_LSL, F_S, 0 }, { "lsr", OP_LSR, 0, 0 }, { "lsrs", OP_LSR, F_S, 0 },
+	{ "asr", OP_ASR, 0, 0 }, { "asrs", OP_ASR, F_S, 0 }, { "ror", OP_ROR, 0, 0 }, { "rors", OP_ROR, F_S, 0 },
+	{ "mul", OP_MUL, 0, 0 }, { "muls", OP_MUL, F_S, 0 }, { "mla", OP_MLA, 0, 0 }, { "mls", OP_MLS, 0, 0 },
+	{ "sdiv", OP_SDIV, 0, 0 }, { "udiv", OP_UDIV, 0, 0 },
+	{ "smull", OP_SMULL, 0, 0 }, { "umull", OP_UMULL, 0, 0 }, { "smlal", OP_SMLAL, 0, 0 }, { "umlal", OP_UMLAL, 0, 0 },
+	{ "smmul", OP_SMMUL, 0, 0 }, { "smmulr", OP_SMMUL, F_R, 0 }, { "smmla", OP_SMMLA, 0, 0 }, { "smmlar", OP_SMMLA, F_R, 0 },
+	{ "smmls", OP_SMMLS, 0, 0 }, { "smmlsr", OP_SMMLS, F_R, 0 },
+	{ "smulbb", OP_SMULXY, 0, 0 }, { "smulbt", OP_SMULXY, F_YT, 0 }, { "smultb", OP_SMULXY, F_XT, 0 }, { "smultt", OP_SMULXY, F_XT | F_YT, 0 },
+	{ "smlabb", OP_SMLAXY, 0, 0 }, { "smlabt", OP_SMLAXY, F_YT, 0 }, { "smlatb", OP_SMLAXY, F_XT, 0 }, { "smlatt", OP_SMLAXY, F_XT | F_YT, 0 },
+	{ "smulwb", OP_SMULWY, 0, 0 }, { "smulwt", OP_SMULWY, F_YT, 0 }, { "smlawb", OP_SMLAWY, 0, 0 }, { "smlawt", OP_SMLAWY, F_YT, 0 },
+	{ "smuad", OP_SMUAD, 0, 0 }, { "smuadx", OP_SMUAD, F_X, 0 }, { "smusd", OP_SMUAD, F_SUB, 0 }, { "smusdx", OP_SMUAD, F_SUB | F_X, 0 },
+	{ "smlad", OP_SMLAD, 0, 0 }, { "smladx", OP_SMLAD, F_X, 0 }, { "smlsd", OP_SMLAD, F_SUB, 0 }, { "smlsdx", OP_SMLAD, F_SUB | F_X, 0 },
+	{ "smlald", OP_SMLALD, 0, 0 }, { "smlaldx", OP_SMLALD, F_X, 0 }, { "smlsld", OP_SMLALD, F_SUB, 0 }, { "smlsldx", OP_SMLALD, F_SUB | F_X, 0 },
+	{ "qadd", OP_QADD, 0, 0 }, { "qsub", OP_QSUB, 0, 0 }, { "qdadd", OP_QDADD, 0, 0 }, { "qdsub", OP_QDSUB, 0, 0 },
+	{ "ssat", OP_SSAT, 0, 0 }, { "usat", OP_USAT, 0, 0 },
+	{ "clz", OP_CLZ, 0, 0 }, { "rbit", OP_RBIT, 0, 0 }, { "rev", OP_REV, 0, 0 }, { "rev16", OP_REV16, 0, 0 },
+	{ "sxth", OP_SXTH, 0, 0 }, { "uxth", OP_UXTH, 0, 0 }, { "sxtb", OP_SXTB, 0, 0 }, { "uxtb", OP_UXTB, 0, 0 },
+	{ "sxtah", OP_SXTAH, 0, 0 }, { "uxtah", OP_UXTAH, 0, 0 }, { "sxtab", OP_SXTAB, 0, 0 }, { "uxtab", OP_UXTAB, 0, 0 },
+	{ "pkhbt", OP_PKHBT, 0, 0 }, { "pkhtb", OP_PKHTB, 0, 0 }, { "sbfx", OP_SBFX, 0, 0 }, { "ubfx", OP_UBFX, 0, 0 },
+	{ "bfi", OP_BFI, 0, 0 }, { "bfc", OP_BFC, 0, 0 },
+	{ "cmp", OP_CMP, 0, 0 }, { "cmn", OP_CMN, 0, 0 }, { "tst", OP_TST, 0, 0 }, { "teq", OP_TEQ, 0, 0 },
+	{ "ldr", OP_LDR, 0, 4 }, { "ldrh", OP_LDR, 0, 2 }, { "ldrsh", OP_LDR, F_SIGNED, 2 }, { "ldrb", OP_LDR, 0, 1 }, { "ldrsb", OP_LDR, F_SIGNED, 1 },
+	{ "str", OP_STR, 0, 4 }, { "strh", OP_STR, 0, 2 }, { "strb", OP_STR, 0, 1 }, { "ldrd", OP_LDRD, 0, 8 }, { "strd", OP_STRD, 0, 8 },
+	{ "ldm", OP_LDM, 0, 0 }, { "ldmia", OP_LDM, 0, 0 }, { "ldmfd", OP_LDM, 0, 0 }, { "ldmdb", OP_LDM, F_DB, 0 }, { "ldmea", OP_LDM, F_DB, 0 },
+	{ "stm", OP_STM, 0, 0 }, { "stmia", OP_STM, 0, 0 }, { "stmea", OP_STM, 0, 0 }, { "stmdb", OP_STM, F_DB, 0 }, { "stmfd", OP_STM, F_DB, 0 },
+	{ "push", OP_PUSH, 0, 0 }, { "pop", OP_POP, 0, 0 },
+	{ "movw", OP_MOVW, 0, 0 }, { "movt", OP_MOVT, 0, 0 }, { "adr", OP_ADR, 0, 0 },
+	{ "b", OP_B, 0, 0 }, { "bl", OP_BL, 0, 0 }, { "bx", OP_BX, 0, 0 }, { "blx", OP_BLX, 0, 0 }, { "cbz", OP_CBZ, 0, 0 }, { "cbnz", OP_CBNZ, 0, 0 },
+	{ "it", OP_IT, 0, 0 }, { "ite", OP_IT, 0, 0 }, { "itt", OP_IT, 0, 0 }, { "itee", OP_IT, 0, 0 }, { "itet", OP_IT, 0, 0 }, { "itte", OP_IT, 0, 0 },
+	{ "ittt", OP_IT, 0, 0 }, { "iteee", OP_IT, 0, 0 }, { "iteet", OP_IT, 0, 0 }, { "itete", OP_IT, 0, 0 }, { "itett", OP_IT, 0, 0 },
+	{ "ittee", OP_IT, 0, 0 }, { "ittet", OP_IT, 0, 0 }, { "ittte", OP_IT, 0, 0 }, { "itttt", OP_IT, 0, 0 },
+	{ "nop", OP_NOP, 0, 0 },
+};
+
+enum { CC_EQ, CC_NE, CC_CS, CC_CC, CC_MI, CC_PL, CC_VS, CC_VC, CC_HI, CC_LS, CC_GE, CC_LT, CC_GT, CC_LE, CC_AL };
+
+static const char *const condNames[] = { "eq", "ne", "cs", "cc", "mi", "pl", "vs", "vc", "hi", "ls", "ge", "lt", "gt", "le", "al", "hs", "lo" };
+
+struct srcLine {
+	int			line;
+	std::string	s;
+};
+
+struct emuMacro {
+	std::vector<std::string>	params, defaults;
+	std::vector<srcLine>		body;
+};
+
+static void emuFail(const thumbEmu &e, int line, const char *fmt, ...)
+{
+	va_list ap;
+	fprintf(stderr, "%s:%d: ", e.path.c_str(), line);
+	va_start(ap, fmt);
+	vfprintf(stderr, fmt, ap);
+	va_end(ap);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/* ---- source text ---- */
+
+static std::string trim(const std::string &s)
+{
+	size_t a = 0, b = s.size();
+	while (a < b && isspace((unsigned char)s[a])) a++;
+	while (b > a && isspace((unsigned char)s[b - 1])) b--;
+	return s.substr(a, b - a);
+}
+
+static std::string lower(std::string s)
+{
+	for (size_t i = 0; i < s.size(); i++) s[i] = tolower((unsigned char)s[i]);
+	return s;
+}
+
+// first word (lower case) and the rest
+static std::string firstWord(const std::string &s, std::string *rest)
+{
+	size_t i = 0;
+	while (i < s.size() && !isspace((unsigned char)s[i])) i++;
+	if (rest) *rest = trim(s.substr(i));
+	return lower(s.substr(0, i));
+}
+
+static std::vector<std::string> split(const std::string &s, char sep)
+{
+	std::vector<std::string> out;
+	size_t a = 0;
+	for (;;) {
+		size_t b = s.find(sep, a);
+		out.push_back(trim(s.substr(a, b == std::string::npos ? std::string::npos : b - a)));
+		if (b == std::string::npos) break;
+		a = b + 1;
+	}
+	return out;
+}
+
+// first s[i..] outside of a "string" (.ascii), npos if there is none
+static size_t findUnquoted(const std::string &s, const char *what, size_t from = 0)
+{
+	bool quoted = false;
+	for (size_t i = from; i < s.size(); i++) {
+		if (quoted && s[i] == '\\') i++;
+		else if (s[i] == '"') quoted = !quoted;
+		else if (!quoted && !s.compare(i, strlen(what), what)) return i;
+	}
+	return std::string::npos;
+}
+
+// comments (/* */, //, @ and lines starting with #) removed, one statement per line
+// (statements joined with ';' are split)
+static bool readSource(const char *path, std::vector<srcLine> &lines)
+{
+	FILE *f = fopen(path, "rb");
+	if (!f) return false;
+	std::string src;
+	char buf[4096];
+	size_t n;
+	while ((n = fread(buf, 1, sizeof(buf), f)) > 0) src.append(buf, n);
+	fclose(f);
+
+	std::string cur;
+	int line = 1;
+	bool comment = false;
+	for (size_t i = 0; i <= src.size(); i++) {
+		char ch = (i < src.size() ? src[i] : '\n');
+		if (comment) {
+			if (ch == '*' && i + 1 < src.size() && src[i + 1] == '/') { comment = false; i++; }
+			else if (ch == '\n') line++;
+			continue;
+		}
+		if (ch == '/' && i + 1 < src.size() && src[i + 1] == '*') { comment = true; i++; continue; }
+		if (ch != '\n') { cur += ch; continue; }
+
+		size_t cut = findUnquoted(cur, "//");
+		if (cut != std::string::npos) cur.erase(cut);
+		cut = findUnquoted(cur, "@");
+		if (cut != std::string::npos) cur.erase(cut);
+		cur = trim(cur);
+		if (!cur.empty() && cur[0] != '#') {
+			// ';' separates statements on one line
+			size_t start = 0;
+			while (start <= cur.size()) {
+				size_t end = findUnquoted(cur, ";", start);
+				if (end == std::string::npos) end = cur.size();
+				srcLine l = { line, trim(cur.substr(start, end - start)) };
+				if (!l.s.empty()) lines.push_back(l);
+				start = end + 1;
+			}
+		}
+		cur.clear();
+		line++;
+	}
+	return true;
+}
+
+/* ---- expressions ---- */
+
+struct exprParser {
+	const thumbEmu	*e;
+	const char		*p;
+	int				line;
+	bool			labels;		// data labels and emuSymbols allowed
+};
+
+static int64_t exprOr(exprParser &x);
+
+static void exprSpace(exprParser &x)
+{
+	while (isspace((unsigned char)*x.p)) x.p++;
+}
+
+static bool exprEat(exprParser &x, const char *tok)
+{
+	exprSpace(x);
+	size_t n = strlen(tok);
+	if (strncmp(x.p, tok, n)) return false;
+	// don't take < for <<, & for && ...
+	if (n == 1 && (tok[0] == '<' || tok[0] == '>' || tok[0] == '&' || tok[0] == '|') && x.p[1] == tok[0]) return false;
+	if (n == 1 && (tok[0] == '<' || tok[0] == '>' || tok[0] == '!') && x.p[1] == '=') return false;
+	x.p += n;
+	return true;
+}
+
+static int64_t exprPrimary(exprParser &x)
+{
+	exprSpace(x);
+	if (exprEat(x, "(")) {
+		int64_t v = exprOr(x);
+		if (!exprEat(x, ")")) emuFail(*x.e, x.line, "missing ) in expression");
+		return v;
+	}
+	if (exprEat(x, "-")) return -exprPrimary(x);
+	if (exprEat(x, "+")) return exprPrimary(x);
+	if (exprEat(x, "~")) return ~exprPrimary(x);
+	if (exprEat(x, "!")) return !exprPrimary(x);
+	if (isdigit((unsigned char)*x.p)) {
+		char *end;
+		int64_t v;
+		if (x.p[0] == '0' && (x.p[1] == 'b' || x.p[1] == 'B')) v = strtoll(x.p + 2, &end, 2);
+		else v = strtoll(x.p, &end, 0);
+		x.p = end;
+		return v;
+	}
+	if (isalpha((unsigned char)*x.p) || *x.p == '_' || *x.p == '.') {
+		const char *a = x.p;
+		while (isalnum((unsigned char)*x.p) || *x.p == '_' || *x.p == '.' || *x.p == '$') x.p++;
+		std::string name(a, x.p - a);
+		std::map<std::string, int64_t>::const_iterator q = x.e->equ.find(name);
+		if (q != x.e->equ.end()) return q->second;
+		if (x.labels) {
+			std::map<std::string, uint32_t>::const_iterator d = x.e->dataLabels.find(name);
+			if (d != x.e->dataLabels.end()) return d->second;
+		}
+		emuFail(*x.e, x.line, "unknown symbol %s", name.c_str());
+	}
+	emuFail(*x.e, x.line, "bad expression at '%s'", x.p);
+	return 0;
+}
+
+static int64_t exprMul(exprParser &x)
+{
+	int64_t v = exprPrimary(x);
+	for (;;) {
+		if (exprEat(x, "*")) v *= exprPrimary(x);
+		else if (exprEat(x, "/")) { int64_t d = exprPrimary(x); if (!d) emuFail(*x.e, x.line, "division by 0"); v /= d; }
+		else if (exprEat(x, "%")) { int64_t d = exprPrimary(x); if (!d) emuFail(*x.e, x.line, "division by 0"); v %= d; }
+		else return v;
+	}
+}
+
+static int64_t exprAdd(exprParser &x)
+{
+	int64_t v = exprMul(x);
+	for (;;) {
+		if (exprEat(x, "+")) v += exprMul(x);
+		else if (exprEat(x, "-")) v -= exprMul(x);
+		else return v;
+	}
+}
+
+static int64_t exprShift(exprParser &x)
+{
+	int64_t v = exprAdd(x);
+	for (;;) {
+		if (exprEat(x, "<<")) v <<= exprAdd(x);
+		else if (exprEat(x, ">>")) v >>= exprAdd(x);
+		else return v;
+	}
+}
+
+static int64_t exprCompare(exprParser &x)
+{
+	int64_t v = exprShift(x);
+	for (;;) {
+		if (exprEat(x, "<=")) v = (v <= exprShift(x));
+		else if (exprEat(x, ">=")) v = (v >= exprShift(x));
+		else if (exprEat(x, "<")) v = (v < exprShift(x));
+		else if (exprEat(x, ">")) v = (v > exprShift(x));
+		else if (exprEat(x, "==")) v = (v == exprShift(x));
+		else if (exprEat(x, "!=")) v = (v != exprShift(x));
+		else return v;
+	}
+}
+
+static int64_t exprBits(exprParser &x)
+{
+	int64_t v = exprCompare(x);
+	for (;;) {
+		if (exprEat(x, "&")) v &= exprCompare(x);
+		else if (exprEat(x, "^")) v ^= exprCompare(x);
+		else if (exprEat(x, "|")) v |= exprCompare(x);
+		else return v;
+	}
+}
+
+static int64_t exprOr(exprParser &x)
+{
+	int64_t v = exprBits(x);
+	for (;;) {
+		if (exprEat(x, "&&")) { int64_t w = exprBits(x); v = (v && w); }
+		else if (exprEat(x, "||")) { int64_t w = exprBits(x); v = (v || w); }
+		else return v;
+	}
+}
+
+static int64_t evalExpr(const thumbEmu &e, std::string s, int line, bool labels)
+{
+	s = trim(s);
+	if (!s.empty() && s[0] == '#') s.erase(0, 1);
+	exprParser x = { &e, s.c_str(), line, labels };
+	int64_t v = exprOr(x);
+	exprSpace(x);
+	if (*x.p) emuFail(e, line, "bad expression '%s'", s.c_str());
+	return v;
+}
+
+/* ---- macros, .rept, .irp, .if ---- */
+
+// index of the line that closes the block opened at lines[i], nested blocks skipped
+static size_t blockEnd(const thumbEmu &e, const std::vector<srcLine> &lines, size_t i, const char *const *open, const char *close)
+{
+	int level = 1;
+	for (size_t k = i + 1; k < lines.size(); k++) {
+		std::string w = firstWord(lines[k].s, 0);
+		for (int o = 0; open[o]; o++)
+			if (w == open[o]) level++;
+		if (w == close && --level == 0) return k;
+	}
+	emuFail(e, lines[i].line, "no %s", close);
+	return 0;
+}
+
+static const char *const ifOpen[] = { ".if", ".ifb", ".ifnb", ".ifdef", ".ifndef", 0 };
+static const char *const reptOpen[] = { ".rept", ".irp", ".irpc", 0 };
+static const char *const macroOpen[] = { 0 };
+
+// replaces \name of the parameters, removes \()
+static std::string substitute(const std::string &s, const std::vector<std::string> &names, const std::vector<std::string> &values)
+{
+	std::string out;
+	for (size_t i = 0; i < s.size(); i++) {
+		if (s[i] != '\\') { out += s[i]; continue; }
+		if (i + 2 < s.size() + 1 && s.compare(i, 3, "\\()") == 0) { i += 2; continue; }
+		size_t k = i + 1;
+		while (k < s.size() && (isalnum((unsigned char)s[k]) || s[k] == '_')) k++;
+		std::string name = s.substr(i + 1, k - i - 1);
+		size_t p;
+		for (p = 0; p < names.size(); p++)
+			if (names[p] == name) break;
+		if (p < names.size()) {
+			out += values[p];
+			i = k - 1;
+		} else {
+			out += s[i];
+		}
+	}
+	return out;
+}
+
+static bool expand(thumbEmu &e, const std::vector<srcLine> &in, std::map<std::string, emuMacro> &macros, std::vector<srcLine> &out)
+{
+	for (size_t i = 0; i < in.size(); i++) {
+		const srcLine &l = in[i];
+		std::string rest, w = firstWord(l.s, &rest);
+
+		if (w == ".end") return false;
+
+		if (w == ".macro") {
+			size_t end = blockEnd(e, in, i, macroOpen, ".endm");
+			std::string name;
+			std::vector<std::string> p;
+			for (size_t k = 0, a = 0; k <= rest.size(); k++) {
+				if (k == rest.size() || isspace((unsigned char)rest[k]) || rest[k] == ',') {
+					if (k > a) p.push_back(rest.substr(a, k - a));
+					a = k + 1;
+				}
+			}
+			if (p.empty()) emuFail(e, l.line, ".macro without a name");
+			emuMacro &m = macros[lower(p[0])];
+			m.params.clear();
+			m.defaults.clear();
+			for (size_t k = 1; k < p.size(); k++) {
+				size_t eq = p[k].find('=');
+				m.params.push_back(p[k].substr(0, eq));
+				m.defaults.push_back(eq == std::string::npos ? "" : p[k].substr(eq + 1));
+			}
+			m.body.assign(in.begin() + i + 1, in.begin() + end);
+			i = end;
+			continue;
+		}
+
+		if (w == ".rept" || w == ".irp") {
+			size_t end = blockEnd(e, in, i, reptOpen, ".endr");
+			std::vector<srcLine> body(in.begin() + i + 1, in.begin() + end);
+			std::vector<std::string> names, values;
+			int n;
+			if (w == ".rept") {
+				n = (int)evalExpr(e, rest, l.line, false);
+			} else {
+				values = split(rest, ',');
+				names.push_back(values[0]);
+				values.erase(values.begin());
+				n = (int)values.size();
+			}
+			for (int k = 0; k < n; k++) {
+				std::vector<srcLine> b = body;
+				if (!names.empty()) {
+					std::vector<std::string> v(1, values[k]);
+					for (size_t j = 0; j < b.size(); j++) b[j].s = substitute(b[j].s, names, v);
+				}
+				if (!expand(e, b, macros, out)) return false;
+			}
+			i = end;
+			continue;
+		}
+
+		if (w == ".if" || w == ".ifb" || w == ".ifnb") {
+			size_t end = blockEnd(e, in, i, ifOpen, ".endif");
+			size_t els = end;
+			int level = 0;
+			for (size_t k = i + 1; k < end; k++) {
+				std::string wk = firstWord(in[k].s, 0);
+				for (int o = 0; ifOpen[o]; o++)
+					if (wk == ifOpen[o]) level++;
+				if (wk == ".endif") level--;
+				if (wk == ".else" && level == 0) { els = k; break; }
+			}
+			bool cond;
+			if (w == ".ifb") cond = rest.empty();
+			else if (w == ".ifnb") cond = !rest.empty();
+			else cond = (evalExpr(e, rest, l.line, false) != 0);
+			std::vector<srcLine> body;
+			if (cond) body.assign(in.begin() + i + 1, in.begin() + els);
+			else if (els < end) body.assign(in.begin() + els + 1, in.begin() + end);
+			if (!expand(e, body, macros, out)) return false;
+			i = end;
+			continue;
+		}
+
+		if (w == ".equ" || w == ".set") {
+			size_t comma = rest.find(',');
+			if (comma == std::string::npos) emuFail(e, l.line, "%s without a value", w.c_str());
+			e.equ[trim(rest.substr(0, comma))] = evalExpr(e, rest.substr(comma + 1), l.line, false);
+			continue;
+		}
+
+		std::map<std::string, emuMacro>::const_iterator m = macros.find(w);
+		if (m != macros.end()) {
+			std::vector<std::string> args;
+			if (!rest.empty()) args = split(rest, ',');
+			std::vector<std::string> values = m->second.defaults;
+			for (size_t k = 0; k < args.size() && k < values.size(); k++)
+				if (!args[k].empty()) values[k] = args[k];
+			if (args.size() > values.size()) emuFail(e, l.line, "too many arguments for %s", w.c_str());
+			std::vector<srcLine> b = m->second.body;
+			for (size_t j = 0; j < b.size(); j++) {
+				b[j].s = trim(substitute(b[j].s, m->second.params, values));
+				b[j].line = l.line;		// errors point to the macro call
+			}
+			if (!expand(e, b, macros, out)) return false;
+			continue;
+		}
+
+		out.push_back(l);
+	}
+	return true;
+}
+
+/* ---- labels, data, register names ---- */
+
+static bool isLabelChar(char ch)
+{
+	return isalnum((unsigned char)ch) || ch == '_' || ch == '.' || ch == '$';
+}
+
+static void alignData(thumbEmu &e, uint32_t a)
+{
+	e.dataEnd = (e.dataEnd + a - 1) & ~(a - 1);
+}
+
+static void assemble(thumbEmu &e, const std::vector<srcLine> &lines)
+{
+	std::vector<std::string> pending;
+
+	e.aliases.assign(1, std::map<std::string, int>());
+	for (size_t i = 0; i < lines.size(); i++) {
+		std::string s = lines[i].s;
+		int line = lines[i].line;
+
+		// labels
+		for (;;) {
+			size_t k = 0;
+			while (k < s.size() && isLabelChar(s[k])) k++;
+			if (k == 0 || k >= s.size() || s[k] != ':') break;
+			pending.push_back(s.substr(0, k));
+			s = trim(s.substr(k + 1));
+		}
+		if (s.empty()) continue;
+
+		std::string rest, w = firstWord(s, &rest);
+		if (w[0] == '.') {
+			int size = 0;
+			if (w == ".word" || w == ".long") size = 4;
+			else if (w == ".short" || w == ".hword") size = 2;
+			else if (w == ".byte") size = 1;
+			if (size) {
+				alignData(e, size);
+				for (size_t k = 0; k < pending.size(); k++) {
+					if (e.dataLabels.count(pending[k]) || e.codeLabels.count(pending[k])) emuFail(e, line, "%s defined twice", pending[k].c_str());
+					e.dataLabels[pending[k]] = e.dataEnd;
+				}
+				pending.clear();
+				std::vector<std::string> v = split(rest, ',');
+				for (size_t k = 0; k < v.size(); k++) {
+					uint32_t x = (uint32_t)evalExpr(e, v[k], line, false);
+					if (e.dataEnd + size > e.mem.size()) emuFail(e, line, "out of memory");
+					memcpy(&e.mem[e.dataEnd], &x, size);		// little endian host
+					e.dataEnd += size;
+				}
+			} else if (w == ".zero" || w == ".space" || w == ".ascii" || w == ".asciz") {
+				std::string bytes;
+				if (w[1] == 'a') {
+					size_t a = rest.find('"'), b = rest.rfind('"');
+					if (a == std::string::npos || b == a) emuFail(e, line, "%s without a string", w.c_str());
+					for (size_t k = a + 1; k < b; k++) {
+						if (rest[k] != '\\' || k + 1 >= b) { bytes += rest[k]; continue; }
+						k++;
+						if (rest[k] >= '0' && rest[k] <= '7') {		// octal, up to 3 digits
+							int c = 0;
+							for (int j = 0; j < 3 && k < b && rest[k] >= '0' && rest[k] <= '7'; j++, k++) c = c * 8 + rest[k] - '0';
+							k--;
+							bytes += (char)c;
+						} else {
+							const char *esc = strchr("b\bf\fn\nr\rt\tv\v", rest[k]);
+							bytes += (esc && rest[k] ? esc[1] : rest[k]);
+						}
+					}
+					if (w == ".asciz") bytes += '\0';
+				} else {
+					std::vector<std::string> v = split(rest, ',');	// .zero size[, fill]
+					bytes.assign((size_t)evalExpr(e, v[0], line, false), v.size() > 1 ? (char)evalExpr(e, v[1], line, false) : '\0');
+				}
+				for (size_t k = 0; k < pending.size(); k++) {
+					if (e.dataLabels.count(pending[k]) || e.codeLabels.count(pending[k])) emuFail(e, line, "%s defined twice", pending[k].c_str());
+					e.dataLabels[pending[k]] = e.dataEnd;
+				}
+				pending.clear();
+				if (e.dataEnd + bytes.size() > e.mem.size()) emuFail(e, line, "out of memory");
+				memcpy(&e.mem[e.dataEnd], bytes.data(), bytes.size());
+				e.dataEnd += (uint32_t)bytes.size();
+			} else if (w == ".align" || w == ".p2align" || w == ".balign") {
+				int a = rest.empty() ? 2 : (int)evalExpr(e, split(rest, ',')[0], line, false);
+				alignData(e, w == ".balign" ? (a < 4 ? 4 : a) : (a < 2 ? 4 : 1 << a));
+			} else if (w == ".unreq") {
+				std::map<std::string, int> al = e.aliases.back();
+				al.erase(lower(rest));
+				e.aliases.push_back(al);
+			} else if (w != ".global" && w != ".globl" && w != ".thumb" && w != ".thumb_func" && w != ".syntax" &&
+				w != ".cpu" && w != ".fpu" && w != ".arch" && w != ".text" && w != ".data" && w != ".bss" && w != ".section" &&
+				w != ".ltorg" && w != ".pool" && w != ".type" && w != ".size" && w != ".file" &&
+				w != ".code" && w != ".eabi_attribute" && w != ".fnstart" && w != ".fnend" && w != ".cantunwind" &&
+				w != ".save" && w != ".setfp" && w != ".pad" && w != ".local" && w != ".ident" && w != ".addrsig" &&
+				w != ".addrsig_sym") {
+				emuFail(e, line, "unknown directive %s", w.c_str());
+			}
+			continue;
+		}
+
+		std::string arg, w2 = firstWord(rest, &arg);
+		if (w2 == ".req") {
+			std::map<std::string, int> al = e.aliases.back();
+			std::string r = lower(arg);
+			int n = -1;
+			if (al.count(r)) n = al[r];
+			else if (r == "sp") n = 13;
+			else if (r == "lr") n = 14;
+			else if (r == "pc") n = 15;
+			else if (r == "ip") n = 12;
+			else if (r == "fp") n = 11;
+			else if (r == "sl") n = 10;
+			else if (r.size() >= 2 && r[0] == 'r' && isdigit((unsigned char)r[1])) n = atoi(r.c_str() + 1);
+			if (n < 0 || n > 15) emuFail(e, line, "bad register %s", arg.c_str());
+			al[lower(w)] = n;
+			e.aliases.push_back(al);
+			continue;
+		}
+
+		for (size_t k = 0; k < pending.size(); k++) {
+			if (e.dataLabels.count(pending[k]) || e.codeLabels.count(pending[k])) emuFail(e, line, "%s defined twice", pending[k].c_str());
+			e.codeLabels[pending[k]] = (int)e.text.size();
+		}
+		pending.clear();
+		e.text.push_back(s);
+		e.line.push_back(line);
+		e.aliasSet.push_back((int)e.aliases.size() - 1);
+	}
+	for (size_t k = 0; k < pending.size(); k++)
+		e.codeLabels[pending[k]] = (int)e.text.size();
+}
+
+bool emuLoad(thumbEmu &e, const char *path, uint32_t memBytes)
+{
+	std::vector<srcLine> src, lines;
+	std::map<std::string, emuMacro> macros;
+
+	e.path = path;
+	e.mem.assign(memBytes, 0);
+	e.code.clear();
+	e.text.clear();
+	e.line.clear();
+	e.codeLabels.clear();
+	e.dataLabels.clear();
+	e.equ.clear();
+	e.funcs.clear();
+	e.funcIndex.clear();
+	e.aliasSet.clear();
+	e.dataEnd = EMU_NULL;
+	e.linked = false;
+	e.cycles = e.instructions = 0;
+	if (!readSource(path, src)) {
+		fprintf(stderr, "%s: can't read\n", path);
+		return false;
+	}
+	expand(e, src, macros, lines);
+	assemble(e, lines);
+	return true;
+}
+
+const char *emuSource(const char *file)
+{
+	static std::string path;
+	const char *self = __FILE__;	// <library>/extras/host/thumbemu.cpp
+	const char *tail = strstr(self, "extras/host/thumbemu.cpp");
+
+	path.assign(self, tail ? tail - self : 0);
+	path += file;
+	return path.c_str();
+}
+
+uint32_t emuAlloc(thumbEmu &e, uint32_t bytes)
+{
+	alignData(e, 8);
+	uint32_t a = e.dataEnd;
+	if ((uint64_t)a + bytes + 0x10000 > e.mem.size()) {		// 64 KB left for the stack
+		fprintf(stderr, "%s: emuAlloc out of memory\n", e.path.c_str());
+		exit(1);
+	}
+	e.dataEnd += bytes;
+	return a;
+}
+
+void *emuPtr(thumbEmu &e, uint32_t addr)
+{
+	return &e.mem[addr];
+}
+
+void emuSymbol(thumbEmu &e, const char *name, uint32_t addr)
+{
+	if (e.linked) emuFail(e, 0, "emuSymbol(%s) after the first emuCall", name);
+	e.dataLabels[name] = addr;
+}
+
+void emuFunction(thumbEmu &e, const char *name, emuFunc f)
+{
+	if (e.linked) emuFail(e, 0, "emuFunction(%s) after the first emuCall", name);
+	e.funcIndex[name] = (int)e.funcs.size();
+	e.funcs.push_back(f);
+}
+
+/* ---- instruction decoding ---- */
+
+struct emuDecoder {
+	thumbEmu	*e;
+	int			k;		// instruction index
+	const std::map<std::string, int> *al;
+};
+
+static void decodeFail(const emuDecoder &d, const char *what)
+{
+	emuFail(*d.e, d.e->line[d.k], "%s: %s", what, d.e->text[d.k].c_str());
+}
+
+static int regNum(const emuDecoder &d, const std::string &s0, bool fail = true)
+{
+	std::string s = lower(trim(s0));
+	std::map<std::string, int>::const_iterator a = d.al->find(s);
+	if (a != d.al->end()) return a->second;
+	if (s == "sp") return 13;
+	if (s == "lr") return 14;
+	if (s == "pc") return 15;
+	if (s == "ip") return 12;
+	if (s == "fp") return 11;
+	if (s == "sl") return 10;
+	if (s.size() >= 2 && s.size() <= 3 && s[0] == 'r' && isdigit((unsigned char)s[1]) && (s.size() == 2 || isdigit((unsigned char)s[2]))) {
+		int n = atoi(s.c_str() + 1);
+		if (n <= 15) return n;
+	}
+	if (fail) decodeFail(d, "bad register");
+	return -1;
+}
+
+static uint32_t immValue(const emuDecoder &d, const std::string &s)
+{
+	if (trim(s)[0] != '#') decodeFail(d, "immediate expected");
+	return (uint32_t)evalExpr(*d.e, s, d.e->line[d.k], false);
+}
+
+// "lsl #2" or "asr r3"
+static bool parseShift(const emuDecoder &d, const std::string &s, emuInsn &in)
+{
+	std::string rest, w = firstWord(s, &rest);
+	static const char *const names[] = { "lsl", "lsr", "asr", "ror" };
+	for (int t = 0; t < 4; t++) {
+		if (w != names[t]) continue;
+		in.shift = t;
+		if (!rest.empty() && rest[0] == '#') in.amount = immValue(d, rest);
+		else in.rs = regNum(d, rest);
+		return true;
+	}
+	return false;
+}
+
+static bool isShift(const std::string &s)
+{
+	std::string w = firstWord(s, 0);
+	return w == "lsl" || w == "lsr" || w == "asr" || w == "ror";
+}
+
+// operand 2: #imm or rm{, shift}
+static void parseOp2(const emuDecoder &d, const std::vector<std::string> &ops, size_t i, emuInsn &in)
+{
+	if (i >= ops.size()) decodeFail(d, "operand missing");
+	if (ops[i][0] == '#') {
+		in.immOp = true;
+		in.imm = immValue(d, ops[i]);
+		if (i + 1 < ops.size()) decodeFail(d, "too many operands");
+		return;
+	}
+	in.rm = regNum(d, ops[i]);
+	if (i + 1 < ops.size() && !parseShift(d, ops[i + 1], in)) decodeFail(d, "bad shift");
+	if (i + 2 < ops.size()) decodeFail(d, "too many operands");
+}
+
+// [rn], [rn, #imm], [rn, rm{, lsl #n}], each with ! or a post-index #imm / rm
+static void parseAddress(const emuDecoder &d, const std::vector<std::string> &ops, size_t i, emuInsn &in)
+{
+	if (i >= ops.size()) decodeFail(d, "address missing");
+	std::string a = ops[i];
+	in.mode = AM_OFFSET;
+	if (a[a.size() - 1] == '!') {
+		in.mode = AM_PRE;
+		a = trim(a.substr(0, a.size() - 1));
+	}
+	if (a[0] != '[' || a[a.size() - 1] != ']') decodeFail(d, "bad address");
+	std::vector<std::string> p = split(a.substr(1, a.size() - 2), ',');
+	in.rn = regNum(d, p[0]);
+	in.immOp = true;
+	in.imm = 0;
+	if (p.size() > 1) {
+		if (p[1][0] == '#') {
+			in.imm = immValue(d, p[1]);
+		} else {
+			in.immOp = false;
+			in.rm = regNum(d, p[1]);
+			if (p.size() > 2 && !parseShift(d, p[2], in)) decodeFail(d, "bad shift");
+		}
+	}
+	if (i + 1 < ops.size()) {
+		if (in.mode != AM_OFFSET || p.size() > 1) decodeFail(d, "bad address");
+		in.mode = AM_POST;
+		if (ops[i + 1][0] == '#') {
+			in.imm = immValue(d, ops[i + 1]);
+		} else {
+			in.immOp = false;
+			in.rm = regNum(d, ops[i + 1]);
+		}
+	}
+}
+
+static uint16_t parseRegList(const emuDecoder &d, std::string s)
+{
+	s = trim(s);
+	if (s.size() < 2 || s[0] != '{' || s[s.size() - 1] != '}') decodeFail(d, "bad register list");
+	std::vector<std::string> p = split(s.substr(1, s.size() - 2), ',');
+	uint16_t regs = 0;
+	for (size_t k = 0; k < p.size(); k++) {
+		size_t dash = p[k].find('-');
+		int a = regNum(d, p[k].substr(0, dash)), b = a;
+		if (dash != std::string::npos) b = regNum(d, p[k].substr(dash + 1));
+		for (int r = a; r <= b; r++) regs |= 1 << r;
+	}
+	return regs;
+}
+
+static uint32_t branchTarget(const emuDecoder &d, const std::string &s)
+{
+	std::map<std::string, int>::const_iterator c = d.e->codeLabels.find(trim(s));
+	if (c != d.e->codeLabels.end()) return c->second;
+	std::map<std::string, int>::const_iterator f = d.e->funcIndex.find(trim(s));
+	if (f != d.e->funcIndex.end()) return EMU_FUNC + f->second;
+	decodeFail(d, "unknown label");
+	return 0;
+}
+
+// operands split at the commas outside [] and {}
+static std::vector<std::string> splitOperands(const std::string &s)
+{
+	std::vector<std::string> out;
+	std::string cur;
+	int depth = 0;
+	for (size_t i = 0; i < s.size(); i++) {
+		if (s[i] == '[' || s[i] == '{') depth++;
+		if (s[i] == ']' || s[i] == '}') depth--;
+		if (s[i] == ',' && depth == 0) {
+			out.push_back(trim(cur));
+			cur.clear();
+		} else {
+			cur += s[i];
+		}
+	}
+	if (!trim(cur).empty()) out.push_back(trim(cur));
+	return out;
+}
+
+static void decode(thumbEmu &e, int k)
+{
+	emuDecoder d = { &e, k, &e.aliases[e.aliasSet[k]] };
+	std::string rest, mn = firstWord(e.text[k], &rest);
+	std::vector<std::string> ops = splitOperands(rest);
+	emuInsn in;
+
+	memset(&in, 0, sizeof(in));
+	in.rd = in.rn = in.rm = in.ra = in.rs = NOREG;
+	if (mn.size() > 2 && (mn.compare(mn.size() - 2, 2, ".w") == 0 || mn.compare(mn.size() - 2, 2, ".n") == 0))
+		mn.erase(mn.size() - 2);
+
+	// mnemonic, or mnemonic + condition
+	const emuMnemonic *m = 0;
+	in.cond = CC_AL;
+	for (size_t i = 0; i < sizeof(mnemonics) / sizeof(mnemonics[0]) && !m; i++)
+		if (mn == mnemonics[i].name) m = &mnemonics[i];
+	for (size_t i = 0; i < sizeof(mnemonics) / sizeof(mnemonics[0]) && !m; i++) {
+		size_t n = strlen(mnemonics[i].name);
+		if (mn.size() != n + 2 || mn.compare(0, n, mnemonics[i].name)) continue;
+		for (int c = 0; c < 17; c++) {
+			if (mn.compare(n, 2, condNames[c])) continue;
+			m = &mnemonics[i];
+			in.cond = (c == 15 ? CC_CS : c == 16 ? CC_CC : c);
+		}
+	}
+	if (!m) decodeFail(d, "unknown instruction");
+	in.op = m->op;
+	in.flags = m->flags;
+	in.size = m->size;
+
+	size_t n = ops.size();
+	switch (in.op) {
+	case OP_MOV: case OP_MVN:
+		in.rd = regNum(d, ops[0]);
+		parseOp2(d, ops, 1, in);
+		break;
+	case OP_ADD: case OP_SUB: case OP_RSB: case OP_ADC: case OP_SBC: case OP_AND: case OP_ORR: case OP_EOR: case OP_BIC:
+		if (n < 2) decodeFail(d, "operand missing");
+		in.rd = regNum(d, ops[0]);
+		if (n == 2 || (n == 3 && isShift(ops[2]))) {
+			in.rn = in.rd;
+			parseOp2(d, ops, 1, in);
+		} else {
+			in.rn = regNum(d, ops[1]);
+			parseOp2(d, ops, 2, in);
+		}
+		break;
+	case OP_LSL: case OP_LSR: case OP_ASR: case OP_ROR:
+		if (n != 2 && n != 3) decodeFail(d, "bad operands");
+		in.rd = regNum(d, ops[0]);
+		in.rm = (n == 2 ? in.rd : regNum(d, ops[1]));
+		in.shift = in.op - OP_LSL;
+		if (ops[n - 1][0] == '#') in.amount = immValue(d, ops[n - 1]);
+		else in.rs = regNum(d, ops[n - 1]);
+		break;
+	case OP_MUL:
+		if (n != 2 && n != 3) decodeFail(d, "bad operands");
+		in.rd = regNum(d, ops[0]);
+		in.rn = (n == 2 ? in.rd : regNum(d, ops[1]));
+		in.rm = regNum(d, ops[n - 1]);
+		break;
+	case OP_SMULL: case OP_UMULL: case OP_SMLAL: case OP_UMLAL: case OP_SMLALD:
+		if (n != 4) decodeFail(d, "bad operands");
+		in.rd = regNum(d, ops[0]);		// low word
+		in.ra = regNum(d, ops[1]);		// high word
+		in.rn = regNum(d, ops[2]);
+		in.rm = regNum(d, ops[3]);
+		break;
+	case OP_MLA: case OP_MLS: case OP_SMMLA: case OP_SMMLS: case OP_SMLAXY: case OP_SMLAWY: case OP_SMLAD:
+		if (n != 4) decodeFail(d, "bad operands");
+		in.ra = regNum(d, ops[3]);
+		/* fall through */
+	case OP_SMMUL: case OP_SMULXY: case OP_SMULWY: case OP_SMUAD: case OP_QADD: case OP_QSUB: case OP_QDADD: case OP_QDSUB:
+	case OP_SDIV: case OP_UDIV:
+		if (n != 3 && !(n == 4 && in.ra != NOREG)) decodeFail(d, "bad operands");
+		in.rd = regNum(d, ops[0]);
+		in.rn = regNum(d, ops[1]);
+		in.rm = regNum(d, ops[2]);
+		break;
+	case OP_SSAT: case OP_USAT:
+		if (n < 3) decodeFail(d, "bad operands");
+		in.rd = regNum(d, ops[0]);
+		{
+			emuInsn sh = in;
+			parseOp2(d, ops, 2, sh);
+			if (sh.immOp) decodeFail(d, "register expected");
+			in.rm = sh.rm;
+			in.shift = sh.shift;
+			in.rs = sh.rs;
+			in.imm = sh.amount;		// shift amount, amount is the saturation
+			in.amount = immValue(d, ops[1]);
+		}
+		break;
+	case OP_CLZ: case OP_RBIT: case OP_REV: case OP_REV16: case OP_SXTH: case OP_UXTH: case OP_SXTB: case OP_UXTB:
+		if (n != 2) decodeFail(d, "bad operands");
+		in.rd = regNum(d, ops[0]);
+		in.rm = regNum(d, ops[1]);
+		break;
+	case OP_SXTAH: case OP_UXTAH: case OP_SXTAB: case OP_UXTAB:
+		if (n < 3) decodeFail(d, "bad operands");
+		in.rd = regNum(d, ops[0]);
+		in.rn = regNum(d, ops[1]);
+		parseOp2(d, ops, 2, in);
+		if (in.immOp || (in.rs == NOREG && in.amount && in.shift != SH_ROR)) decodeFail(d, "bad rotation");
+		break;
+	case OP_PKHBT: case OP_PKHTB:
+		if (n < 3) decodeFail(d, "bad operands");
+		in.rd = regNum(d, ops[0]);
+		in.rn = regNum(d, ops[1]);
+		parseOp2(d, ops, 2, in);
+		if (in.immOp) decodeFail(d, "register expected");
+		break;
+	case OP_SBFX: case OP_UBFX: case OP_BFI:
+		if (n != 4) decodeFail(d, "bad operands");
+		in.rd = regNum(d, ops[0]);
+		in.rn = regNum(d, ops[1]);
+		in.imm = immValue(d, ops[2]);
+		in.amount = immValue(d, ops[3]);
+		if (in.amount < 1 || in.imm + in.amount > 32) decodeFail(d, "bad bitfield");
+		break;
+	case OP_BFC:
+		if (n != 3) decodeFail(d, "bad operands");
+		in.rd = regNum(d, ops[0]);
+		in.imm = immValue(d, ops[1]);
+		in.amount = immValue(d, ops[2]);
+		if (in.amount < 1 || in.imm + in.amount > 32) decodeFail(d, "bad bitfield");
+		break;
+	case OP_CMP: case OP_CMN: case OP_TST: case OP_TEQ:
+		if (n < 2) decodeFail(d, "operand missing");
+		in.rn = regNum(d, ops[0]);
+		parseOp2(d, ops, 1, in);
+		break;
+	case OP_LDR: case OP_STR:
+		if (n < 2) decodeFail(d, "operand missing");
+		in.rd = regNum(d, ops[0]);
+		if (in.op == OP_LDR && ops[1][0] == '=') {
+			in.op = OP_LDRLIT;
+			in.imm = (uint32_t)evalExpr(e, ops[1].substr(1), e.line[k], true);
+		} else if (in.op == OP_LDR && ops[1][0] != '[' && in.size == 4) {		// ldr rX, .LCPI0_0 (compiler literal pool)
+			in.op = OP_LDRLIT;
+			uint32_t a = (uint32_t)evalExpr(e, ops[1], e.line[k], true);
+			if (a + 4 > e.mem.size()) decodeFail(d, "bad literal");
+			memcpy(&in.imm, &e.mem[a], 4);
+		} else {
+			parseAddress(d, ops, 1, in);
+		}
+		if (in.rd == 15 && in.op != OP_STR) decodeFail(d, "load to pc");
+		break;
+	case OP_LDRD: case OP_STRD:
+		if (n < 3) decodeFail(d, "operand missing");
+		in.rd = regNum(d, ops[0]);
+		in.ra = regNum(d, ops[1]);
+		parseAddress(d, ops, 2, in);
+		break;
+	case OP_LDM: case OP_STM:
+		if (n != 2) decodeFail(d, "bad operands");
+		in.writeback = (ops[0][ops[0].size() - 1] == '!');
+		in.rn = regNum(d, in.writeback ? ops[0].substr(0, ops[0].size() - 1) : ops[0]);
+		in.regs = parseRegList(d, ops[1]);
+		break;
+	case OP_PUSH: case OP_POP:
+		if (n != 1) decodeFail(d, "bad operands");
+		in.regs = parseRegList(d, ops[0]);
+		break;
+	case OP_MOVW: case OP_MOVT:
+		if (n != 2) decodeFail(d, "bad operands");
+		in.rd = regNum(d, ops[0]);
+		if (!ops[1].compare(0, 9, ":lower16:"))
+			in.imm = (uint32_t)evalExpr(e, ops[1].substr(9), e.line[k], true) & 0xffff;
+		else if (!ops[1].compare(0, 9, ":upper16:"))
+			in.imm = (uint32_t)evalExpr(e, ops[1].substr(9), e.line[k], true) >> 16;
+		else
+			in.imm = immValue(d, ops[1]) & 0xffff;
+		break;
+	case OP_ADR:
+		if (n != 2) decodeFail(d, "bad operands");
+		in.rd = regNum(d, ops[0]);
+		in.imm = (uint32_t)evalExpr(e, ops[1], e.line[k], true);
+		break;
+	case OP_B: case OP_BL:
+		if (n != 1) decodeFail(d, "bad operands");
+		in.target = branchTarget(d, ops[0]);
+		break;
+	case OP_BX: case OP_BLX:
+		if (n != 1) decodeFail(d, "bad operands");
+		in.rm = regNum(d, ops[0]);
+		break;
+	case OP_CBZ: case OP_CBNZ:
+		if (n != 2) decodeFail(d, "bad operands");
+		in.rn = regNum(d, ops[0]);
+		in.target = branchTarget(d, ops[1]);
+		break;
+	case OP_IT: case OP_NOP:
+		break;
+	}
+	if (in.rd == 15 && in.op != OP_STR && in.op != OP_CMP) decodeFail(d, "pc as destination");
+	e.code[k] = in;
+}
+
+static void link(thumbEmu &e)
+{
+	e.code.resize(e.text.size());
+	for (size_t k = 0; k < e.text.size(); k++) decode(e, (int)k);
+	e.linked = true;
+}
+
+/* ---- execution ---- */
+
+static void execFail(const thumbEmu &e, uint32_t pc, const char *fmt, uint32_t x)
+{
+	char msg[256];
+	snprintf(msg, sizeof(msg), fmt, x);
+	if (pc < e.text.size()) emuFail(e, e.line[pc], "%s: %s", msg, e.text[pc].c_str());
+	emuFail(e, 0, "%s", msg);
+}
+
+static inline uint32_t rd32(thumbEmu &e, uint32_t pc, uint32_t a, int size)
+{
+	if (a < EMU_NULL || (uint64_t)a + size > e.mem.size()) execFail(e, pc, "read from 0x%x", a);
+	uint32_t v = 0;
+	memcpy(&v, &e.mem[a], size);
+	return v;
+}
+
+static inline void wr32(thumbEmu &e, uint32_t pc, uint32_t a, int size, uint32_t v)
+{
+	if (a < EMU_NULL || (uint64_t)a + size > e.mem.size()) execFail(e, pc, "write to 0x%x", a);
+	memcpy(&e.mem[a], &v, size);
+}
+
+static inline uint32_t shiftValue(uint32_t v, int type, uint32_t n)
+{
+	switch (type) {
+	case SH_LSL: return n >= 32 ? 0 : v << n;
+	case SH_LSR: return n >= 32 ? 0 : v >> n;
+	case SH_ASR: return (uint32_t)((int32_t)v >> (n > 31 ? 31 : n));
+	default: n &= 31; return n ? (v >> n) | (v << (32 - n)) : v;
+	}
+}
+
+static inline uint32_t op2(const thumbEmu &e, const emuInsn &in)
+{
+	if (in.immOp) return in.imm;
+	return shiftValue(e.r[in.rm], in.shift, in.rs == NOREG ? in.amount : e.r[in.rs] & 0xff);
+}
+
+// operand 2 of the flag-setting moves, shifts and logical instructions, sets C to the
+// carry out of the shifter (immediates leave it alone, true for all but rotated constants)
+static inline uint32_t op2Carry(thumbEmu &e, const emuInsn &in)
+{
+	if (in.immOp) return in.imm;
+	uint32_t v = e.r[in.rm], n = (in.rs == NOREG ? in.amount : e.r[in.rs] & 0xff);
+	if (!n) return v;
+	switch (in.shift) {
+	case SH_LSL: e.c = (n > 32 ? 0 : (v >> (32 - n)) & 1); break;
+	case SH_LSR: e.c = (n > 32 ? 0 : (v >> (n - 1)) & 1); break;
+	case SH_ASR: e.c = (n >= 32 ? v >> 31 : ((int32_t)v >> (n - 1)) & 1); break;
+	default: e.c = shiftValue(v, SH_ROR, n) >> 31; break;
+	}
+	return shiftValue(v, in.shift, n);
+}
+
+static inline void setNZ(thumbEmu &e, uint32_t v)
+{
+	e.n = v >> 31;
+	e.z = (v == 0);
+}
+
+static inline uint32_t addFlags(thumbEmu &e, uint32_t a, uint32_t b, uint32_t carry)
+{
+	uint64_t sum = (uint64_t)a + b + carry;
+	uint32_t r = (uint32_t)sum;
+	e.c = (int)(sum >> 32);
+	e.v = (((a ^ r) & (b ^ r)) >> 31);
+	setNZ(e, r);
+	return r;
+}
+
+static inline bool condition(const thumbEmu &e, int cond)
+{
+	switch (cond) {
+	case CC_EQ: return e.z;
+	case CC_NE: return !e.z;
+	case CC_CS: return e.c;
+	case CC_CC: return !e.c;
+	case CC_MI: return e.n;
+	case CC_PL: return !e.n;
+	case CC_VS: return e.v;
+	case CC_VC: return !e.v;
+	case CC_HI: return e.c && !e.z;
+	case CC_LS: return !e.c || e.z;
+	case CC_GE: return e.n == e.v;
+	case CC_LT: return e.n != e.v;
+	case CC_GT: return !e.z && e.n == e.v;
+	case CC_LE: return e.z || e.n != e.v;
+	default: return true;
+	}
+}
+
+static inline int32_t saturate(thumbEmu &e, int64_t v, int bits)
+{
+	int64_t hi = ((int64_t)1 << (bits - 1)) - 1, lo = -((int64_t)1 << (bits - 1));
+	if (v > hi) { e.q = 1; return (int32_t)hi; }
+	if (v < lo) { e.q = 1; return (int32_t)lo; }
+	return (int32_t)v;
+}
+
+static inline int32_t half(uint32_t x, bool top)
+{
+	return top ? (int32_t)x >> 16 : (int16_t)x;
+}
+
+static inline int bitCount(uint16_t x)
+{
+	int n = 0;
+	for (; x; x &= x - 1) n++;
+	return n;
+}
+
+// effective address of a load or store, base register written back if needed
+static inline uint32_t address(thumbEmu &e, const emuInsn &in)
+{
+	uint32_t base = e.r[in.rn];
+	uint32_t off = in.immOp ? in.imm : shiftValue(e.r[in.rm], in.shift, in.amount);
+	if (in.mode == AM_OFFSET) return base + off;
+	e.r[in.rn] = base + off;
+	return in.mode == AM_PRE ? base + off : base;
+}
+
+// one instruction, returns the next pc
+static uint32_t step(thumbEmu &e, uint32_t pc)
+{
+	const emuInsn &in = e.code[pc];
+	uint32_t *R = e.r;
+	int cyc = 1;
+	bool load = false;
+
+	e.instructions++;
+	if (in.op == OP_IT) return pc + 1;
+	if (in.op == OP_NOP) { e.cycles++; return pc + 1; }
+	if (in.cond != CC_AL && !condition(e, in.cond)) { e.cycles++; return pc + 1; }
+
+	bool s = (in.flags & F_S) != 0;
+	uint32_t x, res;
+	int64_t p;
+
+	switch (in.op) {
+	case OP_MOV:
+		R[in.rd] = res = (s ? op2Carry(e, in) : op2(e, in));
+		if (s) setNZ(e, res);
+		break;
+	case OP_MVN:
+		R[in.rd] = res = ~(s ? op2Carry(e, in) : op2(e, in));
+		if (s) setNZ(e, res);
+		break;
+	case OP_ADD:
+		x = op2(e, in);
+		R[in.rd] = s ? addFlags(e, R[in.rn], x, 0) : R[in.rn] + x;
+		break;
+	case OP_SUB:
+		x = op2(e, in);
+		R[in.rd] = s ? addFlags(e, R[in.rn], ~x, 1) : R[in.rn] - x;
+		break;
+	case OP_RSB:
+		x = op2(e, in);
+		R[in.rd] = s ? addFlags(e, x, ~R[in.rn], 1) : x - R[in.rn];
+		break;
+	case OP_ADC:
+		x = op2(e, in);
+		R[in.rd] = s ? addFlags(e, R[in.rn], x, e.c) : R[in.rn] + x + e.c;
+		break;
+	case OP_SBC:
+		x = op2(e, in);
+		R[in.rd] = s ? addFlags(e, R[in.rn], ~x, e.c) : R[in.rn] + ~x + e.c;
+		break;
+	case OP_AND: R[in.rd] = res = R[in.rn] & (s ? op2Carry(e, in) : op2(e, in)); if (s) setNZ(e, res); break;
+	case OP_ORR: R[in.rd] = res = R[in.rn] | (s ? op2Carry(e, in) : op2(e, in)); if (s) setNZ(e, res); break;
+	case OP_EOR: R[in.rd] = res = R[in.rn] ^ (s ? op2Carry(e, in) : op2(e, in)); if (s) setNZ(e, res); break;
+	case OP_BIC: R[in.rd] = res = R[in.rn] & ~(s ? op2Carry(e, in) : op2(e, in)); if (s) setNZ(e, res); break;
+	case OP_LSL: case OP_LSR: case OP_ASR: case OP_ROR:
+		R[in.rd] = res = (s ? op2Carry(e, in) : op2(e, in));
+		if (s) setNZ(e, res);
+		break;
+	case OP_MUL:
+		R[in.rd] = res = R[in.rn] * R[in.rm];
+		if (s) setNZ(e, res);
+		break;
+	case OP_MLA: R[in.rd] = R[in.ra] + R[in.rn] * R[in.rm]; cyc = 2; break;
+	case OP_MLS: R[in.rd] = R[in.ra] - R[in.rn] * R[in.rm]; cyc = 2; break;
+	case OP_SDIV: case OP_UDIV: {
+		// 2..12 cycles, it stops early: about one per 4 bits of quotient
+		uint32_t a = R[in.rn], b = R[in.rm];
+		if (in.op == OP_SDIV) {
+			int32_t sa = (int32_t)a, sb = (int32_t)b;
+			R[in.rd] = (!sb ? 0 : (sa == INT32_MIN && sb == -1) ? (uint32_t)sa : (uint32_t)(sa / sb));
+			a = (sa < 0 ? 0u - a : a);
+			b = (sb < 0 ? 0u - b : b);
+		} else {
+			R[in.rd] = (b ? a / b : 0);
+		}
+		int bits = 0;
+		for (x = a; x; x >>= 1) bits++;
+		for (x = b; x; x >>= 1) bits--;
+		cyc = 2 + (bits > 0 ? (bits + 3) / 4 : 0);
+		if (cyc > 12) cyc = 12;
+		break;
+	}
+	case OP_SMULL: case OP_SMLAL: {
+		int64_t prod = (int64_t)(int32_t)R[in.rn] * (int32_t)R[in.rm];
+		uint64_t acc = (in.op == OP_SMLAL ? ((uint64_t)R[in.ra] << 32) | R[in.rd] : 0);
+		acc += (uint64_t)prod;
+		R[in.rd] = (uint32_t)acc;
+		R[in.ra] = (uint32_t)(acc >> 32);
+		break;
+	}
+	case OP_UMULL: case OP_UMLAL: {
+		uint64_t acc = (in.op == OP_UMLAL ? ((uint64_t)R[in.ra] << 32) | R[in.rd] : 0);
+		acc += (uint64_t)R[in.rn] * R[in.rm];
+		R[in.rd] = (uint32_t)acc;
+		R[in.ra] = (uint32_t)(acc >> 32);
+		break;
+	}
+	case OP_SMMUL: case OP_SMMLA: case OP_SMMLS: {
+		uint64_t acc = (in.op == OP_SMMUL ? 0 : (uint64_t)R[in.ra] << 32);
+		uint64_t prod = (uint64_t)((int64_t)(int32_t)R[in.rn] * (int32_t)R[in.rm]);
+		acc = (in.op == OP_SMMLS ? acc - prod : acc + prod);
+		if (in.flags & F_R) acc += 0x80000000u;
+		R[in.rd] = (uint32_t)(acc >> 32);
+		break;
+	}
+	case OP_SMULXY: case OP_SMLAXY:
+		p = (int64_t)half(R[in.rn], in.flags & F_XT) * half(R[in.rm], in.flags & F_YT);
+		if (in.op == OP_SMLAXY) {
+			p += (int32_t)R[in.ra];
+			if (p != (int32_t)p) e.q = 1;
+		}
+		R[in.rd] = (uint32_t)p;
+		break;
+	case OP_SMULWY: case OP_SMLAWY:
+		p = ((int64_t)(int32_t)R[in.rn] * half(R[in.rm], in.flags & F_YT)) >> 16;
+		if (in.op == OP_SMLAWY) {
+			p += (int32_t)R[in.ra];
+			if (p != (int32_t)p) e.q = 1;
+		}
+		R[in.rd] = (uint32_t)p;
+		break;
+	case OP_SMUAD: case OP_SMLAD: case OP_SMLALD: {
+		uint32_t y = R[in.rm];
+		if (in.flags & F_X) y = (y >> 16) | (y << 16);
+		int64_t lo = (int64_t)half(R[in.rn], false) * half(y, false), hi = (int64_t)half(R[in.rn], true) * half(y, true);
+		p = (in.flags & F_SUB) ? lo - hi : lo + hi;
+		if (in.op == OP_SMLALD) {
+			uint64_t acc = (((uint64_t)R[in.ra] << 32) | R[in.rd]) + (uint64_t)p;
+			R[in.rd] = (uint32_t)acc;
+			R[in.ra] = (uint32_t)(acc >> 32);
+		} else {
+			if (in.op == OP_SMLAD) p += (int32_t)R[in.ra];
+			R[in.rd] = (uint32_t)p;
+		}
+		break;
+	}
+	case OP_QADD: R[in.rd] = saturate(e, (int64_t)(int32_t)R[in.rn] + (int32_t)R[in.rm], 32); break;
+	case OP_QSUB: R[in.rd] = saturate(e, (int64_t)(int32_t)R[in.rn] - (int32_t)R[in.rm], 32); break;
+	case OP_QDADD: R[in.rd] = saturate(e, (int64_t)(int32_t)R[in.rn] + saturate(e, 2 * (int64_t)(int32_t)R[in.rm], 32), 32); break;
+	case OP_QDSUB: R[in.rd] = saturate(e, (int64_t)(int32_t)R[in.rn] - saturate(e, 2 * (int64_t)(int32_t)R[in.rm], 32), 32); break;
+	case OP_SSAT: case OP_USAT: {
+		int32_t v = (int32_t)shiftValue(R[in.rm], in.shift, in.imm);
+		if (in.op == OP_SSAT) {
+			R[in.rd] = saturate(e, v, in.amount);
+		} else {
+			int32_t hi = (int32_t)((1u << in.amount) - 1);
+			if (v < 0) { v = 0; e.q = 1; }
+			if (v > hi) { v = hi; e.q = 1; }
+			R[in.rd] = v;
+		}
+		break;
+	}
+	case OP_CLZ:
+		x = R[in.rm];
+		for (res = 0; res < 32 && !(x & 0x80000000u); res++) x <<= 1;
+		R[in.rd] = res;
+		break;
+	case OP_RBIT:
+		x = R[in.rm];
+		res = 0;
+		for (int i = 0; i < 32; i++) res |= ((x >> i) & 1) << (31 - i);
+		R[in.rd] = res;
+		break;
+	case OP_REV:
+		x = R[in.rm];
+		R[in.rd] = (x >> 24) | ((x >> 8) & 0xff00) | ((x << 8) & 0xff0000) | (x << 24);
+		break;
+	case OP_REV16:
+		x = R[in.rm];
+		R[in.rd] = ((x >> 8) & 0x00ff00ff) | ((x << 8) & 0xff00ff00);
+		break;
+	case OP_SXTH: R[in.rd] = (uint32_t)(int16_t)R[in.rm]; break;
+	case OP_UXTH: R[in.rd] = R[in.rm] & 0xffff; break;
+	case OP_SXTB: R[in.rd] = (uint32_t)(int8_t)R[in.rm]; break;
+	case OP_UXTB: R[in.rd] = R[in.rm] & 0xff; break;
+	case OP_SXTAH: R[in.rd] = R[in.rn] + (uint32_t)(int16_t)op2(e, in); break;
+	case OP_UXTAH: R[in.rd] = R[in.rn] + (op2(e, in) & 0xffff); break;
+	case OP_SXTAB: R[in.rd] = R[in.rn] + (uint32_t)(int8_t)op2(e, in); break;
+	case OP_UXTAB: R[in.rd] = R[in.rn] + (op2(e, in) & 0xff); break;
+	case OP_PKHBT: R[in.rd] = (R[in.rn] & 0xffff) | (op2(e, in) & 0xffff0000); break;
+	case OP_PKHTB: R[in.rd] = (R[in.rn] & 0xffff0000) | (op2(e, in) & 0xffff); break;
+	case OP_SBFX: case OP_UBFX:
+		x = (R[in.rn] >> in.imm) & (in.amount == 32 ? 0xffffffff : (1u << in.amount) - 1);
+		if (in.op == OP_SBFX && in.amount < 32 && (x >> (in.amount - 1))) x |= ~0u << in.amount;
+		R[in.rd] = x;
+		break;
+	case OP_BFI:
+		x = (in.amount == 32 ? 0xffffffff : (1u << in.amount) - 1) << in.imm;
+		R[in.rd] = (R[in.rd] & ~x) | ((R[in.rn] << in.imm) & x);
+		break;
+	case OP_BFC:
+		x = (in.amount == 32 ? 0xffffffff : (1u << in.amount) - 1) << in.imm;
+		R[in.rd] &= ~x;
+		break;
+	case OP_CMP: addFlags(e, R[in.rn], ~op2(e, in), 1); break;
+	case OP_CMN: addFlags(e, R[in.rn], op2(e, in), 0); break;
+	case OP_TST: setNZ(e, R[in.rn] & op2Carry(e, in)); break;
+	case OP_TEQ: setNZ(e, R[in.rn] ^ op2Carry(e, in)); break;
+	case OP_LDRLIT:
+		R[in.rd] = in.imm;
+		cyc = 2;
+		break;
+	case OP_LDR: {
+		uint32_t a = address(e, in);
+		x = rd32(e, pc, a, in.size);
+		if (in.flags & F_SIGNED) x = (in.size == 2 ? (uint32_t)(int16_t)x : (uint32_t)(int8_t)x);
+		R[in.rd] = x;
+		cyc = e.lastLoad ? 1 : 2;		// pipelined with the load before
+		if (a & (in.size - 1)) cyc++;	// unaligned: two bus accesses
+		load = true;
+		break;
+	}
+	case OP_STR: {
+		uint32_t a = address(e, in);
+		wr32(e, pc, a, in.size, R[in.rd]);
+		if (a & (in.size - 1)) cyc++;
+		break;
+	}
+	case OP_LDRD: case OP_STRD: {
+		uint32_t a = address(e, in);
+		if (a & 3) execFail(e, pc, "unaligned ldrd/strd at 0x%x", a);
+		if (in.op == OP_LDRD) {
+			R[in.rd] = rd32(e, pc, a, 4);
+			R[in.ra] = rd32(e, pc, a + 4, 4);
+			cyc = 3;
+		} else {
+			wr32(e, pc, a, 4, R[in.rd]);
+			wr32(e, pc, a + 4, 4, R[in.ra]);
+			cyc = 2;
+		}
+		break;
+	}
+	case OP_LDM: case OP_STM: case OP_PUSH: case OP_POP: {
+		int nr = bitCount(in.regs);
+		bool ld = (in.op == OP_LDM || in.op == OP_POP);
+		int rn = (in.op == OP_PUSH || in.op == OP_POP ? 13 : in.rn);
+		bool db = (in.op == OP_PUSH || (in.flags & F_DB));
+		uint32_t a = R[rn], end;
+		if (a & 3) execFail(e, pc, "unaligned ldm/stm at 0x%x", a);
+		if (db) a -= 4 * nr;
+		end = db ? a : a + 4 * nr;
+		uint32_t newPc = EMU_RET - 1;
+		for (int r = 0; r < 16; r++) {
+			if (!(in.regs & (1 << r))) continue;
+			if (!ld) wr32(e, pc, a, 4, R[r]);
+			else if (r == 15) newPc = rd32(e, pc, a, 4);
+			else R[r] = rd32(e, pc, a, 4);
+			a += 4;
+		}
+		if (in.writeback || in.op == OP_PUSH || in.op == OP_POP)
+			if (!(ld && (in.regs & (1 << rn)))) R[rn] = end;
+		cyc = 1 + nr;
+		if (newPc != EMU_RET - 1) {
+			e.cycles += cyc + 2;
+			return newPc;
+		}
+		break;
+	}
+	case OP_MOVW: R[in.rd] = in.imm; break;
+	case OP_MOVT: R[in.rd] = (R[in.rd] & 0xffff) | (in.imm << 16); break;
+	case OP_ADR: R[in.rd] = in.imm; break;
+	case OP_B:
+		e.cycles += 3;
+		return in.target;
+	case OP_BL:
+		R[14] = pc + 1;
+		e.cycles += 3;
+		return in.target;
+	case OP_BX:
+		e.cycles += 3;
+		return R[in.rm];
+	case OP_BLX:
+		x = R[in.rm];
+		R[14] = pc + 1;
+		e.cycles += 3;
+		return x;
+	case OP_CBZ: case OP_CBNZ:
+		if ((R[in.rn] == 0) == (in.op == OP_CBZ)) {
+			e.cycles += 3;
+			return in.target;
+		}
+		break;
+	}
+	e.lastLoad = load;
+	e.cycles += cyc;
+	return pc + 1;
+}
+
+uint32_t emuCall(thumbEmu &e, const char *func, std::initializer_list<uint32_t> args)
+{
+	if (!e.linked) link(e);
+	std::map<std::string, int>::const_iterator f = e.codeLabels.find(func);
+	if (f == e.codeLabels.end()) emuFail(e, 0, "no function %s", func);
+
+	memset(e.r, 0, sizeof(e.r));
+	e.n = e.z = e.c = e.v = e.q = 0;
+	uint32_t sp = (uint32_t)e.mem.size() - EMU_STACK;
+	int nargs = (int)args.size();
+	if (nargs > 4) sp -= 4 * (nargs - 4);
+	int i = 0;
+	for (std::initializer_list<uint32_t>::const_iterator a = args.begin(); a != args.end(); a++, i++) {
+		if (i < 4) e.r[i] = *a;
+		else memcpy(&e.mem[sp + 4 * (i - 4)], &*a, 4);
+	}
+	e.r[13] = sp;
+	e.r[14] = EMU_RET;
+	e.lastLoad = false;
+
+	uint32_t pc = f->second;
+	for (uint32_t steps = 0; pc != EMU_RET; steps++) {
+		if (pc >= EMU_FUNC && pc - EMU_FUNC < e.funcs.size()) {
+			e.funcs[pc - EMU_FUNC](e);
+			pc = e.r[14];
+			continue;
+		}
+		if (pc >= e.code.size()) emuFail(e, 0, "%s jumped to 0x%x", func, pc);
+		if (steps > EMU_MAXSTEPS) emuFail(e, 0, "%s doesn't return", func);
+		pc = step(e, pc);
+	}
+	return e.r[0];
+}
+
+uint32_t emuArg(thumbEmu &e, int n)
+{
+	if (n < 4) return e.r[n];
+	uint32_t v;
+	memcpy(&v, &e.mem[e.r[13] + 4 * (n - 4)], 4);
+	return v;
+}
@@ -0,0 +1,126 @@
+/*
+	Helix library Arduino interface - Thumb-2 assembly emulator for the host tools
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* Runs the Cortex-M4 assembly of the library (asm*_thumb2.S, memcpy_frominterleaved.S)
+    on the host, so kernelbench and conformance can check it against the C versions
+    without a Teensy. It reads the GNU as source directly - .macro, .irp, .rept,
+    .if/.ifb/.ifnb, .equ, .req/.unreq, .word/.short/.byte, .ascii/.zero - and
+    also C compiled to assembly (-S: literal pools, movw/movt of :lower16: and
+    :upper16:, the unwind and attribute directives are skipped). It interprets the
+    instructions the kernels and the compiled decoders use (ARMv7E-M: ALU with
+    carry, shifts, the DSP multiplies, sdiv/udiv, saturation, extends, bit fields,
+    loads/stores/ldm/stm, branches, IT blocks as plain conditions). No tbb/tbh, so
+    compile C with -fno-jump-tables.
+    There are no encodings: code labels are instruction indexes, data (the .word
+    tables and everything from emuAlloc) lives in a flat little-endian memory that
+    C code can use through emuPtr.
+
+    Cycles follow the Cortex-M4 timings of the ARM TRM, simplified: 1 per
+    instruction, loads 2 (1 when they directly follow another load), str 1,
+    ldrd 3, strd 2, ldm/stm/push/pop 1 + registers, mla/mls 2, sdiv/udiv 2..12
+    by the quotient bits, unaligned ldr/str +1, taken branches 3 (+2 when pc
+    is loaded), skipped conditional instructions 1, IT free. No
+    flash wait states or bus contention, so real hardware is somewhat slower.
+
+    Any fault (unknown instruction or label, unaligned ldrd/ldm/strd/stm, out of
+    range access)
+    prints the source line and exits. */
+
+#ifndef thumbemu_h_
+#define thumbemu_h_
+
+#include <stdint.h>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <vector>
+
+struct thumbEmu;
+typedef void (*emuFunc)(thumbEmu &e);
+
+// one decoded instruction, see thumbemu.cpp
+struct emuInsn {
+	uint8_t		op, cond, flags, size;
+	uint8_t		rd, rn, rm, ra;		// ra: accumulator, high word of long multiplies, second register of ldrd/strd
+	uint8_t		shift, rs;			// of rm, by register rs or (rs == 0xff) by amount
+	uint8_t		mode;				// of loads and stores
+	bool		immOp;				// operand 2 or the offset is imm
+	bool		writeback;			// ldm/stm rn!
+	uint32_t	imm;
+	uint32_t	amount;				// shift amount, saturation or bitfield width
+	uint16_t	regs;				// ldm/stm/push/pop
+	uint32_t	target;				// of branches
+};
+
+struct thumbEmu {
+	std::vector<uint8_t>	mem;
+	uint32_t	r[16];
+	int			n, z, c, v, q;		// flags
+	uint64_t	cycles;				// counted up by emuCall, reset it yourself
+	uint64_t	instructions;
+
+	// the program, see thumbemu.cpp
+	std::string	path;
+	std::vector<emuInsn>	code;
+	std::vector<std::string> text;	// of each instruction, for messages
+	std::vector<int>		line;
+	std::map<std::string, int>		codeLabels;
+	std::map<std::string, uint32_t>	dataLabels;
+	std::map<std::string, int64_t>	equ;
+	std::vector<emuFunc>	funcs;
+	std::map<std::string, int>		funcIndex;
+	std::vector<std::map<std::string, int> > aliases;	// .req, one snapshot per change
+	std::vector<int>		aliasSet;	// of each instruction
+	uint32_t	dataEnd;
+	bool		linked;
+	bool		lastLoad;
+};
+
+bool emuLoad(thumbEmu &e, const char *path, uint32_t memBytes = 1 << 20);	// false if it can't be read or parsed
+const char *emuSource(const char *file);	// path of a .S file in the library directory
+
+uint32_t emuAlloc(thumbEmu &e, uint32_t bytes);	// 8-byte aligned, never freed
+void *emuPtr(thumbEmu &e, uint32_t addr);
+void emuSymbol(thumbEmu &e, const char *name, uint32_t addr);	// data the assembly refers to (ldr rX, =name)
+void emuFunction(thumbEmu &e, const char *name, emuFunc f);	// C function the assembly branches to
+
+// calls a global function with the AAPCS arguments (the fifth and later on the stack), returns r0
+uint32_t emuCall(thumbEmu &e, const char *func, std::initializer_list<uint32_t> args);
+uint32_t emuArg(thumbEmu &e, int n);		// argument n of the call, in an emuFunction
+
+#endif
@@ -0,0 +1,409 @@
+/*
+	Helix library Arduino interface - worst-case frame finder for MP3Decode/AACDecode
+
+	Copyright (c) 2014 Frank Bösing
+
+	This library is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+	The helix decoder itself as a different license, look at the subdirectories for more info.
+
+	Diese Bibliothek ist freie Software: Sie können es unter den Bedingungen
+	der GNU General Public License, wie von der Free Software Foundation,
+	Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+	veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+	Diese Bibliothek wird in der Hoffnung, dass es nützlich sein wird, aber
+	OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+	Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+	Siehe die GNU General Public License für weitere Details.
+
+	Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+	Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+	Der Helixdecoder selbst hat eine eigene Lizenz, bitte für mehr Informationen
+	in den Unterverzeichnissen nachsehen.
+
+ */
+
+ /* usage: worstframes [-n worst] [-r repeat] [-k cycles/ns] [-f MHz] [-l load%] [-b cycles] file|dir...
+    Pre-flight check for a music library: decodes every file (directories are
+    scanned recursively for .mp3, .aac, .m4a and .mp4) and lists the most
+    expensive frames of each, so a track that would underrun on the device is
+    found before it is deployed.
+
+    g++ -O2 -I. -DMP3_FRAME_STATS -DAAC_FRAME_STATS extras/host/worstframes.cpp extras/host/mediafile.cpp mp3.cpp aac.cpp -o worstframes
+
+    The host time of each frame is the fastest of -r passes (default 3), and is
+    converted to target cycles with -k (default 8 cycles per host ns, a rough
+    guess for a Teensy 3.x against a desktop PC). To calibrate, divide the
+    largest decode cycles the player reports on the device for a file (max of
+    processorUsageHistogram) by the max ns codecbench reports for it.
+    A frame must decode within -l percent (default 70) of its playing time at
+    -f MHz (default 96), or within -b cycles if given. Files whose worst frame
+    is over budget are marked OVER and the exit code is 2.
+
+    With -DMP3_FRAME_STATS / -DAAC_FRAME_STATS each frame shows what it asked of
+    the decoder: block types, nonZeroBound, IMDCT blocks and bits per granule
+    and channel for MP3; window sequence, max SFB, TNS/PNS and SBR envelopes,
+    noise floors and bands per channel for AAC. With -DMP3_STAGE_STATS /
+    -DAAC_STAGE_STATS it also shows the most expensive stage of the frame. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdint.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "mediafile.h"
+
+struct frameCost {
+	uint32_t	index;
+	uint32_t	ns;			// fastest pass
+	double		start;		// position in the file, seconds
+	double		secs;		// playing time
+	int			samples;	// per channel
+	int			samprate;
+#ifdef MP3_FRAME_STATS
+	MP3FrameStats mp3;
+#endif
+#ifdef AAC_FRAME_STATS
+	AACFrameStats aac;
+#endif
+	int			stage;		// most expensive stage, -1 without stage stats
+	uint32_t	stageNs;
+};
+
+struct fileCost {
+	std::string	name;
+	bool		mp3;
+	uint32_t	frames;
+	uint32_t	errors;
+	std::vector<frameCost> worst;	// most expensive first
+	frameCost	peak;				// the most expensive frame
+	double		worstLoad;			// of the budget
+};
+
+static double cyclesPerNs = 8.0;
+static double mhz = 96.0;
+static double loadPct = 70.0;
+static double budgetCycles = 0;		// 0 = derive from the frame duration
+
+static double frameCycles(const frameCost &c)
+{
+	return c.ns * cyclesPerNs;
+}
+
+static double frameBudget(const frameCost &c)
+{
+	if (budgetCycles > 0) return budgetCycles;
+	return c.secs * mhz * 1e6 * loadPct / 100;
+}
+
+static bool isMedia(const char *name)
+{
+	const char *ext = strrchr(name, '.');
+	if (!ext) return false;
+	return !strcasecmp(ext, ".mp3") || !strcasecmp(ext, ".aac") ||
+		!strcasecmp(ext, ".m4a") || !strcasecmp(ext, ".mp4");
+}
+
+static void scan(const std::string &path, std::vector<std::string> &files)
+{
+	struct stat st;
+	if (stat(path.c_str(), &st)) {
+		perror(path.c_str());
+		return;
+	}
+	if (!S_ISDIR(st.st_mode)) {
+		files.push_back(path);
+		return;
+	}
+	DIR *dir = opendir(path.c_str());
+	if (!dir) {
+		perror(path.c_str());
+		return;
+	}
+	std::vector<std::string> entries;
+	struct dirent *e;
+	while ((e = readdir(dir)) != NULL) {
+		if (e->d_name[0] == '.') continue;
+		std::string sub = path + "/" + e->d_name;
+		if (stat(sub.c_str(), &st)) continue;
+		if (S_ISDIR(st.st_mode) || isMedia(e->d_name)) entries.push_back(sub);
+	}
+	closedir(dir);
+	std::sort(entries.begin(), entries.end());
+	for (size_t i = 0; i < entries.size(); i++) scan(entries[i], files);
+}
+
+#ifdef MP3_STAGE_STATS
+static const char *stageNames[MP3_NSTAGES] = {
+	"sideinfo", "maindata", "scalefact", "huffman", "dequant", "imdct", "subband"
+};
+
+static void mp3Stage(mediaDecoder &d, MP3StageStats &prev, frameCost &c)
+{
+	MP3StageStats s;
+	MP3GetStageStats(d.mp3, &s);
+	for (int i = 0; i < MP3_NSTAGES; i++) {
+		uint32_t t = (uint32_t)(s.time[i] - prev.time[i]);
+		if (c.stage < 0 || t > c.stageNs) {
+			c.stage = i;
+			c.stageNs = t;
+		}
+	}
+	prev = s;
+}
+#endif
+
+#ifdef AAC_STAGE_STATS
+static const char *aacStageNames[AAC_NSTAGES] = {
+	"noiseless", "dequant", "stereo", "pns", "tns", "imdct",
+	"sbr-bits", "qmf-ana", "hf-gen", "hf-adj", "qmf-syn", "upsample"
+};
+
+static void aacStage(mediaDecoder &d, AACStageStats &prev, frameCost &c)
+{
+	AACStageStats s;
+	AACGetStageStats(d.aac, &s);
+	for (int i = 0; i < AAC_NSTAGES; i++) {
+		uint64_t t = 0;
+		for (int e = 0; e < AAC_STATS_NELEMS; e++) t += s.time[e][i] - prev.time[e][i];
+		if (c.stage < 0 || t > c.stageNs) {
+			c.stage = i;
+			c.stageNs = (uint32_t)t;
+		}
+	}
+	prev = s;
+}
+#endif
+
+// decode the whole file once, keeping the fastest time seen for each frame
+static void decodePass(mediaFile &f, std::vector<frameCost> &frames, fileCost &r, bool first)
+{
+	static short pcm[MEDIA_PCM_SIZE];
+	mediaDecoder d;
+	mediaFrame fr;
+	uint32_t n = 0;
+	double pos = 0;
+#ifdef MP3_STAGE_STATS
+	MP3StageStats mp3Prev = MP3StageStats();
+#endif
+#ifdef AAC_STAGE_STATS
+	AACStageStats aacPrev = AACStageStats();
+#endif
+
+	if (!mediaOpen(d, f)) return;
+	while (mediaDecodeFrame(d, pcm, fr)) {
+		frameCost c = frameCost();
+		c.index = n++;
+		c.start = pos;
+		c.ns = fr.ns;
+		c.stage = -1;
+		if (!fr.err) {
+			c.samples = fr.samples / fr.nChans;
+			c.samprate = fr.samprate;
+			c.secs = (double)c.samples / c.samprate;
+			pos += c.secs;
+#ifdef MP3_FRAME_STATS
+			if (d.mp3) MP3GetFrameStats(d.mp3, &c.mp3);
+#endif
+#ifdef AAC_FRAME_STATS
+			if (d.aac) AACGetFrameStats(d.aac, &c.aac);
+#endif
+		}
+#ifdef MP3_STAGE_STATS
+		if (d.mp3) mp3Stage(d, mp3Prev, c);
+#endif
+#ifdef AAC_STAGE_STATS
+		if (d.aac) aacStage(d, aacPrev, c);
+#endif
+		if (first) {
+			if (fr.err) r.errors++;
+			else r.frames++;
+			frames.push_back(c);
+		} else if (c.index < frames.size() && c.ns < frames[c.index].ns) {
+			frames[c.index] = c;
+		}
+	}
+	mediaClose(d);
+}
+
+static bool costlier(const frameCost &a, const frameCost &b)
+{
+	return frameCycles(a) / frameBudget(a) > frameCycles(b) / frameBudget(b);
+}
+
+static bool fileCostlier(const fileCost &a, const fileCost &b)
+{
+	return a.worstLoad > b.worstLoad;
+}
+
+static const char *blockName(int blockType, int mixed)
+{
+	static const char *names[4] = { "long", "start", "short", "stop" };
+	if (mixed) return "mixed";
+	return names[blockType & 3];
+}
+
+static void printDetails(const fileCost &r, const frameCost &c)
+{
+#ifdef MP3_FRAME_STATS
+	if (r.mp3) {
+		const MP3FrameStats &s = c.mp3;
+		int nChans = s.nChans;
+		for (int gr = 0; gr < s.nGrans; gr++) {
+			printf(" gr%d", gr);
+			for (int ch = 0; ch < nChans; ch++)
+				printf("%c%s", ch ? '/' : ' ', blockName(s.blockType[gr][ch], s.mixedBlock[gr][ch]));
+			for (int ch = 0; ch < nChans; ch++)
+				printf("%s%d", ch ? "/" : " nz ", s.nonZeroBound[gr][ch]);
+			for (int ch = 0; ch < nChans; ch++)
+				printf("%s%d", ch ? "/" : " imdct ", s.nIMDCT[gr][ch]);
+			for (int ch = 0; ch < nChans; ch++)
+				printf("%s%d", ch ? "/" : " bits ", s.part23Length[gr][ch]);
+		}
+		printf(" resv %d", s.mainDataBegin);
+		if (nChans == 2 && (s.modeExt & 2)) printf(" ms");
+		if (nChans == 2 && (s.modeExt & 1)) printf(" is");
+	}
+#endif
+#ifdef AAC_FRAME_STATS
+	if (!r.mp3) {
+		static const char *winNames[4] = { "long", "start", "short", "stop" };
+		const AACFrameStats &s = c.aac;
+		int sbr = 0;
+		for (int ch = 0; ch < s.nChans; ch++)
+			printf("%c%s", ch ? '/' : ' ', winNames[s.winSequence[ch] & 3]);
+		for (int ch = 0; ch < s.nChans; ch++)
+			printf("%s%d", ch ? "/" : " sfb ", s.maxSFB[ch]);
+		for (int ch = 0; ch < s.nChans; ch++) {
+			if (s.tns[ch]) printf(" tns%d", ch);
+			if (s.pns[ch]) printf(" pns%d", ch);
+			sbr |= s.sbrEnvelopes[ch];
+		}
+		if (sbr) {
+			for (int ch = 0; ch < s.nChans; ch++)
+				printf("%s%d", ch ? "/" : " env ", s.sbrEnvelopes[ch]);
+			for (int ch = 0; ch < s.nChans; ch++)
+				printf("%s%d", ch ? "/" : " noise ", s.sbrNoiseFloors[ch]);
+			for (int ch = 0; ch < s.nChans; ch++)
+				printf("%s%d", ch ? "/" : " bands ", s.sbrBands[ch]);
+		}
+	}
+#endif
+#ifdef MP3_STAGE_STATS
+	if (r.mp3 && c.stage >= 0) printf(" [%s %u ns]", stageNames[c.stage], c.stageNs);
+#endif
+#ifdef AAC_STAGE_STATS
+	if (!r.mp3 && c.stage >= 0) printf(" [%s %u ns]", aacStageNames[c.stage], c.stageNs);
+#endif
+	(void)r;
+	(void)c;
+}
+
+static void printFile(const fileCost &r)
+{
+	printf("%-32s %7u %9u %10.0f %7.1f%%%s", r.name.c_str(), r.frames, r.peak.ns,
+		frameCycles(r.peak), 100 * r.worstLoad, r.worstLoad > 1 ? "  OVER" : "");
+	if (r.errors) printf("  %u errors", r.errors);
+	printf("\n");
+	for (size_t i = 0; i < r.worst.size(); i++) {
+		const frameCost &c = r.worst[i];
+		printf("  %7u %8.2f %9u %10.0f %7.1f%% ", c.index, c.start, c.ns,
+			frameCycles(c), 100 * frameCycles(c) / frameBudget(c));
+		printDetails(r, c);
+		printf("\n");
+	}
+}
+
+int main(int argc, char **argv)
+{
+	int worst = 5;
+	int repeat = 3;
+	int i;
+
+	for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+		if (!strcmp(argv[i], "-n") && i + 1 < argc) worst = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-r") && i + 1 < argc) repeat = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-k") && i + 1 < argc) cyclesPerNs = atof(argv[++i]);
+		else if (!strcmp(argv[i], "-f") && i + 1 < argc) mhz = atof(argv[++i]);
+		else if (!strcmp(argv[i], "-l") && i + 1 < argc) loadPct = atof(argv[++i]);
+		else if (!strcmp(argv[i], "-b") && i + 1 < argc) budgetCycles = atof(argv[++i]);
+		else break;
+	}
+	if (i >= argc || worst < 0 || repeat < 1 || cyclesPerNs <= 0 || mhz <= 0 || loadPct <= 0) {
+		fprintf(stderr, "usage: %s [-n worst] [-r repeat] [-k cycles/ns] [-f MHz] [-l load%%] [-b cycles] file|dir...\n", argv[0]);
+		return 1;
+	}
+
+	std::vector<std::string> names;
+	for ( ; i < argc; i++) scan(argv[i], names);
+
+	if (budgetCycles > 0) printf("budget %.0f cycles per frame, %.2f cycles per host ns\n", budgetCycles, cyclesPerNs);
+	else printf("budget %.0f%% of %.0f MHz per frame, %.2f cycles per host ns\n", loadPct, mhz, cyclesPerNs);
+	printf("%-32s %7s %9s %10s %8s\n", "file / frame", "frames", "ns", "cycles", "budget");
+	printf("  %7s %8s\n", "frame", "time s");
+
+	std::vector<fileCost> files;
+	int failed = 0;
+	for (size_t n = 0; n < names.size(); n++) {
+		mediaFile f;
+		if (!mediaLoad(names[n].c_str(), f)) {
+			perror(names[n].c_str());
+			failed++;
+			continue;
+		}
+		fileCost r = fileCost();
+		std::vector<frameCost> frames;
+		r.name = names[n];
+		r.mp3 = f.mp3;
+		for (int pass = 0; pass < repeat; pass++)
+			decodePass(f, frames, r, pass == 0);
+		mediaFree(f);
+
+		//error frames did no real work, don't rank them
+		std::vector<frameCost> ok;
+		for (size_t k = 0; k < frames.size(); k++)
+			if (frames[k].samprate) ok.push_back(frames[k]);
+		std::partial_sort(ok.begin(), ok.begin() + std::min((size_t)std::max(worst, 1), ok.size()), ok.end(), costlier);
+		if (ok.size()) {
+			r.peak = ok[0];
+			r.worstLoad = frameCycles(ok[0]) / frameBudget(ok[0]);
+		}
+		r.worst.assign(ok.begin(), ok.begin() + std::min((size_t)worst, ok.size()));
+		if (!r.frames) failed++;
+
+		printFile(r);
+		files.push_back(r);
+	}
+
+	//rank the files by their worst frame
+	std::stable_sort(files.begin(), files.end(), fileCostlier);
+	int over = 0;
+	printf("\n%-32s %8s\n", "ranking", "budget");
+	for (size_t n = 0; n < files.size(); n++) {
+		printf("%-32s %7.1f%%%s\n", files[n].name.c_str(), 100 * files[n].worstLoad,
+			files[n].worstLoad > 1 ? "  OVER" : "");
+		if (files[n].worstLoad > 1) over++;
+	}
+	printf("%d of %d files over budget\n", over, (int)files.size());
+	if (over) return 2;
+	return failed ? 1 : 0;
+}
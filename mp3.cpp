@@ -18,7 +18,11 @@
 #include "mp3/scalfact.c"
 #include "mp3/stproc.c"
 #include "mp3/subband.c"
+#ifndef __arm__
+#include "mp3/polyphase.c"		//C version of asmpoly_thumb2.S, for host builds
+#endif
 #include "mp3/trigtabs.c"
 
 #include "mp3/huffman.c"
-#include "mp3/hufftabs.c"
\ No newline at end of file
+#include "mp3/hufftabs.c"
+#include "mp3/huffmulti.c"
@@ -108,12 +108,13 @@ static __inline void RefillBitstreamCache(BitStreamInfo *bsi)
 	} else if (nBytes == 2) { //FB	
 		unsigned short *Ptr16;
 		Ptr16 =(unsigned short*)bsi->bytePtr;
-		bsi->iCache = REV16(*Ptr16);
+		bsi->iCache = REV16(*Ptr16) << 16;	/* left-justify, GetBits() takes bits from the top */
 		bsi->bytePtr +=2;	
 		bsi->cachedBits = 16;
 		bsi->nBytes -= 2;
 			
-	} /*else { //FB
+	} else {
+		/* last 1 or 3 bytes, all of them go into the cache */
 		bsi->iCache = 0;
 		while (nBytes--) {
 			bsi->iCache |= (*bsi->bytePtr++);
@@ -122,11 +123,6 @@ static __inline void RefillBitstreamCache(BitStreamInfo *bsi)
 		bsi->iCache <<= ((3 - bsi->nBytes)*8);
 		bsi->cachedBits = 8*bsi->nBytes;
 		bsi->nBytes = 0;
-	} */
-	else { //FB		
-		bsi->iCache = (*bsi->bytePtr++) << 24;		
-		bsi->cachedBits = 8;
-		bsi->nBytes = 0;
 	}
 }
 
@@ -234,6 +230,10 @@ int CheckPadBit(MP3DecInfo *mp3DecInfo)
  *                first byte following frame header)
  *              -1 if null frameHeader or invalid header
  *
+ * Notes:       the fields which depend on version, layer, sample rate and channel mode
+ *                (sfBand, nChans, samprate, ...) are only derived again when these
+ *                differ from the last valid header (mp3DecInfo->fixedHdr)
+ *
  * TODO:        check for valid modes, depending on capabilities of decoder
  *              test CRC on actual stream (verify no endian problems)
  **************************************************************************************/
@@ -241,44 +241,67 @@ int UnpackFrameHeader(MP3DecInfo *mp3DecInfo, unsigned char *buf)
 {
 
 	int verIdx;
+	unsigned int hdr;
 	FrameHeader *fh;
 
-	/* validate pointers and sync word */
-	if (!mp3DecInfo || !mp3DecInfo->FrameHeaderPS || (buf[0] & SYNCWORDH) != SYNCWORDH || (buf[1] & SYNCWORDL) != SYNCWORDL)
+	if (!mp3DecInfo || !mp3DecInfo->FrameHeaderPS)
 		return -1;
 
 	fh = ((FrameHeader *)(mp3DecInfo->FrameHeaderPS));
+	hdr = ((unsigned int)buf[0] << 24) | ((unsigned int)buf[1] << 16) | ((unsigned int)buf[2] << 8) | ((unsigned int)buf[3] << 0);
 
-	/* read header fields - use bitmasks instead of GetBits() for speed, since format never varies */
-	verIdx =         (buf[1] >> 3) & 0x03;
-	fh->ver =        (MPEGVersion)( verIdx == 0 ? MPEG25 : ((verIdx & 0x01) ? MPEG1 : MPEG2) );
-	fh->layer = 4 - ((buf[1] >> 1) & 0x03);     /* easy mapping of index to layer number, 4 = error */
-	fh->crc =   1 - ((buf[1] >> 0) & 0x01);
+	/* read the fields which may change from frame to frame */
 	fh->brIdx =      (buf[2] >> 4) & 0x0f;
-	fh->srIdx =      (buf[2] >> 2) & 0x03;
 	fh->paddingBit = (buf[2] >> 1) & 0x01;
 	fh->privateBit = (buf[2] >> 0) & 0x01;
-	fh->sMode =      (StereoMode)((buf[3] >> 6) & 0x03);      /* maps to correct enum (see definition) */    
 	fh->modeExt =    (buf[3] >> 4) & 0x03;
 	fh->copyFlag =   (buf[3] >> 3) & 0x01;
 	fh->origFlag =   (buf[3] >> 2) & 0x01;
 	fh->emphasis =   (buf[3] >> 0) & 0x03;
-
-	/* check parameters to avoid indexing tables with bad values */
-	if (fh->srIdx == 3 || fh->layer == 4 || fh->brIdx == 15)
+	if (fh->brIdx == 15)
 		return -1;
 
-	fh->sfBand = &sfBandTable[fh->ver][fh->srIdx];	/* for readability (we reference sfBandTable many times in decoder) */
+	/* same sync, version, layer, CRC flag, sample rate and channel mode as the last valid
+	 *   header (CBR and nearly all VBR streams) - everything derived from them is still valid
+	 */
+	if ((hdr & HDR_FIXED_MASK) != mp3DecInfo->fixedHdr) {
+		/* validate sync word */
+		if ((buf[0] & SYNCWORDH) != SYNCWORDH || (buf[1] & SYNCWORDL) != SYNCWORDL)
+			return -1;
+
+		/* read header fields - use bitmasks instead of GetBits() for speed, since format never varies */
+		verIdx =         (buf[1] >> 3) & 0x03;
+		if (verIdx == 1) {	/* reserved */
+			mp3DecInfo->fixedHdr = 0;
+			return -1;
+		}
+		fh->ver =        (MPEGVersion)( verIdx == 0 ? MPEG25 : ((verIdx & 0x01) ? MPEG1 : MPEG2) );
+		fh->layer = 4 - ((buf[1] >> 1) & 0x03);     /* easy mapping of index to layer number, 4 = error */
+		fh->crc =   1 - ((buf[1] >> 0) & 0x01);
+		fh->srIdx =      (buf[2] >> 2) & 0x03;
+		fh->sMode =      (StereoMode)((buf[3] >> 6) & 0x03);      /* maps to correct enum (see definition) */    
+
+		/* check parameters to avoid indexing tables with bad values */
+		if (fh->srIdx == 3 || fh->layer == 4) {
+			mp3DecInfo->fixedHdr = 0;
+			return -1;
+		}
+
+		fh->sfBand = &sfBandTable[fh->ver][fh->srIdx];	/* for readability (we reference sfBandTable many times in decoder) */
+
+		/* init user-accessible data */
+		mp3DecInfo->nChans = (fh->sMode == Mono ? 1 : 2);
+		mp3DecInfo->samprate = samplerateTab[fh->ver][fh->srIdx];
+		mp3DecInfo->nGrans = (fh->ver == MPEG1 ? NGRANS_MPEG1 : NGRANS_MPEG2);
+		mp3DecInfo->nGranSamps = ((int)samplesPerFrameTab[fh->ver][fh->layer - 1]) / mp3DecInfo->nGrans;
+		mp3DecInfo->layer = fh->layer;
+		mp3DecInfo->version = fh->ver;
+
+		mp3DecInfo->fixedHdr = hdr & HDR_FIXED_MASK;
+	}
+
 	if (fh->sMode != Joint)		/* just to be safe (dequant, stproc check fh->modeExt) */
 		fh->modeExt = 0;
-
-	/* init user-accessible data */
-	mp3DecInfo->nChans = (fh->sMode == Mono ? 1 : 2);
-	mp3DecInfo->samprate = samplerateTab[fh->ver][fh->srIdx];
-	mp3DecInfo->nGrans = (fh->ver == MPEG1 ? NGRANS_MPEG1 : NGRANS_MPEG2);
-	mp3DecInfo->nGranSamps = ((int)samplesPerFrameTab[fh->ver][fh->layer - 1]) / mp3DecInfo->nGrans;
-	mp3DecInfo->layer = fh->layer;
-	mp3DecInfo->version = fh->ver;
 	
 	/* get bitrate and nSlots from table, unless brIdx == 0 (free mode) in which case caller must figure it out himself
 	 * question - do we want to overwrite mp3DecInfo->bitrate with 0 each time if it's free mode, and
@@ -175,3 +175,44 @@ void FreeBuffers(MP3DecInfo *mp3DecInfo)
 
 	SAFE_FREE(mp3DecInfo);
 }
+
+/**************************************************************************************
+ * Function:    MP3GetMemInfo
+ *
+ * Description: report the heap used by a decoder instance, per buffer
+ *
+ * Inputs:      MP3 decoder instance pointer (HMP3Decoder), may be 0 (sizes only)
+ *              pointer to MP3MemInfo struct
+ *
+ * Outputs:     filled-in MP3MemInfo struct
+ *
+ * Return:      none
+ *
+ * Notes:       sizes as passed to malloc(), without the allocator's overhead
+ **************************************************************************************/
+void MP3GetMemInfo(HMP3Decoder hMP3Decoder, MP3MemInfo *memInfo)
+{
+	MP3DecInfo *mp3DecInfo = (MP3DecInfo *)hMP3Decoder;
+
+	if (!memInfo)
+		return;
+
+	memInfo->decInfo =         sizeof(MP3DecInfo);
+	memInfo->frameHeader =     sizeof(FrameHeader);
+	memInfo->sideInfo =        sizeof(SideInfo);
+	memInfo->scaleFactorInfo = sizeof(ScaleFactorInfo);
+	memInfo->huffmanInfo =     sizeof(HuffmanInfo);
+	memInfo->dequantInfo =     sizeof(DequantInfo);
+	memInfo->imdctInfo =       sizeof(IMDCTInfo);
+	memInfo->subbandInfo =     sizeof(SubbandInfo);
+	memInfo->total = memInfo->decInfo + memInfo->frameHeader + memInfo->sideInfo + memInfo->scaleFactorInfo +
+		memInfo->huffmanInfo + memInfo->dequantInfo + memInfo->imdctInfo + memInfo->subbandInfo;
+
+	memInfo->stackPeak = 0;
+#ifdef MP3_STACK_STATS
+	if (mp3DecInfo)
+		memInfo->stackPeak = mp3DecInfo->stackPeak;
+#else
+	(void)mp3DecInfo;
+#endif
+}
@@ -89,6 +89,7 @@
 #define	IMDCT_SCALE				2	/* additional scaling (by sqrt(2)) for fast IMDCT36 */
 
 #define	HUFF_PAIRTABS			32
+#define	HUFF_MULTI_BITS			8					/* bits looked at by the multi-symbol fast path (huffmulti.c) */
 #define BLOCK_SIZE				18
 #define	NBANDS					32
 #define MAX_REORDER_SAMPS		((192-126)*3)		/* largest critical band for short blocks (see sfBandTable) */
@@ -102,9 +103,14 @@
 #define	MidSideProc			STATNAME(MidSideProc)
 #define	IntensityProcMPEG1	STATNAME(IntensityProcMPEG1)
 #define	IntensityProcMPEG2	STATNAME(IntensityProcMPEG2)
+#define	StereoSetup			STATNAME(StereoSetup)
 #define PolyphaseMono		STATNAME(PolyphaseMono)
 #define PolyphaseStereo		STATNAME(PolyphaseStereo)
+#define PolyphaseStereoPlanar	STATNAME(PolyphaseStereoPlanar)
 #define FDCT32				STATNAME(FDCT32)
+#define FDCT32Thumb2		STATNAME(FDCT32Thumb2)
+#define AntiAliasIMDCT36Thumb2	STATNAME(AntiAliasIMDCT36Thumb2)
+#define IMDCT12x3Thumb2		STATNAME(IMDCT12x3Thumb2)
 
 #define	ISFMpeg1			STATNAME(ISFMpeg1)
 #define	ISFMpeg2			STATNAME(ISFMpeg2)
@@ -121,6 +127,9 @@
 #define	quadTable			STATNAME(quadTable)
 #define	quadTabOffset		STATNAME(quadTabOffset)
 #define	quadTabMaxBits		STATNAME(quadTabMaxBits)
+#define	huffMultiTable		STATNAME(huffMultiTable)
+#define	huffMultiOffset		STATNAME(huffMultiOffset)
+#define	quadMultiTable		STATNAME(quadMultiTable)
 
 /* map these to the corresponding 2-bit values in the frame header */
 typedef enum {
@@ -187,6 +196,21 @@ typedef struct {
     int cbEndL;		/* number nonzero long cb's  */
 } CriticalBandInfo;
 
+/* joint stereo done inside DequantChannel() of the left channel, the right one is dequantized 
+ *  first and its critical band info says where mid-side stops and intensity starts
+ */
+#define IS_NONE		99					/* isStart if intensity stereo is off */
+
+typedef struct _StereoInfo {
+	int *xr;							/* right channel, dequantized, gets R = M - S or intensity output */
+	int midSide;						/* mid-side on */
+	int msEnd;							/* end of the mid-side region (all non-zero right samples) */
+	int isStart[3];						/* first intensity band ([w] for short blocks) or IS_NONE */
+	int isfL[3 * 13];					/* intensity scale factors, [cb] for long and [3*cb + w] */
+	int isfR[3 * 13];					/*   for short blocks */
+	int mOut[MAX_NCHAN];				/* OR of abs of all outputs, for guard bits */
+} StereoInfo;
+
 typedef struct _DequantInfo {
 	int workBuf[MAX_REORDER_SAMPS];		/* workbuf for reordering short blocks */
 	CriticalBandInfo cbi[MAX_NCHAN];	/* filled in dequantizer, used in joint stereo reconstruction */
@@ -217,6 +241,7 @@ typedef struct _IMDCTInfo {
 	int outBuf[MAX_NCHAN][BLOCK_SIZE][NBANDS];	/* output of IMDCT */	
 	int overBuf[MAX_NCHAN][MAX_NSAMP / 2];		/* overlap-add buffer (by symmetry, only need 1/2 size) */
 	int numPrevIMDCT[MAX_NCHAN];				/* how many IMDCT's calculated in this channel on prev. granule */
+	int numActive[MAX_NCHAN];					/* subbands of outBuf that can be non-zero, the rest are cleared */
 	int prevType[MAX_NCHAN];
 	int prevWinSwitch[MAX_NCHAN];
 	int gb[MAX_NCHAN];
@@ -231,6 +256,7 @@ typedef struct _BlockCount {
 	int currWinSwitch;
 	int gbIn;
 	int gbOut;
+	int nBlocksActive;
 } BlockCount;
 
 /* max bits in scalefactors = 5, so use char's to save space */
@@ -258,6 +284,7 @@ typedef struct _ScaleFactorInfo {
 typedef struct _SubbandInfo {
 	int vbuf[MAX_NCHAN * VBUF_LENGTH];		/* vbuf for fast DCT-based synthesis PQMF - double size for speed (no modulo indexing) */
 	int vindex;								/* internal index for tracking position in vbuf */
+	int zeroBlocks[MAX_NCHAN];				/* consecutive all-zero blocks written to vbuf, vbuf[ch] is all zero after 16 */
 } SubbandInfo;
 
 /* bitstream.c */
@@ -267,16 +294,15 @@ int CalcBitsUsed(BitStreamInfo *bsi, unsigned char *startBuf, int startOffset);
 
 /* dequant.c, dqchan.c, stproc.c */
 int DequantChannel(int *sampleBuf, int *workBuf, int *nonZeroBound, FrameHeader *fh, SideInfoSub *sis, 
-					ScaleFactorInfoSub *sfis, CriticalBandInfo *cbi);
+					ScaleFactorInfoSub *sfis, CriticalBandInfo *cbi, StereoInfo *sti);
 void MidSideProc(int x[MAX_NCHAN][MAX_NSAMP], int nSamps, int mOut[2]);
 void IntensityProcMPEG1(int x[MAX_NCHAN][MAX_NSAMP], int nSamps, FrameHeader *fh, ScaleFactorInfoSub *sfis, 
 						CriticalBandInfo *cbi, int midSideFlag, int mixFlag, int mOut[2]);
 void IntensityProcMPEG2(int x[MAX_NCHAN][MAX_NSAMP], int nSamps, FrameHeader *fh, ScaleFactorInfoSub *sfis, 
 						CriticalBandInfo *cbi, ScaleFactorJS *sfjs, int midSideFlag, int mixFlag, int mOut[2]);
+void StereoSetup(StereoInfo *sti, FrameHeader *fh, ScaleFactorInfoSub *sfis, CriticalBandInfo *cbi, 
+				 ScaleFactorJS *sfjs, int nonZeroBound);
 
-/* dct32.c */
-// about 1 ms faster in RAM, but very large
-void FDCT32(int *x, int *d, int offset, int oddBlock, int gb);// __attribute__ ((section (".data")));
 
 /* hufftabs.c */
 extern const HuffTabLookup huffTabLookup[HUFF_PAIRTABS];
@@ -286,6 +312,11 @@ extern const unsigned char quadTable[64+16];
 extern const int quadTabOffset[2];
 extern const int quadTabMaxBits[2];
 
+/* huffmulti.c (generated by extras/host/mkhuffmulti.cpp) */
+extern const unsigned int huffMultiTable[];
+extern const int huffMultiOffset[HUFF_PAIRTABS];
+extern const unsigned int quadMultiTable[2 << HUFF_MULTI_BITS];
+
 /* polyphase.c (or asmpoly.s)
  * some platforms require a C++ compile of all source files,
  * so if we're compiling C as C++ and using native assembly
@@ -296,6 +327,16 @@ extern "C" {
 #endif
 void PolyphaseMono(short *pcm, int *vbuf, const int *coefBase);
 void PolyphaseStereo(short *pcm, int *vbuf, const int *coefBase);
+void PolyphaseStereoPlanar(short *pcmL, short *pcmR, int *vbuf, const int *coefBase);
+
+/* dct32.c, and asmdct32_thumb2.S for Cortex-M4 (falls back to the C version for gb < 6) */
+// about 1 ms faster in RAM, but very large
+void FDCT32(int *x, int *d, int offset, int oddBlock, int gb, int nActive);// __attribute__ ((section (".data")));
+void FDCT32Thumb2(int *x, int *d, int offset, int oddBlock, int gb, int nActive);
+
+/* asmimdct_thumb2.S for Cortex-M4, the common cases of IMDCT36() and IMDCT12x3() in imdct.c */
+int AntiAliasIMDCT36Thumb2(int *xCurr, int *xPrev, int *y, int blockIdx, int antiAlias);
+int IMDCT12x3Thumb2(int *xCurr, int *xPrev, int *y, int btPrev, int blockIdx);
 #ifdef __cplusplus
 }
 #endif
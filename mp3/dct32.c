@@ -112,6 +112,15 @@ static const int dcttab[48] = {
 	buf[16+i] = b2 + b3;    buf[31-i] = MULSHIFT32(*cptr++, b3 - b2) << (s2); \
 }
 
+/* first pass for band-limited input, buf[16+i] = buf[31-i] = 0 */
+#define D32FPH(i, s0, s1, s2) { \
+    a0 = buf[i];			a1 = buf[15-i]; \
+							b3 = MULSHIFT32(*cptr++, a0) << (s0);	\
+							b2 = MULSHIFT32(*cptr++, a1) << (s1);	\
+	buf[i] = a0 + a1;		buf[15-i] = MULSHIFT32(*cptr,   a0 - a1) << (s2); \
+	buf[16+i] = b2 + b3;    buf[31-i] = MULSHIFT32(*cptr++, b3 - b2) << (s2); \
+}
+
 /**************************************************************************************
  * Function:    FDCT32
  *
@@ -122,6 +131,7 @@ static const int dcttab[48] = {
  *                of overflow in internal calculations (see bbtest_imdct test app)
  *              buffer offset and oddblock flag for polyphase filter input buffer
  *              number of guard bits in input
+ *              number of leading subbands in x that can be non-zero (x[nActive..31] = 0)
  *
  * Outputs:     output buffer, data copied and interleaved for polyphase filter
  *              no guarantees about number of guard bits in output
@@ -135,13 +145,16 @@ static const int dcttab[48] = {
  *                differently, depending on magnitude)
  *              guard bit analysis verified by exhaustive testing of all 2^32 
  *                combinations of max pos/max neg values in x[]
+ *              nActive <= 16 (lowpassed streams) skips the upper half in the first pass,
+ *                nActive = 0 (silence) skips both passes and just stores the zeros,
+ *                both bit-exact since the skipped terms are 0
  *
  * TODO:        code organization and optimization for ARM
  *              possibly interleave stereo (cut # of coef loads in half - may not have
  *                enough registers)
  **************************************************************************************/
 // about 1ms faster in RAM
-/* attribute__ ((section (".data"))) */ void FDCT32(int *buf, int *dest, int offset, int oddBlock, int gb)
+/* attribute__ ((section (".data"))) */ void FDCT32(int *buf, int *dest, int offset, int oddBlock, int gb, int nActive)
 {
     int i, s, tmp, es;
     const int *cptr = dcttab;
@@ -161,43 +174,56 @@ static const int dcttab[48] = {
 	}
 
 	/* first pass */    
-	D32FP(0, 1, 5, 1);
-	D32FP(1, 1, 3, 1);
-	D32FP(2, 1, 3, 1);
-	D32FP(3, 1, 2, 1);
-	D32FP(4, 1, 2, 1);
-	D32FP(5, 1, 1, 2);
-	D32FP(6, 1, 1, 2);
-	D32FP(7, 1, 1, 4);
+	if (nActive > 16) {
+		D32FP(0, 1, 5, 1);
+		D32FP(1, 1, 3, 1);
+		D32FP(2, 1, 3, 1);
+		D32FP(3, 1, 2, 1);
+		D32FP(4, 1, 2, 1);
+		D32FP(5, 1, 1, 2);
+		D32FP(6, 1, 1, 2);
+		D32FP(7, 1, 1, 4);
+	} else if (nActive > 0) {
+		D32FPH(0, 1, 5, 1);
+		D32FPH(1, 1, 3, 1);
+		D32FPH(2, 1, 3, 1);
+		D32FPH(3, 1, 2, 1);
+		D32FPH(4, 1, 2, 1);
+		D32FPH(5, 1, 1, 2);
+		D32FPH(6, 1, 1, 2);
+		D32FPH(7, 1, 1, 4);
+	}
 
-	/* second pass */
-	for (i = 4; i > 0; i--) {
-		a0 = buf[0]; 	    a7 = buf[7];		a3 = buf[3];	    a4 = buf[4];
-		b0 = a0 + a7;	    b7 = MULSHIFT32(*cptr++, a0 - a7) << 1;
-		b3 = a3 + a4;	    b4 = MULSHIFT32(*cptr++, a3 - a4) << 3;
-		a0 = b0 + b3;	    a3 = MULSHIFT32(*cptr,   b0 - b3) << 1;
-		a4 = b4 + b7;		a7 = MULSHIFT32(*cptr++, b7 - b4) << 1;
+	/* second pass (silent input: buf is all zero and stays so, skip it) */
+	if (nActive > 0) {
+		for (i = 4; i > 0; i--) {
+			a0 = buf[0]; 	    a7 = buf[7];		a3 = buf[3];	    a4 = buf[4];
+			b0 = a0 + a7;	    b7 = MULSHIFT32(*cptr++, a0 - a7) << 1;
+			b3 = a3 + a4;	    b4 = MULSHIFT32(*cptr++, a3 - a4) << 3;
+			a0 = b0 + b3;	    a3 = MULSHIFT32(*cptr,   b0 - b3) << 1;
+			a4 = b4 + b7;		a7 = MULSHIFT32(*cptr++, b7 - b4) << 1;
 
-		a1 = buf[1];	    a6 = buf[6];	    a2 = buf[2];	    a5 = buf[5];
-		b1 = a1 + a6;	    b6 = MULSHIFT32(*cptr++, a1 - a6) << 1;
-		b2 = a2 + a5;	    b5 = MULSHIFT32(*cptr++, a2 - a5) << 1;
-		a1 = b1 + b2;		a2 = MULSHIFT32(*cptr,   b1 - b2) << 2;
-		a5 = b5 + b6;	    a6 = MULSHIFT32(*cptr++, b6 - b5) << 2;
+			a1 = buf[1];	    a6 = buf[6];	    a2 = buf[2];	    a5 = buf[5];
+			b1 = a1 + a6;	    b6 = MULSHIFT32(*cptr++, a1 - a6) << 1;
+			b2 = a2 + a5;	    b5 = MULSHIFT32(*cptr++, a2 - a5) << 1;
+			a1 = b1 + b2;		a2 = MULSHIFT32(*cptr,   b1 - b2) << 2;
+			a5 = b5 + b6;	    a6 = MULSHIFT32(*cptr++, b6 - b5) << 2;
 
-		b0 = a0 + a1;	    b1 = MULSHIFT32(COS4_0, a0 - a1) << 1;
-		b2 = a2 + a3;	    b3 = MULSHIFT32(COS4_0, a3 - a2) << 1;
-		buf[0] = b0;	    buf[1] = b1;
-		buf[2] = b2 + b3;	buf[3] = b3;
+			b0 = a0 + a1;	    b1 = MULSHIFT32(COS4_0, a0 - a1) << 1;
+			b2 = a2 + a3;	    b3 = MULSHIFT32(COS4_0, a3 - a2) << 1;
+			buf[0] = b0;	    buf[1] = b1;
+			buf[2] = b2 + b3;	buf[3] = b3;
 
-		b4 = a4 + a5;	    b5 = MULSHIFT32(COS4_0, a4 - a5) << 1;
-		b6 = a6 + a7;	    b7 = MULSHIFT32(COS4_0, a7 - a6) << 1;
-		b6 += b7;
-		buf[4] = b4 + b6;	buf[5] = b5 + b7;
-		buf[6] = b5 + b6;	buf[7] = b7;
+			b4 = a4 + a5;	    b5 = MULSHIFT32(COS4_0, a4 - a5) << 1;
+			b6 = a6 + a7;	    b7 = MULSHIFT32(COS4_0, a7 - a6) << 1;
+			b6 += b7;
+			buf[4] = b4 + b6;	buf[5] = b5 + b7;
+			buf[6] = b5 + b6;	buf[7] = b7;
 
-		buf += 8;
+			buf += 8;
+		}
+		buf -= 32;	/* reset */
 	}
-	buf -= 32;	/* reset */
 
 	/* sample 0 - always delayed one block */
 	d = dest + 64*16 + ((offset - oddBlock) & 7) + (oddBlock ? 0 : VBUF_LENGTH);
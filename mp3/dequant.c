@@ -69,11 +69,16 @@
  *                round to PCM (>> by 15 less than we otherwise would have).
  *              Equivalently, we can think of the dequantized coefficients as 
  *                Q(DQ_FRACBITS_OUT - 15) with no implicit bias. 
+ *              Joint stereo is done inside the left channel's DequantChannel() when both
+ *                channels have the same non-mixed block type, so the coefficients are 
+ *                only loaded and stored once. Otherwise MidSideProc() and 
+ *                IntensityProcMPEG1/2() run as separate passes
  **************************************************************************************/
 int Dequantize(MP3DecInfo *mp3DecInfo, int gr)
 {
 	int i, ch, nSamps, mOut[2];
 	FrameHeader *fh;
+	StereoInfo sti;
 	SideInfo *si;
 	ScaleFactorInfo *sfi;
 	HuffmanInfo *hi;
@@ -95,10 +100,42 @@ int Dequantize(MP3DecInfo *mp3DecInfo, int gr)
 	cbi = di->cbi;
 	mOut[0] = mOut[1] = 0;
 
+	/* joint stereo with the same (non-mixed) block type in both channels: dequantize the right
+	 *   channel, then do the stereo reconstruction inside the left channel's dequantizer
+	 */
+	if (mp3DecInfo->nChans == 2 && fh->modeExt && si->sis[gr][0].blockType == si->sis[gr][1].blockType && 
+		!si->sis[gr][0].mixedBlock && !si->sis[gr][1].mixedBlock) {
+
+		hi->gb[1] = DequantChannel(hi->huffDecBuf[1], di->workBuf, &hi->nonZeroBound[1], fh, 
+			&si->sis[gr][1], &sfi->sfis[gr][1], &cbi[1], 0);
+
+		/* see clipping below, the left channel is clipped sample by sample in DequantChannel() */
+		if (hi->gb[1] < 1) {
+			for (i = 0; i < hi->nonZeroBound[1]; i++) {
+				if (hi->huffDecBuf[1][i] < -0x3fffffff)	 hi->huffDecBuf[1][i] = -0x3fffffff;
+				if (hi->huffDecBuf[1][i] >  0x3fffffff)	 hi->huffDecBuf[1][i] =  0x3fffffff;
+			}
+		}
+
+		StereoSetup(&sti, fh, &sfi->sfis[gr][1], &cbi[1], &sfi->sfjs, hi->nonZeroBound[1]);
+		sti.xr = hi->huffDecBuf[1];
+		sti.mOut[0] = sti.mOut[1] = 0;
+		DequantChannel(hi->huffDecBuf[0], di->workBuf, &hi->nonZeroBound[0], fh, 
+			&si->sis[gr][0], &sfi->sfis[gr][0], &cbi[0], &sti);
+
+		hi->gb[0] = CLZ(sti.mOut[0]) - 1;
+		hi->gb[1] = CLZ(sti.mOut[1]) - 1;
+		nSamps = MAX(hi->nonZeroBound[0], hi->nonZeroBound[1]);
+		hi->nonZeroBound[0] = nSamps;
+		hi->nonZeroBound[1] = nSamps;
+
+		return 0;
+	}
+
 	/* dequantize all the samples in each channel */
 	for (ch = 0; ch < mp3DecInfo->nChans; ch++) {
 		hi->gb[ch] = DequantChannel(hi->huffDecBuf[ch], di->workBuf, &hi->nonZeroBound[ch], fh, 
-			&si->sis[gr][ch], &sfi->sfis[gr][ch], &cbi[ch]);
+			&si->sis[gr][ch], &sfi->sfis[gr][ch], &cbi[ch], 0);
 	}
 
 	/* joint stereo processing assumes one guard bit in input samples
@@ -146,9 +183,17 @@ int Dequantize(MP3DecInfo *mp3DecInfo, int gr)
 
 	/* adjust guard bit count and nonZeroBound if we did any stereo processing */
 	if (fh->modeExt) {
+		nSamps = MAX(hi->nonZeroBound[0], hi->nonZeroBound[1]);
+		if (fh->modeExt & 0x01) {
+			/* intensity stereo only reports its own region, but the guard bits are for all samples */
+			mOut[0] = mOut[1] = 0;
+			for (i = 0; i < nSamps; i++) {
+				mOut[0] |= FASTABS(hi->huffDecBuf[0][i]);
+				mOut[1] |= FASTABS(hi->huffDecBuf[1][i]);
+			}
+		}
 		hi->gb[0] = CLZ(mOut[0]) - 1;
 		hi->gb[1] = CLZ(mOut[1]) - 1;
-		nSamps = MAX(hi->nonZeroBound[0], hi->nonZeroBound[1]);
 		hi->nonZeroBound[0] = nSamps;
 		hi->nonZeroBound[1] = nSamps;
 	}
@@ -115,113 +115,326 @@ static const int pow2frac[8] = {
 	0x50a28be6, 0x7fffffff, 0x6597fa94, 0x50a28be6
 };
 
+/* y = pow(x, 4.0/3.0) * pow(2, 25 - scale/4.0) for x = 0..15, the values almost all 
+ * spectral lines have, built once per scale and kept for the next bands
+ */
+typedef struct _DequantTab {
+	int scale;
+	int y[16];
+} DequantTab;
+
+#define DQ_TAB_NONE		0x7fffffff		/* scale never used (gainI is a lot smaller) */
+
 /**************************************************************************************
- * Function:    DequantBlock
+ * Function:    DequantTabInit
  *
- * Description: Ken's highly-optimized, low memory dequantizer performing the operation
- *              y = pow(x, 4.0/3.0) * pow(2, 25 - scale/4.0)
+ * Description: fill the small-value table for one scale
  *
- * Inputs:      input buffer of decode Huffman codewords (signed-magnitude)
- *              output buffer of same length (in-place (outbuf = inbuf) is allowed)
- *              number of samples
- *              
- * Outputs:     dequantized samples in Q25 format
+ * Inputs:      table to fill
+ *              scale (see DequantBlock)
  *
- * Return:      bitwise-OR of the unsigned outputs (for guard bit calculations)
+ * Outputs:     tab->y[x], exactly what the per-sample code computed for x < 16
+ *
+ * Return:      none
  **************************************************************************************/
-/* __attribute__ ((section (".data"))) */ static int DequantBlock(int *inbuf, int *outbuf, int num, int scale)
+static void DequantTabInit(DequantTab *tab, int scale)
 {
-	int tab4[4];
-	int scalef, scalei, shift;
-	int sx, x, y;
-	int mask = 0;
-	const int *tab16; 
-	const unsigned int *coef;
+	int x, scalei, shift;
+	const int *tab16;
 
 	tab16 = pow43_14[scale & 0x3];
-	scalef = pow14[scale & 0x3];
 	scalei = MIN(scale >> 2, 31);	/* smallest input scale = -47, so smallest scalei = -12 */
 
-	/* cache first 4 values */
+	/* first 4 values are Q28 */
 	shift = MIN(scalei + 3, 31);
 	shift = MAX(shift, 0);
-	tab4[0] = 0;
-	tab4[1] = tab16[1] >> shift;
-	tab4[2] = tab16[2] >> shift;
-	tab4[3] = tab16[3] >> shift;
+	tab->y[0] = 0;
+	tab->y[1] = tab16[1] >> shift;
+	tab->y[2] = tab16[2] >> shift;
+	tab->y[3] = tab16[3] >> shift;
+
+	if (scalei < 0) {
+		for (x = 4; x < 16; x++)
+			tab->y[x] = tab16[x] << -scalei;
+	} else {
+		for (x = 4; x < 16; x++)
+			tab->y[x] = tab16[x] >> scalei;
+	}
+	tab->scale = scale;
+}
 
-	do {
+/**************************************************************************************
+ * Function:    DequantBig
+ *
+ * Description: dequantize one value x >= 16 (rare, so kept out of the sample loops)
+ *
+ * Inputs:      magnitude x
+ *              fractional scale (Q31) and integer scale (see DequantBlock)
+ *
+ * Outputs:     none
+ *
+ * Return:      y = pow(x, 4.0/3.0) * pow(2, 25 - scale/4.0), clipped to 0x7fffffff
+ **************************************************************************************/
+static int DequantBig(int x, int scalef, int scalei)
+{
+	int y, shift;
+	const unsigned int *coef;
 
-		sx = *inbuf++;
-		x = sx & 0x7fffffff;	/* sx = sign|mag */
+	if (x < 64) {
 
-		if (x < 4) {
+		y = pow43[x-16];
 
-			y = tab4[x];
+		/* fractional scale */
+		y = MULSHIFT32(y, scalef);
+		shift = scalei - 3;
 
-		} else if (x < 16) {
+	} else {
 
-			y = tab16[x];
-			y = (scalei < 0) ? y << -scalei : y >> scalei;
+		/* normalize to [0x40000000, 0x7fffffff] */
+		x <<= 17;
+		shift = 0;
+		if (x < 0x08000000)
+			x <<= 4, shift += 4;
+		if (x < 0x20000000)
+			x <<= 2, shift += 2;
+		if (x < 0x40000000)
+			x <<= 1, shift += 1;
+
+		coef = (x < SQRTHALF) ? poly43lo : poly43hi;
+
+		/* polynomial */
+		y = coef[0];
+		y = MULSHIFT32(y, x) + coef[1];
+		y = MULSHIFT32(y, x) + coef[2];
+		y = MULSHIFT32(y, x) + coef[3];
+		y = MULSHIFT32(y, x) + coef[4];
+		y = MULSHIFT32(y, pow2frac[shift]) << 3;
+
+		/* fractional scale */
+		y = MULSHIFT32(y, scalef);
+		shift = scalei - pow2exp[shift];
+	}
 
-		} else {
+	/* integer scale */
+	if (shift < 0) {
+		shift = -shift;
+		if (y > (0x7fffffff >> shift))
+			y = 0x7fffffff;		/* clip */
+		else
+			y <<= shift;
+	} else {
+		y >>= shift;
+	}
 
-			if (x < 64) {
+	return y;
+}
 
-				y = pow43[x-16];
+/* one sample: y = |output| for the nonzero mask, s = signed output, (y ^ -1) + 1 = -y */
+#define DQ_SAMPLE(s) { \
+	sx = *inbuf++; \
+	x = sx & 0x7fffffff;	/* sx = sign|mag */ \
+	y = (x < 16 ? tabY[x] : DequantBig(x, scalef, scalei)); \
+	mask |= y; \
+	sign = sx >> 31; \
+	s = (y ^ sign) - sign; \
+}
 
-				/* fractional scale */
-				y = MULSHIFT32(y, scalef);
-				shift = scalei - 3;
+/* joint stereo assumes one guard bit, clip to [-2^30+1, 2^30-1] (almost never happens) */
+#define CLIP_GB1(s) { \
+	if ((unsigned int)(s) + 0x3fffffff > 0x7ffffffe) \
+		s = ((s) < 0 ? -0x3fffffff : 0x3fffffff); \
+}
 
-			} else {
+/* what the joint stereo does to a band of the left channel */
+#define JS_NONE		0		/* nothing, intensity on but mid-side off */
+#define JS_MS		1		/* mid-side */
+#define JS_IS		2		/* intensity */
 
-				/* normalize to [0x40000000, 0x7fffffff] */
-				x <<= 17;
-				shift = 0;
-				if (x < 0x08000000)
-					x <<= 4, shift += 4;
-				if (x < 0x20000000)
-					x <<= 2, shift += 2;
-				if (x < 0x40000000)
-					x <<= 1, shift += 1;
+/**************************************************************************************
+ * Function:    DequantBlock
+ *
+ * Description: Ken's highly-optimized, low memory dequantizer performing the operation
+ *              y = pow(x, 4.0/3.0) * pow(2, 25 - scale/4.0)
+ *
+ * Inputs:      input buffer of decode Huffman codewords (signed-magnitude)
+ *              output buffer of same length (in-place (outbuf = inbuf) is allowed)
+ *              number of samples
+ *              small-value table, rebuilt here if it was made for another scale
+ *              
+ * Outputs:     dequantized samples in Q25 format
+ *
+ * Return:      bitwise-OR of the unsigned outputs (for guard bit calculations)
+ *
+ * Notes:       x < 16 is a table lookup and a branchless sign, only the rare bigger 
+ *                values take the pow43 table or the polynomial
+ **************************************************************************************/
+/* __attribute__ ((section (".data"))) */ static int DequantBlock(int *inbuf, int *outbuf, int num, int scale, DequantTab *tab)
+{
+	int scalef, scalei;
+	int sx, x, y, s, sign;
+	int mask = 0;
+	const int *tabY;
 
-				coef = (x < SQRTHALF) ? poly43lo : poly43hi;
+	if (tab->scale != scale)
+		DequantTabInit(tab, scale);
+	tabY = tab->y;
 
-				/* polynomial */
-				y = coef[0];
-				y = MULSHIFT32(y, x) + coef[1];
-				y = MULSHIFT32(y, x) + coef[2];
-				y = MULSHIFT32(y, x) + coef[3];
-				y = MULSHIFT32(y, x) + coef[4];
-				y = MULSHIFT32(y, pow2frac[shift]) << 3;
+	scalef = pow14[scale & 0x3];
+	scalei = MIN(scale >> 2, 31);	/* smallest input scale = -47, so smallest scalei = -12 */
 
-				/* fractional scale */
-				y = MULSHIFT32(y, scalef);
-				shift = scalei - pow2exp[shift];
-			}
+	do {
+		DQ_SAMPLE(s);
+		*outbuf++ = s;
+	} while (--num);
 
-			/* integer scale */
-			if (shift < 0) {
-				shift = -shift;
-				if (y > (0x7fffffff >> shift))
-					y = 0x7fffffff;		/* clip */
-				else
-					y <<= shift;
-			} else {
-				y >>= shift;
-			}
-		}
+	return mask;
+}
 
-		/* sign and store */
-		mask |= y;
-		*outbuf++ = (sx < 0) ? -y : y;
+/**************************************************************************************
+ * Function:    DequantBlockJS
+ *
+ * Description: DequantBlock() for a left channel band, with the joint stereo 
+ *                reconstruction done on each sample while it is in a register
+ *
+ * Inputs:      input buffer of decode Huffman codewords (signed-magnitude), left channel
+ *              output buffer of same length (in-place (outbuf = inbuf) is allowed)
+ *              right channel samples of the band (dequantized)
+ *              number of samples
+ *              small-value table, rebuilt here if it was made for another scale
+ *              what to do (JS_NONE, JS_MS, JS_IS) and the intensity scale factors
+ *              
+ * Outputs:     L in outbuf, R in xr
+ *              updated guard bit masks (mOut[0] = left, mOut[1] = right)
+ *
+ * Return:      bitwise-OR of the unsigned dequantized left samples (for cbi)
+ **************************************************************************************/
+static int DequantBlockJS(int *inbuf, int *outbuf, int *xr, int num, int scale, DequantTab *tab, 
+						  int mode, int fl, int fr, int mOut[2])
+{
+	int scalef, scalei;
+	int sx, x, y, s, l, r, sign;
+	int mask = 0, mOutL = 0, mOutR = 0;
+	const int *tabY;
 
-	} while (--num);
+	if (tab->scale != scale)
+		DequantTabInit(tab, scale);
+	tabY = tab->y;
+
+	scalef = pow14[scale & 0x3];
+	scalei = MIN(scale >> 2, 31);
+
+	if (mode == JS_MS) {
+		/* L = M + S, R = M - S (1/sqrt(2) is in the gain) */
+		do {
+			DQ_SAMPLE(s);
+			CLIP_GB1(s);
+			r = *xr;
+			l = s + r;	*outbuf++ = l;	mOutL |= FASTABS(l);
+			r = s - r;	*xr++ = r;		mOutR |= FASTABS(r);
+		} while (--num);
+	} else if (mode == JS_IS) {
+		do {
+			DQ_SAMPLE(s);
+			CLIP_GB1(s);
+			r = MULSHIFT32(fr, s) << 2;	*xr++ = r;		mOutR |= FASTABS(r);
+			s = MULSHIFT32(fl, s) << 2;	*outbuf++ = s;	mOutL |= FASTABS(s);
+		} while (--num);
+	} else {
+		do {
+			DQ_SAMPLE(s);
+			CLIP_GB1(s);
+			*outbuf++ = s;		mOutL |= FASTABS(s);
+			r = *xr++;			mOutR |= FASTABS(r);
+		} while (--num);
+	}
+	mOut[0] |= mOutL;
+	mOut[1] |= mOutR;
 
 	return mask;
 }
 
+/**************************************************************************************
+ * Function:    ReorderJS
+ *
+ * Description: short block reordering of one window of a left channel band, with the
+ *                joint stereo reconstruction done on the way (see DequantBlockJS)
+ *
+ * Inputs:      dequantized left samples of the window (contiguous)
+ *              left and right channel output, window w of the band (stride 3)
+ *              number of samples
+ *              what to do (JS_NONE, JS_MS, JS_IS) and the intensity scale factors
+ *              
+ * Outputs:     L in xl, R in xr
+ *              updated guard bit masks (mOut[0] = left, mOut[1] = right)
+ *
+ * Return:      none
+ **************************************************************************************/
+static void ReorderJS(int *src, int *xl, int *xr, int num, int mode, int fl, int fr, int mOut[2])
+{
+	int s, l, r, mOutL = 0, mOutR = 0;
+
+	if (mode == JS_MS) {
+		do {
+			s = *src++;
+			CLIP_GB1(s);
+			r = *xr;
+			l = s + r;	*xl = l;	mOutL |= FASTABS(l);	xl += 3;
+			r = s - r;	*xr = r;	mOutR |= FASTABS(r);	xr += 3;
+		} while (--num);
+	} else if (mode == JS_IS) {
+		do {
+			s = *src++;
+			CLIP_GB1(s);
+			r = MULSHIFT32(fr, s) << 2;	*xr = r;	mOutR |= FASTABS(r);	xr += 3;
+			s = MULSHIFT32(fl, s) << 2;	*xl = s;	mOutL |= FASTABS(s);	xl += 3;
+		} while (--num);
+	} else {
+		do {
+			s = *src++;
+			CLIP_GB1(s);
+			*xl = s;		mOutL |= FASTABS(s);		xl += 3;
+			r = *xr;		mOutR |= FASTABS(r);		xr += 3;
+		} while (--num);
+	}
+	mOut[0] |= mOutL;
+	mOut[1] |= mOutR;
+}
+
+/**************************************************************************************
+ * Function:    StereoTail
+ *
+ * Description: joint stereo past the last dequantized left sample, up to sti->msEnd
+ *                (left is 0 there, so mid-side is L = S, R = -S)
+ *
+ * Inputs:      left channel samples
+ *              StereoInfo struct
+ *              index of the first sample to do
+ *              
+ * Outputs:     updated samples and guard bit masks
+ *
+ * Return:      none
+ **************************************************************************************/
+static void StereoTail(int *xl, StereoInfo *sti, int i)
+{
+	int r, mOutR = 0;
+	int *xr = sti->xr;
+
+	for (   ; i < sti->msEnd; i++) {
+		r = xr[i];
+		mOutR |= FASTABS(r);
+		if (sti->midSide) {
+			xl[i] = r;
+			xr[i] = -r;
+		}
+	}
+	if (sti->midSide)
+		sti->mOut[0] |= mOutR;
+	sti->mOut[1] |= mOutR;
+}
+
+/* band cb (window w) of the left channel: intensity from isStart[w] up, below mid-side or nothing */
+#define JS_MODE(sti, cb, w)		((cb) >= (sti)->isStart[w] ? JS_IS : ((sti)->midSide ? JS_MS : JS_NONE))
+
 /**************************************************************************************
  * Function:    DequantChannel
  *
@@ -233,17 +446,21 @@ static const int pow2frac[8] = {
  *              non-zero bound for this channel/granule
  *              valid FrameHeader, SideInfoSub, ScaleFactorInfoSub, and CriticalBandInfo
  *                structures for this channel/granule
+ *              StereoInfo from StereoSetup() to do the joint stereo reconstruction on the
+ *                way (left channel, right one already dequantized), or 0
  *
  * Outputs:     MAX_NSAMP dequantized samples in sampleBuf
  *              updated non-zero bound (indicating which samples are != 0 after DQ)
  *              filled-in cbi structure indicating start and end critical bands
+ *              with sti: L in sampleBuf, R in sti->xr, guard bit masks in sti->mOut
  *
- * Return:      minimum number of guard bits in dequantized sampleBuf
+ * Return:      minimum number of guard bits in dequantized sampleBuf (before stereo)
  *
  * Notes:       dequantized samples in Q(DQ_FRACBITS_OUT) format 
+ *              with sti both channels must have the same block type, not mixed
  **************************************************************************************/
 /* __attribute__ ((section (".data"))) */ int DequantChannel(int *sampleBuf, int *workBuf, int *nonZeroBound, FrameHeader *fh, SideInfoSub *sis, 
-					ScaleFactorInfoSub *sfis, CriticalBandInfo *cbi)
+					ScaleFactorInfoSub *sfis, CriticalBandInfo *cbi, StereoInfo *sti)
 {
 	int i, j, w, cb;
 	int /* cbStartL, */ cbEndL, cbStartS, cbEndS;
@@ -251,6 +468,7 @@ static const int pow2frac[8] = {
 	int globalGain, gainI;
 	int cbMax[3];
 	ARRAY3 *buf;    /* short block reorder */
+	DequantTab tab;
 	
 	/* set default start/end points for short/long blocks - will update with non-zero cb info */
 	if (sis->blockType == 2) {
@@ -273,6 +491,7 @@ static const int pow2frac[8] = {
 	cbMax[2] = cbMax[1] = cbMax[0] = 0;
 	gbMask = 0;
 	i = 0;
+	tab.scale = DQ_TAB_NONE;
 
 	/* sfactScale = 0 --> quantizer step size = 2
 	 * sfactScale = 1 --> quantizer step size = sqrt(2)
@@ -296,7 +515,11 @@ static const int pow2frac[8] = {
 		nSamps = fh->sfBand->l[cb + 1] - fh->sfBand->l[cb];
 		gainI = 210 - globalGain + sfactMultiplier * (sfis->l[cb] + (sis->preFlag ? (int)preTab[cb] : 0));
 
-		nonZero |= DequantBlock(sampleBuf + i, sampleBuf + i, nSamps, gainI);
+		if (sti)
+			nonZero |= DequantBlockJS(sampleBuf + i, sampleBuf + i, sti->xr + i, nSamps, gainI, &tab, 
+				JS_MODE(sti, cb, 0), sti->isfL[cb], sti->isfR[cb], sti->mOut);
+		else
+			nonZero |= DequantBlock(sampleBuf + i, sampleBuf + i, nSamps, gainI, &tab);
 		i += nSamps;
 
 		/* update highest non-zero critical band */
@@ -315,8 +538,11 @@ static const int pow2frac[8] = {
 	cbi->cbEndSMax = 0;
 
 	/* early exit if no short blocks */
-	if (cbStartS >= 12) 
+	if (cbStartS >= 12) {
+		if (sti)
+			StereoTail(sampleBuf, sti, i);
 		return CLZ(gbMask) - 1;
+	}
 	
 	/* short blocks */
 	cbMax[2] = cbMax[1] = cbMax[0] = cbStartS;
@@ -327,7 +553,7 @@ static const int pow2frac[8] = {
 			nonZero =  0;
 			gainI = 210 - globalGain + 8*sis->subBlockGain[w] + sfactMultiplier*(sfis->s[cb][w]);
 
-			nonZero |= DequantBlock(sampleBuf + i + nSamps*w, workBuf + nSamps*w, nSamps, gainI);
+			nonZero |= DequantBlock(sampleBuf + i + nSamps*w, workBuf + nSamps*w, nSamps, gainI, &tab);
 
 			/* update highest non-zero critical band */
 			if (nonZero)
@@ -336,13 +562,20 @@ static const int pow2frac[8] = {
 		}
 
 		/* reorder blocks */
-		buf = (ARRAY3 *)(sampleBuf + i);
-		i += 3*nSamps;
-		for (j = 0; j < nSamps; j++) {
-			buf[j][0] = workBuf[0*nSamps + j];
-			buf[j][1] = workBuf[1*nSamps + j];
-			buf[j][2] = workBuf[2*nSamps + j];
+		if (sti) {
+			for (w = 0; w < 3; w++) {
+				ReorderJS(workBuf + nSamps*w, sampleBuf + i + w, sti->xr + i + w, nSamps, 
+					JS_MODE(sti, cb, w), sti->isfL[3*cb + w], sti->isfR[3*cb + w], sti->mOut);
+			}
+		} else {
+			buf = (ARRAY3 *)(sampleBuf + i);
+			for (j = 0; j < nSamps; j++) {
+				buf[j][0] = workBuf[0*nSamps + j];
+				buf[j][1] = workBuf[1*nSamps + j];
+				buf[j][2] = workBuf[2*nSamps + j];
+			}
 		}
+		i += 3*nSamps;
 
 		ASSERT(3*nSamps <= MAX_REORDER_SAMPS);
 
@@ -361,6 +594,9 @@ static const int pow2frac[8] = {
 
 	ASSERT(*nonZeroBound <= MAX_NSAMP);
 
+	if (sti)
+		StereoTail(sampleBuf, sti, i);
+
 	cbi->cbType = (sis->mixedBlock ? 2 : 1);	/* 2 = mixed short/long, 1 = short only */
 
 	cbi->cbEndS[0] = cbMax[0];
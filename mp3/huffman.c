@@ -56,6 +56,12 @@
 #define GetCWXQ(x)      ((int)( (((unsigned char)(x)) >> 1) & 0x01))
 #define GetCWYQ(x)      ((int)( (((unsigned char)(x)) >> 0) & 0x01))
 
+/* multi-symbol entries - see comments in huffmulti.c about the format */
+#define GetMultiLen1(x)	((int)( ((x) >> 0) & 0x000f))
+#define GetMultiLen2(x)	((int)( ((x) >> 4) & 0x000f))
+#define GetMultiVal(x, n)	((int)( (((x) >> (n)) & 0x000f) | (((x) << (27 - (n))) & 0x80000000) ))
+#define GetMultiValQ(x, n)	((int)( (((x) >> (n)) & 0x0001) | (((x) << (30 - (n))) & 0x80000000) ))
+
 /* apply sign of s to the positive number x (save in MSB, will do two's complement in dequant) */
 #define ApplySign(x, s)	{ (x) |= ((s) & 0x80000000); }
 
@@ -86,7 +92,8 @@ static int DecodeHuffmanPairs(int *xy, int nVals, int tabIdx, int bitsLeft, unsi
 	int cachedBits, padBits, len, startBits, linBits, maxBits, minBits;
 	HuffTabType tabType;
 	unsigned short cw, *tBase, *tCurr;
-	unsigned int cache;
+	unsigned int cache, mcw;
+	const unsigned int *mBase;
 
 	if(nVals <= 0) 
 		return 0;
@@ -98,6 +105,7 @@ static int DecodeHuffmanPairs(int *xy, int nVals, int tabIdx, int bitsLeft, unsi
 	tBase = (unsigned short *)(huffTable + huffTabOffset[tabIdx]);
 	linBits = huffTabLookup[tabIdx].linBits;
 	tabType = huffTabLookup[tabIdx].tabType;
+	mBase = huffMultiTable + huffMultiOffset[tabIdx];
 
 	ASSERT(!(nVals & 0x01));
 	ASSERT(tabIdx < HUFF_PAIRTABS);
@@ -146,6 +154,31 @@ static int DecodeHuffmanPairs(int *xy, int nVals, int tabIdx, int bitsLeft, unsi
 
 			/* largest maxBits = 9, plus 2 for sign bits, so make sure cache has at least 11 bits */
 			while (nVals > 0 && cachedBits >= 11 ) {
+				/* fast path: one or two short codewords (with sign bits) in the next HUFF_MULTI_BITS bits */
+				mcw = mBase[cache >> (32 - HUFF_MULTI_BITS)];
+				len = GetMultiLen2(mcw);
+				if (len && nVals >= 4 && cachedBits - len >= padBits) {
+					xy[0] = GetMultiVal(mcw, 8);
+					xy[1] = GetMultiVal(mcw, 13);
+					xy[2] = GetMultiVal(mcw, 18);
+					xy[3] = GetMultiVal(mcw, 23);
+					xy += 4;
+					nVals -= 4;
+					cachedBits -= len;
+					cache <<= len;
+					continue;
+				}
+				len = GetMultiLen1(mcw);
+				if (len && cachedBits - len >= padBits) {
+					xy[0] = GetMultiVal(mcw, 8);
+					xy[1] = GetMultiVal(mcw, 13);
+					xy += 2;
+					nVals -= 2;
+					cachedBits -= len;
+					cache <<= len;
+					continue;
+				}
+
 				cw = tBase[cache >> (32 - maxBits)];
 				len = GetHLen(cw);
 				cachedBits -= len;
@@ -191,6 +224,32 @@ static int DecodeHuffmanPairs(int *xy, int nVals, int tabIdx, int bitsLeft, unsi
 
 			/* largest maxBits = 9, plus 2 for sign bits, so make sure cache has at least 11 bits */
 			while (nVals > 0 && cachedBits >= 11 ) {
+				if (tCurr == tBase) {
+					/* fast path: one or two short codewords (with sign bits) in the next HUFF_MULTI_BITS bits */
+					mcw = mBase[cache >> (32 - HUFF_MULTI_BITS)];
+					len = GetMultiLen2(mcw);
+					if (len && nVals >= 4 && cachedBits - len >= padBits) {
+						xy[0] = GetMultiVal(mcw, 8);
+						xy[1] = GetMultiVal(mcw, 13);
+						xy[2] = GetMultiVal(mcw, 18);
+						xy[3] = GetMultiVal(mcw, 23);
+						xy += 4;
+						nVals -= 4;
+						cachedBits -= len;
+						cache <<= len;
+						continue;
+					}
+					len = GetMultiLen1(mcw);
+					if (len && cachedBits - len >= padBits) {
+						xy[0] = GetMultiVal(mcw, 8);
+						xy[1] = GetMultiVal(mcw, 13);
+						xy += 2;
+						nVals -= 2;
+						cachedBits -= len;
+						cache <<= len;
+						continue;
+					}
+				}
 				maxBits = GetMaxbits(tCurr[0]);
 				cw = tCurr[(cache >> (32 - maxBits)) + 1];
 				len = GetHLen(cw);
@@ -288,14 +347,16 @@ static int DecodeHuffmanQuads(int *vwxy, int nVals, int tabIdx, int bitsLeft, un
 {
 	int i, v, w, x, y;
 	int len, maxBits, cachedBits, padBits;
-	unsigned int cache;
+	unsigned int cache, mcw;
 	unsigned char cw, *tBase;
+	const unsigned int *mBase;
 
 	if (bitsLeft <= 0)
 		return 0;
 
 	tBase = (unsigned char *)quadTable + quadTabOffset[tabIdx];
 	maxBits = quadTabMaxBits[tabIdx];
+	mBase = quadMultiTable + (tabIdx << HUFF_MULTI_BITS);
 
 	/* initially fill cache with any partial byte */
 	cache = 0;
@@ -328,6 +389,37 @@ static int DecodeHuffmanQuads(int *vwxy, int nVals, int tabIdx, int bitsLeft, un
 
 		/* largest maxBits = 6, plus 4 for sign bits, so make sure cache has at least 10 bits */
 		while (i < (nVals - 3) && cachedBits >= 10 ) {
+			/* fast path: one or two quads (with sign bits) in the next HUFF_MULTI_BITS bits */
+			mcw = mBase[cache >> (32 - HUFF_MULTI_BITS)];
+			len = GetMultiLen2(mcw);
+			if (len && i < (nVals - 7) && cachedBits - len >= padBits) {
+				vwxy[0] = GetMultiValQ(mcw, 8);
+				vwxy[1] = GetMultiValQ(mcw, 10);
+				vwxy[2] = GetMultiValQ(mcw, 12);
+				vwxy[3] = GetMultiValQ(mcw, 14);
+				vwxy[4] = GetMultiValQ(mcw, 16);
+				vwxy[5] = GetMultiValQ(mcw, 18);
+				vwxy[6] = GetMultiValQ(mcw, 20);
+				vwxy[7] = GetMultiValQ(mcw, 22);
+				vwxy += 8;
+				i += 8;
+				cachedBits -= len;
+				cache <<= len;
+				continue;
+			}
+			len = GetMultiLen1(mcw);
+			if (len && cachedBits - len >= padBits) {
+				vwxy[0] = GetMultiValQ(mcw, 8);
+				vwxy[1] = GetMultiValQ(mcw, 10);
+				vwxy[2] = GetMultiValQ(mcw, 12);
+				vwxy[3] = GetMultiValQ(mcw, 14);
+				vwxy += 4;
+				i += 4;
+				cachedBits -= len;
+				cache <<= len;
+				continue;
+			}
+
 			cw = tBase[cache >> (32 - maxBits)];
 			len = GetHLenQ(cw);
 			cachedBits -= len;
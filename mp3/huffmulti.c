@@ -0,0 +1,630 @@
+/* generated by extras/host/mkhuffmulti.cpp from hufftabs.c - do not edit */
+
+#include "coder.h"
+
+/* first-level tables for the multi-symbol fast path in huffman.c, indexed by the
+ *   next 8 bits of the stream
+ *
+ * pair tables: bits 0-3 = length of the first codeword incl. sign bits (0 = use huffTable)
+ *   bits 4-7 = length of both codewords (0 = only the first one fits), then x1, y1, x2, y2
+ *   with 5 bits each (sign in bit 4, magnitude in bits 0-3). Pairs with linbits are not
+ *   listed. Tables 16-23 and 24-31 share one table each, like in huffTable
+ * quad tables: the same two lengths, then two quads of 2 bits per value
+ *   (magnitude in bit 0, sign in bit 1), v in the lowest bits
+ */
+const unsigned int huffMultiTable[] = {
+	/* huffMulti01[256] */
+	0x00002105, 0x00002105, 0x00042185, 0x00442185, 0x00002165, 0x00002165, 0x00002165, 0x00002165,
+	0x00022105, 0x00022105, 0x00062185, 0x00462185, 0x00022165, 0x00022165, 0x00022165, 0x00022165,
+	0x00003105, 0x00003105, 0x00043185, 0x00443185, 0x00003165, 0x00003165, 0x00003165, 0x00003165,
+	0x00023105, 0x00023105, 0x00063185, 0x00463185, 0x00023165, 0x00023165, 0x00023165, 0x00023165,
+	0x00002004, 0x00002004, 0x00802084, 0x08802084, 0x00042074, 0x00042074, 0x00442074, 0x00442074,
+	0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054,
+	0x00022004, 0x00022004, 0x00822084, 0x08822084, 0x00062074, 0x00062074, 0x00462074, 0x00462074,
+	0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054,
+	0x00840183, 0x08840183, 0x00c40183, 0x08c40183, 0x00800173, 0x00800173, 0x08800173, 0x08800173,
+	0x00040163, 0x00040163, 0x00040163, 0x00040163, 0x00440163, 0x00440163, 0x00440163, 0x00440163,
+	0x00000143, 0x00000143, 0x00000143, 0x00000143, 0x00000143, 0x00000143, 0x00000143, 0x00000143,
+	0x00000143, 0x00000143, 0x00000143, 0x00000143, 0x00000143, 0x00000143, 0x00000143, 0x00000143,
+	0x00841183, 0x08841183, 0x00c41183, 0x08c41183, 0x00801173, 0x00801173, 0x08801173, 0x08801173,
+	0x00041163, 0x00041163, 0x00041163, 0x00041163, 0x00441163, 0x00441163, 0x00441163, 0x00441163,
+	0x00001143, 0x00001143, 0x00001143, 0x00001143, 0x00001143, 0x00001143, 0x00001143, 0x00001143,
+	0x00001143, 0x00001143, 0x00001143, 0x00001143, 0x00001143, 0x00001143, 0x00001143, 0x00001143,
+	0x00840061, 0x00840061, 0x00840061, 0x00840061, 0x08840061, 0x08840061, 0x08840061, 0x08840061,
+	0x00c40061, 0x00c40061, 0x00c40061, 0x00c40061, 0x08c40061, 0x08c40061, 0x08c40061, 0x08c40061,
+	0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051,
+	0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051,
+	0x00040041, 0x00040041, 0x00040041, 0x00040041, 0x00040041, 0x00040041, 0x00040041, 0x00040041,
+	0x00040041, 0x00040041, 0x00040041, 0x00040041, 0x00040041, 0x00040041, 0x00040041, 0x00040041,
+	0x00440041, 0x00440041, 0x00440041, 0x00440041, 0x00440041, 0x00440041, 0x00440041, 0x00440041,
+	0x00440041, 0x00440041, 0x00440041, 0x00440041, 0x00440041, 0x00440041, 0x00440041, 0x00440041,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+
+	/* huffMulti02[256] */
+	0x00004208, 0x00024208, 0x00005208, 0x00025208, 0x00004007, 0x00004087, 0x00024007, 0x00024087,
+	0x00004107, 0x00004187, 0x00024107, 0x00024187, 0x00005107, 0x00005187, 0x00025107, 0x00025187,
+	0x00002207, 0x00002287, 0x00022207, 0x00022287, 0x00003207, 0x00003287, 0x00023207, 0x00023287,
+	0x00000206, 0x00000206, 0x00000276, 0x00000276, 0x00001206, 0x00001206, 0x00001276, 0x00001276,
+	0x00002105, 0x00002105, 0x00002105, 0x00002105, 0x00002165, 0x00002165, 0x00002165, 0x00002165,
+	0x00022105, 0x00022105, 0x00022105, 0x00022105, 0x00022165, 0x00022165, 0x00022165, 0x00022165,
+	0x00003105, 0x00003105, 0x00003105, 0x00003105, 0x00003165, 0x00003165, 0x00003165, 0x00003165,
+	0x00023105, 0x00023105, 0x00023105, 0x00023105, 0x00023165, 0x00023165, 0x00023165, 0x00023165,
+	0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00802084, 0x08802084, 0x00042084, 0x00442084,
+	0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054,
+	0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00822084, 0x08822084, 0x00062084, 0x00462084,
+	0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054,
+	0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00800184, 0x08800184, 0x00040184, 0x00440184,
+	0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154,
+	0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00801184, 0x08801184, 0x00041184, 0x00441184,
+	0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154,
+	0x00000001, 0x00000001, 0x01000081, 0x09000081, 0x01040081, 0x09040081, 0x01440081, 0x09440081,
+	0x00880081, 0x08880081, 0x00c80081, 0x08c80081, 0x00080071, 0x00080071, 0x00480071, 0x00480071,
+	0x00840061, 0x00840061, 0x00840061, 0x00840061, 0x08840061, 0x08840061, 0x08840061, 0x08840061,
+	0x00c40061, 0x00c40061, 0x00c40061, 0x00c40061, 0x08c40061, 0x08c40061, 0x08c40061, 0x08c40061,
+	0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051,
+	0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051,
+	0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051,
+	0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+
+	/* huffMulti03[256] */
+	0x00004208, 0x00024208, 0x00005208, 0x00025208, 0x00004007, 0x00004007, 0x00024007, 0x00024007,
+	0x00004107, 0x00004107, 0x00024107, 0x00024107, 0x00005107, 0x00005107, 0x00025107, 0x00025107,
+	0x00002207, 0x00002207, 0x00022207, 0x00022207, 0x00003207, 0x00003207, 0x00023207, 0x00023207,
+	0x00000206, 0x00000206, 0x00000206, 0x00000286, 0x00001206, 0x00001206, 0x00001206, 0x00001286,
+	0x00000104, 0x00000104, 0x00040184, 0x00440184, 0x00840184, 0x08840184, 0x00c40184, 0x08c40184,
+	0x00800174, 0x00800174, 0x08800174, 0x08800174, 0x00000164, 0x00000164, 0x00000164, 0x00000164,
+	0x00001104, 0x00001104, 0x00041184, 0x00441184, 0x00841184, 0x08841184, 0x00c41184, 0x08c41184,
+	0x00801174, 0x00801174, 0x08801174, 0x08801174, 0x00001164, 0x00001164, 0x00001164, 0x00001164,
+	0x00002104, 0x00002104, 0x00042184, 0x00442184, 0x00842184, 0x08842184, 0x00c42184, 0x08c42184,
+	0x00802174, 0x00802174, 0x08802174, 0x08802174, 0x00002164, 0x00002164, 0x00002164, 0x00002164,
+	0x00022104, 0x00022104, 0x00062184, 0x00462184, 0x00862184, 0x08862184, 0x00c62184, 0x08c62184,
+	0x00822174, 0x00822174, 0x08822174, 0x08822174, 0x00022164, 0x00022164, 0x00022164, 0x00022164,
+	0x00003104, 0x00003104, 0x00043184, 0x00443184, 0x00843184, 0x08843184, 0x00c43184, 0x08c43184,
+	0x00803174, 0x00803174, 0x08803174, 0x08803174, 0x00003164, 0x00003164, 0x00003164, 0x00003164,
+	0x00023104, 0x00023104, 0x00063184, 0x00463184, 0x00863184, 0x08863184, 0x00c63184, 0x08c63184,
+	0x00823174, 0x00823174, 0x08823174, 0x08823174, 0x00023164, 0x00023164, 0x00023164, 0x00023164,
+	0x00002003, 0x00002003, 0x00002003, 0x00002003, 0x00042073, 0x00042073, 0x00442073, 0x00442073,
+	0x00842073, 0x00842073, 0x08842073, 0x08842073, 0x00c42073, 0x00c42073, 0x08c42073, 0x08c42073,
+	0x00802063, 0x00802063, 0x00802063, 0x00802063, 0x08802063, 0x08802063, 0x08802063, 0x08802063,
+	0x00002053, 0x00002053, 0x00002053, 0x00002053, 0x00002053, 0x00002053, 0x00002053, 0x00002053,
+	0x00022003, 0x00022003, 0x00022003, 0x00022003, 0x00062073, 0x00062073, 0x00462073, 0x00462073,
+	0x00862073, 0x00862073, 0x08862073, 0x08862073, 0x00c62073, 0x00c62073, 0x08c62073, 0x08c62073,
+	0x00822063, 0x00822063, 0x00822063, 0x00822063, 0x08822063, 0x08822063, 0x08822063, 0x08822063,
+	0x00022053, 0x00022053, 0x00022053, 0x00022053, 0x00022053, 0x00022053, 0x00022053, 0x00022053,
+	0x00000002, 0x00000002, 0x00000002, 0x00000002, 0x00000002, 0x00000002, 0x00080082, 0x00480082,
+	0x00040062, 0x00040062, 0x00040062, 0x00040062, 0x00440062, 0x00440062, 0x00440062, 0x00440062,
+	0x00840062, 0x00840062, 0x00840062, 0x00840062, 0x08840062, 0x08840062, 0x08840062, 0x08840062,
+	0x00c40062, 0x00c40062, 0x00c40062, 0x00c40062, 0x08c40062, 0x08c40062, 0x08c40062, 0x08c40062,
+	0x00800052, 0x00800052, 0x00800052, 0x00800052, 0x00800052, 0x00800052, 0x00800052, 0x00800052,
+	0x08800052, 0x08800052, 0x08800052, 0x08800052, 0x08800052, 0x08800052, 0x08800052, 0x08800052,
+	0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042,
+	0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042,
+
+	/* huffMulti05[256] */
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00002308, 0x00022308, 0x00003308, 0x00023308,
+	0x00000000, 0x00000000, 0x00006008, 0x00026008, 0x00000308, 0x00001308, 0x00000000, 0x00000000,
+	0x00004108, 0x00024108, 0x00005108, 0x00025108, 0x00002208, 0x00022208, 0x00003208, 0x00023208,
+	0x00004007, 0x00004087, 0x00024007, 0x00024087, 0x00000207, 0x00000287, 0x00001207, 0x00001287,
+	0x00002105, 0x00002105, 0x00002105, 0x00002105, 0x00002165, 0x00002165, 0x00002165, 0x00002165,
+	0x00022105, 0x00022105, 0x00022105, 0x00022105, 0x00022165, 0x00022165, 0x00022165, 0x00022165,
+	0x00003105, 0x00003105, 0x00003105, 0x00003105, 0x00003165, 0x00003165, 0x00003165, 0x00003165,
+	0x00023105, 0x00023105, 0x00023105, 0x00023105, 0x00023165, 0x00023165, 0x00023165, 0x00023165,
+	0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00802084, 0x08802084, 0x00042084, 0x00442084,
+	0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054,
+	0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00822084, 0x08822084, 0x00062084, 0x00462084,
+	0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054,
+	0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00800184, 0x08800184, 0x00040184, 0x00440184,
+	0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154,
+	0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00801184, 0x08801184, 0x00041184, 0x00441184,
+	0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154,
+	0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001,
+	0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x01000081, 0x09000081, 0x00080081, 0x00480081,
+	0x00840061, 0x00840061, 0x00840061, 0x00840061, 0x08840061, 0x08840061, 0x08840061, 0x08840061,
+	0x00c40061, 0x00c40061, 0x00c40061, 0x00c40061, 0x08c40061, 0x08c40061, 0x08c40061, 0x08c40061,
+	0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051,
+	0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051,
+	0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051,
+	0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+
+	/* huffMulti06[256] */
+	0x00000000, 0x00000000, 0x00006008, 0x00026008, 0x00006208, 0x00026208, 0x00007208, 0x00027208,
+	0x00004308, 0x00024308, 0x00005308, 0x00025308, 0x00000307, 0x00000307, 0x00001307, 0x00001307,
+	0x00006107, 0x00006107, 0x00026107, 0x00026107, 0x00007107, 0x00007107, 0x00027107, 0x00027107,
+	0x00002307, 0x00002307, 0x00022307, 0x00022307, 0x00003307, 0x00003307, 0x00023307, 0x00023307,
+	0x00004207, 0x00004207, 0x00024207, 0x00024207, 0x00005207, 0x00005207, 0x00025207, 0x00025207,
+	0x00004006, 0x00004006, 0x00004006, 0x00004006, 0x00024006, 0x00024006, 0x00024006, 0x00024006,
+	0x00004106, 0x00004106, 0x00004106, 0x00004106, 0x00024106, 0x00024106, 0x00024106, 0x00024106,
+	0x00005106, 0x00005106, 0x00005106, 0x00005106, 0x00025106, 0x00025106, 0x00025106, 0x00025106,
+	0x00002206, 0x00002206, 0x00002206, 0x00002206, 0x00022206, 0x00022206, 0x00022206, 0x00022206,
+	0x00003206, 0x00003206, 0x00003206, 0x00003206, 0x00023206, 0x00023206, 0x00023206, 0x00023206,
+	0x00000205, 0x00000205, 0x00000205, 0x00000205, 0x00000205, 0x00000205, 0x00000205, 0x00000285,
+	0x00001205, 0x00001205, 0x00001205, 0x00001205, 0x00001205, 0x00001205, 0x00001205, 0x00001285,
+	0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00802084, 0x08802084,
+	0x00842084, 0x08842084, 0x00c42084, 0x08c42084, 0x00042084, 0x00442084, 0x00002074, 0x00002074,
+	0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00822084, 0x08822084,
+	0x00862084, 0x08862084, 0x00c62084, 0x08c62084, 0x00062084, 0x00462084, 0x00022074, 0x00022074,
+	0x00002104, 0x00002104, 0x00002104, 0x00002104, 0x00002104, 0x00002104, 0x00802184, 0x08802184,
+	0x00842184, 0x08842184, 0x00c42184, 0x08c42184, 0x00042184, 0x00442184, 0x00002174, 0x00002174,
+	0x00022104, 0x00022104, 0x00022104, 0x00022104, 0x00022104, 0x00022104, 0x00822184, 0x08822184,
+	0x00862184, 0x08862184, 0x00c62184, 0x08c62184, 0x00062184, 0x00462184, 0x00022174, 0x00022174,
+	0x00003104, 0x00003104, 0x00003104, 0x00003104, 0x00003104, 0x00003104, 0x00803184, 0x08803184,
+	0x00843184, 0x08843184, 0x00c43184, 0x08c43184, 0x00043184, 0x00443184, 0x00003174, 0x00003174,
+	0x00023104, 0x00023104, 0x00023104, 0x00023104, 0x00023104, 0x00023104, 0x00823184, 0x08823184,
+	0x00863184, 0x08863184, 0x00c63184, 0x08c63184, 0x00063184, 0x00463184, 0x00023174, 0x00023174,
+	0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00800184, 0x08800184,
+	0x00840184, 0x08840184, 0x00c40184, 0x08c40184, 0x00040184, 0x00440184, 0x00000174, 0x00000174,
+	0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00801184, 0x08801184,
+	0x00841184, 0x08841184, 0x00c41184, 0x08c41184, 0x00041184, 0x00441184, 0x00001174, 0x00001174,
+	0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003,
+	0x00000003, 0x00000003, 0x00080083, 0x00480083, 0x00800073, 0x00800073, 0x08800073, 0x08800073,
+	0x00840073, 0x00840073, 0x08840073, 0x08840073, 0x00c40073, 0x00c40073, 0x08c40073, 0x08c40073,
+	0x00040073, 0x00040073, 0x00440073, 0x00440073, 0x00000063, 0x00000063, 0x00000063, 0x00000063,
+
+	/* huffMulti07[256] */
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000408, 0x00001408,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000308, 0x00001308, 0x00000000, 0x00000000, 0x00004108, 0x00024108, 0x00005108, 0x00025108,
+	0x00002207, 0x00002287, 0x00022207, 0x00022287, 0x00003207, 0x00003287, 0x00023207, 0x00023287,
+	0x00004007, 0x00004087, 0x00024007, 0x00024087, 0x00000207, 0x00000287, 0x00001207, 0x00001287,
+	0x00002106, 0x00002106, 0x00002176, 0x00002176, 0x00022106, 0x00022106, 0x00022176, 0x00022176,
+	0x00003106, 0x00003106, 0x00003176, 0x00003176, 0x00023106, 0x00023106, 0x00023176, 0x00023176,
+	0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00802084, 0x08802084, 0x00042084, 0x00442084,
+	0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054,
+	0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00822084, 0x08822084, 0x00062084, 0x00462084,
+	0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054,
+	0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00800184, 0x08800184, 0x00040184, 0x00440184,
+	0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154,
+	0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00801184, 0x08801184, 0x00041184, 0x00441184,
+	0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154,
+	0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001,
+	0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001,
+	0x00880081, 0x08880081, 0x00c80081, 0x08c80081, 0x01000081, 0x09000081, 0x00080081, 0x00480081,
+	0x00840071, 0x00840071, 0x08840071, 0x08840071, 0x00c40071, 0x00c40071, 0x08c40071, 0x08c40071,
+	0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051,
+	0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051,
+	0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051,
+	0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+
+	/* huffMulti08[256] */
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00004208, 0x00024208, 0x00005208, 0x00025208,
+	0x00004007, 0x00004007, 0x00024007, 0x00024007, 0x00000207, 0x00000207, 0x00001207, 0x00001207,
+	0x00004106, 0x00004106, 0x00004106, 0x00004186, 0x00024106, 0x00024106, 0x00024106, 0x00024186,
+	0x00005106, 0x00005106, 0x00005106, 0x00005186, 0x00025106, 0x00025106, 0x00025106, 0x00025186,
+	0x00002206, 0x00002206, 0x00002206, 0x00002286, 0x00022206, 0x00022206, 0x00022206, 0x00022286,
+	0x00003206, 0x00003206, 0x00003206, 0x00003286, 0x00023206, 0x00023206, 0x00023206, 0x00023286,
+	0x00002104, 0x00002104, 0x00002104, 0x00002104, 0x00842184, 0x08842184, 0x00c42184, 0x08c42184,
+	0x00802184, 0x08802184, 0x00042184, 0x00442184, 0x00002164, 0x00002164, 0x00002164, 0x00002164,
+	0x00022104, 0x00022104, 0x00022104, 0x00022104, 0x00862184, 0x08862184, 0x00c62184, 0x08c62184,
+	0x00822184, 0x08822184, 0x00062184, 0x00462184, 0x00022164, 0x00022164, 0x00022164, 0x00022164,
+	0x00003104, 0x00003104, 0x00003104, 0x00003104, 0x00843184, 0x08843184, 0x00c43184, 0x08c43184,
+	0x00803184, 0x08803184, 0x00043184, 0x00443184, 0x00003164, 0x00003164, 0x00003164, 0x00003164,
+	0x00023104, 0x00023104, 0x00023104, 0x00023104, 0x00863184, 0x08863184, 0x00c63184, 0x08c63184,
+	0x00823184, 0x08823184, 0x00063184, 0x00463184, 0x00023164, 0x00023164, 0x00023164, 0x00023164,
+	0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00842084, 0x08842084, 0x00c42084, 0x08c42084,
+	0x00802084, 0x08802084, 0x00042084, 0x00442084, 0x00002064, 0x00002064, 0x00002064, 0x00002064,
+	0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00862084, 0x08862084, 0x00c62084, 0x08c62084,
+	0x00822084, 0x08822084, 0x00062084, 0x00462084, 0x00022064, 0x00022064, 0x00022064, 0x00022064,
+	0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00840184, 0x08840184, 0x00c40184, 0x08c40184,
+	0x00800184, 0x08800184, 0x00040184, 0x00440184, 0x00000164, 0x00000164, 0x00000164, 0x00000164,
+	0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00841184, 0x08841184, 0x00c41184, 0x08c41184,
+	0x00801184, 0x08801184, 0x00041184, 0x00441184, 0x00001164, 0x00001164, 0x00001164, 0x00001164,
+	0x00000002, 0x00000002, 0x00000002, 0x00000002, 0x00000002, 0x00000002, 0x00000002, 0x00000002,
+	0x01040082, 0x09040082, 0x01440082, 0x09440082, 0x00880082, 0x08880082, 0x00c80082, 0x08c80082,
+	0x00840062, 0x00840062, 0x00840062, 0x00840062, 0x08840062, 0x08840062, 0x08840062, 0x08840062,
+	0x00c40062, 0x00c40062, 0x00c40062, 0x00c40062, 0x08c40062, 0x08c40062, 0x08c40062, 0x08c40062,
+	0x00800062, 0x00800062, 0x00800062, 0x00800062, 0x08800062, 0x08800062, 0x08800062, 0x08800062,
+	0x00040062, 0x00040062, 0x00040062, 0x00040062, 0x00440062, 0x00440062, 0x00440062, 0x00440062,
+	0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042,
+	0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042,
+
+	/* huffMulti09[256] */
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000408, 0x00001408,
+	0x00008108, 0x00028108, 0x00009108, 0x00029108, 0x00002408, 0x00022408, 0x00003408, 0x00023408,
+	0x00006208, 0x00026208, 0x00007208, 0x00027208, 0x00004308, 0x00024308, 0x00005308, 0x00025308,
+	0x00006107, 0x00006107, 0x00026107, 0x00026107, 0x00007107, 0x00007107, 0x00027107, 0x00027107,
+	0x00002307, 0x00002307, 0x00022307, 0x00022307, 0x00003307, 0x00003307, 0x00023307, 0x00023307,
+	0x00006007, 0x00006007, 0x00026007, 0x00026007, 0x00000307, 0x00000307, 0x00001307, 0x00001307,
+	0x00004207, 0x00004207, 0x00024207, 0x00024207, 0x00005207, 0x00005207, 0x00025207, 0x00025207,
+	0x00004006, 0x00004006, 0x00004006, 0x00004006, 0x00024006, 0x00024006, 0x00024006, 0x00024006,
+	0x00004106, 0x00004106, 0x00004106, 0x00004106, 0x00024106, 0x00024106, 0x00024106, 0x00024106,
+	0x00005106, 0x00005106, 0x00005106, 0x00005106, 0x00025106, 0x00025106, 0x00025106, 0x00025106,
+	0x00002206, 0x00002206, 0x00002206, 0x00002206, 0x00022206, 0x00022206, 0x00022206, 0x00022206,
+	0x00003206, 0x00003206, 0x00003206, 0x00003206, 0x00023206, 0x00023206, 0x00023206, 0x00023206,
+	0x00000205, 0x00000205, 0x00000205, 0x00000205, 0x00000205, 0x00000205, 0x00000205, 0x00000285,
+	0x00001205, 0x00001205, 0x00001205, 0x00001205, 0x00001205, 0x00001205, 0x00001205, 0x00001285,
+	0x00002105, 0x00002105, 0x00002105, 0x00002105, 0x00002105, 0x00002105, 0x00002105, 0x00002185,
+	0x00022105, 0x00022105, 0x00022105, 0x00022105, 0x00022105, 0x00022105, 0x00022105, 0x00022185,
+	0x00003105, 0x00003105, 0x00003105, 0x00003105, 0x00003105, 0x00003105, 0x00003105, 0x00003185,
+	0x00023105, 0x00023105, 0x00023105, 0x00023105, 0x00023105, 0x00023105, 0x00023105, 0x00023185,
+	0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00002004,
+	0x00002004, 0x00002004, 0x00802084, 0x08802084, 0x00042084, 0x00442084, 0x00002074, 0x00002074,
+	0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00022004,
+	0x00022004, 0x00022004, 0x00822084, 0x08822084, 0x00062084, 0x00462084, 0x00022074, 0x00022074,
+	0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104,
+	0x00000104, 0x00000104, 0x00800184, 0x08800184, 0x00040184, 0x00440184, 0x00000174, 0x00000174,
+	0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104,
+	0x00001104, 0x00001104, 0x00801184, 0x08801184, 0x00041184, 0x00441184, 0x00001174, 0x00001174,
+	0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003,
+	0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00080083, 0x00480083,
+	0x00840083, 0x08840083, 0x00c40083, 0x08c40083, 0x00800073, 0x00800073, 0x08800073, 0x08800073,
+	0x00040073, 0x00040073, 0x00440073, 0x00440073, 0x00000063, 0x00000063, 0x00000063, 0x00000063,
+
+	/* huffMulti10[256] */
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000308, 0x00001308, 0x00000000, 0x00000000,
+	0x00004108, 0x00024108, 0x00005108, 0x00025108, 0x00002208, 0x00022208, 0x00003208, 0x00023208,
+	0x00004007, 0x00004087, 0x00024007, 0x00024087, 0x00000207, 0x00000287, 0x00001207, 0x00001287,
+	0x00002106, 0x00002106, 0x00002176, 0x00002176, 0x00022106, 0x00022106, 0x00022176, 0x00022176,
+	0x00003106, 0x00003106, 0x00003176, 0x00003176, 0x00023106, 0x00023106, 0x00023176, 0x00023176,
+	0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00802084, 0x08802084, 0x00042084, 0x00442084,
+	0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054, 0x00002054,
+	0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00822084, 0x08822084, 0x00062084, 0x00462084,
+	0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054, 0x00022054,
+	0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00800184, 0x08800184, 0x00040184, 0x00440184,
+	0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154,
+	0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00801184, 0x08801184, 0x00041184, 0x00441184,
+	0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154,
+	0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001,
+	0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001,
+	0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x01000081, 0x09000081, 0x00080081, 0x00480081,
+	0x00840071, 0x00840071, 0x08840071, 0x08840071, 0x00c40071, 0x00c40071, 0x08c40071, 0x08c40071,
+	0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051, 0x00800051,
+	0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051, 0x08800051,
+	0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051,
+	0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+
+	/* huffMulti11[256] */
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00006108, 0x00026108, 0x00007108, 0x00027108, 0x00002308, 0x00022308, 0x00003308, 0x00023308,
+	0x00006008, 0x00026008, 0x00000308, 0x00001308, 0x00004208, 0x00024208, 0x00005208, 0x00025208,
+	0x00002207, 0x00002207, 0x00022207, 0x00022207, 0x00003207, 0x00003207, 0x00023207, 0x00023207,
+	0x00004106, 0x00004106, 0x00004106, 0x00004186, 0x00024106, 0x00024106, 0x00024106, 0x00024186,
+	0x00005106, 0x00005106, 0x00005106, 0x00005186, 0x00025106, 0x00025106, 0x00025106, 0x00025186,
+	0x00004006, 0x00004006, 0x00004006, 0x00004086, 0x00024006, 0x00024006, 0x00024006, 0x00024086,
+	0x00000206, 0x00000206, 0x00000206, 0x00000286, 0x00001206, 0x00001206, 0x00001206, 0x00001286,
+	0x00002105, 0x00002105, 0x00002105, 0x00002105, 0x00002105, 0x00002105, 0x00002175, 0x00002175,
+	0x00022105, 0x00022105, 0x00022105, 0x00022105, 0x00022105, 0x00022105, 0x00022175, 0x00022175,
+	0x00003105, 0x00003105, 0x00003105, 0x00003105, 0x00003105, 0x00003105, 0x00003175, 0x00003175,
+	0x00023105, 0x00023105, 0x00023105, 0x00023105, 0x00023105, 0x00023105, 0x00023175, 0x00023175,
+	0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00002004,
+	0x00802084, 0x08802084, 0x00042084, 0x00442084, 0x00002064, 0x00002064, 0x00002064, 0x00002064,
+	0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00022004,
+	0x00822084, 0x08822084, 0x00062084, 0x00462084, 0x00022064, 0x00022064, 0x00022064, 0x00022064,
+	0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104,
+	0x00800184, 0x08800184, 0x00040184, 0x00440184, 0x00000164, 0x00000164, 0x00000164, 0x00000164,
+	0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104,
+	0x00801184, 0x08801184, 0x00041184, 0x00441184, 0x00001164, 0x00001164, 0x00001164, 0x00001164,
+	0x00000002, 0x00000002, 0x00000002, 0x00000002, 0x00000002, 0x00000002, 0x00000002, 0x00000002,
+	0x00000002, 0x00000002, 0x00000002, 0x00000002, 0x00000002, 0x00000002, 0x00000002, 0x00000002,
+	0x01040082, 0x09040082, 0x01440082, 0x09440082, 0x01000082, 0x09000082, 0x00080082, 0x00480082,
+	0x00840072, 0x00840072, 0x08840072, 0x08840072, 0x00c40072, 0x00c40072, 0x08c40072, 0x08c40072,
+	0x00800062, 0x00800062, 0x00800062, 0x00800062, 0x08800062, 0x08800062, 0x08800062, 0x08800062,
+	0x00040062, 0x00040062, 0x00040062, 0x00040062, 0x00440062, 0x00440062, 0x00440062, 0x00440062,
+	0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042,
+	0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042, 0x00000042,
+
+	/* huffMulti12[256] */
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00006308, 0x00026308, 0x00007308, 0x00027308, 0x00002408, 0x00022408, 0x00003408, 0x00023408,
+	0x00006208, 0x00026208, 0x00007208, 0x00027208, 0x00004308, 0x00024308, 0x00005308, 0x00025308,
+	0x00000408, 0x00001408, 0x00006008, 0x00026008, 0x00000307, 0x00000307, 0x00001307, 0x00001307,
+	0x00006107, 0x00006107, 0x00026107, 0x00026107, 0x00007107, 0x00007107, 0x00027107, 0x00027107,
+	0x00002307, 0x00002307, 0x00022307, 0x00022307, 0x00003307, 0x00003307, 0x00023307, 0x00023307,
+	0x00004207, 0x00004207, 0x00024207, 0x00024207, 0x00005207, 0x00005207, 0x00025207, 0x00025207,
+	0x00004106, 0x00004106, 0x00004106, 0x00004106, 0x00024106, 0x00024106, 0x00024106, 0x00024106,
+	0x00005106, 0x00005106, 0x00005106, 0x00005106, 0x00025106, 0x00025106, 0x00025106, 0x00025106,
+	0x00002206, 0x00002206, 0x00002206, 0x00002206, 0x00022206, 0x00022206, 0x00022206, 0x00022206,
+	0x00003206, 0x00003206, 0x00003206, 0x00003206, 0x00023206, 0x00023206, 0x00023206, 0x00023206,
+	0x00004006, 0x00004006, 0x00004006, 0x00004006, 0x00024006, 0x00024006, 0x00024006, 0x00024006,
+	0x00000206, 0x00000206, 0x00000206, 0x00000206, 0x00001206, 0x00001206, 0x00001206, 0x00001206,
+	0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004,
+	0x00000004, 0x00000084, 0x00000004, 0x00000004, 0x00800084, 0x08800084, 0x00040084, 0x00440084,
+	0x00002105, 0x00002105, 0x00002105, 0x00002105, 0x00002105, 0x00002105, 0x00002105, 0x00002105,
+	0x00022105, 0x00022105, 0x00022105, 0x00022105, 0x00022105, 0x00022105, 0x00022105, 0x00022105,
+	0x00003105, 0x00003105, 0x00003105, 0x00003105, 0x00003105, 0x00003105, 0x00003105, 0x00003105,
+	0x00023105, 0x00023105, 0x00023105, 0x00023105, 0x00023105, 0x00023105, 0x00023105, 0x00023105,
+	0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00002004, 0x00002004,
+	0x00002004, 0x00002084, 0x00002004, 0x00002004, 0x00802084, 0x08802084, 0x00042084, 0x00442084,
+	0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00022004, 0x00022004,
+	0x00022004, 0x00022084, 0x00022004, 0x00022004, 0x00822084, 0x08822084, 0x00062084, 0x00462084,
+	0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104,
+	0x00000104, 0x00000184, 0x00000104, 0x00000104, 0x00800184, 0x08800184, 0x00040184, 0x00440184,
+	0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104,
+	0x00001104, 0x00001184, 0x00001104, 0x00001104, 0x00801184, 0x08801184, 0x00041184, 0x00441184,
+
+	/* huffMulti13[256] */
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00006008, 0x00026008, 0x00000308, 0x00001308, 0x00000000, 0x00000000,
+	0x00004108, 0x00024108, 0x00005108, 0x00025108, 0x00002208, 0x00022208, 0x00003208, 0x00023208,
+	0x00004007, 0x00004087, 0x00024007, 0x00024087, 0x00000207, 0x00000287, 0x00001207, 0x00001287,
+	0x00002106, 0x00002106, 0x00002176, 0x00002176, 0x00022106, 0x00022106, 0x00022176, 0x00022176,
+	0x00003106, 0x00003106, 0x00003176, 0x00003176, 0x00023106, 0x00023106, 0x00023176, 0x00023176,
+	0x00002005, 0x00002005, 0x00002005, 0x00002005, 0x00002065, 0x00002065, 0x00002065, 0x00002065,
+	0x00022005, 0x00022005, 0x00022005, 0x00022005, 0x00022065, 0x00022065, 0x00022065, 0x00022065,
+	0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00040184, 0x00440184,
+	0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154,
+	0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00041184, 0x00441184,
+	0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154,
+	0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001,
+	0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001,
+	0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001,
+	0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x01000081, 0x09000081, 0x00080081, 0x00480081,
+	0x00840071, 0x00840071, 0x08840071, 0x08840071, 0x00c40071, 0x00c40071, 0x08c40071, 0x08c40071,
+	0x00800061, 0x00800061, 0x00800061, 0x00800061, 0x08800061, 0x08800061, 0x08800061, 0x08800061,
+	0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051,
+	0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+
+	/* huffMulti15[256] */
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00002408, 0x00022408, 0x00003408, 0x00023408, 0x00000000, 0x00000000, 0x00008008, 0x00028008,
+	0x00006208, 0x00026208, 0x00007208, 0x00027208, 0x00004308, 0x00024308, 0x00005308, 0x00025308,
+	0x00000408, 0x00001408, 0x00006008, 0x00026008, 0x00006108, 0x00026108, 0x00007108, 0x00027108,
+	0x00002308, 0x00022308, 0x00003308, 0x00023308, 0x00000307, 0x00000307, 0x00001307, 0x00001307,
+	0x00004207, 0x00004207, 0x00024207, 0x00024207, 0x00005207, 0x00005207, 0x00025207, 0x00025207,
+	0x00004107, 0x00004107, 0x00024107, 0x00024107, 0x00005107, 0x00005107, 0x00025107, 0x00025107,
+	0x00002207, 0x00002207, 0x00022207, 0x00022207, 0x00003207, 0x00003207, 0x00023207, 0x00023207,
+	0x00004006, 0x00004006, 0x00004006, 0x00004006, 0x00024006, 0x00024006, 0x00024006, 0x00024006,
+	0x00000206, 0x00000206, 0x00000206, 0x00000206, 0x00001206, 0x00001206, 0x00001206, 0x00001206,
+	0x00002105, 0x00002105, 0x00002105, 0x00002105, 0x00002105, 0x00002105, 0x00002105, 0x00002185,
+	0x00022105, 0x00022105, 0x00022105, 0x00022105, 0x00022105, 0x00022105, 0x00022105, 0x00022185,
+	0x00003105, 0x00003105, 0x00003105, 0x00003105, 0x00003105, 0x00003105, 0x00003105, 0x00003185,
+	0x00023105, 0x00023105, 0x00023105, 0x00023105, 0x00023105, 0x00023105, 0x00023105, 0x00023185,
+	0x00002005, 0x00002005, 0x00002005, 0x00002005, 0x00002005, 0x00002005, 0x00002005, 0x00002085,
+	0x00022005, 0x00022005, 0x00022005, 0x00022005, 0x00022005, 0x00022005, 0x00022005, 0x00022085,
+	0x00000105, 0x00000105, 0x00000105, 0x00000105, 0x00000105, 0x00000105, 0x00000105, 0x00000185,
+	0x00001105, 0x00001105, 0x00001105, 0x00001105, 0x00001105, 0x00001105, 0x00001105, 0x00001185,
+	0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003,
+	0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00000003,
+	0x00000003, 0x00000003, 0x00000003, 0x00000003, 0x00840083, 0x08840083, 0x00c40083, 0x08c40083,
+	0x00800083, 0x08800083, 0x00040083, 0x00440083, 0x00000063, 0x00000063, 0x00000063, 0x00000063,
+
+	/* huffMulti16[256] */
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00004108, 0x00024108, 0x00005108, 0x00025108, 0x00002208, 0x00022208, 0x00003208, 0x00023208,
+	0x00004007, 0x00004087, 0x00024007, 0x00024087, 0x00000207, 0x00000287, 0x00001207, 0x00001287,
+	0x00002106, 0x00002106, 0x00002176, 0x00002176, 0x00022106, 0x00022106, 0x00022176, 0x00022176,
+	0x00003106, 0x00003106, 0x00003176, 0x00003176, 0x00023106, 0x00023106, 0x00023176, 0x00023176,
+	0x00002005, 0x00002005, 0x00002005, 0x00002005, 0x00002065, 0x00002065, 0x00002065, 0x00002065,
+	0x00022005, 0x00022005, 0x00022005, 0x00022005, 0x00022065, 0x00022065, 0x00022065, 0x00022065,
+	0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00000104, 0x00040184, 0x00440184,
+	0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154, 0x00000154,
+	0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00001104, 0x00041184, 0x00441184,
+	0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154, 0x00001154,
+	0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001,
+	0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001,
+	0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001,
+	0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x01000081, 0x09000081, 0x00080081, 0x00480081,
+	0x00840071, 0x00840071, 0x08840071, 0x08840071, 0x00c40071, 0x00c40071, 0x08c40071, 0x08c40071,
+	0x00800061, 0x00800061, 0x00800061, 0x00800061, 0x08800061, 0x08800061, 0x08800061, 0x08800061,
+	0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051, 0x00040051,
+	0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051, 0x00440051,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+
+	/* huffMulti24[256] */
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00006108, 0x00026108, 0x00007108, 0x00027108, 0x00002308, 0x00022308, 0x00003308, 0x00023308,
+	0x00006008, 0x00026008, 0x00000308, 0x00001308, 0x00004208, 0x00024208, 0x00005208, 0x00025208,
+	0x00004107, 0x00004107, 0x00024107, 0x00024107, 0x00005107, 0x00005107, 0x00025107, 0x00025107,
+	0x00002207, 0x00002207, 0x00022207, 0x00022207, 0x00003207, 0x00003207, 0x00023207, 0x00023207,
+	0x00004007, 0x00004007, 0x00024007, 0x00024007, 0x00000207, 0x00000207, 0x00001207, 0x00001207,
+	0x00002106, 0x00002106, 0x00002106, 0x00002106, 0x00022106, 0x00022106, 0x00022106, 0x00022106,
+	0x00003106, 0x00003106, 0x00003106, 0x00003106, 0x00023106, 0x00023106, 0x00023106, 0x00023106,
+	0x00002005, 0x00002005, 0x00002005, 0x00002005, 0x00002005, 0x00002005, 0x00002005, 0x00002005,
+	0x00022005, 0x00022005, 0x00022005, 0x00022005, 0x00022005, 0x00022005, 0x00022005, 0x00022005,
+	0x00000105, 0x00000105, 0x00000105, 0x00000105, 0x00000105, 0x00000105, 0x00000105, 0x00000105,
+	0x00001105, 0x00001105, 0x00001105, 0x00001105, 0x00001105, 0x00001105, 0x00001105, 0x00001105,
+	0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004,
+	0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000084,
+};
+
+const int huffMultiOffset[HUFF_PAIRTABS] = {
+	0,
+	0,
+	256,
+	512,
+	0,
+	768,
+	1024,
+	1280,
+	1536,
+	1792,
+	2048,
+	2304,
+	2560,
+	2816,
+	0,
+	3072,
+	3328,
+	3328,
+	3328,
+	3328,
+	3328,
+	3328,
+	3328,
+	3328,
+	3584,
+	3584,
+	3584,
+	3584,
+	3584,
+	3584,
+	3584,
+	3584,
+};
+
+const unsigned int quadMultiTable[2 << HUFF_MULTI_BITS] = {
+	/* table A[256] */
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00004408, 0x0000c408, 0x00004c08, 0x0000cc08,
+	0x00004107, 0x00004187, 0x0000c107, 0x0000c187, 0x00004307, 0x00004387, 0x0000c307, 0x0000c387,
+	0x00001407, 0x00001487, 0x00003407, 0x00003487, 0x00001c07, 0x00001c87, 0x00003c07, 0x00003c87,
+	0x00005007, 0x00005087, 0x0000d007, 0x0000d087, 0x00007007, 0x00007087, 0x0000f007, 0x0000f087,
+	0x00001107, 0x00001187, 0x00003107, 0x00003187, 0x00001307, 0x00001387, 0x00003307, 0x00003387,
+	0x00000507, 0x00000587, 0x00000d07, 0x00000d87, 0x00000707, 0x00000787, 0x00000f07, 0x00000f87,
+	0x00001005, 0x00001005, 0x00001005, 0x00001005, 0x00001065, 0x00001065, 0x00001065, 0x00001065,
+	0x00003005, 0x00003005, 0x00003005, 0x00003005, 0x00003065, 0x00003065, 0x00003065, 0x00003065,
+	0x00004005, 0x00004005, 0x00004005, 0x00004005, 0x00004065, 0x00004065, 0x00004065, 0x00004065,
+	0x0000c005, 0x0000c005, 0x0000c005, 0x0000c005, 0x0000c065, 0x0000c065, 0x0000c065, 0x0000c065,
+	0x00000405, 0x00000405, 0x00000405, 0x00000405, 0x00000465, 0x00000465, 0x00000465, 0x00000465,
+	0x00000c05, 0x00000c05, 0x00000c05, 0x00000c05, 0x00000c65, 0x00000c65, 0x00000c65, 0x00000c65,
+	0x00000105, 0x00000105, 0x00000105, 0x00000105, 0x00000165, 0x00000165, 0x00000165, 0x00000165,
+	0x00000305, 0x00000305, 0x00000305, 0x00000305, 0x00000365, 0x00000365, 0x00000365, 0x00000365,
+	0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00000001,
+	0x00000001, 0x00000001, 0x00000001, 0x00000001, 0x00410081, 0x00c10081, 0x00430081, 0x00c30081,
+	0x00140081, 0x00340081, 0x001c0081, 0x003c0081, 0x00500081, 0x00d00081, 0x00700081, 0x00f00081,
+	0x00110081, 0x00310081, 0x00130081, 0x00330081, 0x00050081, 0x000d0081, 0x00070081, 0x000f0081,
+	0x00100061, 0x00100061, 0x00100061, 0x00100061, 0x00300061, 0x00300061, 0x00300061, 0x00300061,
+	0x00400061, 0x00400061, 0x00400061, 0x00400061, 0x00c00061, 0x00c00061, 0x00c00061, 0x00c00061,
+	0x00040061, 0x00040061, 0x00040061, 0x00040061, 0x000c0061, 0x000c0061, 0x000c0061, 0x000c0061,
+	0x00010061, 0x00010061, 0x00010061, 0x00010061, 0x00030061, 0x00030061, 0x00030061, 0x00030061,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+	0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021, 0x00000021,
+
+	/* table B[256] */
+	0x00005508, 0x0000d508, 0x00007508, 0x0000f508, 0x00005d08, 0x0000dd08, 0x00007d08, 0x0000fd08,
+	0x00005708, 0x0000d708, 0x00007708, 0x0000f708, 0x00005f08, 0x0000df08, 0x00007f08, 0x0000ff08,
+	0x00001507, 0x00001507, 0x00003507, 0x00003507, 0x00001d07, 0x00001d07, 0x00003d07, 0x00003d07,
+	0x00001707, 0x00001707, 0x00003707, 0x00003707, 0x00001f07, 0x00001f07, 0x00003f07, 0x00003f07,
+	0x00004507, 0x00004507, 0x0000c507, 0x0000c507, 0x00004d07, 0x00004d07, 0x0000cd07, 0x0000cd07,
+	0x00004707, 0x00004707, 0x0000c707, 0x0000c707, 0x00004f07, 0x00004f07, 0x0000cf07, 0x0000cf07,
+	0x00000506, 0x00000506, 0x00000506, 0x00000506, 0x00000d06, 0x00000d06, 0x00000d06, 0x00000d06,
+	0x00000706, 0x00000706, 0x00000706, 0x00000706, 0x00000f06, 0x00000f06, 0x00000f06, 0x00000f06,
+	0x00005107, 0x00005107, 0x0000d107, 0x0000d107, 0x00007107, 0x00007107, 0x0000f107, 0x0000f107,
+	0x00005307, 0x00005307, 0x0000d307, 0x0000d307, 0x00007307, 0x00007307, 0x0000f307, 0x0000f307,
+	0x00001106, 0x00001106, 0x00001106, 0x00001106, 0x00003106, 0x00003106, 0x00003106, 0x00003106,
+	0x00001306, 0x00001306, 0x00001306, 0x00001306, 0x00003306, 0x00003306, 0x00003306, 0x00003306,
+	0x00004106, 0x00004106, 0x00004106, 0x00004106, 0x0000c106, 0x0000c106, 0x0000c106, 0x0000c106,
+	0x00004306, 0x00004306, 0x00004306, 0x00004306, 0x0000c306, 0x0000c306, 0x0000c306, 0x0000c306,
+	0x00000105, 0x00000105, 0x00000105, 0x00000105, 0x00000105, 0x00000105, 0x00000105, 0x00000105,
+	0x00000305, 0x00000305, 0x00000305, 0x00000305, 0x00000305, 0x00000305, 0x00000305, 0x00000305,
+	0x00005407, 0x00005407, 0x0000d407, 0x0000d407, 0x00007407, 0x00007407, 0x0000f407, 0x0000f407,
+	0x00005c07, 0x00005c07, 0x0000dc07, 0x0000dc07, 0x00007c07, 0x00007c07, 0x0000fc07, 0x0000fc07,
+	0x00001406, 0x00001406, 0x00001406, 0x00001406, 0x00003406, 0x00003406, 0x00003406, 0x00003406,
+	0x00001c06, 0x00001c06, 0x00001c06, 0x00001c06, 0x00003c06, 0x00003c06, 0x00003c06, 0x00003c06,
+	0x00004406, 0x00004406, 0x00004406, 0x00004406, 0x0000c406, 0x0000c406, 0x0000c406, 0x0000c406,
+	0x00004c06, 0x00004c06, 0x00004c06, 0x00004c06, 0x0000cc06, 0x0000cc06, 0x0000cc06, 0x0000cc06,
+	0x00000405, 0x00000405, 0x00000405, 0x00000405, 0x00000405, 0x00000405, 0x00000405, 0x00000405,
+	0x00000c05, 0x00000c05, 0x00000c05, 0x00000c05, 0x00000c05, 0x00000c05, 0x00000c05, 0x00000c05,
+	0x00005006, 0x00005006, 0x00005006, 0x00005006, 0x0000d006, 0x0000d006, 0x0000d006, 0x0000d006,
+	0x00007006, 0x00007006, 0x00007006, 0x00007006, 0x0000f006, 0x0000f006, 0x0000f006, 0x0000f006,
+	0x00001005, 0x00001005, 0x00001005, 0x00001005, 0x00001005, 0x00001005, 0x00001005, 0x00001005,
+	0x00003005, 0x00003005, 0x00003005, 0x00003005, 0x00003005, 0x00003005, 0x00003005, 0x00003005,
+	0x00004005, 0x00004005, 0x00004005, 0x00004005, 0x00004005, 0x00004005, 0x00004005, 0x00004005,
+	0x0000c005, 0x0000c005, 0x0000c005, 0x0000c005, 0x0000c005, 0x0000c005, 0x0000c005, 0x0000c005,
+	0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004,
+	0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000004, 0x00000084,
+};
@@ -45,6 +45,13 @@
 #include "coder.h"
 //#include "assembly.h"
 
+/* long blocks with window type 0 and short blocks in assembly on ARM (asmimdct_thumb2.S),
+ * unless MP3_IMDCT_C is defined in mp3dec.h
+ */
+#if defined(__arm__) && !defined(MP3_IMDCT_C)
+#define IMDCT_THUMB2
+#endif
+
 /**************************************************************************************
  * Function:    AntiAlias
  *
@@ -68,6 +75,8 @@
  *              assume at least 1 guard bit in x[] to avoid overflow
  *                (should be guaranteed from dequant, and max gain from stproc * max 
  *                 gain from AntiAlias < 2.0)
+ *              HybridTransform() calls this with nBfly = 1 right before the IMDCT of
+ *                each long block, for the boundary above it
  **************************************************************************************/
 // a little bit faster in RAM (< 1 ms per block)
 /* __attribute__ ((section (".data"))) */ static void AntiAlias(int *x, int nBfly)
@@ -656,7 +665,7 @@ static __inline void imdct12 (int *x, int *out)
 /**************************************************************************************
  * Function:    HybridTransform
  *
- * Description: IMDCT's, windowing, and overlap-add on long/short/mixed blocks
+ * Description: antialias, IMDCT's, windowing, and overlap-add on long/short/mixed blocks
  *
  * Inputs:      vector of input coefficients, length = nBlocksTotal * 18)
  *              vector of overlap samples from last time, length = nBlocksPrev * 9)
@@ -671,6 +680,8 @@ static __inline void imdct12 (int *x, int *out)
  * Outputs:     transformed, windowed, and overlapped sample buffer
  *              does frequency inversion on odd blocks
  *              updated buffer of samples for overlap
+ *              number of leading subbands of y that can be non-zero in bc->nBlocksActive,
+ *                the rest are cleared (lets Subband() skip silent ones)
  *
  * Return:      number of non-zero IMDCT blocks calculated in this call
  *                (including overlap-add)
@@ -680,7 +691,7 @@ static __inline void imdct12 (int *x, int *out)
 /* __attribute__ ((section (".data"))) */ static int HybridTransform(int *xCurr, int *xPrev, int y[BLOCK_SIZE][NBANDS], SideInfoSub *sis, BlockCount *bc)
 {
 	int xPrevWin[18], currWinIdx, prevWinIdx;
-	int i, j, nBlocksOut, nonZero, mOut;
+	int i, j, nBfly, nBlocksOut, nonZero, mOut;
 	int fiBit, xp;
 
 	ASSERT(bc->nBlocksLong  <= NBANDS);
@@ -689,7 +700,11 @@ static __inline void imdct12 (int *x, int *out)
 
 	mOut = 0;
 
-	/* do long blocks, if any */
+	/* do long blocks, if any
+	 * antialias across the upper edge of each long block just before its IMDCT (the lower edge 
+	 *   was done with the previous block), so the block is only read once
+	 */
+	nBfly = bc->nBlocksLong - 1;
 	for(i = 0; i < bc->nBlocksLong; i++) {
 		/* currWinIdx picks the right window for long blocks (if mixed, long blocks use window type 0) */
 		currWinIdx = sis->blockType;
@@ -701,7 +716,16 @@ static __inline void imdct12 (int *x, int *out)
 			 prevWinIdx = 0;
 
 		/* do 36-point IMDCT, including windowing and overlap-add */
-		mOut |= IMDCT36(xCurr, xPrev, &(y[0][i]), currWinIdx, prevWinIdx, i, bc->gbIn);
+#ifdef IMDCT_THUMB2
+		if (currWinIdx == 0 && prevWinIdx == 0 && bc->gbIn >= 7) {
+			mOut |= AntiAliasIMDCT36Thumb2(xCurr, xPrev, &(y[0][i]), i, (i < nBfly));
+		} else
+#endif
+		{
+			if (i < nBfly)
+				AntiAlias(xCurr, 1);
+			mOut |= IMDCT36(xCurr, xPrev, &(y[0][i]), currWinIdx, prevWinIdx, i, bc->gbIn);
+		}
 		xCurr += 18;
 		xPrev += 9;
 	}
@@ -714,11 +738,17 @@ static __inline void imdct12 (int *x, int *out)
 		if (i < bc->prevWinSwitch)
 			 prevWinIdx = 0;
 		
+#ifdef IMDCT_THUMB2
+		if (bc->gbIn >= 7)
+			mOut |= IMDCT12x3Thumb2(xCurr, xPrev, &(y[0][i]), prevWinIdx, i);
+		else
+#endif
 		mOut |= IMDCT12x3(xCurr, xPrev, &(y[0][i]), prevWinIdx, i, bc->gbIn);
 		xCurr += 18;
 		xPrev += 9;
 	}
 	nBlocksOut = i;
+	bc->nBlocksActive = i;
 	
 	/* window and overlap prev if prev longer that current */
 	for (   ; i < bc->nBlocksPrev; i++) {
@@ -745,8 +775,10 @@ static __inline void imdct12 (int *x, int *out)
 			xPrev[j] = 0;
 		}
 		xPrev += 9;
-		if (nonZero)
+		if (nonZero) {
 			nBlocksOut = i;
+			bc->nBlocksActive = i + 1;
+		}
 	}
 	
 	/* clear rest of blocks */
@@ -756,6 +788,8 @@ static __inline void imdct12 (int *x, int *out)
 	}
 
 	bc->gbOut = CLZ(mOut) - 1;
+	if (mOut == 0)
+		bc->nBlocksActive = 0;	/* silent granule, at least one block is always transformed */
 
 	return nBlocksOut;
 }
@@ -817,7 +851,15 @@ static __inline void imdct12 (int *x, int *out)
 		nBfly = 0;
 	}
  
-	AntiAlias(hi->huffDecBuf[ch], nBfly);
+#ifdef MP3_FRAME_STATS
+	mp3DecInfo->frameStats.modeExt = fh->modeExt;
+	mp3DecInfo->frameStats.blockType[gr][ch] = si->sis[gr][ch].blockType;
+	mp3DecInfo->frameStats.mixedBlock[gr][ch] = si->sis[gr][ch].mixedBlock;
+	mp3DecInfo->frameStats.part23Length[gr][ch] = si->sis[gr][ch].part23Length;
+	mp3DecInfo->frameStats.nonZeroBound[gr][ch] = hi->nonZeroBound[ch];
+#endif
+
+	/* AntiAlias() is done block by block in HybridTransform(), nBfly = bc.nBlocksLong - 1 */
 	hi->nonZeroBound[ch] = MAX(hi->nonZeroBound[ch], (nBfly * 18) + 8);
 
 	ASSERT(hi->nonZeroBound[ch] <= MAX_NSAMP);
@@ -834,8 +876,12 @@ static __inline void imdct12 (int *x, int *out)
 	mi->prevType[ch] = si->sis[gr][ch].blockType;
 	mi->prevWinSwitch[ch] = bc.currWinSwitch;		/* 0 means not a mixed block (either all short or all long) */
 	mi->gb[ch] = bc.gbOut;
+	mi->numActive[ch] = bc.nBlocksActive;
 
 	ASSERT(mi->numPrevIMDCT[ch] <= NBANDS);
+#ifdef MP3_FRAME_STATS
+	mp3DecInfo->frameStats.nIMDCT[gr][ch] = mi->numPrevIMDCT[ch];
+#endif
 
 	/* output has gained 2 int bits */
 	return 0;
@@ -51,15 +51,22 @@
 #define NGRANS_MPEG1	2
 #define NGRANS_MPEG2	1
 
-/* 11-bit syncword if MPEG 2.5 extensions are enabled */
-/*
+/* 11-bit syncword if MPEG 2.5 extensions are enabled
+ *   (the reserved version 01 that it lets through is rejected with the header)
+ */
 #define	SYNCWORDH		0xff
 #define	SYNCWORDL		0xe0
-*/
 
 /* 12-bit syncword if MPEG 1,2 only are supported */
+/*
 #define	SYNCWORDH		0xff
 #define	SYNCWORDL		0xf0
+*/
+
+/* frame header bits which stay the same from frame to frame: sync, version, layer, CRC flag,
+ *   sample rate and channel mode (bitrate, padding, mode extension and the flags may change)
+ */
+#define	HDR_FIXED_MASK	0xffff0cc0
 
 typedef struct _MP3DecInfo {
 	/* pointers to platform-specific data structures */
@@ -87,14 +94,32 @@ typedef struct _MP3DecInfo {
 	int nSlots;
 	int layer;
 	MPEGVersion version;
+	unsigned int fixedHdr;	/* HDR_FIXED_MASK bits of the last valid frame header, 0 = none yet */
 
 	int mainDataBegin;
 	int mainDataBytes;
 
 	int part23Length[MAX_NGRAN][MAX_NCHAN];
 
+#ifdef MP3_STAGE_STATS
+	MP3StageStats stageStats;
+#endif
+#ifdef MP3_FRAME_STATS
+	MP3FrameStats frameStats;
+#endif
+#ifdef MP3_STACK_STATS
+	int stackPeak;
+#endif
+
 } MP3DecInfo;
 
+/* where Subband() writes the PCM samples of a frame */
+typedef struct _PCMOut {
+	short *buf;			/* interleaved LRLRLR..., 0 for planar output */
+	short *left;		/* planar: left (or mono) channel */
+	short *right;		/* planar: right channel */
+} PCMOut;
+
 typedef struct _SFBandTable {
 	short l[23];
 	short s[14];
@@ -110,7 +135,7 @@ int DecodeHuffman(MP3DecInfo *mp3DecInfo, unsigned char *buf, int *bitOffset, in
 int Dequantize(MP3DecInfo *mp3DecInfo, int gr);
 int IMDCT(MP3DecInfo *mp3DecInfo, int gr, int ch);
 int UnpackScaleFactors(MP3DecInfo *mp3DecInfo, unsigned char *buf, int *bitOffset, int bitsAvail, int gr, int ch);
-int Subband(MP3DecInfo *mp3DecInfo, short *pcmBuf);
+int Subband(MP3DecInfo *mp3DecInfo, PCMOut *pcmOut, int gr);
 
 /* mp3tabs.c - global ROM tables */
 extern const int samplerateTab[3][3];
@@ -45,10 +45,30 @@
 //#include "hlxclib/string.h"		/* for memmove, memcpy (can replace with different implementations if desired) */
 #include "mp3common.h"	/* includes mp3dec.h (public API) and internal, platform-independent API */
 
+#define MAX_MAINDATA_BEGIN	511		/* 9-bit mainDataBegin (MPEG 1), see MAINBUF_SIZE */
+#define MP3HeaderWord(b)	(((unsigned int)(b)[0] << 24) | ((unsigned int)(b)[1] << 16) | ((unsigned int)(b)[2] << 8) | ((unsigned int)(b)[3] << 0))	/* first byte in the MSB */
 
-//#define PROFILE
-#ifdef PROFILE
-#include "systime.h"
+#ifdef MP3_STAGE_STATS
+#define STAGE_START()		stageTime = CYCLES()
+#define STAGE_END(stage)	MP3AddStageTime(mp3DecInfo, stage, stageTime)
+
+static void MP3AddStageTime(MP3DecInfo *mp3DecInfo, int stage, unsigned int start)
+{
+	unsigned int t = CYCLES() - start;
+	MP3StageStats *stats = &mp3DecInfo->stageStats;
+
+	stats->time[stage] += t;
+	stats->calls[stage]++;
+	if (t > stats->maxTime[stage])
+		stats->maxTime[stage] = t;
+}
+#else
+#define STAGE_START()
+#define STAGE_END(stage)
+#endif
+
+#ifdef MP3_STACK_STATS
+#include "../common/stackpaint.h"
 #endif
 
 /**************************************************************************************
@@ -120,6 +140,88 @@ int MP3FindSyncWord(unsigned char *buf, int nBytes)
 	return -1;
 }
 
+/**************************************************************************************
+ * Function:    MP3FrameBytes
+ *
+ * Description: length of a layer 3 frame from its header
+ *
+ * Inputs:      32-bit frame header (first byte in the MSB)
+ *
+ * Outputs:     none
+ *
+ * Return:      frame length in bytes, including header and padding byte
+ *              0 for free format (length unknown)
+ *              -1 if not a valid layer 3 header
+ **************************************************************************************/
+static int MP3FrameBytes(unsigned int hdr)
+{
+	int verIdx, ver, layer, brIdx, srIdx;
+
+	verIdx = (hdr >> 19) & 0x03;
+	layer =  4 - ((hdr >> 17) & 0x03);
+	brIdx =  (hdr >> 12) & 0x0f;
+	srIdx =  (hdr >> 10) & 0x03;
+	if (verIdx == 1 || layer != 3 || brIdx == 15 || srIdx == 3)
+		return -1;
+	if (brIdx == 0)
+		return 0;
+
+	ver = (verIdx == 0 ? MPEG25 : ((verIdx & 0x01) ? MPEG1 : MPEG2));
+	return (int)slotTab[ver][srIdx][brIdx] + ((hdr >> 9) & 0x01);
+}
+
+/**************************************************************************************
+ * Function:    MP3FindNextFrame
+ *
+ * Description: locate the next frame header in the raw mp3 stream
+ *
+ * Inputs:      valid MP3 decoder instance pointer (HMP3Decoder)
+ *              buffer to search for the frame header
+ *              max number of bytes to search in buffer
+ *
+ * Outputs:     none
+ *
+ * Return:      offset to the next frame header (bytes from start of buf)
+ *              -1 if no frame header found after searching nBytes
+ *
+ * Notes:       MP3Decode leaves the input pointer right behind the frame, so usually
+ *                buf starts with a header matching the last one (HDR_FIXED_MASK) and 
+ *                no search is needed
+ *              otherwise a sync word is only accepted if it starts a valid layer 3
+ *                header and, if that frame ends inside buf, the next header follows
+ *                at the expected offset with the same fixed fields - this avoids most
+ *                of the false syncs MP3FindSyncWord() finds in corrupt data or tags
+ **************************************************************************************/
+int MP3FindNextFrame(HMP3Decoder hMP3Decoder, unsigned char *buf, int nBytes)
+{
+	MP3DecInfo *mp3DecInfo = (MP3DecInfo *)hMP3Decoder;
+	unsigned int hdr;
+	int i, offset, frameBytes;
+
+	if (!mp3DecInfo)
+		return MP3FindSyncWord(buf, nBytes);
+
+	if (nBytes >= 4 && mp3DecInfo->fixedHdr && (MP3HeaderWord(buf) & HDR_FIXED_MASK) == mp3DecInfo->fixedHdr)
+		return 0;
+
+	i = 0;
+	while ((offset = MP3FindSyncWord(buf + i, nBytes - i)) >= 0) {
+		i += offset;
+		if (nBytes - i < 4)
+			return i;		/* incomplete header, MP3Decode will ask for more data */
+
+		hdr = MP3HeaderWord(buf + i);
+		frameBytes = MP3FrameBytes(hdr);
+		if (frameBytes == 0 || (frameBytes > 0 && nBytes - i < frameBytes + 4))
+			return i;		/* free format or next header not in buf, can't check */
+		if (frameBytes > 0 && (MP3HeaderWord(buf + i + frameBytes) & HDR_FIXED_MASK) == (hdr & HDR_FIXED_MASK))
+			return i;
+		i++;
+	}
+
+	return -1;
+}
+
 /**************************************************************************************
  * Function:    MP3FindFreeSync
  *
@@ -239,42 +341,160 @@ int MP3GetNextFrameInfo(HMP3Decoder hMP3Decoder, MP3FrameInfo *mp3FrameInfo, uns
 	return ERR_MP3_NONE;
 }
 
+#ifdef MP3_STAGE_STATS
+/**************************************************************************************
+ * Function:    MP3GetStageStats
+ *
+ * Description: get the accumulated per-stage timing of MP3Decode
+ *
+ * Inputs:      valid MP3 decoder instance pointer (HMP3Decoder)
+ *              pointer to MP3StageStats struct
+ *
+ * Outputs:     filled-in MP3StageStats struct
+ *
+ * Return:      error code, defined in mp3dec.h (0 means no error, < 0 means error)
+ *
+ * Notes:       times are cycles on ARM, nanoseconds on the host
+ *              the copy is not atomic, a decode running in a higher priority
+ *                interrupt may update the stats while they are copied
+ **************************************************************************************/
+int MP3GetStageStats(HMP3Decoder hMP3Decoder, MP3StageStats *stats)
+{
+	MP3DecInfo *mp3DecInfo = (MP3DecInfo *)hMP3Decoder;
+
+	if (!mp3DecInfo || !stats)
+		return ERR_MP3_NULL_POINTER;
+
+	memcpy(stats, &mp3DecInfo->stageStats, sizeof(MP3StageStats));
+
+	return ERR_MP3_NONE;
+}
+
+/**************************************************************************************
+ * Function:    MP3ResetStageStats
+ *
+ * Description: clear the per-stage timing of MP3Decode
+ *
+ * Inputs:      valid MP3 decoder instance pointer (HMP3Decoder)
+ *
+ * Outputs:     none
+ *
+ * Return:      none
+ **************************************************************************************/
+void MP3ResetStageStats(HMP3Decoder hMP3Decoder)
+{
+	MP3DecInfo *mp3DecInfo = (MP3DecInfo *)hMP3Decoder;
+
+	if (!mp3DecInfo)
+		return;
+
+	memset(&mp3DecInfo->stageStats, 0, sizeof(MP3StageStats));
+}
+#endif
+
+#ifdef MP3_FRAME_STATS
+/**************************************************************************************
+ * Function:    MP3GetFrameStats
+ *
+ * Description: get block types, coefficient counts etc. of the last frame
+ *
+ * Inputs:      valid MP3 decoder instance pointer (HMP3Decoder)
+ *              pointer to MP3FrameStats struct
+ *
+ * Outputs:     filled-in MP3FrameStats struct
+ *
+ * Return:      error code, defined in mp3dec.h (0 means no error, < 0 means error)
+ *
+ * Notes:       only complete if the last call to MP3Decode returned ERR_MP3_NONE
+ **************************************************************************************/
+int MP3GetFrameStats(HMP3Decoder hMP3Decoder, MP3FrameStats *stats)
+{
+	MP3DecInfo *mp3DecInfo = (MP3DecInfo *)hMP3Decoder;
+
+	if (!mp3DecInfo || !stats)
+		return ERR_MP3_NULL_POINTER;
+
+	memcpy(stats, &mp3DecInfo->frameStats, sizeof(MP3FrameStats));
+
+	return ERR_MP3_NONE;
+}
+#endif
+
 /**************************************************************************************
  * Function:    MP3ClearBadFrame
  *
  * Description: zero out pcm buffer if error decoding MP3 frame
  *
  * Inputs:      mp3DecInfo struct with correct frame size parameters filled in
- *              pointer pcm output buffer
+ *              PCMOut struct with the pcm output buffer (or one buffer per channel)
  *
  * Outputs:     zeroed out pcm buffer
  *
  * Return:      none
  **************************************************************************************/
-static void MP3ClearBadFrame(MP3DecInfo *mp3DecInfo, short *outbuf)
+static void MP3ClearBadFrame(MP3DecInfo *mp3DecInfo, PCMOut *pcmOut)
 {
-	int i;
+	int i, nSamps;
 
 	if (!mp3DecInfo)
 		return;
 
-	for (i = 0; i < mp3DecInfo->nGrans * mp3DecInfo->nGranSamps * mp3DecInfo->nChans; i++)
-		outbuf[i] = 0;
+	nSamps = mp3DecInfo->nGrans * mp3DecInfo->nGranSamps;
+	if (pcmOut->buf) {
+		for (i = 0; i < nSamps * mp3DecInfo->nChans; i++)
+			pcmOut->buf[i] = 0;
+	} else {
+		memset(pcmOut->left, 0, nSamps * sizeof(short));
+		if (mp3DecInfo->nChans == 2 && pcmOut->right)
+			memset(pcmOut->right, 0, nSamps * sizeof(short));
+	}
 }
 
 /**************************************************************************************
- * Function:    MP3Decode
+ * Function:    MP3AppendMainData
+ *
+ * Description: append main data to the bit reservoir in mainBuf
+ *
+ * Inputs:      mp3DecInfo struct
+ *              pointer to the new main data
+ *              number of new bytes (nBytes + keep <= MAINBUF_SIZE)
+ *              number of bytes before them which must stay available
+ *
+ * Outputs:     main data appended at mainBuf + mainDataBytes, updated mainDataBytes
+ *
+ * Return:      none
+ *
+ * Notes:       the reservoir grows until mainBuf is full, only then the bytes still
+ *                needed are moved to the front
+ *              at typical bit rates several frames fit, so most frames only cost the
+ *                copy of their own main data
+ **************************************************************************************/
+static void MP3AppendMainData(MP3DecInfo *mp3DecInfo, unsigned char *buf, int nBytes, int keep)
+{
+	if (keep > mp3DecInfo->mainDataBytes)
+		keep = mp3DecInfo->mainDataBytes;
+
+	if (mp3DecInfo->mainDataBytes + nBytes > MAINBUF_SIZE) {
+		memmove(mp3DecInfo->mainBuf, mp3DecInfo->mainBuf + mp3DecInfo->mainDataBytes - keep, keep);
+		mp3DecInfo->mainDataBytes = keep;
+	}
+	memcpy(mp3DecInfo->mainBuf + mp3DecInfo->mainDataBytes, buf, nBytes);
+	mp3DecInfo->mainDataBytes += nBytes;
+}
+
+/**************************************************************************************
+ * Function:    MP3DecodeFrame
  *
  * Description: decode one frame of MP3 data
  *
  * Inputs:      valid MP3 decoder instance pointer (HMP3Decoder)
  *              double pointer to buffer of MP3 data (containing headers + mainData)
  *              number of valid bytes remaining in inbuf
- *              pointer to outbuf, big enough to hold one frame of decoded PCM samples
+ *              PCMOut struct, with room for one frame of decoded PCM samples
  *              flag indicating whether MP3 data is normal MPEG format (useSize = 0)
  *                or reformatted as "self-contained" frames (useSize = 1)
  *
- * Outputs:     PCM data in outbuf, interleaved LRLRLR... if stereo
+ * Outputs:     PCM data in outbuf, interleaved LRLRLR... if stereo (or planar)
  *                number of output samples = nGrans * nGranSamps * nChans
  *              updated inbuf pointer, updated bytesLeft
  *
@@ -283,29 +503,26 @@ static void MP3ClearBadFrame(MP3DecInfo *mp3DecInfo, short *outbuf)
  * Notes:       switching useSize on and off between frames in the same stream 
  *                is not supported (bit reservoir is not maintained if useSize on)
  **************************************************************************************/
-int MP3Decode(HMP3Decoder hMP3Decoder, unsigned char **inbuf, int *bytesLeft, short *outbuf, int useSize)
+static int MP3DecodeFrame(HMP3Decoder hMP3Decoder, unsigned char **inbuf, int *bytesLeft, PCMOut *outbuf, int useSize)
 {
 	int offset, bitOffset, mainBits, gr, ch, fhBytes, siBytes, freeFrameBytes;
 	int prevBitOffset, sfBlockBits, huffBlockBits;
 	unsigned char *mainPtr;
 	MP3DecInfo *mp3DecInfo = (MP3DecInfo *)hMP3Decoder;
-	
-	#ifdef PROFILE
-	long time;
-	#endif
+#ifdef MP3_STAGE_STATS
+	unsigned int stageTime;
+#endif
 
 	if (!mp3DecInfo)
 		return ERR_MP3_NULL_POINTER;
 
+	STAGE_START();
 	/* unpack frame header */
 	fhBytes = UnpackFrameHeader(mp3DecInfo, *inbuf);
 	if (fhBytes < 0)	
 		return ERR_MP3_INVALID_FRAMEHEADER;		/* don't clear outbuf since we don't know size (failed to parse header) */
 	*inbuf += fhBytes;
 	
-#ifdef PROFILE
-	time = systime_get();
-#endif
 	/* unpack side info */
 	siBytes = UnpackSideInfo(mp3DecInfo, *inbuf);
 	if (siBytes < 0) {
@@ -314,9 +531,13 @@ int MP3Decode(HMP3Decoder hMP3Decoder, unsigned char **inbuf, int *bytesLeft, sh
 	}
 	*inbuf += siBytes;
 	*bytesLeft -= (fhBytes + siBytes);
-#ifdef PROFILE
-	time = systime_get() - time;
-	printf("UnpackSideInfo: %i ms\n", time);
+	STAGE_END(MP3_STAGE_SIDEINFO);
+#ifdef MP3_FRAME_STATS
+	/* the per granule fields are filled in by IMDCT() */
+	memset(&mp3DecInfo->frameStats, 0, sizeof(MP3FrameStats));
+	mp3DecInfo->frameStats.nGrans = mp3DecInfo->nGrans;
+	mp3DecInfo->frameStats.nChans = mp3DecInfo->nChans;
+	mp3DecInfo->frameStats.mainDataBegin = mp3DecInfo->mainDataBegin;
 #endif
 	
 	
@@ -352,6 +573,7 @@ int MP3Decode(HMP3Decoder hMP3Decoder, unsigned char **inbuf, int *bytesLeft, sh
 
 		/* can operate in-place on reformatted frames */
 		mp3DecInfo->mainDataBytes = mp3DecInfo->nSlots;
+		mainBits = mp3DecInfo->nSlots * 8;
 		mainPtr = *inbuf;
 		*inbuf += mp3DecInfo->nSlots;
 		*bytesLeft -= (mp3DecInfo->nSlots);
@@ -362,51 +584,47 @@ int MP3Decode(HMP3Decoder hMP3Decoder, unsigned char **inbuf, int *bytesLeft, sh
 			return ERR_MP3_INDATA_UNDERFLOW;	
 		}
 
-#ifdef PROFILE
-	time = systime_get();
-#endif
-		/* fill main data buffer with enough new data for this frame */
-		if (mp3DecInfo->mainDataBytes >= mp3DecInfo->mainDataBegin) {
-			/* adequate "old" main data available (i.e. bit reservoir) */
-			memmove(mp3DecInfo->mainBuf, mp3DecInfo->mainBuf + mp3DecInfo->mainDataBytes - mp3DecInfo->mainDataBegin, mp3DecInfo->mainDataBegin);
-			memcpy(mp3DecInfo->mainBuf + mp3DecInfo->mainDataBegin, *inbuf, mp3DecInfo->nSlots);
-
-			mp3DecInfo->mainDataBytes = mp3DecInfo->mainDataBegin + mp3DecInfo->nSlots;
+		STAGE_START();
+		if (mp3DecInfo->mainDataBegin == 0) {
+			/* no bit reservoir used: decode in place, keep the end of this frame for the next one
+			 * (its main data can't start before this frame's, older bytes aren't needed anymore)
+			 */
+			mainPtr = *inbuf;
+			mainBits = mp3DecInfo->nSlots * 8;
+			offset = (mp3DecInfo->nSlots < MAX_MAINDATA_BEGIN ? mp3DecInfo->nSlots : MAX_MAINDATA_BEGIN);
+			mp3DecInfo->mainDataBytes = 0;
+			MP3AppendMainData(mp3DecInfo, *inbuf + mp3DecInfo->nSlots - offset, offset, 0);
+			*inbuf += mp3DecInfo->nSlots;
+			*bytesLeft -= (mp3DecInfo->nSlots);
+		} else if (mp3DecInfo->mainDataBytes >= mp3DecInfo->mainDataBegin) {
+			/* adequate "old" main data available (i.e. bit reservoir), append the new data behind it */
+			MP3AppendMainData(mp3DecInfo, *inbuf, mp3DecInfo->nSlots, mp3DecInfo->mainDataBegin);
+			mainBits = (mp3DecInfo->mainDataBegin + mp3DecInfo->nSlots) * 8;
+			mainPtr = mp3DecInfo->mainBuf + mp3DecInfo->mainDataBytes - mp3DecInfo->nSlots - mp3DecInfo->mainDataBegin;
 			*inbuf += mp3DecInfo->nSlots;
 			*bytesLeft -= (mp3DecInfo->nSlots);
-			mainPtr = mp3DecInfo->mainBuf;
 		} else {
 			/* not enough data in bit reservoir from previous frames (perhaps starting in middle of file) */
-			memcpy(mp3DecInfo->mainBuf + mp3DecInfo->mainDataBytes, *inbuf, mp3DecInfo->nSlots);
-			mp3DecInfo->mainDataBytes += mp3DecInfo->nSlots;
+			MP3AppendMainData(mp3DecInfo, *inbuf, mp3DecInfo->nSlots, MAX_MAINDATA_BEGIN);
 			*inbuf += mp3DecInfo->nSlots;
 			*bytesLeft -= (mp3DecInfo->nSlots);
 			MP3ClearBadFrame(mp3DecInfo, outbuf);
 			return ERR_MP3_MAINDATA_UNDERFLOW;
 		}
-#ifdef PROFILE
-	time = systime_get() - time;
-	printf("data buffer filling: %i ms\n", time);
-#endif
+		STAGE_END(MP3_STAGE_MAINDATA);
 
 	}
 	bitOffset = 0;
-	mainBits = mp3DecInfo->mainDataBytes * 8;
 
 	/* decode one complete frame */
 	for (gr = 0; gr < mp3DecInfo->nGrans; gr++) {
 		for (ch = 0; ch < mp3DecInfo->nChans; ch++) {
 			
-			#ifdef PROFILE
-				time = systime_get();
-			#endif
+			STAGE_START();
 			/* unpack scale factors and compute size of scale factor block */
 			prevBitOffset = bitOffset;
 			offset = UnpackScaleFactors(mp3DecInfo, mainPtr, &bitOffset, mainBits, gr, ch);
-			#ifdef PROFILE
-				time = systime_get() - time;
-				printf("UnpackScaleFactors: %i ms\n", time);
-			#endif
+			STAGE_END(MP3_STAGE_SCALEFACT);
 
 			sfBlockBits = 8*offset - prevBitOffset + bitOffset;
 			huffBlockBits = mp3DecInfo->part23Length[gr][ch] - sfBlockBits;
@@ -418,9 +636,7 @@ int MP3Decode(HMP3Decoder hMP3Decoder, unsigned char **inbuf, int *bytesLeft, sh
 				return ERR_MP3_INVALID_SCALEFACT;
 			}
 
-			#ifdef PROFILE
-				time = systime_get();
-			#endif
+			STAGE_START();
 			/* decode Huffman code words */
 			prevBitOffset = bitOffset;
 			offset = DecodeHuffman(mp3DecInfo, mainPtr, &bitOffset, huffBlockBits, gr, ch);
@@ -428,57 +644,116 @@ int MP3Decode(HMP3Decoder hMP3Decoder, unsigned char **inbuf, int *bytesLeft, sh
 				MP3ClearBadFrame(mp3DecInfo, outbuf);
 				return ERR_MP3_INVALID_HUFFCODES;
 			}
-			#ifdef PROFILE
-				time = systime_get() - time;
-				printf("Huffman: %i ms\n", time);
-			#endif
+			STAGE_END(MP3_STAGE_HUFFMAN);
 
 			mainPtr += offset;
 			mainBits -= (8*offset - prevBitOffset + bitOffset);
 		}
 		
-		#ifdef PROFILE
-			time = systime_get();
-		#endif
+		STAGE_START();
 		/* dequantize coefficients, decode stereo, reorder short blocks */
 		if (Dequantize(mp3DecInfo, gr) < 0) {
 			MP3ClearBadFrame(mp3DecInfo, outbuf);
 			return ERR_MP3_INVALID_DEQUANTIZE;			
 		}
-		#ifdef PROFILE
-			time = systime_get() - time;
-			printf("Dequantize: %i ms\n", time);
-		#endif
+		STAGE_END(MP3_STAGE_DEQUANT);
 
 		/* alias reduction, inverse MDCT, overlap-add, frequency inversion */
 		for (ch = 0; ch < mp3DecInfo->nChans; ch++)
 		{
-		#ifdef PROFILE
-			time = systime_get();
-		#endif
+			STAGE_START();
 			if (IMDCT(mp3DecInfo, gr, ch) < 0) {
 				MP3ClearBadFrame(mp3DecInfo, outbuf);
 				return ERR_MP3_INVALID_IMDCT;			
 			}
-		#ifdef PROFILE
-			time = systime_get() - time;
-			printf("IMDCT: %i ms\n", time);
-		#endif
+			STAGE_END(MP3_STAGE_IMDCT);
 		}
 		
-		#ifdef PROFILE
-			time = systime_get();
-		#endif
-		/* subband transform - if stereo, interleaves pcm LRLRLR */
-		if (Subband(mp3DecInfo, outbuf + gr*mp3DecInfo->nGranSamps*mp3DecInfo->nChans) < 0) {
+		STAGE_START();
+		/* subband transform - if stereo, interleaves pcm LRLRLR (unless planar) */
+		if (Subband(mp3DecInfo, outbuf, gr) < 0) {
 			MP3ClearBadFrame(mp3DecInfo, outbuf);
 			return ERR_MP3_INVALID_SUBBAND;			
 		}
-		#ifdef PROFILE
-			time = systime_get() - time;
-			printf("Subband: %i ms\n", time);
-		#endif
+		STAGE_END(MP3_STAGE_SUBBAND);
 		
 	}
+#ifdef MP3_STAGE_STATS
+	mp3DecInfo->stageStats.frames++;
+#endif
 	return ERR_MP3_NONE;
 }
+
+/**************************************************************************************
+ * Function:    MP3DecodeOut
+ *
+ * Description: decode one frame of MP3 data, see MP3DecodeFrame
+ *
+ * Notes:       with MP3_STACK_STATS the free stack is painted before and checked
+ *                after the frame, the deepest use is kept for MP3GetMemInfo()
+ **************************************************************************************/
+static int MP3DecodeOut(HMP3Decoder hMP3Decoder, unsigned char **inbuf, int *bytesLeft, PCMOut *outbuf, int useSize)
+{
+#ifdef MP3_STACK_STATS
+	MP3DecInfo *mp3DecInfo = (MP3DecInfo *)hMP3Decoder;
+	int err, depth;
+
+	StackPaint();
+	err = MP3DecodeFrame(hMP3Decoder, inbuf, bytesLeft, outbuf, useSize);
+	depth = StackDepth();
+	if (mp3DecInfo && depth > mp3DecInfo->stackPeak)
+		mp3DecInfo->stackPeak = depth;
+
+	return err;
+#else
+	return MP3DecodeFrame(hMP3Decoder, inbuf, bytesLeft, outbuf, useSize);
+#endif
+}
+
+/**************************************************************************************
+ * Function:    MP3Decode
+ *
+ * Description: decode one frame of MP3 data, see MP3DecodeFrame
+ *
+ * Inputs:      pointer to outbuf, big enough to hold one frame of decoded PCM samples
+ *
+ * Outputs:     PCM data in outbuf, interleaved LRLRLR... if stereo
+ **************************************************************************************/
+int MP3Decode(HMP3Decoder hMP3Decoder, unsigned char **inbuf, int *bytesLeft, short *outbuf, int useSize)
+{
+	PCMOut pcmOut;
+
+	pcmOut.buf = outbuf;
+	pcmOut.left = pcmOut.right = 0;
+
+	return MP3DecodeOut(hMP3Decoder, inbuf, bytesLeft, &pcmOut, useSize);
+}
+
+/**************************************************************************************
+ * Function:    MP3DecodePlanar
+ *
+ * Description: decode one frame of MP3 data into separate buffers for each channel,
+ *                see MP3DecodeFrame
+ *
+ * Inputs:      output buffers of the left (or mono) and right channel, each big
+ *                enough for nGrans * nGranSamps samples
+ *
+ * Outputs:     PCM data of channel 0 in outL, of channel 1 in outR
+ *
+ * Notes:       outR is not used for mono streams
+ *              the samples come out of the synthesis filterbank in this layout,
+ *                there is no deinterleaving pass
+ **************************************************************************************/
+int MP3DecodePlanar(HMP3Decoder hMP3Decoder, unsigned char **inbuf, int *bytesLeft, short *outL, short *outR, int useSize)
+{
+	PCMOut pcmOut;
+
+	if (!outL)
+		return ERR_MP3_NULL_POINTER;
+
+	pcmOut.buf = 0;
+	pcmOut.left = outL;
+	pcmOut.right = outR;
+
+	return MP3DecodeOut(hMP3Decoder, inbuf, bytesLeft, &pcmOut, useSize);
+}
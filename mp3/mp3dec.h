@@ -59,12 +59,39 @@
 #
 #elif defined(__GNUC__) && defined(__i386__)
 #
+#elif defined(__GNUC__) && defined(__amd64__)
+#
 #elif defined(_OPENWAVE_SIMULATOR) || defined(_OPENWAVE_ARMULATOR)
 #
 #else
 #error No platform defined. See valid options in mp3dec.h
 #endif
 
+/* per-stage timing of MP3Decode, read back with MP3GetStageStats()
+ * costs two reads of the cycle counter per stage, so keep it off for normal use
+ */
+//#define MP3_STAGE_STATS
+
+/* peak stack depth of MP3Decode, read back with MP3GetMemInfo()
+ * paints the free stack before every frame (see common/stackpaint.h), keep it off for normal use
+ */
+//#define MP3_STACK_STATS
+
+/* block types, coefficient counts etc. of the last frame, read back with MP3GetFrameStats()
+ * a few stores per granule, for finding out what makes a frame expensive
+ */
+//#define MP3_FRAME_STATS
+
+/* use the C FDCT32 (mp3/dct32.c) on ARM as well, instead of the assembly in asmdct32_thumb2.S
+ * both are bit-exact, the C version is the reference
+ */
+//#define MP3_FDCT32_C
+
+/* use the C hybrid filterbank (antialias, IMDCT, overlap-add in mp3/imdct.c) on ARM as well,
+ * instead of asmimdct_thumb2.S
+ */
+//#define MP3_IMDCT_C
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -118,14 +145,77 @@ typedef struct _MP3FrameInfo {
 	int version;
 } MP3FrameInfo;
 
+#ifdef MP3_STAGE_STATS
+enum {
+	MP3_STAGE_SIDEINFO =	0,	/* UnpackFrameHeader, UnpackSideInfo */
+	MP3_STAGE_MAINDATA,			/* filling the main data buffer (bit reservoir) */
+	MP3_STAGE_SCALEFACT,		/* UnpackScaleFactors, per channel */
+	MP3_STAGE_HUFFMAN,			/* DecodeHuffman, per channel */
+	MP3_STAGE_DEQUANT,			/* Dequantize (incl. stereo processing) */
+	MP3_STAGE_IMDCT,			/* IMDCT, per channel */
+	MP3_STAGE_SUBBAND,			/* Subband (polyphase synthesis) */
+
+	MP3_NSTAGES
+};
+
+/* times are CPU cycles on ARM, nanoseconds on the host (see CYCLES() in assembly.h) */
+typedef struct _MP3StageStats {
+	uint64_t time[MP3_NSTAGES];		/* total */
+	uint32_t maxTime[MP3_NSTAGES];	/* longest single call */
+	uint32_t calls[MP3_NSTAGES];
+	uint32_t frames;				/* frames decoded without error */
+} MP3StageStats;
+#endif
+
+#ifdef MP3_FRAME_STATS
+/* what the last frame asked of the decoder, per granule and channel */
+typedef struct _MP3FrameStats {
+	int nGrans;
+	int nChans;
+	int mainDataBegin;						/* bytes taken from the bit reservoir */
+	int modeExt;							/* bit 1 = mid-side, bit 0 = intensity stereo (joint stereo only) */
+	int blockType[MAX_NGRAN][MAX_NCHAN];	/* 0 = long, 1 = start, 2 = short, 3 = stop */
+	int mixedBlock[MAX_NGRAN][MAX_NCHAN];
+	int part23Length[MAX_NGRAN][MAX_NCHAN];	/* bits of scale factors and Huffman codes */
+	int nonZeroBound[MAX_NGRAN][MAX_NCHAN];	/* coefficients which can be != 0 after stereo processing */
+	int nIMDCT[MAX_NGRAN][MAX_NCHAN];		/* subbands which went through the IMDCT */
+} MP3FrameStats;
+#endif
+
+/* heap used by one decoder instance, in bytes as requested from malloc() */
+typedef struct _MP3MemInfo {
+	int decInfo;			/* MP3DecInfo */
+	int frameHeader;		/* FrameHeader */
+	int sideInfo;			/* SideInfo */
+	int scaleFactorInfo;	/* ScaleFactorInfo */
+	int huffmanInfo;		/* HuffmanInfo */
+	int dequantInfo;		/* DequantInfo */
+	int imdctInfo;			/* IMDCTInfo */
+	int subbandInfo;		/* SubbandInfo */
+	int total;
+	int stackPeak;			/* deepest stack use of MP3Decode so far, 0 without MP3_STACK_STATS */
+} MP3MemInfo;
+
 /* public API */
 HMP3Decoder MP3InitDecoder(void);
 void MP3FreeDecoder(HMP3Decoder hMP3Decoder);
 int MP3Decode(HMP3Decoder hMP3Decoder, unsigned char **inbuf, int *bytesLeft, short *outbuf, int useSize);
+int MP3DecodePlanar(HMP3Decoder hMP3Decoder, unsigned char **inbuf, int *bytesLeft, short *outL, short *outR, int useSize);
 
 void MP3GetLastFrameInfo(HMP3Decoder hMP3Decoder, MP3FrameInfo *mp3FrameInfo);
 int MP3GetNextFrameInfo(HMP3Decoder hMP3Decoder, MP3FrameInfo *mp3FrameInfo, unsigned char *buf);
 int MP3FindSyncWord(unsigned char *buf, int nBytes);
+int MP3FindNextFrame(HMP3Decoder hMP3Decoder, unsigned char *buf, int nBytes);
+void MP3GetMemInfo(HMP3Decoder hMP3Decoder, MP3MemInfo *memInfo);
+
+#ifdef MP3_STAGE_STATS
+int MP3GetStageStats(HMP3Decoder hMP3Decoder, MP3StageStats *stats);
+void MP3ResetStageStats(HMP3Decoder hMP3Decoder);
+#endif
+
+#ifdef MP3_FRAME_STATS
+int MP3GetFrameStats(HMP3Decoder hMP3Decoder, MP3FrameStats *stats);
+#endif
 
 #ifdef __cplusplus
 }
@@ -203,12 +203,12 @@ void PolyphaseMono(short *pcm, int *vbuf, const int *coefBase)
 }
 
 /**************************************************************************************
- * Function:    PolyphaseStereo
+ * Function:    PolyphaseStereoOut
  *
  * Description: filter one subband and produce 32 output PCM samples for each channel
  *
- * Inputs:      pointer to PCM output buffer
- *              number of "extra shifts" (vbuf format = Q(DQ_FRACBITS_OUT-2))
+ * Inputs:      pointers to the first left and right PCM output sample
+ *              distance between two output samples of one channel
  *              pointer to start of vbuf (preserved from last call)
  *              start of filter coefficient table (in proper, shuffled order)
  *              no minimum number of guard bits is required for input vbuf 
@@ -218,11 +218,11 @@ void PolyphaseMono(short *pcm, int *vbuf, const int *coefBase)
  *
  * Return:      none
  *
- * Notes:       interleaves PCM samples LRLRLR...
+ * Notes:       step is a constant in both callers, so each gets its own inlined copy
  *
  * TODO:        add 32-bit version for platforms where 64-bit mul-acc is not supported
  **************************************************************************************/
-void PolyphaseStereo(short *pcm, int *vbuf, const int *coefBase)
+static __inline void PolyphaseStereoOut(short *pcmL, short *pcmR, int step, int *vbuf, const int *coefBase)
 {
 	int i;
 	const int *coef;
@@ -246,8 +246,8 @@ void PolyphaseStereo(short *pcm, int *vbuf, const int *coefBase)
 	MC0S(6)
 	MC0S(7)
 
-	*(pcm + 0) = ClipToShort((int)SAR64(sum1L, (32-CSHIFT)), DEF_NFRACBITS);
-	*(pcm + 1) = ClipToShort((int)SAR64(sum1R, (32-CSHIFT)), DEF_NFRACBITS);
+	*(pcmL + 0) = ClipToShort((int)SAR64(sum1L, (32-CSHIFT)), DEF_NFRACBITS);
+	*(pcmR + 0) = ClipToShort((int)SAR64(sum1R, (32-CSHIFT)), DEF_NFRACBITS);
 
 	/* special case, output sample 16 */
 	coef = coefBase + 256;
@@ -263,13 +263,14 @@ void PolyphaseStereo(short *pcm, int *vbuf, const int *coefBase)
 	MC1S(6)
 	MC1S(7)
 
-	*(pcm + 2*16 + 0) = ClipToShort((int)SAR64(sum1L, (32-CSHIFT)), DEF_NFRACBITS);
-	*(pcm + 2*16 + 1) = ClipToShort((int)SAR64(sum1R, (32-CSHIFT)), DEF_NFRACBITS);
+	*(pcmL + step*16) = ClipToShort((int)SAR64(sum1L, (32-CSHIFT)), DEF_NFRACBITS);
+	*(pcmR + step*16) = ClipToShort((int)SAR64(sum1R, (32-CSHIFT)), DEF_NFRACBITS);
 
 	/* main convolution loop: sum1L = samples 1, 2, 3, ... 15   sum2L = samples 31, 30, ... 17 */
 	coef = coefBase + 16;
 	vb1 = vbuf + 64;
-	pcm += 2;
+	pcmL += step;
+	pcmR += step;
 
 	/* right now, the compiler creates bad asm from this... */
 	for (i = 15; i > 0; i--) {
@@ -286,10 +287,51 @@ void PolyphaseStereo(short *pcm, int *vbuf, const int *coefBase)
 		MC2S(7)
 
 		vb1 += 64;
-		*(pcm + 0)         = ClipToShort((int)SAR64(sum1L, (32-CSHIFT)), DEF_NFRACBITS);
-		*(pcm + 1)         = ClipToShort((int)SAR64(sum1R, (32-CSHIFT)), DEF_NFRACBITS);
-		*(pcm + 2*2*i + 0) = ClipToShort((int)SAR64(sum2L, (32-CSHIFT)), DEF_NFRACBITS);
-		*(pcm + 2*2*i + 1) = ClipToShort((int)SAR64(sum2R, (32-CSHIFT)), DEF_NFRACBITS);
-		pcm += 2;
+		*(pcmL + 0)        = ClipToShort((int)SAR64(sum1L, (32-CSHIFT)), DEF_NFRACBITS);
+		*(pcmR + 0)        = ClipToShort((int)SAR64(sum1R, (32-CSHIFT)), DEF_NFRACBITS);
+		*(pcmL + step*2*i) = ClipToShort((int)SAR64(sum2L, (32-CSHIFT)), DEF_NFRACBITS);
+		*(pcmR + step*2*i) = ClipToShort((int)SAR64(sum2R, (32-CSHIFT)), DEF_NFRACBITS);
+		pcmL += step;
+		pcmR += step;
 	}
 }
+
+/**************************************************************************************
+ * Function:    PolyphaseStereo
+ *
+ * Description: filter one subband and produce 32 output PCM samples for each channel
+ *
+ * Inputs:      pointer to PCM output buffer
+ *              pointer to start of vbuf (preserved from last call)
+ *              start of filter coefficient table (in proper, shuffled order)
+ *
+ * Outputs:     32 samples of two channels of decoded PCM data, (i.e. Q16.0)
+ *
+ * Return:      none
+ *
+ * Notes:       interleaves PCM samples LRLRLR...
+ **************************************************************************************/
+void PolyphaseStereo(short *pcm, int *vbuf, const int *coefBase)
+{
+	PolyphaseStereoOut(pcm, pcm + 1, 2, vbuf, coefBase);
+}
+
+/**************************************************************************************
+ * Function:    PolyphaseStereoPlanar
+ *
+ * Description: filter one subband and produce 32 output PCM samples for each channel
+ *
+ * Inputs:      pointers to the left and right PCM output buffers
+ *              pointer to start of vbuf (preserved from last call)
+ *              start of filter coefficient table (in proper, shuffled order)
+ *
+ * Outputs:     32 samples of each channel into its own buffer, (i.e. Q16.0)
+ *
+ * Return:      none
+ *
+ * Notes:       same samples as PolyphaseStereo, for planar output
+ **************************************************************************************/
+void PolyphaseStereoPlanar(short *pcmL, short *pcmR, int *vbuf, const int *coefBase)
+{
+	PolyphaseStereoOut(pcmL, pcmR, 1, vbuf, coefBase);
+}
@@ -99,6 +99,8 @@ void MidSideProc(int x[MAX_NCHAN][MAX_NSAMP], int nSamps, int mOut[2])
  * Return:      none
  *
  * Notes:       assume at least 1 GB in input
+ *              isf is up to 4 bits, all of 7..15 are illegal positions (ISFMpeg1 has 7
+ *                entries)
  *
  * TODO:        combine MPEG1/2 into one function (maybe)
  *              make sure all the mixed-block and IIP logic is right
@@ -139,7 +141,7 @@ void IntensityProcMPEG1(int x[MAX_NCHAN][MAX_NSAMP], int nSamps, FrameHeader *fh
 	/* long blocks */
 	for (cb = cbStartL; cb < cbEndL && sampsLeft > 0; cb++) {
 		isf = sfis->l[cb];
-		if (isf == 7) {
+		if (isf >= 7) {
 			fl = ISFIIP[midSideFlag][0];
 			fr = ISFIIP[midSideFlag][1];
 		} else {
@@ -159,7 +161,7 @@ void IntensityProcMPEG1(int x[MAX_NCHAN][MAX_NSAMP], int nSamps, FrameHeader *fh
 	for (cb = cbStartS; cb < cbEndS && sampsLeft >= 3; cb++) {
 		for (w = 0; w < 3; w++) {
 			isf = sfis->s[cb][w];
-			if (isf == 7) {
+			if (isf >= 7) {
 				fls[w] = ISFIIP[midSideFlag][0];
 				frs[w] = ISFIIP[midSideFlag][1];
 			} else {
@@ -294,3 +296,97 @@ void IntensityProcMPEG2(int x[MAX_NCHAN][MAX_NSAMP], int nSamps, FrameHeader *fh
 	return;
 }
 
+/**************************************************************************************
+ * Function:    StereoSetup
+ *
+ * Description: prepare joint stereo reconstruction inside DequantChannel() of the left 
+ *                channel, after the right channel is dequantized
+ *
+ * Inputs:      valid FrameHeader struct
+ *              ScaleFactorInfoSub and CriticalBandInfo of the right channel
+ *              ScaleFactorJS struct with joint stereo info from UnpackSFMPEG2()
+ *              non-zero bound of the right channel
+ *
+ * Outputs:     filled StereoInfo (except xr and mOut): mid-side and intensity regions,
+ *                intensity scale factors of every band of the intensity region
+ *
+ * Return:      none
+ *
+ * Notes:       same regions and scale factors as MidSideProc() + IntensityProcMPEG1/2() 
+ *                for non-mixed blocks of the same type in both channels, which is all
+ *                DequantChannel() handles
+ **************************************************************************************/
+void StereoSetup(StereoInfo *sti, FrameHeader *fh, ScaleFactorInfoSub *sfis, CriticalBandInfo *cbi, 
+				 ScaleFactorJS *sfjs, int nonZeroBound)
+{
+	int i, j, k, r, w, cb, nBands, nWin;
+	int isf, sfIdx, midSideFlag, il[23];
+	const int *isfTab;
+
+	midSideFlag = fh->modeExt >> 1;
+	sti->midSide = midSideFlag;
+	sti->isStart[0] = sti->isStart[1] = sti->isStart[2] = IS_NONE;
+
+	if (!(fh->modeExt & 0x01)) {
+		/* mid-side only, on the whole spectrum */
+		sti->msEnd = nonZeroBound;
+		return;
+	}
+
+	/* mid-side (or nothing) up to the end of the right channel, intensity above */
+	if (cbi->cbType == 0) {
+		sti->isStart[0] = cbi->cbEndL + 1;
+		sti->msEnd = fh->sfBand->l[cbi->cbEndL + 1];
+		nBands = 22;
+		nWin = 1;
+	} else {
+		for (w = 0; w < 3; w++)
+			sti->isStart[w] = (fh->ver == MPEG1 ? cbi->cbEndSMax : cbi->cbEndS[w]) + 1;
+		sti->msEnd = 3 * fh->sfBand->s[cbi->cbEndSMax + 1];
+		nBands = 13;
+		nWin = 3;
+	}
+
+	if (fh->ver == MPEG1) {
+		isfTab = ISFMpeg1[midSideFlag];
+		for (cb = 0, i = 0; cb < nBands; cb++) {
+			for (w = 0; w < nWin; w++, i++) {
+				isf = (nWin == 1 ? sfis->l[cb] : sfis->s[cb][w]);
+				if (isf >= 7) {
+					sti->isfL[i] = ISFIIP[midSideFlag][0];
+					sti->isfR[i] = ISFIIP[midSideFlag][1];
+				} else {
+					sti->isfL[i] = isfTab[isf];
+					sti->isfR[i] = isfTab[6] - isfTab[isf];
+				}
+			}
+		}
+	} else {
+		isfTab = ISFMpeg2[sfjs->intensityScale][midSideFlag];
+
+		/* illegal intensity positions (depending on slen) */
+		for (k = r = 0; r < 4; r++) {
+			isf = (1 << sfjs->slen[r]) - 1;
+			for (j = 0; j < sfjs->nr[r]; j++, k++) 
+				il[k] = isf;
+		}
+		if (nWin == 1)
+			il[21] = il[22] = 1;
+		else
+			il[12] = 1;
+
+		for (cb = 0, i = 0; cb < nBands; cb++) {
+			for (w = 0; w < nWin; w++, i++) {
+				sfIdx = (nWin == 1 ? sfis->l[cb] : sfis->s[cb][w]);
+				if (sfIdx == il[cb]) {
+					sti->isfL[i] = ISFIIP[midSideFlag][0];
+					sti->isfR[i] = ISFIIP[midSideFlag][1];
+				} else {
+					isf = (sfIdx + 1) >> 1;
+					sti->isfL[i] = isfTab[(sfIdx & 0x01 ? isf : 0)];
+					sti->isfR[i] = isfTab[(sfIdx & 0x01 ? 0 : isf)];
+				}
+			}
+		}
+	}
+}
@@ -45,6 +45,42 @@
 #include "coder.h"
 //#include "assembly.h"
 
+/* FDCT32 in assembly on ARM (asmdct32_thumb2.S), unless MP3_FDCT32_C is defined in mp3dec.h */
+#if defined(__arm__) && !defined(MP3_FDCT32_C)
+#define FDCT32_SB	FDCT32Thumb2
+#else
+#define FDCT32_SB	FDCT32
+#endif
+
+/* after this many silent blocks in a row (one full turn of vindex over both halves),
+ *   every slot of vbuf[ch] the polyphase filter reads has been overwritten with 0
+ */
+#define VBUF_ZERO_BLOCKS	16
+
+/**************************************************************************************
+ * Function:    SubbandDCT
+ *
+ * Description: 32-point DCT of one block of one channel into vbuf[ch], skipped once
+ *                vbuf[ch] is all zero and the input stays silent
+ *
+ * Inputs:      IMDCTInfo and SubbandInfo structs, channel, block index
+ *
+ * Outputs:     updated vbuf[ch] and sbi->zeroBlocks[ch]
+ *
+ * Return:      non-zero if vbuf[ch] is all zero (polyphase output would be all zero)
+ **************************************************************************************/
+static __inline int SubbandDCT(IMDCTInfo *mi, SubbandInfo *sbi, int ch, int b)
+{
+	int nActive = mi->numActive[ch];
+
+	if (nActive || sbi->zeroBlocks[ch] < VBUF_ZERO_BLOCKS)
+		FDCT32_SB(mi->outBuf[ch][b], sbi->vbuf + ch*32, sbi->vindex, (b & 0x01), mi->gb[ch], nActive);
+
+	sbi->zeroBlocks[ch] = (nActive ? 0 : MIN(sbi->zeroBlocks[ch] + 1, VBUF_ZERO_BLOCKS));
+
+	return (sbi->zeroBlocks[ch] == VBUF_ZERO_BLOCKS);
+}
+
 /**************************************************************************************
  * Function:    Subband
  *
@@ -52,14 +88,23 @@
  *
  * Inputs:      filled MP3DecInfo structure, after calling IMDCT for all channels
  *              vbuf[ch] and vindex[ch] must be preserved between calls
+ *              PCMOut struct for the frame, index of current granule
  *
- * Outputs:     decoded PCM data, interleaved LRLRLR... if stereo
+ * Outputs:     decoded PCM data, interleaved LRLRLR... if stereo, or one buffer per
+ *                channel with planar output
  *
  * Return:      0 on success,  -1 if null input pointers
+ *
+ * Notes:       the DCT only transforms the mi->numActive[ch] subbands that can be non-zero,
+ *                and once all channels have been silent long enough to clear vbuf, the
+ *                polyphase filter is skipped as well (output is exactly 0)
+ *              planar output needs no extra pass over the samples, PolyphaseStereoPlanar
+ *                stores them where they belong
  **************************************************************************************/
-/*__attribute__ ((section (".data"))) */ int Subband(MP3DecInfo *mp3DecInfo, short *pcmBuf)
+/*__attribute__ ((section (".data"))) */ int Subband(MP3DecInfo *mp3DecInfo, PCMOut *pcmOut, int gr)
 {
-	int b;
+	int b, i, n, zero;
+	short *pcmBuf, *pcmR;
 	//HuffmanInfo *hi;
 	IMDCTInfo *mi;
 	SubbandInfo *sbi;
@@ -67,27 +112,54 @@
 	/* validate pointers */
 	if (!mp3DecInfo || !mp3DecInfo->HuffmanInfoPS || !mp3DecInfo->IMDCTInfoPS || !mp3DecInfo->SubbandInfoPS)
 		return -1;
+	if (!pcmOut->buf && (!pcmOut->left || (mp3DecInfo->nChans == 2 && !pcmOut->right)))
+		return -1;
 
 	//hi = (HuffmanInfo *)mp3DecInfo->HuffmanInfoPS;
 	mi = (IMDCTInfo *)(mp3DecInfo->IMDCTInfoPS);
 	sbi = (SubbandInfo*)(mp3DecInfo->SubbandInfoPS);
 
+	/* index of the first output sample of the granule, per channel */
+	n = gr * BLOCK_SIZE * NBANDS;
+
 	if (mp3DecInfo->nChans == 2) {
 		/* stereo */
 		for (b = 0; b < BLOCK_SIZE; b++) {
-			FDCT32(mi->outBuf[0][b], sbi->vbuf + 0*32, sbi->vindex, (b & 0x01), mi->gb[0]);
-			FDCT32(mi->outBuf[1][b], sbi->vbuf + 1*32, sbi->vindex, (b & 0x01), mi->gb[1]);
-			PolyphaseStereo(pcmBuf, sbi->vbuf + sbi->vindex + VBUF_LENGTH * (b & 0x01), polyCoef);
+			zero = SubbandDCT(mi, sbi, 0, b);
+			zero &= SubbandDCT(mi, sbi, 1, b);
+			if (pcmOut->buf) {
+				pcmBuf = pcmOut->buf + 2 * n;
+				if (zero) {
+					for (i = 0; i < 2 * NBANDS; i++)
+						pcmBuf[i] = 0;
+				} else {
+					PolyphaseStereo(pcmBuf, sbi->vbuf + sbi->vindex + VBUF_LENGTH * (b & 0x01), polyCoef);
+				}
+			} else {
+				pcmBuf = pcmOut->left + n;
+				pcmR = pcmOut->right + n;
+				if (zero) {
+					for (i = 0; i < NBANDS; i++)
+						pcmBuf[i] = pcmR[i] = 0;
+				} else {
+					PolyphaseStereoPlanar(pcmBuf, pcmR, sbi->vbuf + sbi->vindex + VBUF_LENGTH * (b & 0x01), polyCoef);
+				}
+			}
 			sbi->vindex = (sbi->vindex - (b & 0x01)) & 7;
-			pcmBuf += (2 * NBANDS);
+			n += NBANDS;
 		}
 	} else {
 		/* mono */
 		for (b = 0; b < BLOCK_SIZE; b++) {
-			FDCT32(mi->outBuf[0][b], sbi->vbuf + 0*32, sbi->vindex, (b & 0x01), mi->gb[0]);
-			PolyphaseMono(pcmBuf, sbi->vbuf + sbi->vindex + VBUF_LENGTH * (b & 0x01), polyCoef);
+			pcmBuf = (pcmOut->buf ? pcmOut->buf + n : pcmOut->left + n);
+			if (SubbandDCT(mi, sbi, 0, b)) {
+				for (i = 0; i < NBANDS; i++)
+					pcmBuf[i] = 0;
+			} else {
+				PolyphaseMono(pcmBuf, sbi->vbuf + sbi->vindex + VBUF_LENGTH * (b & 0x01), polyCoef);
+			}
 			sbi->vindex = (sbi->vindex - (b & 0x01)) & 7;
-			pcmBuf += NBANDS;
+			n += NBANDS;
 		}
 	}
 
@@ -43,7 +43,11 @@
 #include "common/assembly.h"
 
 #define AAC_SD_BUF_SIZE	3072 								//Enough space for a complete stereo frame
+#ifdef AAC_ENABLE_UPSAMPLE
+#define AAC_BUF_SIZE	(AAC_MAX_NCHANS * AAC_MAX_NSAMPS * 2)	//AAC output buffer, SBR (or core-only upsampling) doubles the samples per frame
+#else
 #define AAC_BUF_SIZE	(AAC_MAX_NCHANS * AAC_MAX_NSAMPS)	//AAC output buffer
+#endif
 
 #define DECODE_NUM_STATES 2									//How many steps in decode() ?
 
@@ -65,8 +69,17 @@ static uint32_t 		firstChunk, lastChunk;	//for MP4/M4A //TODO: use for ID3 too
 
 static uint32_t			decode_cycles_max;
 static uint32_t			decode_cycles_max_sd;
+static AudioCodecHistogram	decode_hist;
+static AudioCodecHistogram	decode_hist_sd;
+static int				stack_peak;		//of the decoders freed so far
+static volatile uint32_t	decode_cycles_preempted; //time spent in update() during the current decode()
+static uint32_t			decode_frames;	//frames decoded, for the event log
 
 static unsigned int		playing;
+static volatile bool	sbr_core_only;			//requested by sbrCoreOnly(), applied between frames
+static bool				sbr_core_only_dec;		//what the decoder is set to
+static volatile bool	sbr_low_power;			//requested by sbrLowPower(), applied between frames
+static bool				sbr_low_power_dec;
 
 
 static HAACDecoder	hAACDecoder;
@@ -75,6 +88,24 @@ static AACFrameInfo	aacFrameInfo;
 static void decode(void);
 static void aacstop(void);
 
+#ifdef AAC_STAGE_STATS
+static AACStageStats	stage_stats;	//of the last track, the decoder is freed at its end
+#endif
+
+
+//HE-AAC without SBR: the core is upsampled instead, for when the CPU can't keep up with SBR.
+//Can be switched while playing, e.g. when processorUsageMaxDecoder() gets too high. Kept across tracks.
+void AudioPlaySdAac::sbrCoreOnly(bool coreOnly)
+{
+	sbr_core_only = coreOnly;
+}
+
+//HE-AAC with low-power (real-valued) SBR, see AACSetSBRLowPower(). Switching while playing
+//flushes the SBR state, expect a click. Kept across tracks.
+void AudioPlaySdAac::sbrLowPower(bool lowPower)
+{
+	sbr_low_power = lowPower;
+}
 
 void AudioPlaySdAac::stop(void)
 {
@@ -127,20 +158,71 @@ void AudioPlaySdAac::processorUsageMaxResetDecoder(void){
 	__enable_irq();
 };
 
+//playing time of one frame in seconds: 1024 samples per channel, 2048 with SBR
+static float frameDuration(void)
+{
+	if (aacFrameInfo.outputSamps && aacFrameInfo.nChans && aacFrameInfo.sampRateOut)
+		return (float)(aacFrameInfo.outputSamps / aacFrameInfo.nChans) / aacFrameInfo.sampRateOut;
+	return AAC_MAX_NSAMPS / AUDIO_SAMPLE_RATE_EXACT;
+}
+
 float AudioPlaySdAac::processorUsageMaxDecoder(void){
-	//this is somewhat incorrect, it does not take the interruptions of update() into account -
-	//therefore the returned number is too high.
-	//Todo: better solution
-	return (decode_cycles_max / (0.026*F_CPU)) * 100;
+	//the interruptions of update() are subtracted, see decode()
+	return (decode_cycles_max / (frameDuration()*F_CPU)) * 100;
 };
 
 float AudioPlaySdAac::processorUsageMaxSD(void){
-	//this is somewhat incorrect, it does not take the interruptions of update() into account -
-	//therefore the returned number is too high.
-	//Todo: better solution
-	return (decode_cycles_max_sd / (0.026*F_CPU)) * 100;
+	//the interruptions of update() are subtracted, see decode()
+	return (decode_cycles_max_sd / (frameDuration()*F_CPU)) * 100;
 };
 
+void AudioPlaySdAac::processorUsageHistogram(AudioCodecHistogram *decoder, AudioCodecHistogram *sd)
+{
+	__disable_irq();
+	if (decoder) memcpy(decoder, &decode_hist, sizeof(AudioCodecHistogram));
+	if (sd) memcpy(sd, &decode_hist_sd, sizeof(AudioCodecHistogram));
+	__enable_irq();
+}
+
+void AudioPlaySdAac::processorUsageHistogramReset(void)
+{
+	__disable_irq();
+	memset(&decode_hist, 0, sizeof(AudioCodecHistogram));
+	memset(&decode_hist_sd, 0, sizeof(AudioCodecHistogram));
+	__enable_irq();
+}
+
+size_t AudioPlaySdAac::memoryUsageBuffers(void)
+{
+	return AAC_SD_BUF_SIZE + 2 * AAC_BUF_SIZE * sizeof(int16_t);
+}
+
+void AudioPlaySdAac::memoryUsageDecoder(AACMemInfo *info)
+{
+	__disable_irq();
+	AACGetMemInfo(hAACDecoder, info);
+	if (stack_peak > info->stackPeak) info->stackPeak = stack_peak;
+	__enable_irq();
+}
+
+#ifdef AAC_STAGE_STATS
+void AudioPlaySdAac::stageStats(AACStageStats *stats)
+{
+	__disable_irq();
+	if (hAACDecoder) AACGetStageStats(hAACDecoder, stats);
+	else memcpy(stats, &stage_stats, sizeof(AACStageStats));
+	__enable_irq();
+}
+
+void AudioPlaySdAac::stageStatsReset(void)
+{
+	__disable_irq();
+	if (hAACDecoder) AACResetStageStats(hAACDecoder);
+	memset(&stage_stats, 0, sizeof(AACStageStats));
+	__enable_irq();
+}
+#endif
+
 
 _ATOM AudioPlaySdAac::findMp4Atom(const char *atom, uint32_t posi)
 {
@@ -192,9 +274,21 @@ bool AudioPlaySdAac::setupMp4(void)
 	if (!stsd.size)
 		return false; //something is not ok
 
-	uint16_t channels = fread16(file, stsd.position + 8 + 0x20);
+	int channels = fread16(file, stsd.position + 8 + 0x20);
 	//uint16_t bits		= fread16(file, stsd.position + 8 + 0x22); //not used
-	uint16_t samplerate = fread32(file, stsd.position + 8 + 0x26);
+	int samplerate = fread32(file, stsd.position + 8 + 0x26) & 0xffff;
+
+	//HE-AAC files often have the output rate in the mp4a entry, the decoder needs
+	//the rate of the AAC core from the AudioSpecificConfig in the esds box
+	int ascChannels, ascSamplerate;
+	uint32_t esds = stsd.position + 8 + 0x2c;
+	uint8_t esdsBuf[64];
+	file.seek(esds);
+	if (file.read(esdsBuf, sizeof(esdsBuf)) == sizeof(esdsBuf) &&
+		AACParseESDS(esdsBuf, sizeof(esdsBuf), &ascChannels, &ascSamplerate) == ERR_AAC_NONE) {
+		if (ascChannels) channels = ascChannels;
+		samplerate = ascSamplerate;
+	}
 
 	setupDecoder(channels, samplerate, AAC_PROFILE_LC);
 
@@ -246,6 +340,8 @@ int AudioPlaySdAac::play(const char *filename){
 	buf[1] = (short *) malloc(AAC_BUF_SIZE * sizeof(int16_t));
 
 	hAACDecoder = AACInitDecoder();
+	sbr_core_only_dec = false;
+	sbr_low_power_dec = false;
 	
 	if (!sd_buf || !buf[0] || !buf[1] || !hAACDecoder)
 	{
@@ -308,6 +404,7 @@ int AudioPlaySdAac::play(const char *filename){
 	
 	play_pos = 0;
 	samples_played = 0;
+	decode_frames = 0;
 
 	decode_cycles_max_sd = 0;
 	decode_cycles_max = 0;
@@ -316,6 +413,7 @@ int AudioPlaySdAac::play(const char *filename){
 
 	for (int i=0; i< DECODE_NUM_STATES; i++) decode(); 
 	
+	//HE-AAC comes out at the SBR rate, without SBR too (the core is upsampled, AAC_ENABLE_UPSAMPLE)
 	if((aacFrameInfo.sampRateOut != AUDIOCODECS_SAMPLE_RATE ) || (aacFrameInfo.nChans > 2)) {
 		//Serial.println("incompatible AAC file.");
 		lastError = ERR_CODEC_FORMAT;
@@ -343,9 +441,14 @@ void AudioPlaySdAac::update(void)
 	//if the swi is not active currently.
 	//In addition, check before if there waits work for it.
 	int db = decoding_block;
-	if (!NVIC_IS_ACTIVE(IRQ_AUDIOCODEC)) 
+	if (!NVIC_IS_ACTIVE(IRQ_AUDIOCODEC)) {
 		if (decoded_length[db]==0)
 			NVIC_TRIGGER_INTERRUPT(IRQ_AUDIOCODEC);
+	} else {
+		//we have preempted decode(). The duration of this update() is not known yet,
+		//take the total of the last round (in units of 16 cycles) as estimate.
+		decode_cycles_preempted += (uint32_t)AudioStream::cpu_cycles_total << 4;
+	}
 
 	//determine the block we're playing from
 	int playing_block = 1 - db;
@@ -353,13 +456,20 @@ void AudioPlaySdAac::update(void)
 		{
 		//Huston, we have a problem: The decoder was too slow!
 		//best is, we stop the whole track, as we have no chance to play it.
+		//(so there are no late frames for AAC)
+			codecEvent(CODEC_EVENT_UNDERRUN, decode_frames);
+			codecEvent(CODEC_EVENT_SKIPPED, decode_frames);
 			stop();
 			return;
 		}
 
 	// allocate the audio blocks to transmit
 	block_left = allocate();
-	if (block_left == NULL) return;
+	if (block_left == NULL) {
+		codecEvent(CODEC_EVENT_ALLOCATE, decode_frames);
+		codecEvent(CODEC_EVENT_SKIPPED, decode_frames);
+		return;
+	}
 
 	int pl = play_pos;
 	
@@ -368,6 +478,8 @@ void AudioPlaySdAac::update(void)
 		// block for the right channel output
 		block_right = allocate();
 		if (block_right == NULL) {
+			codecEvent(CODEC_EVENT_ALLOCATE, decode_frames);
+			codecEvent(CODEC_EVENT_SKIPPED, decode_frames);
 			release(block_left);
 			return;
 		}
@@ -413,6 +525,7 @@ void decode(void)
 
 	if (decoded_length[decoding_block]) return; //this block is playing, do NOT fill it
 
+	decode_cycles_preempted = 0;
 	uint32_t cycles = ARM_DWT_CYCCNT;
 	int eof = false;
 	
@@ -426,7 +539,10 @@ void decode(void)
 			sd_p = sd_buf;
 
 			uint32_t cycles_sd = ARM_DWT_CYCCNT - cycles;
+			uint32_t preempted = decode_cycles_preempted;
+			cycles_sd = (cycles_sd > preempted) ? cycles_sd - preempted : 0;
 			if (cycles_sd > decode_cycles_max_sd ) decode_cycles_max_sd = cycles_sd;
+			histogramAdd(&decode_hist_sd, cycles_sd);
 			break;
 		}
 
@@ -448,14 +564,25 @@ void decode(void)
 				
 			}
 			
+			if (sbr_core_only != sbr_core_only_dec) {
+				sbr_core_only_dec = sbr_core_only;
+				AACSetSBRCoreOnly(hAACDecoder, sbr_core_only_dec);
+			}
+			if (sbr_low_power != sbr_low_power_dec) {
+				sbr_low_power_dec = sbr_low_power;
+				AACSetSBRLowPower(hAACDecoder, sbr_low_power_dec);
+			}
+
 			int decode_res = AACDecode(hAACDecoder, &sd_p, (int*)&sd_left, buf[decoding_block]);
 
 			if (!decode_res) {
 				AACGetLastFrameInfo(hAACDecoder, &aacFrameInfo);
 				decoded_length[decoding_block] = aacFrameInfo.outputSamps;
+				decode_frames++;
 			} else {
 				//Serial.print("err:");Serial.println(decode_res);
 				lastError = decode_res;
+				codecEvent(CODEC_EVENT_DECODE_ERROR, decode_frames);
 				eof = true;
 				//goto aacend;
 			}
@@ -466,7 +593,10 @@ void decode(void)
 			}
 
 			cycles = ARM_DWT_CYCCNT - cycles;
+			uint32_t preempted = decode_cycles_preempted;
+			cycles = (cycles > preempted) ? cycles - preempted : 0;
 			if (cycles > decode_cycles_max ) decode_cycles_max = cycles;
+			histogramAdd(&decode_hist, cycles);
 		}
 	} //switch
 		
@@ -489,6 +619,14 @@ void aacstop(void)
 	if (buf[1]) {free(buf[1]);buf[1] = NULL;}
 	if (buf[0]) {free(buf[0]);buf[0] = NULL;}
 	if (sd_buf) {free(sd_buf);sd_buf = NULL;}
+#ifdef AAC_STAGE_STATS
+	if (hAACDecoder) AACGetStageStats(hAACDecoder, &stage_stats);
+#endif
+	if (hAACDecoder) {
+		AACMemInfo info;
+		AACGetMemInfo(hAACDecoder, &info);
+		if (info.stackPeak > stack_peak) stack_peak = info.stackPeak;
+	}
 	if (hAACDecoder) {AACFreeDecoder(hAACDecoder);hAACDecoder=NULL;};
 	__enable_irq();
 	file.close();
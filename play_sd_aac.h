@@ -62,10 +62,22 @@ public:
 	uint32_t positionMillis(void);
 	uint32_t lengthMillis(void);
 	uint32_t bitrate(void);
+	void sbrCoreOnly(bool coreOnly);	//HE-AAC: skip SBR, upsample the core instead (cheaper, no high band)
+	void sbrLowPower(bool lowPower);	//HE-AAC: real-valued low-power SBR (cheaper, some aliasing in the high band), host build only
 
 	void processorUsageMaxResetDecoder(void);
 	float processorUsageMaxDecoder(void);
 	float processorUsageMaxSD(void);
+	void processorUsageHistogram(AudioCodecHistogram *decoder, AudioCodecHistogram *sd);	//snapshot, kept across tracks, see codecs.h
+	void processorUsageHistogramReset(void);
+
+	size_t memoryUsageBuffers(void);	//SD and PCM buffers, allocated by play()
+	void memoryUsageDecoder(AACMemInfo *info);	//decoder heap and peak stack depth, see aac/aacdec.h
+
+#ifdef AAC_STAGE_STATS
+	void stageStats(AACStageStats *stats);	//per-stage decode times, see aac/aacdec.h
+	void stageStatsReset(void);
+#endif
 
 	void setupDecoder(int channels, int samplerate, int profile);
 	_ATOM findMp4Atom(const char *atom, uint32_t posi);
@@ -43,8 +43,10 @@
 #include "play_sd_mp3.h"
 
 
-#define MP3_SD_BUF_SIZE	2048 								//Enough space for a complete stereo frame
-#define MP3_BUF_SIZE	(MAX_NCHAN * MAX_NGRAN * MAX_NSAMP) //MP3 output buffer
+#define MP3_SD_BUF_SIZE	2048 								//SD input ring, enough space for a complete stereo frame
+#define MP3_SD_PRE_SIZE	1444								//in front of the ring, for a frame crossing its end (max 1441 bytes)
+#define MP3_FRAME_SAMPS	(MAX_NGRAN * MAX_NSAMP)				//samples per channel of a frame
+#define MP3_BUF_SIZE	(MAX_NCHAN * MP3_FRAME_SAMPS)		//MP3 output buffer, planar: left, then right
 
 #define DECODE_NUM_STATES 2									//How many steps in decode() ?
 
@@ -53,11 +55,10 @@
 static File				file;
 
 static uint8_t			*sd_buf; //decode
-static uint8_t			*sd_p; 	 //decode
-static int				sd_left; //decode
+static AudioCodecRing	sd_ring; //decode
  
-static short			*buf[2]; //output buffers
-static size_t			decoded_length[2];
+static short			*buf[2]; //output buffers, one frame plays while the next one is decoded
+static size_t			decoded_length[2]; //samples per channel left to play
 static size_t			decoding_block;
 static unsigned int		decoding_state; //state 0: read sd, state 1: decode
 
@@ -66,6 +67,12 @@ static size_t 			size_id3;
 
 static uint32_t			decode_cycles_max;
 static uint32_t			decode_cycles_max_sd;
+static AudioCodecHistogram	decode_hist;
+static AudioCodecHistogram	decode_hist_sd;
+static int				stack_peak;		//of the decoders freed so far
+static volatile uint32_t	decode_cycles_preempted; //time spent in update() during the current decode()
+static uint32_t			decode_frames;	//frames decoded, for the event log
+static bool				underrun;		//update() had nothing to play, waiting for decode()
 
 static unsigned int		playing;
 
@@ -73,8 +80,9 @@ static HMP3Decoder		hMP3Decoder;
 static MP3FrameInfo		mp3FrameInfo;
 
 
-static void mp3stop(void);
-static void decode(void);
+#ifdef MP3_STAGE_STATS
+static MP3StageStats	stage_stats;	//of the last track, the decoder is freed at its end
+#endif
 
 void AudioPlaySdMp3::stop(void)
 {
@@ -126,26 +134,69 @@ void AudioPlaySdMp3::processorUsageMaxResetDecoder(void){
 };
 
 float AudioPlaySdMp3::processorUsageMaxDecoder(void){
-	//this is somewhat incorrect, it does not take the interruptions of update() into account - 
-	//therefore the returned number is too high.
-	//Todo: better solution
+	//the interruptions of update() are subtracted, see decode()
 	return (decode_cycles_max / (0.026*F_CPU)) * 100;
 };
 
 float AudioPlaySdMp3::processorUsageMaxSD(void){
-	//this is somewhat incorrect, it does not take the interruptions of update() into account - 
-	//therefore the returned number is too high.
-	//Todo: better solution
+	//the interruptions of update() are subtracted, see decode()
 	return (decode_cycles_max_sd / (0.026*F_CPU)) * 100;
 };
 
+void AudioPlaySdMp3::processorUsageHistogram(AudioCodecHistogram *decoder, AudioCodecHistogram *sd)
+{
+	__disable_irq();
+	if (decoder) memcpy(decoder, &decode_hist, sizeof(AudioCodecHistogram));
+	if (sd) memcpy(sd, &decode_hist_sd, sizeof(AudioCodecHistogram));
+	__enable_irq();
+}
+
+void AudioPlaySdMp3::processorUsageHistogramReset(void)
+{
+	__disable_irq();
+	memset(&decode_hist, 0, sizeof(AudioCodecHistogram));
+	memset(&decode_hist_sd, 0, sizeof(AudioCodecHistogram));
+	__enable_irq();
+}
+
+size_t AudioPlaySdMp3::memoryUsageBuffers(void)
+{
+	return MP3_SD_PRE_SIZE + MP3_SD_BUF_SIZE + 2 * MP3_BUF_SIZE * sizeof(int16_t);
+}
+
+void AudioPlaySdMp3::memoryUsageDecoder(MP3MemInfo *info)
+{
+	__disable_irq();
+	MP3GetMemInfo(hMP3Decoder, info);
+	if (stack_peak > info->stackPeak) info->stackPeak = stack_peak;
+	__enable_irq();
+}
+
+#ifdef MP3_STAGE_STATS
+void AudioPlaySdMp3::stageStats(MP3StageStats *stats)
+{
+	__disable_irq();
+	if (hMP3Decoder) MP3GetStageStats(hMP3Decoder, stats);
+	else memcpy(stats, &stage_stats, sizeof(MP3StageStats));
+	__enable_irq();
+}
+
+void AudioPlaySdMp3::stageStatsReset(void)
+{
+	__disable_irq();
+	if (hMP3Decoder) MP3ResetStageStats(hMP3Decoder);
+	memset(&stage_stats, 0, sizeof(MP3StageStats));
+	__enable_irq();
+}
+#endif
+
 
 int AudioPlaySdMp3::play(const char *filename){
 	stop();
 
 	lastError = ERR_CODEC_NONE;
 	
-	sd_buf = (uint8_t *) malloc(MP3_SD_BUF_SIZE);
+	sd_buf = (uint8_t *) malloc(MP3_SD_PRE_SIZE + MP3_SD_BUF_SIZE);
 	buf[0] = (short *) malloc(MP3_BUF_SIZE * sizeof(int16_t));
 	buf[1] = (short *) malloc(MP3_BUF_SIZE * sizeof(int16_t));
 
@@ -168,7 +219,7 @@ int AudioPlaySdMp3::play(const char *filename){
 	}
 
 	//Read-ahead 10 Bytes to detect ID3	
-	sd_left = file.read(sd_buf, 10);
+	file.read(sd_buf, 10);
 
 	//Skip ID3, if existent
 	int skip = skipID3(sd_buf);
@@ -176,13 +227,16 @@ int AudioPlaySdMp3::play(const char *filename){
 		size_id3 = skip;
 		int b = skip & 0xfffffe00;
 		file.seek(b);
-		sd_left = 0;
-	} else size_id3 = 0;
+	} else {
+		size_id3 = 0;
+		file.seek(0);
+	}
 	
-	//Fill buffer from the beginning with fresh data
-	sd_left = fillReadBuffer(file, sd_buf, sd_buf, sd_left, MP3_SD_BUF_SIZE);
+	//Fill the ring with fresh data
+	readRingInit(&sd_ring, sd_buf, MP3_SD_PRE_SIZE, MP3_SD_BUF_SIZE);
+	fillReadRing(file, &sd_ring);
 
-	if (!sd_left) {
+	if (!sd_ring.left) {
 		lastError = ERR_CODEC_FILE_NOT_FOUND;
 		stop();
 		return lastError;
@@ -194,6 +248,7 @@ int AudioPlaySdMp3::play(const char *filename){
 	NVIC_SET_PRIORITY(IRQ_AUDIOCODEC, IRQ_AUDIOCODEC_PRIO);
 	NVIC_ENABLE_IRQ(IRQ_AUDIOCODEC);
 	
+	memset(&mp3FrameInfo, 0, sizeof(mp3FrameInfo));	//play() checks the format of the first decoded frame
 	decoded_length[0] = 0;
 	decoded_length[1] = 0;
 	decoding_block = 0;
@@ -201,12 +256,12 @@ int AudioPlaySdMp3::play(const char *filename){
 	
 	play_pos = 0;
 	samples_played = 0;
+	decode_frames = 0;
+	underrun = false;
 
 	decode_cycles_max_sd = 0;
 	decode_cycles_max = 0;
 
-	sd_p = sd_buf;
-
 	for (size_t i=0; i< DECODE_NUM_STATES; i++) decode(); 
 	
 	if((mp3FrameInfo.samprate != AUDIOCODECS_SAMPLE_RATE ) || (mp3FrameInfo.bitsPerSample != 16) || (mp3FrameInfo.nChans > 2)) {
@@ -236,51 +291,70 @@ void AudioPlaySdMp3::update(void)
 	//if the swi is not active currently.
 	//In addition, check before if there waits work for it.
 	int db = decoding_block;
-	if (!NVIC_IS_ACTIVE(IRQ_AUDIOCODEC)) 
+	if (!NVIC_IS_ACTIVE(IRQ_AUDIOCODEC)) {
 		if (decoded_length[db]==0)
 			NVIC_TRIGGER_INTERRUPT(IRQ_AUDIOCODEC);
+	} else {
+		//we have preempted decode(). The duration of this update() is not known yet,
+		//take the total of the last round (in units of 16 cycles) as estimate.
+		decode_cycles_preempted += (uint32_t)AudioStream::cpu_cycles_total << 4;
+	}
 
 	//determine the block we're playing from
-	int playing_block = 1 - decoding_block;
-	if (decoded_length[playing_block] <= 0) return;
+	int playing_block = 1 - db;
+	if (decoded_length[playing_block] == 0) {
+		if (decoded_length[db] == 0) {
+			//the decoder was too slow or dropped a frame: this block is lost
+			underrun = true;
+			codecEvent(CODEC_EVENT_UNDERRUN, decode_frames);
+			codecEvent(CODEC_EVENT_SKIPPED, decode_frames);
+			return;
+		}
+		//the frame before the decoded one was dropped, e.g. the first one
+		decoding_block = playing_block;
+		playing_block = db;
+		play_pos = 0;
+	}
 
 	// allocate the audio blocks to transmit
 	block_left = allocate();
-	if (block_left == NULL) return;
+	if (block_left == NULL) {
+		codecEvent(CODEC_EVENT_ALLOCATE, decode_frames);
+		codecEvent(CODEC_EVENT_SKIPPED, decode_frames);
+		return;
+	}
 
+	//the decoder has written the channels planar, no deinterleaving
 	uintptr_t pl = play_pos;
-	
+	short *pcm = buf[playing_block] + pl;
+
 	if (mp3FrameInfo.nChans == 2) {
 		// if we're playing stereo, allocate another
 		// block for the right channel output
 		block_right = allocate();
 		if (block_right == NULL) {
+			codecEvent(CODEC_EVENT_ALLOCATE, decode_frames);
+			codecEvent(CODEC_EVENT_SKIPPED, decode_frames);
 			release(block_left);
 			return;
 		}
-		
-		memcpy_frominterleaved(block_left->data, block_right->data, buf[playing_block] + pl);
-		
-		pl += AUDIO_BLOCK_SAMPLES * 2;
+
+		memcpy(block_left->data, pcm, AUDIO_BLOCK_SAMPLES * sizeof(short));
+		memcpy(block_right->data, pcm + MP3_FRAME_SAMPS, AUDIO_BLOCK_SAMPLES * sizeof(short));
 		transmit(block_left, 0);
 		transmit(block_right, 1);
 		release(block_right);
-		decoded_length[playing_block] -= AUDIO_BLOCK_SAMPLES * 2;
-
 	} else
 	{
 		// if we're playing mono, no right-side block
-		// let's do a (hopefully good optimized) simple memcpy
-		memcpy(block_left->data, buf[playing_block] + pl, AUDIO_BLOCK_SAMPLES * sizeof(short));
-		
-		pl += AUDIO_BLOCK_SAMPLES;
+		memcpy(block_left->data, pcm, AUDIO_BLOCK_SAMPLES * sizeof(short));
 		transmit(block_left, 0);
 		transmit(block_left, 1);
-		decoded_length[playing_block] -= AUDIO_BLOCK_SAMPLES;
-
 	}
 
+	pl += AUDIO_BLOCK_SAMPLES;
 	samples_played += AUDIO_BLOCK_SAMPLES;
+	decoded_length[playing_block] -= AUDIO_BLOCK_SAMPLES;
 
 	release(block_left);
 	
@@ -295,11 +369,12 @@ void AudioPlaySdMp3::update(void)
 }
 
 //decoding-interrupt
-void decode(void)
+void AudioPlaySdMp3::decode(void)
 {
 
 	if (decoded_length[decoding_block]) return; //this block is playing, do NOT fill it
 		
+	decode_cycles_preempted = 0;
 	uint32_t cycles = ARM_DWT_CYCCNT;
 	int eof = false;
 	
@@ -308,20 +383,24 @@ void decode(void)
 	case 0: 
 		{
 	
-		//if (sd_left < 1024) { //todo: optimize 1024..
-			sd_left = fillReadBuffer( file, sd_buf, sd_p, sd_left, MP3_SD_BUF_SIZE);
-			if (!sd_left) { eof = true; goto mp3end; }
-			sd_p = sd_buf;
-		//}
-			uint32_t cycles_sd = (ARM_DWT_CYCCNT - cycles);
+			//top up the ring, the reads land directly in its free space
+			fillReadRing(file, &sd_ring);
+			if (!sd_ring.left) { eof = true; goto mp3end; }
+			uint32_t cycles_sd = ARM_DWT_CYCCNT - cycles;
+			uint32_t preempted = decode_cycles_preempted;
+			cycles_sd = (cycles_sd > preempted) ? cycles_sd - preempted : 0;
 			if (cycles_sd > decode_cycles_max_sd ) decode_cycles_max_sd = cycles_sd;
+			histogramAdd(&decode_hist_sd, cycles_sd);
 			break;
 		}
 	
 	case 1:
 		{		
-			// find start of next MP3 frame - assume EOF if no sync found
-			int offset = MP3FindSyncWord(sd_p, sd_left);
+			int db = decoding_block;	//update() switches decoding_block if we are late
+
+			// find start of next MP3 frame (usually right here) - assume EOF if no sync found
+			int sd_left = readRingContiguous(&sd_ring, MP3_SD_PRE_SIZE);
+			int offset = MP3FindNextFrame(hMP3Decoder, sd_ring.rd, sd_left);
 
 			if (offset < 0) {
 				//Serial.println("No sync"); //no error at end of file
@@ -329,35 +408,51 @@ void decode(void)
 				goto mp3end;
 			}
 
-			sd_p += offset;
-			sd_left -= offset;
+			readRingSkip(&sd_ring, offset);
+
+			//the whole frame must be contiguous, the decoder reads it in place
+			sd_left = readRingContiguous(&sd_ring, MP3_SD_PRE_SIZE);
+			uint8_t *sd_p = sd_ring.rd;
 
-			int decode_res = MP3Decode(hMP3Decoder, &sd_p, (int*)&sd_left,buf[decoding_block], 0);
+			//planar output: the left channel in the first half of the buffer, the right one in the second
+			int decode_res = MP3DecodePlanar(hMP3Decoder, &sd_p, &sd_left, buf[db], buf[db] + MP3_FRAME_SAMPS, 0);
+			readRingSkip(&sd_ring, sd_p - sd_ring.rd);
 
 			switch(decode_res)
 			{
 				case ERR_MP3_NONE:
 				{
 					MP3GetLastFrameInfo(hMP3Decoder, &mp3FrameInfo);
-					decoded_length[decoding_block] = mp3FrameInfo.outputSamps;					
+					decoded_length[db] = mp3FrameInfo.outputSamps / mp3FrameInfo.nChans;
+					decode_frames++;
+					if (underrun) {
+						underrun = false;
+						codecEvent(CODEC_EVENT_LATE, decode_frames);
+					}
 					break;
 				}
 
 				case ERR_MP3_MAINDATA_UNDERFLOW:
 				{
+					//frame dropped, no output
+					codecEvent(CODEC_EVENT_DECODE_ERROR, decode_frames);
 					break;
 				}
 
 				default :
 				{
 					lastError = decode_res;
+					codecEvent(CODEC_EVENT_DECODE_ERROR, decode_frames);
 					eof = true;
 					break;
 				}
 			}
 
-			cycles = (ARM_DWT_CYCCNT - cycles);
+			cycles = ARM_DWT_CYCCNT - cycles;
+			uint32_t preempted = decode_cycles_preempted;
+			cycles = (cycles > preempted) ? cycles - preempted : 0;
 			if (cycles > decode_cycles_max ) decode_cycles_max = cycles;
+			histogramAdd(&decode_hist, cycles);
 			break;
 		}
 	}//switch
@@ -373,7 +468,7 @@ mp3end:
 
 }
 
-void mp3stop(void)
+void AudioPlaySdMp3::mp3stop(void)
 {
 	AudioStopUsingSPI();
 	__disable_irq();	
@@ -381,6 +476,14 @@ void mp3stop(void)
 	if (buf[1]) {free(buf[1]);buf[1] = NULL;}
 	if (buf[0]) {free(buf[0]);buf[0] = NULL;}
 	if (sd_buf) {free(sd_buf);sd_buf = NULL;}
+#ifdef MP3_STAGE_STATS
+	if (hMP3Decoder) MP3GetStageStats(hMP3Decoder, &stage_stats);
+#endif
+	if (hMP3Decoder) {
+		MP3MemInfo info;
+		MP3GetMemInfo(hMP3Decoder, &info);
+		if (info.stackPeak > stack_peak) stack_peak = info.stackPeak;
+	}
 	if (hMP3Decoder) {MP3FreeDecoder(hMP3Decoder);hMP3Decoder=NULL;};
 	__enable_irq();
 	file.close();
@@ -63,12 +63,24 @@ public:
 	void processorUsageMaxResetDecoder(void);
 	float processorUsageMaxDecoder(void);
 	float processorUsageMaxSD(void);
+	void processorUsageHistogram(AudioCodecHistogram *decoder, AudioCodecHistogram *sd);	//snapshot, kept across tracks, see codecs.h
+	void processorUsageHistogramReset(void);
+
+	size_t memoryUsageBuffers(void);	//SD and PCM buffers, allocated by play()
+	void memoryUsageDecoder(MP3MemInfo *info);	//decoder heap and peak stack depth, see mp3/mp3dec.h
+
+#ifdef MP3_STAGE_STATS
+	void stageStats(MP3StageStats *stats);	//per-stage decode times, see mp3/mp3dec.h
+	void stageStatsReset(void);
+#endif
 
 private:
 	uintptr_t	play_pos; //upd
 	uint32_t	samples_played;//upd
 	//int			lastError;
 	void update(void);
+	static void decode(void);	//decoding-interrupt
+	static void mp3stop(void);
 };
 
 